@@ -0,0 +1,120 @@
+#pragma once
+
+// =========================================================================
+// --- CLOCK COMPOSITION ---
+// The wiring of the clock above the hardware, shared by the firmware
+// (main.cpp), the simulation (sim/) and the Linux process (linux/). Every
+// target provides the leaves that touch the hardware, see IClockLeaves,
+// and the time; the composition builds the motors, the homing, the hands,
+// their tick profile tunings and the clock on top of them.
+// =========================================================================
+#include <memory>
+
+#include <soc/api/IDigitalInput.h>
+#include <soc/api/ILogger.h>
+#include <soc/api/IPersistentStore.h>
+#include <soc/api/IPwmOutput.h>
+#include <soc/api/ISoc.h>
+#include <soc/api/ITime.h>
+#include <stepper/api/IStepperController.h>
+#include <stepper/accel/AccelStepperMotor.h>
+#include <stepper/accel/CachingStepperController.h>
+#include <stepper/homing/LimitSwitchHomingStrategy.h>
+#include <aviator-clock/AviatorClock.h>
+#include <aviator-clock/ClockHand.h>
+#include <aviator-clock/TickProfileTuning.h>
+#include <ClockConfig.h>
+
+/**
+ * @brief The leaves of the hands, made and owned by the target. Asked once per hand
+ * while composing.
+ */
+class IClockLeaves
+{
+public:
+  virtual ~IClockLeaves() = default;
+
+  /**
+   * @brief The driver of the hand, the composition configures it through a command cache.
+   */
+  virtual stepper::api::IStepperController &controller(aviator_clock::ClockHand::HandType type) = 0;
+
+  /**
+   * @brief The limit switch the hand homes and tunes on, begun.
+   */
+  virtual soc::api::IDigitalInput &limitSwitch(aviator_clock::ClockHand::HandType type) = 0;
+
+  /**
+   * @brief The PWM output on the enable pin, only asked for a reduced hold current.
+   */
+  virtual soc::api::IPwmOutput &enablePwm(aviator_clock::ClockHand::HandType type) = 0;
+
+  /**
+   * @brief The enable pin the motor drives itself if the hold current is not reduced.
+   */
+  virtual uint8_t enablePin(aviator_clock::ClockHand::HandType type) const = 0;
+};
+
+class ClockComposition
+{
+public:
+  struct Settings
+  {
+    // the profile until a hand is tuned, or of all hands without a store
+    double tickSpeedDps = SHARP_TICK_SPEED_DPS;
+    double tickAccelerationDps2 = SHARP_TICK_ACCELERATION_DPS2;
+    stepper::accel::AccelStepperMotor::PowerConfig power = COIL_POWER;
+    bool secondHandSweeps = SECOND_HAND_SWEEPS;
+    bool retune = TICK_PROFILE_RETUNE;
+  };
+
+  /**
+   * @param store Where the tick profiles are saved. Without one the hands are not tuned.
+   */
+  ClockComposition(IClockLeaves &leaves,
+                   soc::api::ITime &timeProvider,
+                   soc::api::ILogger &logger,
+                   soc::api::IPersistentStore *store,
+                   const Settings &settings);
+
+  /**
+   * @brief Builds the clock and adds the tunings and the clock to the soc. Every hand
+   * waits for its own tuning and homes then, see TickProfileTuning.
+   */
+  void compose(soc::api::ISoc &soc);
+
+  // Observers, valid after compose(). The hands are owned by the clock, the clock by the soc.
+  aviator_clock::AviatorClock &clock() const;
+  aviator_clock::ClockHand &hand(aviator_clock::ClockHand::HandType type) const;
+  stepper::accel::AccelStepperMotor &motor(aviator_clock::ClockHand::HandType type) const;
+  stepper::accel::CachingStepperController &commandCache(aviator_clock::ClockHand::HandType type) const;
+
+  /**
+   * @return The tuning of the hand, nullptr without a store.
+   */
+  aviator_clock::TickProfileTuning *tuning(aviator_clock::ClockHand::HandType type) const;
+
+private:
+  static const int HAND_COUNT = 3; // by HandType
+
+  // what a hand borrows, the motor is owned by the hand
+  struct HandParts
+  {
+    std::unique_ptr<stepper::accel::CachingStepperController> commandCache;
+    std::unique_ptr<stepper::homing::LimitSwitchHomingStrategy> homingStrategy;
+    std::shared_ptr<aviator_clock::TickProfileTuning> tuning;
+    stepper::accel::AccelStepperMotor *motor;
+    aviator_clock::ClockHand *hand;
+  };
+
+  IClockLeaves &_leaves;
+  soc::api::ITime &_timeProvider;
+  soc::api::ILogger &_logger;
+  soc::api::IPersistentStore *_store;
+  const Settings _settings;
+
+  HandParts _parts[HAND_COUNT];
+  aviator_clock::AviatorClock *_clock;
+
+  std::unique_ptr<aviator_clock::ClockHand> createHand(aviator_clock::ClockHand::HandType type);
+};
@@ -0,0 +1,127 @@
+#pragma once
+
+// =========================================================================
+// --- CLOCK CONFIGURATION ---
+// Shared by the firmware (main.cpp) and the native simulation (sim/),
+// so both run exactly the same settings. The settings of the ESP32 only
+// are in FirmwareConfig.h.
+// =========================================================================
+#include <stepper/accel/AccelStepperMotor.h>
+#include <stepper/homing/LimitSwitchHomingStrategy.h>
+#include <soc/rtc/DS3231Time.h>
+#include <soc/rtc/DriftCompensatedTime.h>
+#include <aviator-clock/TickProfileTuner.h>
+
+// --- Pin Definitions ---
+// second hand
+#define DIR_PIN_HW 12
+#define STEP_PIN_HW 14
+#define ENABLE_PIN_HW 27
+#define LIMIT_SWITCH_PIN_HW 26
+
+// minute hand
+#define MINUTE_DIR_PIN_HW 25
+#define MINUTE_STEP_PIN_HW 33
+#define MINUTE_ENABLE_PIN_HW 32
+#define MINUTE_LIMIT_SWITCH_PIN_HW 13
+
+// hour hand
+#define HOUR_DIR_PIN_HW 19
+#define HOUR_STEP_PIN_HW 18
+#define HOUR_ENABLE_PIN_HW 21
+#define HOUR_LIMIT_SWITCH_PIN_HW 22
+
+// DS3231 RTC, the default I2C pins 21 and 22 belong to the hour hand
+#define RTC_SDA_PIN_HW 16
+#define RTC_SCL_PIN_HW 17
+
+// --- Motor Configuration ---
+const int EFFECTIVE_STEPS_PER_REVOLUTION = 1600;
+
+// --- Clock Face Configuration ---
+const double DIAL_TOTAL_ACTIVE_ANGLE = 330.0;
+const double DIAL_START_OFFSET_DEGREES = 0.0;
+
+// --- Settings for Sharper Movement ---
+// The tick profile until a hand is tuned, or if its tuning fails.
+const double SHARP_TICK_SPEED_DPS = 2400.0;
+const double SHARP_TICK_ACCELERATION_DPS2 = 60000.0;
+
+// --- Tick Profile Tuning ---
+// At the first boot every hand is tuned to the fastest tick profile that loses no steps,
+// minus 20 %, and the result is saved in the NVS. Set TICK_PROFILE_RETUNE to tune again at
+// every boot, e.g. after changing a hand. The test moves stay within the dial.
+const bool TICK_PROFILE_RETUNE = false;
+const aviator_clock::TickProfileTuner::Config TICK_PROFILE_TUNING = {
+    .start = {.speedDps = 600.0, .accelerationDps2 = 15000.0},
+    .limit = {.speedDps = 4800.0, .accelerationDps2 = 240000.0},
+    .growthFactor = 1.25,
+    .marginFraction = 0.2,
+    .tickDegrees = 5.5,
+    .ticksPerLevel = 10,
+    .longMoveDegrees = 240.0,
+    .probe = {.speedDps = 20.0, .accelerationDps2 = 2000.0},
+    .probeStartDegrees = 30.0, // beyond where the homing stops on the switch
+    .probeOvershootDegrees = 10.0,
+    .switchDirectionSign = -1, // as homingConfig
+    .toleranceSteps = 2};
+
+// --- Catch-up after Time Jumps ---
+// A jump of more than CATCH_UP_THRESHOLD_UNITS is shown with one move at this profile.
+// The physics simulation loses no steps across the whole dial, which takes ~170 ms.
+const double CATCH_UP_SPEED_DPS = 2400.0;
+const double CATCH_UP_ACCELERATION_DPS2 = 120000.0;
+const int CATCH_UP_THRESHOLD_UNITS = 2;
+
+// Sweep the second hand continuously instead of ticking once per second.
+const bool SECOND_HAND_SWEEPS = false;
+
+// --- Clock Configuration ---
+// Minimum time between the starts of the second, minute and hour hand moves, so
+// they don't accelerate at the same time at minute and hour rollovers. Hands of
+// the same type start together. A tick takes ~20 ms.
+const unsigned long HAND_MOVE_STAGGER_MS = 50;
+
+// --- Coil Power ---
+// After a move the coils keep the full current for idleTimeoutMs, until the hand has
+// stopped ringing. Then the enable pins are chopped to holdDuty, the hands stay in place
+// at a fraction of the current. The next move gets the full current wakeLeadMicros
+// before its first step. Tuned with the physics simulation, see src/sim.
+const stepper::accel::AccelStepperMotor::PowerConfig COIL_POWER = {
+    .idlePower = stepper::accel::AccelStepperMotor::IdlePower::REDUCED,
+    .idleTimeoutMs = 30,
+    .holdDuty = 300,
+    .wakeLeadMicros = 1500};
+// LEDC channels of the enable pins, above the audible range
+const uint8_t ENABLE_PWM_CHANNEL = 0;
+const uint8_t MINUTE_ENABLE_PWM_CHANNEL = 1;
+const uint8_t HOUR_ENABLE_PWM_CHANNEL = 2;
+const uint32_t ENABLE_PWM_FREQUENCY_HZ = 25000;
+
+// --- Homing Configuration ---
+const stepper::homing::LimitSwitchHomingStrategy::Config homingConfig = {
+    .homingSpeedStepsPerSec = 400,                              // Slower speed for homing (e.g., 1/4 revolution per sec if 1600 steps/rev)
+    .homingAccelerationStepsPerSecSq = 800,                     // Gentle acceleration
+    .maxHomingTravelSteps = EFFECTIVE_STEPS_PER_REVOLUTION * 2, // e.g., allow 2 full revolutions to find switch
+    .moveDirectionSign = -1                                     // IMPORTANT: Set this to +1 or -1 depending on your setup!
+                                                                // -1 usually means counter-clockwise for AccelStepper
+};
+
+// --- Real Time Clock ---
+// The RTC is read at boot and once an hour, the time in between is extrapolated
+// from millis(). Disagreements up to 5 s are slewed in at 1 %, larger ones are set at once.
+const uint32_t RTC_I2C_FREQUENCY_HZ = 100000;
+const soc::rtc::DS3231Time::Config RTC_TIME = {
+    .resyncIntervalMs = 3600000UL,
+    .stepThresholdMs = 5000UL,
+    .slewPpm = 10000UL};
+
+// --- Crystal Drift Compensation ---
+// millis() is corrected by the rate learned against the RTC, saved in the NVS namespace
+// PREFERENCES_NAMESPACE. A rate is used once it is good to 10 ppm, after about 28 hours.
+const char *const PREFERENCES_NAMESPACE = "aviator-clock";
+const soc::rtc::DriftCompensatedTime::Config DRIFT_COMPENSATION = {
+    .sampleIntervalMs = 3600000UL,
+    .acceptUncertaintyPpmQ16 = 10 * soc::rtc::DriftCompensatedTime::ONE_PPM,
+    .maxCorrectionPpmQ16 = 200 * soc::rtc::DriftCompensatedTime::ONE_PPM,
+    .saveIntervalMs = 86400000UL};
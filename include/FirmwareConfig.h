@@ -0,0 +1,28 @@
+#pragma once
+
+// =========================================================================
+// --- FIRMWARE CONFIGURATION ---
+// The settings of the ESP32 soc, used by the firmware (main.cpp) only. The
+// settings of the clock are in ClockConfig.h.
+// =========================================================================
+#include <cstdint>
+#include <soc/esp32/DebounceFilter.h>
+#include <soc/esp32/ESP32Soc.h>
+
+// --- Loop Watchdog ---
+// A tick runs at up to ~10.7 k steps/s, a step every ~94 us, and a motor steps at most once
+// per loop: a longer loop slows the tick down. Overruns are blamed on the soc component beyond
+// its slice, send 'w' to log them; the hands are blamed as the clock. A blamed non-critical
+// component, the drift compensation or the RTC sync, is degraded for degradeLoops loops.
+const soc::esp32::ESP32Soc::WatchdogConfig LOOP_WATCHDOG = {
+    .loopBudgetMicros = 100,
+    .sliceMicros = 50,
+    .degradeLoops = 1000};
+
+// --- Limit Switch Debouncing ---
+// The switches are sampled from a timer and integrated, a level counts after
+// LIMIT_SWITCH_DEBOUNCE.threshold samples: 2 ms, less than a step at homing speed.
+const uint32_t LIMIT_SWITCH_SAMPLE_PERIOD_US = 500;
+const soc::esp32::DebounceFilter::Config LIMIT_SWITCH_DEBOUNCE = {
+    .mode = soc::esp32::DebounceFilter::Mode::INTEGRATOR,
+    .threshold = 4};
@@ -3,8 +3,10 @@
 #include <stepper/api/IStepperController.h>
 #include <stepper/api/IStepperMotor.h>
 #include <stepper/api/IHomingStrategy.h>
+#include <stepper/api/MotionListeners.h>
 #include <stepper/api/StepperMotorState.h>
 #include <soc/api/ILogger.h>
+#include <soc/api/IPwmOutput.h>
 
 // A common invalid pin marker
 #ifndef INVALID_PIN
@@ -18,6 +20,39 @@ namespace stepper
         class AccelStepperMotor : public IStepperMotor
         {
         public:
+            /**
+             * @brief What the coils get while the motor stands still.
+             * FULL keeps the rated current, DISABLED switches the driver off, the rotor then
+             * rests in the detent of the nearest full step. REDUCED chops the enable pin with
+             * a PWM output, the hold current and torque scale with the duty.
+             */
+            enum class IdlePower
+            {
+                FULL,
+                DISABLED,
+                REDUCED
+            };
+
+            enum class CoilPower
+            {
+                OFF,
+                HOLD,
+                ON
+            };
+
+            struct PowerConfig
+            {
+                IdlePower idlePower;
+                unsigned long idleTimeoutMs;  // full current after a move, until the hand has settled
+                uint16_t holdDuty;            // REDUCED: duty of the enable pin, in 1/IPwmOutput::DUTY_FULL
+                unsigned long wakeLeadMicros; // full current before the first step after idle
+            };
+
+            /**
+             * @brief Keeps the coils at full current, the behaviour without a PowerConfig.
+             */
+            static PowerConfig alwaysOn();
+
             AccelStepperMotor(
                 stepper::api::IStepperController& stepperController,
                 int fullStepsPerRevolution,
@@ -27,15 +62,19 @@ namespace stepper
                 bool enablePinActiveLow = true);
 
             // --- IStepperMotor Interface Implementation ---
-            bool home() override;
+            stepper::api::Status home() override;
             bool isHomingFailed() const override;
             bool isHoming() const override;
             bool needsHoming() const override;
-            bool moveToAbsolute(double degreesAbsolute) override;
-            bool rotateRelative(double degreesRelative) override;
+            stepper::api::Status moveToAbsolute(double degreesAbsolute) override;
+            stepper::api::Status moveToStep(long stepsAbsolute) override;
+            long getStepsPerRevolution() const override;
+            stepper::api::Status rotateRelative(double degreesRelative) override;
+            stepper::api::Status runAtVelocity(double degreesPerSecond) override;
+            bool isRunningAtVelocity() const override;
             void setSpeed(double degreesPerSecond) override;
             void setAcceleration(double degreesPerSecondSquared) override;
-            double getCurrentPositionDegrees() const override;
+            stepper::api::Result<double> getCurrentPositionDegrees() const override;
             void enable() override;
             void disable() override;
             stepper::api::StepperMotorState getState() const override;
@@ -44,6 +83,26 @@ namespace stepper
             void update() override;
             bool isBusy() const override;
             void stop() override;
+            bool isPowerDownPending() const override;
+            bool isUpdateDue() const override;
+            bool addMotionListener(stepper::api::IMotionListener &listener) override;
+            void removeMotionListener(stepper::api::IMotionListener &listener) override;
+
+            /**
+             * @brief Reduces the coil current once the motor was idle for idleTimeoutMs.
+             * The next move energizes the coils at once and starts stepping wakeLeadMicros
+             * later, when the current has risen and the rotor is back at the commanded
+             * (micro)step. The position is kept as long as the rotor does not move by two
+             * full steps while the current is reduced.
+             *
+             * DISABLED needs the enable pin of the constructor. REDUCED needs enablePwm on
+             * the enable pin instead, construct the motor without an enable pin then.
+             * An unusable configuration is logged and ignored.
+             */
+            void setPowerConfig(const PowerConfig &config, soc::api::IPwmOutput *enablePwm = nullptr);
+
+            CoilPower getCoilPower() const;
+            unsigned long getWakeCount() const;
 
         private:
             stepper::api::IStepperController& _stepperController;
@@ -55,10 +114,35 @@ namespace stepper
             bool _isHomed;
             float _currentSetSpeedDps;
             float _currentSetAccelerationDps2;
+            long _maxSpeedSteps;          // _currentSetSpeedDps in steps, set again before every move
+            long _accelerationSteps;      // _currentSetAccelerationDps2 in steps
+            bool _velocityMode;
+            unsigned long _nextStepDueMicros; // of the controller, update() skips it until then
 
             soc::api::ILogger& _logger;
             stepper::api::StepperMotorState _currentState;
 
+            PowerConfig _powerConfig;
+            soc::api::IPwmOutput *_enablePwm;
+            CoilPower _coilPower;
+            bool _powerDownPending;
+            unsigned long _idleSinceMs;
+            bool _waking;
+            unsigned long _wakeStartMicros;
+            unsigned long _wakeCount;
+
+            stepper::api::MotionListeners _motionListeners;
+
+            void setState(stepper::api::StepperMotorState state);
+            stepper::api::StepperError commandError(bool needsPosition) const;
+            bool hasIdlePower() const;
+            void setCoilPower(CoilPower power);
+            void beginIdle();
+            void endMove();
+            void wakeCoils();
+            bool isWaking();
+            bool isStepDue() const;
+            void resetStepDue();
             long degreesToSteps(double degrees) const;
             double stepsToDegrees(long steps) const;
         };
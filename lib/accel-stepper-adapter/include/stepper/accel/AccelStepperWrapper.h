@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cmath>
+#include <memory>
 #include <stepper/api/IStepperController.h>
+#include <stepper/accel/BatchedAccelStepper.h>
 #include <AccelStepper.h>
 
 using stepper::api::IStepperController;
@@ -12,13 +15,44 @@ namespace stepper
         class AccelStepperWrapper : public IStepperController
         {
         private:
-            AccelStepper _accelStepper;
+            std::unique_ptr<AccelStepper> _stepper;
+            BatchedAccelStepper *_batchedStepper; // the same object if the pulses are batched
+            AccelStepper &_accelStepper;
+            unsigned long _lastStepMicros; // AccelStepper keeps its step time private, see noteStep()
+
+            /**
+             * @brief Remembers the time of a step across run() or runSpeed(). now is taken
+             * before the call, not after AccelStepper's own micros(), so the due time
+             * derived from it is never late.
+             */
+            void noteStep(unsigned long now, long positionBefore)
+            {
+                if (_accelStepper.currentPosition() != positionBefore)
+                {
+                    _lastStepMicros = now;
+                }
+            }
 
         public:
             AccelStepperWrapper(uint8_t stepPin,
                                 uint8_t dirPin,
                                 AccelStepper::MotorInterfaceType interface = AccelStepper::DRIVER)
-                : _accelStepper(interface, stepPin, dirPin) {}
+                : _stepper(std::make_unique<AccelStepper>(interface, stepPin, dirPin)),
+                  _batchedStepper(nullptr),
+                  _accelStepper(*_stepper),
+                  _lastStepMicros(0) {}
+
+            /**
+             * @brief Step/dir driver whose step pulses are batched with the other motors,
+             * see BatchedAccelStepper.
+             */
+            AccelStepperWrapper(uint8_t stepPin,
+                                uint8_t dirPin,
+                                soc::esp32::ESP32PulseBatch &pulseBatch)
+                : _stepper(std::make_unique<BatchedAccelStepper>(stepPin, dirPin, pulseBatch)),
+                  _batchedStepper(static_cast<BatchedAccelStepper *>(_stepper.get())),
+                  _accelStepper(*_stepper),
+                  _lastStepMicros(0) {}
 
             void setEnablePin(uint8_t enablePin) override
             {
@@ -28,6 +62,10 @@ namespace stepper
             void setPinsInverted(bool dirInvert, bool stepInvert, bool enableInvert) override
             {
                 _accelStepper.setPinsInverted(dirInvert, stepInvert, enableInvert);
+                if (_batchedStepper)
+                {
+                    _batchedStepper->setDirectionInverted(dirInvert);
+                }
             }
 
             void enableOutputs() override
@@ -77,13 +115,55 @@ namespace stepper
 
             bool run() override
             {
-                return _accelStepper.run();
+                unsigned long now = micros();
+                long position = _accelStepper.currentPosition();
+                bool running = _accelStepper.run();
+                noteStep(now, position);
+                return running;
             }
 
             void stop() override
             {
                 _accelStepper.stop();
             }
+
+            unsigned long nextStepDueMicros() override
+            {
+                // AccelStepper keeps its speed at 1e6 / step interval, and at 0 without a step
+                unsigned long now = micros();
+                float speed = fabsf(_accelStepper.speed());
+                if (speed == 0.0f)
+                {
+                    return now;
+                }
+                // the interval is truncated there, one microsecond early covers the rounding
+                unsigned long interval = static_cast<unsigned long>(1000000.0f / speed);
+                interval = interval > 0 ? interval - 1 : 0;
+                if (now - _lastStepMicros >= interval)
+                {
+                    return now;
+                }
+                return _lastStepMicros + interval;
+            }
+
+            void setSpeed(float speed) override
+            {
+                _accelStepper.setSpeed(speed);
+            }
+
+            float getSpeed() override
+            {
+                return _accelStepper.speed();
+            }
+
+            bool runSpeed() override
+            {
+                unsigned long now = micros();
+                long position = _accelStepper.currentPosition();
+                bool stepped = _accelStepper.runSpeed();
+                noteStep(now, position);
+                return stepped;
+            }
         };
     }
 }
\ No newline at end of file
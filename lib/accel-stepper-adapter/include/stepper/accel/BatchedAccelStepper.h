@@ -0,0 +1,56 @@
+#pragma once
+
+#include <AccelStepper.h>
+#include <soc/esp32/ESP32PulseBatch.h>
+#include <soc/esp32/FastGpio.h>
+
+namespace stepper
+{
+    namespace accel
+    {
+        /**
+         * @brief AccelStepper driver (step/dir) whose step pulses go out with those of the
+         * other motors of the loop.
+         *
+         * A step writes the dir pin through the GPIO registers and adds the step pin to the
+         * shared ESP32PulseBatch, the main loop flushes the batch once after all motors ran.
+         * The dir pin is latched long before the rising edge. If the motor steps again before
+         * the flush, its pending pulse goes out first, so no step is lost. The step pin is
+         * active high, AccelStepper's step inversion does not apply.
+         */
+        class BatchedAccelStepper : public AccelStepper
+        {
+        public:
+            BatchedAccelStepper(uint8_t stepPin, uint8_t dirPin, soc::esp32::ESP32PulseBatch &pulseBatch)
+                : AccelStepper(AccelStepper::DRIVER, stepPin, dirPin),
+                  _pulseBatch(pulseBatch),
+                  _stepMask(soc::esp32::FastGpio::mask(stepPin)),
+                  _dirMask(soc::esp32::FastGpio::mask(dirPin)),
+                  _dirInverted(false)
+            {
+            }
+
+            void setDirectionInverted(bool dirInverted)
+            {
+                _dirInverted = dirInverted;
+            }
+
+        protected:
+            void step(long /*step*/) override
+            {
+                if (_pulseBatch.isPending(_stepMask))
+                {
+                    _pulseBatch.flush();
+                }
+                soc::esp32::FastGpio::write(_dirMask, (_direction == DIRECTION_CW) != _dirInverted);
+                _pulseBatch.add(_stepMask);
+            }
+
+        private:
+            soc::esp32::ESP32PulseBatch &_pulseBatch;
+            const uint64_t _stepMask;
+            const uint64_t _dirMask;
+            bool _dirInverted;
+        };
+    }
+}
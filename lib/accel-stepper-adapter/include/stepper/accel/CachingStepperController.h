@@ -0,0 +1,78 @@
+#pragma once
+
+#include <stepper/api/IStepperController.h>
+
+namespace stepper
+{
+    namespace accel
+    {
+        /**
+         * @brief IStepperController decorator that drops reconfigurations which change nothing:
+         * setMaxSpeed() and setAcceleration() with the value last applied, enableOutputs() and
+         * disableOutputs() while the outputs already are in that state. Everything else is passed on.
+         *
+         * AccelStepperMotor sets the profile before every move because the homing strategy may
+         * have changed it. The cache only knows what went through it, so the motor and its
+         * LimitSwitchHomingStrategy must both be given the cache, not the controller behind it.
+         * Call invalidate() after the wrapped controller was configured directly.
+         */
+        class CachingStepperController : public stepper::api::IStepperController
+        {
+        public:
+            explicit CachingStepperController(stepper::api::IStepperController &stepperController);
+
+            // --- IStepperController Interface Implementation ---
+            void setEnablePin(uint8_t enablePin) override;
+            void setPinsInverted(bool dirInvert, bool stepInvert, bool enableInvert) override;
+            void enableOutputs() override;
+            void disableOutputs() override;
+            void setMaxSpeed(float speed) override;
+            void setAcceleration(float acceleration) override;
+            void moveTo(long absoluteSteps) override;
+            void move(long relativeSteps) override;
+            long getCurrentPosition() override;
+            void setCurrentPosition(long absoluteSteps) override;
+            long distanceToGo() override;
+            bool run() override;
+            void stop() override;
+            unsigned long nextStepDueMicros() override;
+            void setSpeed(float speed) override;
+            float getSpeed() override;
+            bool runSpeed() override;
+
+            /**
+             * @brief Forgets the applied values, the next reconfigurations are passed on.
+             */
+            void invalidate();
+
+            /**
+             * @brief Reconfigurations passed on to the wrapped controller.
+             */
+            unsigned long getForwardedCount() const;
+
+            /**
+             * @brief Reconfigurations dropped because they would not have changed anything.
+             */
+            unsigned long getSkippedCount() const;
+
+        private:
+            enum class Outputs
+            {
+                UNKNOWN,
+                ENABLED,
+                DISABLED
+            };
+
+            stepper::api::IStepperController &_stepperController;
+            bool _maxSpeedKnown;
+            float _maxSpeed;
+            bool _accelerationKnown;
+            float _acceleration;
+            Outputs _outputs;
+            unsigned long _forwardedCount;
+            unsigned long _skippedCount;
+
+            bool forward(bool changes);
+        };
+    }
+}
@@ -48,6 +48,8 @@ namespace stepper
 
             HomingPhase _currentPhase;
             stepper::api::HomingResult _currentHomingResult;
+
+            void setPhase(HomingPhase phase);
         };
 
     } // namespace homing
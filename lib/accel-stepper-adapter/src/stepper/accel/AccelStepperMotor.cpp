@@ -1,13 +1,18 @@
 #include <stepper/accel/AccelStepperMotor.h>
 #include <stepper/api/StepperMotorState.h>
+#include <Arduino.h>
 #include <cmath>
-#include <stdexcept>
+#include <soc/trace/TraceRecorder.h>
 
 // A common invalid pin marker (ensure it's defined if not in a global header)
 #ifndef INVALID_PIN
 #define INVALID_PIN 0xFF
 #endif
 
+using stepper::api::MotionEvent;
+using stepper::api::Result;
+using stepper::api::Status;
+using stepper::api::StepperError;
 using stepper::api::StepperMotorState;
 
 namespace stepper
@@ -28,8 +33,22 @@ namespace stepper
                                        _isHomed(false),                                     // Motor starts as not homed
                                        _currentSetSpeedDps(100.0),                          // Default speed
                                        _currentSetAccelerationDps2(100.0),                  // Default acceleration
-                                       _currentState(stepper::api::StepperMotorState::IDLE) // Initialize state
+                                       _maxSpeedSteps(0),
+                                       _accelerationSteps(0),
+                                       _velocityMode(false),
+                                       _nextStepDueMicros(0),
+                                       _currentState(stepper::api::StepperMotorState::IDLE), // Initialize state
+                                       _powerConfig(alwaysOn()),
+                                       _enablePwm(nullptr),
+                                       // the driver is disabled below, without an enable pin it is always on
+                                       _coilPower(enablePin != INVALID_PIN ? CoilPower::OFF : CoilPower::ON),
+                                       _powerDownPending(false),
+                                       _idleSinceMs(0),
+                                       _waking(false),
+                                       _wakeStartMicros(0),
+                                       _wakeCount(0)
         {
+            SOC_TRACE_TRACK(this, "AccelStepperMotor");
             homingStrategy.resetStrategy();
 
             if (_enablePin != INVALID_PIN)
@@ -41,8 +60,223 @@ namespace stepper
                 _stepperController.disableOutputs();
             }
 
-            _stepperController.setMaxSpeed(degreesToSteps(_currentSetSpeedDps));
-            _stepperController.setAcceleration(degreesToSteps(_currentSetAccelerationDps2));
+            _maxSpeedSteps = degreesToSteps(_currentSetSpeedDps);
+            _accelerationSteps = degreesToSteps(_currentSetAccelerationDps2);
+            _stepperController.setMaxSpeed(_maxSpeedSteps);
+            _stepperController.setAcceleration(_accelerationSteps);
+        }
+
+        AccelStepperMotor::PowerConfig AccelStepperMotor::alwaysOn()
+        {
+            PowerConfig config;
+            config.idlePower = IdlePower::FULL;
+            config.idleTimeoutMs = 0;
+            config.holdDuty = soc::api::IPwmOutput::DUTY_FULL;
+            config.wakeLeadMicros = 0;
+            return config;
+        }
+
+        static const char *stateName(StepperMotorState state)
+        {
+            switch (state)
+            {
+            case StepperMotorState::IDLE:
+                return "IDLE";
+            case StepperMotorState::MOVING:
+                return "MOVING";
+            case StepperMotorState::HOMING_IN_PROGRESS:
+                return "HOMING_IN_PROGRESS";
+            case StepperMotorState::HOMING_FAILED:
+                return "HOMING_FAILED";
+            }
+            return "UNKNOWN";
+        }
+
+        void AccelStepperMotor::setState(StepperMotorState state)
+        {
+            if (state != _currentState)
+            {
+                SOC_TRACE_STATE(this, stateName(state));
+            }
+            _currentState = state;
+        }
+
+        StepperError AccelStepperMotor::commandError(bool needsPosition) const
+        {
+            if (_currentState == StepperMotorState::HOMING_IN_PROGRESS)
+            {
+                return StepperError::HOMING_IN_PROGRESS;
+            }
+            if (_currentState == StepperMotorState::HOMING_FAILED)
+            {
+                return StepperError::HOMING_FAILED;
+            }
+            if (needsPosition && !_isHomed)
+            {
+                return StepperError::NOT_HOMED;
+            }
+            // a position move may take over from the velocity mode
+            if (_currentState != StepperMotorState::IDLE && !_velocityMode)
+            {
+                return StepperError::BUSY;
+            }
+            return StepperError::NONE;
+        }
+
+        void AccelStepperMotor::setPowerConfig(const PowerConfig &config, soc::api::IPwmOutput *enablePwm)
+        {
+            if (config.idlePower == IdlePower::DISABLED && _enablePin == INVALID_PIN && enablePwm == nullptr)
+            {
+                _logger.error("AccelStepperMotor: Cannot disable the driver when idle without an enable pin.");
+                return;
+            }
+            if (config.idlePower == IdlePower::REDUCED && enablePwm == nullptr)
+            {
+                _logger.error("AccelStepperMotor: A reduced hold current needs a PWM output on the enable pin.");
+                return;
+            }
+
+            _powerConfig = config;
+            _enablePwm = enablePwm;
+            if (_enablePwm != nullptr)
+            {
+                // the PWM output takes over the enable pin, in the state the motor is in
+                _enablePwm->begin();
+                setCoilPower(_coilPower);
+            }
+            _powerDownPending = false;
+            if (_currentState == StepperMotorState::IDLE)
+            {
+                beginIdle();
+            }
+        }
+
+        AccelStepperMotor::CoilPower AccelStepperMotor::getCoilPower() const
+        {
+            return _coilPower;
+        }
+
+        unsigned long AccelStepperMotor::getWakeCount() const
+        {
+            return _wakeCount;
+        }
+
+        bool AccelStepperMotor::isPowerDownPending() const
+        {
+            return _powerDownPending;
+        }
+
+        bool AccelStepperMotor::hasIdlePower() const
+        {
+            return _powerConfig.idlePower != IdlePower::FULL;
+        }
+
+        void AccelStepperMotor::setCoilPower(CoilPower power)
+        {
+            if (_enablePwm != nullptr)
+            {
+                uint16_t duty = 0;
+                if (power == CoilPower::ON)
+                {
+                    duty = soc::api::IPwmOutput::DUTY_FULL;
+                }
+                else if (power == CoilPower::HOLD)
+                {
+                    duty = _powerConfig.holdDuty;
+                }
+                _enablePwm->setDuty(duty);
+            }
+            else if (_enablePin != INVALID_PIN)
+            {
+                // without PWM there is no reduced current
+                if (power == CoilPower::OFF)
+                {
+                    _stepperController.disableOutputs();
+                }
+                else
+                {
+                    _stepperController.enableOutputs();
+                }
+            }
+            if (power != _coilPower)
+            {
+                SOC_TRACE_INSTANT(this, "coilPower", static_cast<int32_t>(power));
+            }
+            _coilPower = power;
+        }
+
+        void AccelStepperMotor::beginIdle()
+        {
+            setState(StepperMotorState::IDLE);
+            _waking = false;
+            if (hasIdlePower() && _coilPower == CoilPower::ON && !_powerDownPending)
+            {
+                _powerDownPending = true;
+                _idleSinceMs = millis();
+            }
+        }
+
+        void AccelStepperMotor::endMove()
+        {
+            beginIdle();
+            _motionListeners.notify(*this, MotionEvent::MOVE_COMPLETE);
+        }
+
+        bool AccelStepperMotor::addMotionListener(stepper::api::IMotionListener &listener)
+        {
+            return _motionListeners.add(listener);
+        }
+
+        void AccelStepperMotor::removeMotionListener(stepper::api::IMotionListener &listener)
+        {
+            _motionListeners.remove(listener);
+        }
+
+        void AccelStepperMotor::wakeCoils()
+        {
+            // without idle power management the coils were enabled with the command
+            if (!hasIdlePower())
+            {
+                return;
+            }
+
+            _powerDownPending = false;
+            if (_coilPower == CoilPower::ON)
+            {
+                return;
+            }
+            setCoilPower(CoilPower::ON);
+            _wakeCount++;
+            if (_powerConfig.wakeLeadMicros > 0)
+            {
+                _waking = true;
+                _wakeStartMicros = micros();
+            }
+        }
+
+        bool AccelStepperMotor::isWaking()
+        {
+            if (_waking && micros() - _wakeStartMicros >= _powerConfig.wakeLeadMicros)
+            {
+                _waking = false;
+            }
+            return _waking;
+        }
+
+        bool AccelStepperMotor::isStepDue() const
+        {
+            return static_cast<long>(micros() - _nextStepDueMicros) >= 0;
+        }
+
+        void AccelStepperMotor::resetStepDue()
+        {
+            // a command may bring the next step forward, ask the controller again
+            _nextStepDueMicros = micros();
+        }
+
+        bool AccelStepperMotor::isUpdateDue() const
+        {
+            return _currentState != StepperMotorState::MOVING || isStepDue();
         }
 
         long AccelStepperMotor::degreesToSteps(double degrees) const
@@ -55,23 +289,31 @@ namespace stepper
             return (static_cast<double>(steps) / _fullStepsPerRevolution) * 360.0;
         }
 
-        bool AccelStepperMotor::home()
+        Status AccelStepperMotor::home()
         {
-            if (_currentState == StepperMotorState::MOVING ||
-                _currentState == StepperMotorState::HOMING_IN_PROGRESS)
+            if (_currentState == StepperMotorState::MOVING)
+            {
+                return StepperError::BUSY;
+            }
+            if (_currentState == StepperMotorState::HOMING_IN_PROGRESS)
             {
-                return false;
+                return StepperError::HOMING_IN_PROGRESS;
             }
 
             _homingStrategy.resetStrategy();
             if (!_homingStrategy.beginHoming())
             {
-                _currentState = StepperMotorState::HOMING_FAILED;
-                return false;
+                setState(StepperMotorState::HOMING_FAILED);
+                _motionListeners.notify(*this, MotionEvent::HOMING_FAILED);
+                return StepperError::HOMING_REJECTED;
             }
 
-            _currentState = StepperMotorState::HOMING_IN_PROGRESS;
+            setState(StepperMotorState::HOMING_IN_PROGRESS);
             _isHomed = false;
+            if (hasIdlePower())
+            {
+                wakeCoils();
+            }
 
             // For instant strategies, check status immediately
             // e.g. NotHomingStrategy
@@ -80,10 +322,11 @@ namespace stepper
             {
                 _stepperController.setCurrentPosition(0);
                 _isHomed = true;
-                _currentState = StepperMotorState::IDLE;
+                beginIdle();
+                _motionListeners.notify(*this, MotionEvent::HOMING_SUCCEEDED);
             }
 
-            return true;
+            return Status::ok();
         }
 
         StepperMotorState AccelStepperMotor::getState() const 
@@ -106,65 +349,119 @@ namespace stepper
             return !_isHomed;
         }
 
-        bool AccelStepperMotor::moveToAbsolute(double degreesAbsolute)
+        Status AccelStepperMotor::moveToAbsolute(double degreesAbsolute)
         {
-            if (needsHoming())
-            {
-                return false;
-            }
+            return moveToStep(degreesToSteps(degreesAbsolute));
+        }
+
+        long AccelStepperMotor::getStepsPerRevolution() const
+        {
+            return _fullStepsPerRevolution;
+        }
 
-            if (_currentState != StepperMotorState::IDLE)
+        Status AccelStepperMotor::moveToStep(long stepsAbsolute)
+        {
+            StepperError error = commandError(true);
+            if (error != StepperError::NONE)
             {
-                return false;
+                return error;
             }
+            _velocityMode = false;
 
-            if (_enablePin != INVALID_PIN)
+            if (!hasIdlePower() && _enablePin != INVALID_PIN)
             {
                 enable();
             }
 
-            _stepperController.setMaxSpeed(degreesToSteps(_currentSetSpeedDps));
-            _stepperController.setAcceleration(degreesToSteps(_currentSetAccelerationDps2));
-            _stepperController.moveTo(degreesToSteps(degreesAbsolute));
+            // the homing strategy may have changed them
+            _stepperController.setMaxSpeed(_maxSpeedSteps);
+            _stepperController.setAcceleration(_accelerationSteps);
+            _stepperController.moveTo(stepsAbsolute);
+            resetStepDue();
 
             if (_stepperController.distanceToGo() != 0)
             {
-                _currentState = StepperMotorState::MOVING;
+                // a motor with idle power management wakes up only for a real move
+                wakeCoils();
+                setState(StepperMotorState::MOVING);
             }
             else
             {
-                _currentState = StepperMotorState::IDLE;
+                endMove();
             }
 
-            return true;
+            return Status::ok();
         }
 
-        bool AccelStepperMotor::rotateRelative(double degreesRelative)
+        Status AccelStepperMotor::rotateRelative(double degreesRelative)
         {
-            if (_currentState != StepperMotorState::IDLE)
+            // relative to wherever the motor is, it needs no home position
+            StepperError error = commandError(false);
+            if (error != StepperError::NONE)
             {
-                return false;
+                return error;
             }
+            _velocityMode = false;
 
-            if (_enablePin != INVALID_PIN)
+            if (!hasIdlePower() && _enablePin != INVALID_PIN)
             {
                 enable();
             }
 
-            _stepperController.setMaxSpeed(degreesToSteps(_currentSetSpeedDps));
-            _stepperController.setAcceleration(degreesToSteps(_currentSetAccelerationDps2));
+            _stepperController.setMaxSpeed(_maxSpeedSteps);
+            _stepperController.setAcceleration(_accelerationSteps);
             _stepperController.move(degreesToSteps(degreesRelative));
+            resetStepDue();
 
             if (_stepperController.distanceToGo() != 0)
             {
-                _currentState = StepperMotorState::MOVING;
+                // a motor with idle power management wakes up only for a real move
+                wakeCoils();
+                setState(StepperMotorState::MOVING);
             }
             else
             {
-                _currentState = StepperMotorState::IDLE;
+                endMove();
+            }
+
+            return Status::ok();
+        }
+
+        Status AccelStepperMotor::runAtVelocity(double degreesPerSecond)
+        {
+            StepperError error = commandError(true);
+            if (error != StepperError::NONE)
+            {
+                return error;
+            }
+
+            if (!_velocityMode && !hasIdlePower() && _enablePin != INVALID_PIN)
+            {
+                enable();
+            }
+            if (!_velocityMode)
+            {
+                wakeCoils();
             }
 
-            return true;
+            // not truncated to whole steps, a slow hand runs at a fraction of a step per loop
+            double stepsPerSecond = (degreesPerSecond / 360.0) * _fullStepsPerRevolution;
+            // the controller limits the speed to the max speed
+            float maxSpeed = fabs(stepsPerSecond) > _maxSpeedSteps
+                                 ? static_cast<float>(fabs(stepsPerSecond))
+                                 : static_cast<float>(_maxSpeedSteps);
+            _stepperController.setMaxSpeed(maxSpeed);
+            _stepperController.setSpeed(static_cast<float>(stepsPerSecond));
+            resetStepDue();
+
+            _velocityMode = true;
+            setState(StepperMotorState::MOVING);
+            return Status::ok();
+        }
+
+        bool AccelStepperMotor::isRunningAtVelocity() const
+        {
+            return _velocityMode;
         }
 
         void AccelStepperMotor::setSpeed(double degreesPerSecond)
@@ -179,7 +476,9 @@ namespace stepper
                 _logger.info("Set speed to %f", degreesPerSecond);
             }
 
-            _stepperController.setMaxSpeed(degreesToSteps(_currentSetSpeedDps));
+            _maxSpeedSteps = degreesToSteps(_currentSetSpeedDps);
+            _stepperController.setMaxSpeed(_maxSpeedSteps);
+            resetStepDue();
         }
 
         void AccelStepperMotor::setAcceleration(double degreesPerSecondSquared)
@@ -192,31 +491,36 @@ namespace stepper
             {
                 _currentSetAccelerationDps2 = degreesPerSecondSquared;
             }
-            _stepperController.setAcceleration(degreesToSteps(_currentSetAccelerationDps2));
+            _accelerationSteps = degreesToSteps(_currentSetAccelerationDps2);
+            _stepperController.setAcceleration(_accelerationSteps);
+            resetStepDue();
         }
 
-        double AccelStepperMotor::getCurrentPositionDegrees() const
+        Result<double> AccelStepperMotor::getCurrentPositionDegrees() const
         {
             if (!_isHomed)
             {
-                throw std::runtime_error("Motor not homed, position unknown.");
+                return StepperError::NOT_HOMED;
             }
             return stepsToDegrees(_stepperController.getCurrentPosition());
         }
 
         void AccelStepperMotor::enable()
         {
-            if (_enablePin != INVALID_PIN)
+            _powerDownPending = false;
+            if (_enablePin != INVALID_PIN || _enablePwm != nullptr)
             {
-                _stepperController.enableOutputs();
+                setCoilPower(CoilPower::ON);
             }
         }
 
         void AccelStepperMotor::disable()
         {
-            if (_enablePin != INVALID_PIN)
+            _powerDownPending = false;
+            _waking = false;
+            if (_enablePin != INVALID_PIN || _enablePwm != nullptr)
             {
-                _stepperController.disableOutputs();
+                setCoilPower(CoilPower::OFF);
             }
         }
 
@@ -226,13 +530,36 @@ namespace stepper
         void AccelStepperMotor::update()
         {
             if (_currentState == StepperMotorState::IDLE)
+            {
+                if (_powerDownPending && millis() - _idleSinceMs >= _powerConfig.idleTimeoutMs)
+                {
+                    _powerDownPending = false;
+                    setCoilPower(_powerConfig.idlePower == IdlePower::REDUCED ? CoilPower::HOLD : CoilPower::OFF);
+                }
+                return;
+            }
+
+            // the current rises after a wake up, no step before it holds the rotor
+            if (isWaking())
             {
                 return;
             }
 
-            if (_currentState == StepperMotorState::MOVING)
+            // most loops come between two steps, the controller would do nothing
+            if (_currentState == StepperMotorState::MOVING && !isStepDue())
+            {
+                return;
+            }
+
+            if (_currentState == StepperMotorState::MOVING && _velocityMode)
+            {
+                _stepperController.runSpeed();
+                _nextStepDueMicros = _stepperController.nextStepDueMicros();
+            }
+            else if (_currentState == StepperMotorState::MOVING)
             {
                 _stepperController.run();
+                _nextStepDueMicros = _stepperController.nextStepDueMicros();
 
                 // Check if the motor has reached its target destination.
                 if (_stepperController.distanceToGo() == 0)
@@ -244,7 +571,7 @@ namespace stepper
                     // This helps ensure that AccelStepper itself acknowledges completion.
                     if (!_stepperController.run())
                     {
-                        _currentState = StepperMotorState::IDLE;
+                        endMove();
                         // You can add a log here for debugging:
                         // Serial.println("Adapter: Move complete. State -> IDLE.");
                     }
@@ -265,20 +592,22 @@ namespace stepper
                 {
                     _stepperController.setCurrentPosition(0);
                     _isHomed = true;
-                    _currentState = StepperMotorState::IDLE;
+                    beginIdle();
 
                     // Restore operational parameters on the controller
                     _logger.info(
                         "AccelStepperMotor: Homing succeeded, setting speed and acceleration to %f and %f", 
                         _currentSetSpeedDps, 
                         _currentSetAccelerationDps2);
-                    _stepperController.setMaxSpeed(degreesToSteps(_currentSetSpeedDps));
-                    _stepperController.setAcceleration(degreesToSteps(_currentSetAccelerationDps2));
+                    _stepperController.setMaxSpeed(_maxSpeedSteps);
+                    _stepperController.setAcceleration(_accelerationSteps);
+                    _motionListeners.notify(*this, MotionEvent::HOMING_SUCCEEDED);
                 }
                 else if (homingStatus != stepper::api::HomingResult::IN_PROGRESS)
                 {
-                    _currentState = StepperMotorState::HOMING_FAILED;
+                    setState(StepperMotorState::HOMING_FAILED);
                     _stepperController.stop();
+                    _motionListeners.notify(*this, MotionEvent::HOMING_FAILED);
                 }
             }
         }
@@ -295,21 +624,30 @@ namespace stepper
                 return; // Already idle and at target, nothing to stop
             }
 
+            // leaves the velocity mode, stop() decelerates from the current speed
+            _velocityMode = false;
+
             _stepperController.stop(); // Tell AccelStepper to decelerate to the current position.
                                        // This sets a new target (current position) and AccelStepper
                                        // will decelerate when run() is called.
+            resetStepDue();
 
             // If it was moving or had a non-zero distance to go, it's now effectively in a MOVING state
             // (decelerating to the stop point). If it was already idle but not at its target
             // (e.g., stop() called twice), this ensures it tries to go to that stopped target.
             if (_stepperController.distanceToGo() != 0)
             {
-                _currentState = StepperMotorState::MOVING;
+                setState(StepperMotorState::MOVING);
+            }
+            else if (_currentState == StepperMotorState::MOVING)
+            {
+                // a velocity run stopped between two steps, it ends here
+                endMove();
             }
             else
             {
                 // If stop() was called but distanceToGo was already 0 (e.g. already stopped at target)
-                _currentState = StepperMotorState::IDLE;
+                beginIdle();
             }
         }
     }
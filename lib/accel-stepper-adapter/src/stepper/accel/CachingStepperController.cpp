@@ -0,0 +1,157 @@
+#include <stepper/accel/CachingStepperController.h>
+
+namespace stepper
+{
+    namespace accel
+    {
+        CachingStepperController::CachingStepperController(stepper::api::IStepperController &stepperController)
+            : _stepperController(stepperController),
+              _maxSpeedKnown(false),
+              _maxSpeed(0.0f),
+              _accelerationKnown(false),
+              _acceleration(0.0f),
+              _outputs(Outputs::UNKNOWN),
+              _forwardedCount(0),
+              _skippedCount(0)
+        {
+        }
+
+        bool CachingStepperController::forward(bool changes)
+        {
+            if (changes)
+            {
+                _forwardedCount++;
+            }
+            else
+            {
+                _skippedCount++;
+            }
+            return changes;
+        }
+
+        void CachingStepperController::invalidate()
+        {
+            _maxSpeedKnown = false;
+            _accelerationKnown = false;
+            _outputs = Outputs::UNKNOWN;
+        }
+
+        unsigned long CachingStepperController::getForwardedCount() const
+        {
+            return _forwardedCount;
+        }
+
+        unsigned long CachingStepperController::getSkippedCount() const
+        {
+            return _skippedCount;
+        }
+
+        void CachingStepperController::setEnablePin(uint8_t enablePin)
+        {
+            // AccelStepper drives a new enable pin to enabled
+            _outputs = Outputs::UNKNOWN;
+            _stepperController.setEnablePin(enablePin);
+        }
+
+        void CachingStepperController::setPinsInverted(bool dirInvert, bool stepInvert, bool enableInvert)
+        {
+            // the level of the enable pin now means the other state
+            _outputs = Outputs::UNKNOWN;
+            _stepperController.setPinsInverted(dirInvert, stepInvert, enableInvert);
+        }
+
+        void CachingStepperController::enableOutputs()
+        {
+            if (forward(_outputs != Outputs::ENABLED))
+            {
+                _outputs = Outputs::ENABLED;
+                _stepperController.enableOutputs();
+            }
+        }
+
+        void CachingStepperController::disableOutputs()
+        {
+            if (forward(_outputs != Outputs::DISABLED))
+            {
+                _outputs = Outputs::DISABLED;
+                _stepperController.disableOutputs();
+            }
+        }
+
+        void CachingStepperController::setMaxSpeed(float speed)
+        {
+            if (forward(!_maxSpeedKnown || speed != _maxSpeed))
+            {
+                _maxSpeedKnown = true;
+                _maxSpeed = speed;
+                _stepperController.setMaxSpeed(speed);
+            }
+        }
+
+        void CachingStepperController::setAcceleration(float acceleration)
+        {
+            if (forward(!_accelerationKnown || acceleration != _acceleration))
+            {
+                _accelerationKnown = true;
+                _acceleration = acceleration;
+                _stepperController.setAcceleration(acceleration);
+            }
+        }
+
+        void CachingStepperController::moveTo(long absoluteSteps)
+        {
+            _stepperController.moveTo(absoluteSteps);
+        }
+
+        void CachingStepperController::move(long relativeSteps)
+        {
+            _stepperController.move(relativeSteps);
+        }
+
+        long CachingStepperController::getCurrentPosition()
+        {
+            return _stepperController.getCurrentPosition();
+        }
+
+        void CachingStepperController::setCurrentPosition(long absoluteSteps)
+        {
+            _stepperController.setCurrentPosition(absoluteSteps);
+        }
+
+        long CachingStepperController::distanceToGo()
+        {
+            return _stepperController.distanceToGo();
+        }
+
+        bool CachingStepperController::run()
+        {
+            return _stepperController.run();
+        }
+
+        void CachingStepperController::stop()
+        {
+            _stepperController.stop();
+        }
+
+        unsigned long CachingStepperController::nextStepDueMicros()
+        {
+            return _stepperController.nextStepDueMicros();
+        }
+
+        void CachingStepperController::setSpeed(float speed)
+        {
+            // not cached, run() changes the speed of the controller with every step
+            _stepperController.setSpeed(speed);
+        }
+
+        float CachingStepperController::getSpeed()
+        {
+            return _stepperController.getSpeed();
+        }
+
+        bool CachingStepperController::runSpeed()
+        {
+            return _stepperController.runSpeed();
+        }
+    }
+}
@@ -1,5 +1,6 @@
 #include <stepper/homing/LimitSwitchHomingStrategy.h>
 #include <cmath>
+#include <soc/trace/TraceRecorder.h>
 
 namespace stepper
 {
@@ -17,6 +18,8 @@ namespace stepper
               _currentPhase(HomingPhase::NOT_STARTED),
               _currentHomingResult(stepper::api::HomingResult::NOT_YET_STARTED)
         {
+            SOC_TRACE_TRACK(this, "LimitSwitchHoming");
+
             if (_config.maxHomingTravelSteps <= 0)
             {
                 // Or throw an exception, or handle this error appropriately
@@ -25,9 +28,24 @@ namespace stepper
             }
         }
 
+        static const char *phaseName(int phase)
+        {
+            static const char *const NAMES[] = {"NOT_STARTED", "MOVING_TOWARDS_SWITCH", "DECELERATING_ON_SWITCH", "TIMED_OUT"};
+            return NAMES[phase];
+        }
+
+        void LimitSwitchHomingStrategy::setPhase(HomingPhase phase)
+        {
+            if (phase != _currentPhase)
+            {
+                SOC_TRACE_STATE(this, phaseName(static_cast<int>(phase)));
+            }
+            _currentPhase = phase;
+        }
+
         void LimitSwitchHomingStrategy::resetStrategy()
         {
-            _currentPhase = HomingPhase::NOT_STARTED;
+            setPhase(HomingPhase::NOT_STARTED);
             _currentHomingResult = stepper::api::HomingResult::NOT_YET_STARTED;
         }
 
@@ -45,7 +63,7 @@ namespace stepper
 
             if (_stepperController.distanceToGo() != 0)
             {
-                _currentPhase = HomingPhase::MOVING_TOWARDS_SWITCH;
+                setPhase(HomingPhase::MOVING_TOWARDS_SWITCH);
                 _currentHomingResult = stepper::api::HomingResult::IN_PROGRESS;
                 return true;
             }
@@ -56,7 +74,7 @@ namespace stepper
                 if (_limitSwitch.isActive())
                 {
                     _stepperController.setCurrentPosition(0);
-                    _currentPhase = HomingPhase::DECELERATING_ON_SWITCH;
+                    setPhase(HomingPhase::DECELERATING_ON_SWITCH);
                     _currentHomingResult = stepper::api::HomingResult::SUCCESS;
                     return true;
                 }
@@ -81,12 +99,12 @@ namespace stepper
                 {
                     _logger.info("Limit switch is active");
                     _stepperController.stop();
-                    _currentPhase = HomingPhase::DECELERATING_ON_SWITCH;
+                    setPhase(HomingPhase::DECELERATING_ON_SWITCH);
                     _currentHomingResult = stepper::api::HomingResult::IN_PROGRESS;
                 }
                 else if (_stepperController.distanceToGo() == 0)
                 {
-                    _currentPhase = HomingPhase::TIMED_OUT;
+                    setPhase(HomingPhase::TIMED_OUT);
                     _currentHomingResult = stepper::api::HomingResult::FAILURE_TIMEOUT;
                 }
                 break;
@@ -127,7 +145,7 @@ namespace stepper
                 // but cancelHoming is usually for immediate effect. The AccelStepperMotor's
                 // state machine should handle further calls to run if it transitions to MOVING.
             }
-            _currentPhase = HomingPhase::NOT_STARTED;
+            setPhase(HomingPhase::NOT_STARTED);
             _currentHomingResult = stepper::api::HomingResult::CANCELLED;
         }
     } // namespace homing
@@ -1,6 +1,11 @@
 #pragma once
+#include <cstdint>
 #include <map>
 #include <MockSerial.h>
+#include <FakePins.h>
+#include <VirtualClock.h>
+#include <FakeGpioRegisters.h>
+#include <FakeLedc.h>
 
 
 // Arduino pin‐state macros (you already had these)
@@ -13,17 +18,16 @@
 #define INPUT_PULLUP 0x2
 #define INPUT_PULLDOWN 0x8
 
-// your fakePinValues() & pin functions…
-inline std::map<int,int>& fakePinValues() {
-    static std::map<int,int> _m;
-    return _m;
+// time is virtual, see VirtualClock.h
+inline unsigned long millis() {
+    return static_cast<unsigned long>(virtualClock().read() / 1000ULL);
 }
 
-inline unsigned long millis() {
-    return 0; // Just return a constant value
+inline unsigned long micros() {
+    return static_cast<unsigned long>(virtualClock().read());
 }
 
-inline void pinMode(int pin, int mode) {
+inline void pinMode(int /*pin*/, int /*mode*/) {
     // no-op or record mode if you like:
     // fakePinModes()[pin] = mode;
 }
@@ -39,6 +43,11 @@ inline int digitalRead(int pin) {
     return LOW;
 }
 
-inline void delay(uint32_t /*ms*/) {
-    // no-op in tests (or record ms if you want to assert on timing)
+inline void delay(uint32_t ms) {
+    // does not block, just moves the virtual clock forward
+    virtualClock().advanceMillis(ms);
+}
+
+inline void delayMicroseconds(uint32_t us) {
+    virtualClock().advanceMicros(us);
 }
@@ -0,0 +1,92 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include <FakePins.h>
+#include <VirtualClock.h>
+
+/**
+ * @brief Register-level stand-in for the ESP32 GPIO matrix, GPIO 0-39 as one 64 bit mask.
+ *
+ * Writes follow the W1TS/W1TC semantics of the chip: a set bit sets or clears its pin,
+ * a zero bit leaves it alone. The pins themselves live in fakePinValues(), so code using
+ * the registers and code using digitalWrite()/digitalRead() see the same levels. Every
+ * register access is counted and, unless logWrites is off (benchmarks), every write is
+ * logged with its virtual time.
+ */
+class FakeGpioRegisters
+{
+public:
+    struct Write
+    {
+        bool set;             // W1TS, otherwise W1TC
+        uint64_t mask;
+        uint64_t timeMicros;
+    };
+
+    void reset()
+    {
+        writes.clear();
+        logWrites = true;
+        setWrites = 0;
+        clearWrites = 0;
+        inputReads = 0;
+    }
+
+    void writeSet(uint64_t mask)
+    {
+        setWrites++;
+        if (logWrites)
+        {
+            writes.push_back({true, mask, virtualClock().nowMicros()});
+        }
+        apply(mask, 1);
+    }
+
+    void writeClear(uint64_t mask)
+    {
+        clearWrites++;
+        if (logWrites)
+        {
+            writes.push_back({false, mask, virtualClock().nowMicros()});
+        }
+        apply(mask, 0);
+    }
+
+    // GPIO_IN_REG and GPIO_IN1_REG
+    uint64_t readInputs()
+    {
+        inputReads++;
+        uint64_t levels = 0;
+        for (const auto &pin : fakePinValues())
+        {
+            if (pin.first >= 0 && pin.first < 64 && pin.second)
+            {
+                levels |= 1ULL << pin.first;
+            }
+        }
+        return levels;
+    }
+
+    std::vector<Write> writes;
+    bool logWrites = true;
+    unsigned long setWrites = 0;
+    unsigned long clearWrites = 0;
+    unsigned long inputReads = 0;
+
+private:
+    static void apply(uint64_t mask, int value)
+    {
+        while (mask != 0)
+        {
+            fakePinValues()[__builtin_ctzll(mask)] = value;
+            mask &= mask - 1;
+        }
+    }
+};
+
+inline FakeGpioRegisters &fakeGpioRegisters()
+{
+    static FakeGpioRegisters _registers;
+    return _registers;
+}
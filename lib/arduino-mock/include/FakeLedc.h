@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+#include <map>
+
+// The LEDC PWM generator of the ESP32: the channels with their setup and duty.
+struct FakeLedcChannel
+{
+    double frequencyHz = 0.0;
+    uint8_t resolutionBits = 0;
+    uint32_t duty = 0;
+    int pin = -1;
+};
+
+inline std::map<uint8_t, FakeLedcChannel> &fakeLedcChannels()
+{
+    static std::map<uint8_t, FakeLedcChannel> _channels;
+    return _channels;
+}
+
+inline double ledcSetup(uint8_t channel, double frequencyHz, uint8_t resolutionBits)
+{
+    FakeLedcChannel &ledc = fakeLedcChannels()[channel];
+    ledc.frequencyHz = frequencyHz;
+    ledc.resolutionBits = resolutionBits;
+    return frequencyHz;
+}
+
+inline void ledcAttachPin(uint8_t pin, uint8_t channel)
+{
+    fakeLedcChannels()[channel].pin = pin;
+}
+
+inline void ledcWrite(uint8_t channel, uint32_t duty)
+{
+    fakeLedcChannels()[channel].duty = duty;
+}
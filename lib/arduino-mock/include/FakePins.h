@@ -0,0 +1,8 @@
+#pragma once
+#include <map>
+
+// your fakePinValues() & pin functions…
+inline std::map<int,int>& fakePinValues() {
+    static std::map<int,int> _m;
+    return _m;
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstring>
 #include <iostream> // For printing to console in the mock
 
 class MockSerial
@@ -0,0 +1,101 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Stand-in for the NVS partition: namespaces of keys with byte values. It outlives
+ * every Preferences object, so a test reboots by creating a new one. Counts the writes.
+ */
+class FakeFlash
+{
+public:
+    void reset()
+    {
+        namespaces.clear();
+        writes = 0;
+    }
+
+    std::map<std::string, std::map<std::string, std::vector<uint8_t>>> namespaces;
+    unsigned long writes = 0;
+};
+
+inline FakeFlash &fakeFlash()
+{
+    static FakeFlash _flash;
+    return _flash;
+}
+
+// the byte functions of the Preferences library of the ESP32 core
+class Preferences
+{
+public:
+    bool begin(const char *name, bool readOnly = false, const char * /*partitionLabel*/ = nullptr)
+    {
+        // NVS limits namespace and key names to 15 characters
+        if (name == nullptr || strlen(name) > 15)
+        {
+            return false;
+        }
+        _name = name;
+        _readOnly = readOnly;
+        _open = true;
+        return true;
+    }
+    void end() { _open = false; }
+
+    size_t putBytes(const char *key, const void *value, size_t length)
+    {
+        if (!_open || _readOnly || key == nullptr || strlen(key) > 15)
+        {
+            return 0;
+        }
+        const uint8_t *bytes = static_cast<const uint8_t *>(value);
+        fakeFlash().namespaces[_name][key].assign(bytes, bytes + length);
+        fakeFlash().writes++;
+        return length;
+    }
+    size_t getBytesLength(const char *key)
+    {
+        const std::vector<uint8_t> *entry = find(key);
+        return entry ? entry->size() : 0;
+    }
+    size_t getBytes(const char *key, void *buffer, size_t maxLength)
+    {
+        const std::vector<uint8_t> *entry = find(key);
+        if (entry == nullptr || entry->size() > maxLength)
+        {
+            return 0;
+        }
+        memcpy(buffer, entry->data(), entry->size());
+        return entry->size();
+    }
+    bool isKey(const char *key) { return find(key) != nullptr; }
+    bool remove(const char *key)
+    {
+        return _open && !_readOnly && fakeFlash().namespaces[_name].erase(key) > 0;
+    }
+
+private:
+    std::string _name;
+    bool _readOnly = false;
+    bool _open = false;
+
+    const std::vector<uint8_t> *find(const char *key) const
+    {
+        if (!_open)
+        {
+            return nullptr;
+        }
+        auto space = fakeFlash().namespaces.find(_name);
+        if (space == fakeFlash().namespaces.end())
+        {
+            return nullptr;
+        }
+        auto entry = space->second.find(key);
+        return entry == space->second.end() ? nullptr : &entry->second;
+    }
+};
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#define MSBFIRST 1
+#define LSBFIRST 0
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x01
+#define SPI_MODE2 0x02
+#define SPI_MODE3 0x03
+
+class SPISettings
+{
+public:
+    SPISettings(uint32_t clock = 1000000, uint8_t bitOrder = MSBFIRST, uint8_t dataMode = SPI_MODE0)
+        : clock(clock), bitOrder(bitOrder), dataMode(dataMode) {}
+
+    uint32_t clock;
+    uint8_t bitOrder;
+    uint8_t dataMode;
+};
+
+// records what is written, the bus itself takes no virtual time
+class SPIClass
+{
+public:
+    void begin() { begun = true; }
+    void end() { begun = false; }
+    void beginTransaction(SPISettings settings)
+    {
+        this->settings = settings;
+        transactions++;
+    }
+    void endTransaction() {}
+
+    uint8_t transfer(uint8_t data)
+    {
+        written.push_back(data);
+        return 0;
+    }
+    void writeBytes(const uint8_t *data, uint32_t size)
+    {
+        written.insert(written.end(), data, data + size);
+    }
+
+    bool begun = false;
+    SPISettings settings;
+    unsigned long transactions = 0;
+    std::vector<uint8_t> written;
+};
+
+inline SPIClass SPI;
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+#include <FakePins.h>
+
+/**
+ * @brief Controllable virtual time base backing millis(), micros() and delay()
+ * of the arduino mock.
+ *
+ * Time only moves when it is told to:
+ * - manually, via advanceMicros()/advanceMillis()/advanceTo(),
+ * - by delay()/delayMicroseconds(), which advance the clock instead of blocking,
+ * - optionally on every millis()/micros() read (auto-advance), which models the
+ *   CPU time a loop iteration costs on real hardware.
+ *
+ * Pin changes can be scheduled at absolute virtual times. They are applied to
+ * fakePinValues() in chronological order while the clock passes them, so code
+ * polling digitalRead() sees them exactly when it would on the target.
+ *
+ * Unlike the ESP32, the values are not truncated to 32 bit. Native code is compiled
+ * with a 64 bit unsigned long, so a truncated counter would break the usual
+ * "now - last >= interval" wrap-around arithmetic instead of exercising it.
+ */
+class VirtualClock
+{
+public:
+    /**
+     * @brief Resets time to zero, disables auto-advance and drops all scheduled events.
+     */
+    void reset()
+    {
+        _nowMicros = 0;
+        _autoAdvanceMicros = 0;
+        _pinEvents.clear();
+    }
+
+    /**
+     * @brief Current virtual time in microseconds, without auto-advancing.
+     */
+    uint64_t nowMicros() const
+    {
+        return _nowMicros;
+    }
+
+    /**
+     * @brief Reads the clock the way millis()/micros() do: applies auto-advance first.
+     * @return The current virtual time in microseconds.
+     */
+    uint64_t read()
+    {
+        if (_autoAdvanceMicros > 0)
+        {
+            advanceMicros(_autoAdvanceMicros);
+        }
+        return _nowMicros;
+    }
+
+    /**
+     * @brief Sets how many microseconds every millis()/micros() read advances the clock.
+     * @param micros 0 disables auto-advance (the default).
+     */
+    void setAutoAdvanceMicros(uint32_t micros)
+    {
+        _autoAdvanceMicros = micros;
+    }
+
+    uint32_t getAutoAdvanceMicros() const
+    {
+        return _autoAdvanceMicros;
+    }
+
+    void advanceMicros(uint64_t micros)
+    {
+        advanceTo(_nowMicros + micros);
+    }
+
+    void advanceMillis(uint64_t millis)
+    {
+        advanceTo(_nowMicros + millis * 1000ULL);
+    }
+
+    /**
+     * @brief Moves the clock forward to an absolute time, applying every pin change
+     * scheduled up to and including that time. Moving backwards is ignored.
+     */
+    void advanceTo(uint64_t absoluteMicros)
+    {
+        if (absoluteMicros < _nowMicros)
+        {
+            return;
+        }
+
+        while (!_pinEvents.empty() && _pinEvents.begin()->first <= absoluteMicros)
+        {
+            auto event = _pinEvents.begin();
+            _nowMicros = event->first;
+            fakePinValues()[event->second.pin] = event->second.value;
+            _pinEvents.erase(event);
+        }
+        _nowMicros = absoluteMicros;
+    }
+
+    /**
+     * @brief Schedules a pin change at an absolute virtual time. Events in the past
+     * are applied immediately. Events at the same time are applied in scheduling order.
+     */
+    void schedulePinChange(uint64_t atMicros, int pin, int value)
+    {
+        if (atMicros <= _nowMicros)
+        {
+            fakePinValues()[pin] = value;
+            return;
+        }
+        _pinEvents.emplace(atMicros, PinEvent{pin, value});
+    }
+
+    /**
+     * @brief Schedules a pin change relative to the current virtual time.
+     */
+    void schedulePinChangeIn(uint64_t inMicros, int pin, int value)
+    {
+        schedulePinChange(_nowMicros + inMicros, pin, value);
+    }
+
+    /**
+     * @brief Skips idle time: jumps to the next scheduled pin change, if any.
+     * @return True if an event was pending and has been applied.
+     */
+    bool advanceToNextEvent()
+    {
+        if (_pinEvents.empty())
+        {
+            return false;
+        }
+        advanceTo(_pinEvents.begin()->first);
+        return true;
+    }
+
+    size_t pendingEvents() const
+    {
+        return _pinEvents.size();
+    }
+
+private:
+    struct PinEvent
+    {
+        int pin;
+        int value;
+    };
+
+    uint64_t _nowMicros = 0;
+    uint32_t _autoAdvanceMicros = 0;
+    // multimap keeps insertion order for equal keys
+    std::multimap<uint64_t, PinEvent> _pinEvents;
+};
+
+/**
+ * @brief The process wide virtual clock used by the Arduino time functions.
+ */
+inline VirtualClock &virtualClock()
+{
+    static VirtualClock _clock;
+    return _clock;
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+// records what is written and serves the bytes the test queued, the bus itself takes no virtual time
+class TwoWire
+{
+public:
+    struct Transmission
+    {
+        uint16_t address;
+        std::vector<uint8_t> data;
+        bool sendStop;
+    };
+
+    bool begin(int sdaPin = -1, int sclPin = -1, uint32_t frequency = 0)
+    {
+        begun = true;
+        this->sdaPin = sdaPin;
+        this->sclPin = sclPin;
+        this->frequency = frequency;
+        return true;
+    }
+
+    void beginTransmission(uint16_t address)
+    {
+        _address = address;
+        _pending.clear();
+    }
+    size_t write(uint8_t data)
+    {
+        _pending.push_back(data);
+        return 1;
+    }
+    size_t write(const uint8_t *data, size_t size)
+    {
+        _pending.insert(_pending.end(), data, data + size);
+        return size;
+    }
+    // 0 on success, 2 for an address without acknowledge, like the Arduino core
+    uint8_t endTransmission(bool sendStop = true)
+    {
+        transmissions.push_back({_address, _pending, sendStop});
+        return acknowledge ? 0 : 2;
+    }
+
+    size_t requestFrom(uint16_t /*address*/, size_t size, bool /*sendStop*/ = true)
+    {
+        requests++;
+        _received.clear();
+        while (acknowledge && _received.size() < size && !readData.empty())
+        {
+            _received.push_back(readData.front());
+            readData.pop_front();
+        }
+        return _received.size();
+    }
+    int available()
+    {
+        return static_cast<int>(_received.size());
+    }
+    int read()
+    {
+        if (_received.empty())
+        {
+            return -1;
+        }
+        uint8_t data = _received.front();
+        _received.pop_front();
+        return data;
+    }
+
+    bool begun = false;
+    int sdaPin = -1;
+    int sclPin = -1;
+    uint32_t frequency = 0;
+    bool acknowledge = true;
+    std::deque<uint8_t> readData; // served to requestFrom() in order
+    std::vector<Transmission> transmissions;
+    unsigned long requests = 0;
+
+private:
+    uint16_t _address = 0;
+    std::vector<uint8_t> _pending;
+    std::deque<uint8_t> _received;
+};
+
+inline TwoWire Wire;
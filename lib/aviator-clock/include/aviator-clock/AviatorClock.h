@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include <soc/api/ISocComponent.h>
+#include <soc/api/ITime.h>
+#include <soc/api/ILogger.h>
+#include <aviator-clock/ClockHand.h>
+
+namespace aviator_clock
+{
+    /**
+     * @brief The clock: a composite of clock hands that owns the hands and, through
+     * them, their motors.
+     *
+     * The time is read once per loop and the decomposed TimeComponents are shared with
+     * every hand. Only hands that need attention are touched in a loop: hands that are
+     * homing or moving, hands whose motor waits to power down, and hands whose unit just
+     * changed. An idle loop costs the same
+     * for one hand or many.
+     *
+     * At a minute or hour rollover several hands have to move at once. The moves are
+     * queued (second, minute, hour) and started at least moveStaggerMs apart, so the
+     * motors don't accelerate at the same time.
+     *
+     * A hand that names a dependency, see ClockHand::setDependency(), is set up and homed
+     * once its dependency is set up, the other hands do not wait for it. So one hand homes
+     * while the tick profile of another is still tuned.
+     */
+    class AviatorClock : public soc::api::ISocComponent
+    {
+    public:
+        AviatorClock(soc::api::ITime &timeProvider,
+                     soc::api::ILogger &logger,
+                     unsigned long moveStaggerMs);
+
+        virtual ~AviatorClock() = default;
+
+        /**
+         * @brief Transfers the ownership of a hand to the clock. Add all hands before setup().
+         */
+        void addHand(std::unique_ptr<ClockHand> hand);
+
+        size_t getHandCount() const;
+
+        /**
+         * @brief True if no hand is moving, homing or powering down and no move is waiting for its slot.
+         */
+        bool isSettled() const;
+
+        void setup() override;
+        void advanceState(unsigned long currentTimeMs) override;
+        void render() override;
+        void teardown() override;
+
+        /**
+         * @brief True once every hand is set up and finished its homing, the hands home side by side.
+         */
+        bool isSetUp() const override;
+        const char *getName() const override;
+
+    private:
+        struct HandSlot
+        {
+            std::unique_ptr<ClockHand> hand;
+            bool active; // homing, moving or powering down, updated every loop
+            bool queued; // waiting for its move slot
+            bool started; // set up, its dependency was
+        };
+
+        soc::api::ITime &_timeProvider;
+        soc::api::ILogger &_logger;
+        const unsigned long _moveStaggerMs;
+
+        std::vector<HandSlot> _hands;
+        std::vector<size_t> _activeHands;
+        std::deque<size_t> _pendingMoves;
+        // hand indexes by HandType, so a rollover only visits the hands it concerns
+        std::vector<size_t> _handsByType[3];
+
+        soc::api::ITime::TimeComponents _lastTime;
+        bool _hasTime;
+        bool _timeErrorLogged;
+        unsigned long _lastMoveStartMs;
+        bool _moveStarted;
+        size_t _waitingHands; // for their dependencies
+
+        void startReadyHands();
+        void activate(size_t index);
+        void queueMove(size_t index);
+        void queueMovesForType(ClockHand::HandType type);
+        void startPendingMoves(unsigned long currentTimeMs);
+    };
+}
@@ -5,11 +5,17 @@
 #include <soc/api/ISocComponent.h>
 #include <soc/api/ITime.h>
 #include <soc/api/ILogger.h>
+#include <stepper/api/IMotionListener.h>
 #include <stepper/api/IStepperMotor.h>
+#include <aviator-clock/DialMapping.h>
 
 namespace aviator_clock
 {
-    class ClockHand : public soc::api::ISocComponent
+    /**
+     * @brief A hand learns from the motion events of its motor when a move or the homing
+     * has ended, it does not poll the motor for it. The hand is the only one to command its motor.
+     */
+    class ClockHand : public soc::api::ISocComponent, public stepper::api::IMotionListener
     {
     public:
         enum class HandType
@@ -19,6 +25,18 @@ namespace aviator_clock
             SECOND
         };
 
+        /**
+         * @brief TICK jumps from unit to unit with a full accel/decel move.
+         * SWEEP runs the motor at the constant velocity of the hand and corrects the
+         * phase error with small velocity adjustments; at the end of the dial it flies
+         * back with a regular move. In SWEEP mode 12 o'clock is at the start of the dial.
+         */
+        enum class MotionMode
+        {
+            TICK,
+            SWEEP
+        };
+
         /**
          * @brief Construct a new generic Clock Hand.
          *
@@ -44,6 +62,96 @@ namespace aviator_clock
         void render() override;
         void teardown() override;
 
+        /**
+         * @brief True once the homing started by setup() succeeded or failed.
+         */
+        bool isSetUp() const override;
+        const char *getName() const override;
+
+        /**
+         * @return The component set with setDependency(), at index 0.
+         */
+        const ISocComponent *getDependency(size_t index) const override;
+
+        /**
+         * @brief A component the hand waits for before its setup(), e.g. the tuning of its
+         * tick profile, see AviatorClock. Null for none.
+         */
+        void setDependency(const soc::api::ISocComponent *dependency);
+
+        void onMotionEvent(IStepperMotor &motor, stepper::api::MotionEvent event) override;
+
+        /**
+         * @brief Selects ticking or sweeping, call it before setup().
+         */
+        void setMotionMode(MotionMode mode);
+        MotionMode getMotionMode() const;
+
+        /**
+         * @brief Replaces the linear dial by a calibrated, non-linear one. Call it before
+         * setup(), which bakes it into the lookup table. An invalid mapping, or one for
+         * another number of units, is logged and ignored.
+         */
+        void setDialMapping(const DialMapping &mapping);
+
+        /**
+         * @brief Replaces the tick profile of the constructor, call it before setup().
+         */
+        void setTickProfile(double speedDps, double accelerationDps2);
+
+        /**
+         * @brief Profile of catch-up moves. When the time jumps (RTC set, resume from sleep)
+         * more than thresholdUnits ahead, or back, the hand moves straight to the new unit
+         * with this profile and returns to the tick profile afterwards. A sweeping hand
+         * uses it for every repositioning. Defaults to the tick profile and 2 units.
+         */
+        void setCatchUpProfile(double speedDps, double accelerationDps2, int thresholdUnits);
+
+        unsigned long getCatchUpCount() const;
+        unsigned long getLastCatchUpMs() const;
+        unsigned long getMaxCatchUpMs() const;
+        /**
+         * @brief Planned duration of a catch-up across the whole dial, the bound of every catch-up.
+         */
+        unsigned long getCatchUpBoundMs() const;
+
+        // --- Driven by a composite, e.g. AviatorClock ---
+
+        /**
+         * @brief Runs the motor with the already decomposed time, a sweeping hand
+         * follows it, a ticking hand ignores it.
+         * @param currentTimeMs Monotonic time of the loop, e.g. millis(), to time the catch-up moves.
+         * Between two steps of a move the motor is not updated, see IStepperMotor::isUpdateDue().
+         * @return True while the hand is homing, moving or sweeping, or its motor waits to power
+         * down the coils, and needs to be updated every loop.
+         */
+        bool update(const soc::api::ITime::TimeComponents &time, unsigned long currentTimeMs);
+
+        /**
+         * @brief True once the hand is homed and no move is in progress.
+         */
+        bool isReady() const;
+
+        /**
+         * @brief The unit this hand shows for the given time, e.g. the minutes for a MINUTE hand.
+         */
+        int unitFor(const soc::api::ITime::TimeComponents &time) const;
+
+        /**
+         * @brief True if the hand is not yet positioned or shows another unit than the given time.
+         */
+        bool needsMoveTo(const soc::api::ITime::TimeComponents &time) const;
+
+        /**
+         * @brief Starts the move to the given, already decomposed time if the hand is ready
+         * and does not show it yet. The first call after homing initializes the position.
+         * @param currentTimeMs Monotonic time of the loop, see update().
+         * @return True if a move was started.
+         */
+        bool showTime(const soc::api::ITime::TimeComponents &time, unsigned long currentTimeMs);
+
+        HandType getType() const;
+
     private:
         HandType _type;
         soc::api::ITime &_timeProvider;
@@ -52,7 +160,9 @@ namespace aviator_clock
 
         double _totalAngleForDial;      // Total angular span of the hand, less than 360 for analog instruments
         double _dialStartOffsetDegrees; // Offset of "0" from motor's physical 0
-        double _degreesPerUnit;         // Calculated degrees for each unit tick
+        double _degreesPerUnit;         // Calculated degrees for each unit tick, on average for a non-linear dial
+        DialMapping _dialMapping;       // Units to steps, baked at setup, the hour hand shows 0 as 12
+        double _subStepsPerDegree;
 
         int _lastUnitProcessed;
         bool _isPositionInitialized;
@@ -60,7 +170,32 @@ namespace aviator_clock
         double _motorAccelerationDps2;
         bool _homingFailed;
         bool _operationStarted;
+        bool _motorHomed; // from the motion events
+        bool _motorBusy;  // a command was accepted, its event has not come yet
+
+        MotionMode _motionMode;
+        double _unitDurationSeconds;  // time the hand needs for one unit when sweeping
+        double _sweepVelocityDps;     // last velocity commanded in SWEEP mode
+        int _unitsOnDial;
+
+        double _catchUpSpeedDps;
+        double _catchUpAccelerationDps2;
+        int _catchUpThresholdUnits;
+        unsigned long _catchUpBoundMs;
+        bool _catchingUp;
+        unsigned long _catchUpStartMs;
+        unsigned long _catchUpCount;
+        unsigned long _lastCatchUpMs;
+        unsigned long _maxCatchUpMs;
+        unsigned long _nowMs;         // currentTimeMs of the last update() or showTime()
+        const soc::api::ISocComponent *_dependency;
 
         void moveToUnit(int unit);
+        void syncMotorState();
+        bool isTimeJump(int unit) const;
+        void beginCatchUp(int units);
+        void endCatchUp();
+        uint32_t sweepUnitFixed(const soc::api::ITime::TimeComponents &time) const;
+        void sweep(const soc::api::ITime::TimeComponents &time);
     };
 }
\ No newline at end of file
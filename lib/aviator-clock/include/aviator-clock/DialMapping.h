@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace aviator_clock
+{
+    /**
+     * @brief Maps the units of a dial (seconds, minutes, hours) to motor positions, for
+     * gauge faces with a non-uniform scale.
+     *
+     * The face is described by calibration points (unit -> degrees), from unit 0 to the
+     * last unit of the dial. A monotone cubic spline (Fritsch-Carlson) runs through them,
+     * so the hand never moves backwards between two points. bake() samples the spline
+     * into a table of fixed-point motor positions, 1/SUB_STEPS of a step each. At runtime
+     * a position costs a table lookup and an integer interpolation.
+     */
+    class DialMapping
+    {
+    public:
+        struct CalibrationPoint
+        {
+            double unit;    // 0 up to the units on the dial, may be fractional
+            double degrees; // hand position from the motor's physical 0
+        };
+
+        static const int32_t SUB_STEPS = 256;       // fixed-point positions in 1/256 step
+        static const uint32_t UNIT_ONE = 1UL << 16; // fractional units in 16.16 fixed point
+
+        /**
+         * @brief The linear dial ClockHand uses without calibration.
+         */
+        static DialMapping linear(int unitsOnDial, double startDegrees, double totalDegrees);
+
+        /**
+         * @param points Calibration points, strictly increasing in unit, the first at unit 0
+         * and the last at unitsOnDial, the degrees must not decrease.
+         */
+        DialMapping(int unitsOnDial, const std::vector<CalibrationPoint> &points);
+
+        bool isValid() const;
+        int getUnitsOnDial() const;
+
+        /**
+         * @brief Evaluates the spline, for baking and for tests.
+         */
+        double degreesAt(double unit) const;
+
+        /**
+         * @brief Samples the spline into the lookup table, call it once at setup.
+         */
+        void bake(long stepsPerRevolution);
+
+        bool isBaked() const;
+
+        /**
+         * @brief Motor position of a whole unit, rounded to a step.
+         */
+        long stepsForUnit(int unit) const;
+
+        /**
+         * @brief Motor position of a fractional unit (16.16 fixed point), in 1/SUB_STEPS of a step.
+         */
+        int32_t subStepsAt(uint32_t unitFixed) const;
+
+        /**
+         * @brief Slope of the mapping at a fractional unit, in 1/SUB_STEPS of a step per unit.
+         */
+        int32_t subStepsPerUnitAt(uint32_t unitFixed) const;
+
+    private:
+        int _unitsOnDial;
+        std::vector<CalibrationPoint> _points;
+        std::vector<double> _tangents; // degrees per unit at every calibration point
+        bool _valid;
+
+        uint32_t _samplesPerUnit;
+        std::vector<int32_t> _table; // position of every sample in 1/SUB_STEPS of a step
+
+        bool validate() const;
+        void computeTangents();
+        size_t segmentIndex(uint32_t unitFixed, uint32_t &fraction) const;
+    };
+}
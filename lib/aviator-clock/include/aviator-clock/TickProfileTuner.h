@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstdint>
+
+#include <soc/api/IDigitalInput.h>
+#include <soc/api/ILogger.h>
+#include <soc/api/IPersistentStore.h>
+#include <stepper/api/IMotionListener.h>
+#include <stepper/api/IStepperMotor.h>
+
+namespace aviator_clock
+{
+    /**
+     * @brief Finds the fastest tick profile a hand follows without losing steps.
+     *
+     * Every gauge has its own friction and inertia, a fixed profile either loses steps on
+     * one or leaves speed unused on another. The tuner homes the motor, then measures where
+     * the limit switch triggers when approached slowly from probeStartDegrees: the reference.
+     * Level by level it raises speed and acceleration by growthFactor, from start up to
+     * limit. A level ticks ticksPerLevel times away from the switch, makes one long move
+     * over most of the dial, like the fly back of a second hand, returns at the start
+     * profile and probes the switch again. All test moves go the same way, so steps lost on the way out
+     * cannot cancel with steps lost on the way back. A trigger position more than
+     * toleranceSteps off the reference means the level lost steps. The result is the last
+     * level without, reduced by marginFraction, and is saved to the store for the next boots.
+     *
+     * The tuner commands the motor until it is done, run it before the hand takes over its
+     * motor. Call update() every loop, it updates the motor as well.
+     */
+    class TickProfileTuner : public stepper::api::IMotionListener
+    {
+    public:
+        struct Profile
+        {
+            double speedDps;
+            double accelerationDps2;
+        };
+
+        struct Config
+        {
+            Profile start;                // the first level and the return, every hand should follow it
+            Profile limit;                // the levels are not raised beyond
+            double growthFactor;          // from one level to the next
+            double marginFraction;        // the last safe level is reduced by this
+            double tickDegrees;           // the test moves of a level
+            int ticksPerLevel;
+            double longMoveDegrees;       // after the ticks, further away from the switch
+            Profile probe;                // slow, so the switch triggers at the same position every time
+            double probeStartDegrees;     // away from the switch and its homing overshoot, every probe starts here
+            double probeOvershootDegrees; // beyond the switch, a probe that gets here did not find it
+            int switchDirectionSign;      // as moveDirectionSign of the homing
+            long toleranceSteps;          // a probe further off the reference lost steps
+        };
+
+        /**
+         * @brief The record in the store.
+         */
+        struct SavedProfile
+        {
+            uint32_t version;
+            float speedDps;
+            float accelerationDps2;
+        };
+        static const uint32_t SAVED_PROFILE_VERSION = 1;
+
+        enum class State
+        {
+            IDLE,
+            HOMING,
+            MOVING_TO_PROBE_START,
+            PROBING,
+            TICKING,
+            LONG_MOVE,
+            RETURNING,
+            SUCCEEDED,
+            FAILED
+        };
+
+        /**
+         * @brief From 600 deg/s and 15000 deg/s^2 up to 4800 deg/s and 240000 deg/s^2 in steps of
+         * 25 %, ten ticks of a second hand and a move of 240 deg per level, all within the
+         * 330 deg of the dial, 20 % margin.
+         */
+        static Config defaultConfig();
+
+        /**
+         * @brief Reads the profile a tuner saved.
+         * @return False if there is none, profile is unchanged then.
+         */
+        static bool loadProfile(soc::api::IPersistentStore &store, const char *storeKey, Profile &profile);
+
+        /**
+         * @param limitSwitch The switch the homing uses.
+         * @param storeKey Where the result is saved, at most 15 characters, must outlive the tuner.
+         */
+        TickProfileTuner(IStepperMotor &motor,
+                         soc::api::IDigitalInput &limitSwitch,
+                         soc::api::IPersistentStore &store,
+                         const char *storeKey,
+                         soc::api::ILogger &logger,
+                         const Config &config = defaultConfig());
+        virtual ~TickProfileTuner();
+
+        /**
+         * @brief Starts tuning with the homing of the motor.
+         * @return False if the tuner could not listen to the motor or the homing was rejected.
+         */
+        bool begin();
+
+        /**
+         * @brief Updates the motor and watches the switch while probing.
+         * @return True while tuning.
+         */
+        bool update();
+
+        void onMotionEvent(IStepperMotor &motor, stepper::api::MotionEvent event) override;
+
+        State getState() const;
+
+        /**
+         * @brief The tuned profile, with the margin. Only valid once SUCCEEDED.
+         */
+        const Profile &getProfile() const;
+
+        /**
+         * @brief The levels that lost no steps.
+         */
+        int getSafeLevelCount() const;
+
+        /**
+         * @brief Trigger position of the last probe relative to the reference, in steps.
+         */
+        long getLastProbeErrorSteps() const;
+
+    private:
+        IStepperMotor &_motor;
+        soc::api::IDigitalInput &_limitSwitch;
+        soc::api::IPersistentStore &_store;
+        const char *_storeKey;
+        soc::api::ILogger &_logger;
+        const Config _config;
+
+        State _state;
+        bool _listening;
+        long _probeStartSteps;
+        long _probeEndSteps;
+        long _tickSteps;
+        long _longMoveSteps;
+
+        bool _hasReference;
+        long _referenceSteps;
+        bool _triggered;
+        long _triggerSteps;
+        long _lastProbeErrorSteps;
+
+        Profile _level;  // being tested
+        Profile _safe;   // the last level without lost steps
+        int _safeLevels;
+        int _tick;
+        Profile _result;
+
+        long toSteps(double degrees) const;
+        long currentSteps() const;
+        void applyProfile(const Profile &profile);
+        void moveTo(long steps);
+        void startProbe();
+        void evaluateProbe();
+        void startLevel();
+        void finish();
+        void fail(const char *reason);
+    };
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <memory>
+
+#include <soc/api/IDigitalInput.h>
+#include <soc/api/ILogger.h>
+#include <soc/api/IPersistentStore.h>
+#include <soc/api/ISocComponent.h>
+#include <stepper/api/IStepperMotor.h>
+#include <aviator-clock/ClockHand.h>
+#include <aviator-clock/TickProfileTuner.h>
+
+namespace aviator_clock
+{
+    /**
+     * @brief Gives a hand its tick profile as a soc component: the saved one, or one a
+     * TickProfileTuner finds in the loop.
+     *
+     * The hand names it as its dependency, see ClockHand::setDependency(), and takes over
+     * its motor once the component is set up. Tuning runs side by side with the other
+     * components, e.g. another hand that homes. If the tuning fails the hand keeps the
+     * profile it was constructed with.
+     */
+    class TickProfileTuning : public soc::api::ISocComponent
+    {
+    public:
+        /**
+         * @param motor The motor of the hand.
+         * @param storeKey Where the profile is saved, see TickProfileTuner, and the name of the component.
+         * @param retune Tune even if a profile is saved.
+         */
+        TickProfileTuning(ClockHand &hand,
+                          IStepperMotor &motor,
+                          soc::api::IDigitalInput &limitSwitch,
+                          soc::api::IPersistentStore &store,
+                          const char *storeKey,
+                          soc::api::ILogger &logger,
+                          const TickProfileTuner::Config &config,
+                          bool retune);
+        virtual ~TickProfileTuning() override = default;
+
+        /**
+         * @brief Loads the saved profile, or starts tuning.
+         */
+        void setup() override;
+        void advanceState(unsigned long currentTimeMs) override;
+        void render() override;
+        void teardown() override;
+
+        /**
+         * @brief True once the hand has its profile, or the tuning failed.
+         */
+        bool isSetUp() const override;
+        const char *getName() const override;
+
+        /**
+         * @brief True if the profile of the hand was tuned at this boot.
+         */
+        bool isTuned() const;
+
+    private:
+        ClockHand &_hand;
+        IStepperMotor &_motor;
+        soc::api::IDigitalInput &_limitSwitch;
+        soc::api::IPersistentStore &_store;
+        const char *_storeKey;
+        soc::api::ILogger &_logger;
+        const TickProfileTuner::Config _config;
+        const bool _retune;
+
+        std::unique_ptr<TickProfileTuner> _tuner;
+        bool _done;
+        bool _tuned;
+
+        void finish();
+    };
+}
@@ -0,0 +1,281 @@
+#include <aviator-clock/AviatorClock.h>
+#include <soc/trace/TraceRecorder.h>
+
+namespace aviator_clock
+{
+    AviatorClock::AviatorClock(soc::api::ITime &timeProvider,
+                               soc::api::ILogger &logger,
+                               unsigned long moveStaggerMs)
+        : _timeProvider(timeProvider),
+          _logger(logger),
+          _moveStaggerMs(moveStaggerMs),
+          _lastTime{0, 0, 0, 0},
+          _hasTime(false),
+          _timeErrorLogged(false),
+          _lastMoveStartMs(0),
+          _moveStarted(false),
+          _waitingHands(0)
+    {
+        SOC_TRACE_TRACK(this, "AviatorClock");
+    }
+
+    void AviatorClock::addHand(std::unique_ptr<ClockHand> hand)
+    {
+        if (hand == nullptr)
+        {
+            _logger.error("AviatorClock: Null hand provided");
+            return;
+        }
+
+        size_t index = _hands.size();
+        _handsByType[static_cast<int>(hand->getType())].push_back(index);
+        _hands.push_back(HandSlot{std::move(hand), false, false, false});
+    }
+
+    size_t AviatorClock::getHandCount() const
+    {
+        return _hands.size();
+    }
+
+    bool AviatorClock::isSettled() const
+    {
+        return _activeHands.empty() && _pendingMoves.empty();
+    }
+
+    // --- ISocComponent Methods ---
+    void AviatorClock::setup()
+    {
+        _activeHands.clear();
+        _pendingMoves.clear();
+        _hasTime = false;
+        _moveStarted = false;
+
+        for (HandSlot &slot : _hands)
+        {
+            slot.active = false;
+            slot.queued = false;
+            slot.started = false;
+        }
+        _waitingHands = _hands.size();
+        startReadyHands();
+        _logger.info("AviatorClock: %u hands set up, %u wait for their dependencies.",
+                     static_cast<unsigned>(_hands.size() - _waitingHands), static_cast<unsigned>(_waitingHands));
+    }
+
+    bool AviatorClock::isSetUp() const
+    {
+        if (_waitingHands > 0)
+        {
+            return false;
+        }
+        for (const HandSlot &slot : _hands)
+        {
+            if (!slot.hand->isSetUp())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const char *AviatorClock::getName() const
+    {
+        return "AviatorClock";
+    }
+
+    void AviatorClock::advanceState(unsigned long currentTimeMs)
+    {
+        if (_waitingHands > 0)
+        {
+            startReadyHands();
+        }
+
+        // read the time once for all hands
+        soc::api::ITime::TimeComponents time;
+        if (!_timeProvider.asTimeComponents(time))
+        {
+            if (!_timeErrorLogged)
+            {
+                _logger.error("AviatorClock: timeProvider did not return true. So I am doing nothing.");
+                _timeErrorLogged = true;
+            }
+            return;
+        }
+        _timeErrorLogged = false;
+
+        // hands that are homing or moving, swap-remove the ones that are done
+        for (size_t i = 0; i < _activeHands.size();)
+        {
+            size_t index = _activeHands[i];
+            HandSlot &slot = _hands[index];
+            if (slot.hand->update(time, currentTimeMs))
+            {
+                // a hand that waits to power down its motor is ready for the next move
+                if (slot.hand->isReady() && slot.hand->needsMoveTo(time))
+                {
+                    queueMove(index);
+                }
+                i++;
+                continue;
+            }
+
+            slot.active = false;
+            _activeHands[i] = _activeHands.back();
+            _activeHands.pop_back();
+
+            // just homed, or the time moved on while the hand was moving
+            if (slot.hand->isReady() && slot.hand->needsMoveTo(time))
+            {
+                queueMove(index);
+            }
+        }
+
+        // the hands of a unit only need to move when that unit changed
+        if (!_hasTime || time.seconds != _lastTime.seconds)
+        {
+            queueMovesForType(ClockHand::HandType::SECOND);
+        }
+        if (!_hasTime || time.minutes != _lastTime.minutes)
+        {
+            queueMovesForType(ClockHand::HandType::MINUTE);
+        }
+        if (!_hasTime || time.hours != _lastTime.hours)
+        {
+            queueMovesForType(ClockHand::HandType::HOUR);
+        }
+        _lastTime = time;
+        _hasTime = true;
+
+        startPendingMoves(currentTimeMs);
+    }
+
+    void AviatorClock::render()
+    {
+        // idle hands have nothing to output
+        for (size_t index : _activeHands)
+        {
+            _hands[index].hand->render();
+        }
+    }
+
+    void AviatorClock::teardown()
+    {
+        for (HandSlot &slot : _hands)
+        {
+            // the motor of a hand that was never set up is not its own yet
+            if (slot.started)
+            {
+                slot.hand->teardown();
+            }
+            slot.active = false;
+            slot.queued = false;
+        }
+        _activeHands.clear();
+        _pendingMoves.clear();
+    }
+
+    // --- Private Methods ---
+    static bool dependenciesSetUp(const soc::api::ISocComponent &component)
+    {
+        for (size_t i = 0;; i++)
+        {
+            const soc::api::ISocComponent *dependency = component.getDependency(i);
+            if (dependency == nullptr)
+            {
+                return true;
+            }
+            if (!dependency->isSetUp())
+            {
+                return false;
+            }
+        }
+    }
+
+    void AviatorClock::startReadyHands()
+    {
+        for (size_t i = 0; i < _hands.size(); i++)
+        {
+            if (_hands[i].started || !dependenciesSetUp(*_hands[i].hand))
+            {
+                continue;
+            }
+            _hands[i].started = true;
+            _waitingHands--;
+            _hands[i].hand->setup();
+            // the hand starts homing, update it until it is done
+            activate(i);
+        }
+    }
+
+    void AviatorClock::activate(size_t index)
+    {
+        if (!_hands[index].active)
+        {
+            _hands[index].active = true;
+            _activeHands.push_back(index);
+        }
+    }
+
+    void AviatorClock::queueMove(size_t index)
+    {
+        if (_hands[index].queued)
+        {
+            return;
+        }
+        _hands[index].queued = true;
+
+        // the second hands go first, a late tick is the most visible
+        int type = static_cast<int>(_hands[index].hand->getType());
+        auto position = _pendingMoves.end();
+        while (position != _pendingMoves.begin() &&
+               static_cast<int>(_hands[*(position - 1)].hand->getType()) < type)
+        {
+            --position;
+        }
+        _pendingMoves.insert(position, index);
+    }
+
+    void AviatorClock::queueMovesForType(ClockHand::HandType type)
+    {
+        for (size_t index : _handsByType[static_cast<int>(type)])
+        {
+            // busy hands are queued again once their current move is done
+            if (_hands[index].hand->isReady())
+            {
+                queueMove(index);
+            }
+        }
+    }
+
+    void AviatorClock::startPendingMoves(unsigned long currentTimeMs)
+    {
+        // the hands of a type are a bank and start together, so a rollover takes as many
+        // slots as there are types, however many hands there are
+        bool bankStarted = false;
+        ClockHand::HandType bank = ClockHand::HandType::SECOND;
+        while (!_pendingMoves.empty())
+        {
+            size_t index = _pendingMoves.front();
+            HandSlot &slot = _hands[index];
+            bool sameBank = bankStarted && slot.hand->getType() == bank;
+            if (!sameBank && _moveStarted && currentTimeMs - _lastMoveStartMs < _moveStaggerMs)
+            {
+                return;
+            }
+
+            _pendingMoves.pop_front();
+            slot.queued = false;
+
+            // the time may have changed while queued, showTime() uses the latest
+            if (slot.hand->showTime(_lastTime, currentTimeMs))
+            {
+                SOC_TRACE_INSTANT(this, "startMove", static_cast<int32_t>(index));
+                activate(index);
+                _lastMoveStartMs = currentTimeMs;
+                _moveStarted = true;
+                bankStarted = true;
+                bank = slot.hand->getType();
+            }
+        }
+    }
+} // namespace aviator_clock
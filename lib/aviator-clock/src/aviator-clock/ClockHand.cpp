@@ -1,4 +1,6 @@
 #include <aviator-clock/ClockHand.h>
+#include <soc/trace/TraceRecorder.h>
+#include <cmath>
 
 namespace aviator_clock
 {
@@ -18,6 +20,8 @@ namespace aviator_clock
           // the stepperMotor will be as well.
           _stepperMotor(std::move(stepperMotor)),
           _logger(logger),
+          _dialMapping(0, std::vector<DialMapping::CalibrationPoint>()),
+          _subStepsPerDegree(DialMapping::SUB_STEPS / 360.0),
           _lastUnitProcessed(-1),
           _isPositionInitialized(false),
           _totalAngleForDial(totalAngleForDial),
@@ -25,7 +29,24 @@ namespace aviator_clock
           _motorSpeedDps(motorSpeedDps),
           _motorAccelerationDps2(motorAccelerationDps2),
           _homingFailed(false),
-          _operationStarted(false)
+          _operationStarted(false),
+          _motorHomed(false),
+          _motorBusy(false),
+          _motionMode(MotionMode::TICK),
+          _unitDurationSeconds(1.0),
+          _sweepVelocityDps(0.0),
+          _unitsOnDial(0),
+          _catchUpSpeedDps(motorSpeedDps),
+          _catchUpAccelerationDps2(motorAccelerationDps2),
+          _catchUpThresholdUnits(2),
+          _catchUpBoundMs(0),
+          _catchingUp(false),
+          _catchUpStartMs(0),
+          _catchUpCount(0),
+          _lastCatchUpMs(0),
+          _maxCatchUpMs(0),
+          _nowMs(0),
+          _dependency(nullptr)
     {
         if (_stepperMotor == nullptr)
         {
@@ -44,10 +65,18 @@ namespace aviator_clock
         {
         case HandType::HOUR:
             unitsOnDial = 12;
+            _unitDurationSeconds = 3600.0;
+            SOC_TRACE_TRACK(this, "HourHand");
             break;
         case HandType::MINUTE:
+            unitsOnDial = 60;
+            _unitDurationSeconds = 60.0;
+            SOC_TRACE_TRACK(this, "MinuteHand");
+            break;
         case HandType::SECOND:
             unitsOnDial = 60;
+            _unitDurationSeconds = 1.0;
+            SOC_TRACE_TRACK(this, "SecondHand");
             break;
         }
 
@@ -59,6 +88,9 @@ namespace aviator_clock
         {
             _degreesPerUnit = _totalAngleForDial / static_cast<double>(unitsOnDial);
         }
+        _unitsOnDial = unitsOnDial;
+        _dialMapping = DialMapping::linear(unitsOnDial, _dialStartOffsetDegrees, _totalAngleForDial);
+        setCatchUpProfile(_catchUpSpeedDps, _catchUpAccelerationDps2, _catchUpThresholdUnits);
     }
 
     // --- ISocComponent Methods ---
@@ -67,21 +99,35 @@ namespace aviator_clock
         if (!_stepperMotor)
             return;
 
+        _dialMapping.bake(_stepperMotor->getStepsPerRevolution());
+        _subStepsPerDegree = _stepperMotor->getStepsPerRevolution() * DialMapping::SUB_STEPS / 360.0;
+
         _stepperMotor->setSpeed(_motorSpeedDps);
         _stepperMotor->setAcceleration(_motorAccelerationDps2);
         _logger.info("ClockHand::setup() - Motor configured. Speed=%.2f, Accel=%.2f", _motorSpeedDps, _motorAccelerationDps2);
 
+        if (!_stepperMotor->addMotionListener(*this))
+        {
+            _logger.error("ClockHand: No free motion listener slot on the motor.");
+        }
+        _isPositionInitialized = false;
+        _lastUnitProcessed = -1;
+        _catchingUp = false;
+
         _stepperMotor->enable();
-        if (!_stepperMotor->home())
+        // an instant homing reports its success from home()
+        _motorHomed = false;
+        _motorBusy = true;
+        stepper::api::Status homing = _stepperMotor->home();
+        if (!homing)
         {
-            _logger.error("ClockHand: Stepper homing failed!");
+            _logger.error("ClockHand: Stepper homing failed: %s", stepper::api::stepperErrorName(homing.error()));
+            syncMotorState();
         }
         else
         {
             _logger.info("ClockHand: Stepper homing started.");
         }
-        _isPositionInitialized = false;
-        _lastUnitProcessed = -1;
     }
 
     void ClockHand::advanceState(unsigned long currentTimeMs)
@@ -89,86 +135,262 @@ namespace aviator_clock
         if (!_stepperMotor)
             return;
 
-        _stepperMotor->update();
+        soc::api::ITime::TimeComponents currentTime;
+        if (!_timeProvider.asTimeComponents(currentTime))
+        {
+            _logger.error("timeProvider did not return true. So I am doing nothing.");
+            return;
+        }
+
+        // While homing (or if failed) or while a move is in progress, do not proceed to clock logic.
+        if (update(currentTime, currentTimeMs) || !isReady())
+        {
+            return;
+        }
+        showTime(currentTime, currentTimeMs);
+    }
+
+    void ClockHand::setMotionMode(MotionMode mode)
+    {
+        _motionMode = mode;
+    }
+
+    ClockHand::MotionMode ClockHand::getMotionMode() const
+    {
+        return _motionMode;
+    }
+
+    void ClockHand::setDialMapping(const DialMapping &mapping)
+    {
+        if (!mapping.isValid() || mapping.getUnitsOnDial() != _unitsOnDial)
+        {
+            _logger.error("ClockHand: Invalid dial mapping for %d units, keeping the linear dial.", _unitsOnDial);
+            return;
+        }
+        _dialMapping = mapping;
+    }
+
+    void ClockHand::setTickProfile(double speedDps, double accelerationDps2)
+    {
+        _motorSpeedDps = speedDps;
+        _motorAccelerationDps2 = accelerationDps2;
+    }
+
+    // trapezoidal profile, triangular if the speed is never reached
+    static unsigned long moveDurationMs(double degrees, double speedDps, double accelerationDps2)
+    {
+        if (speedDps <= 0.0 || accelerationDps2 <= 0.0)
+        {
+            return 0;
+        }
+        double rampDegrees = speedDps * speedDps / accelerationDps2;
+        double seconds = degrees >= rampDegrees ? degrees / speedDps + speedDps / accelerationDps2
+                                                : 2.0 * sqrt(degrees / accelerationDps2);
+        return static_cast<unsigned long>(ceil(seconds * 1000.0));
+    }
+
+    void ClockHand::setCatchUpProfile(double speedDps, double accelerationDps2, int thresholdUnits)
+    {
+        _catchUpSpeedDps = speedDps;
+        _catchUpAccelerationDps2 = accelerationDps2;
+        _catchUpThresholdUnits = thresholdUnits > 1 ? thresholdUnits : 1;
+        _catchUpBoundMs = moveDurationMs(_totalAngleForDial, speedDps, accelerationDps2);
+    }
+
+    unsigned long ClockHand::getCatchUpCount() const
+    {
+        return _catchUpCount;
+    }
+
+    unsigned long ClockHand::getLastCatchUpMs() const
+    {
+        return _lastCatchUpMs;
+    }
+
+    unsigned long ClockHand::getMaxCatchUpMs() const
+    {
+        return _maxCatchUpMs;
+    }
+
+    unsigned long ClockHand::getCatchUpBoundMs() const
+    {
+        return _catchUpBoundMs;
+    }
+
+    bool ClockHand::update(const soc::api::ITime::TimeComponents &time, unsigned long currentTimeMs)
+    {
+        if (!_stepperMotor)
+            return false;
+
+        _nowMs = currentTimeMs;
+
+        // between two steps of a move nothing changes, the loop has time for the others.
+        // A sweeping hand still follows the time, e.g. flies back at the end of the dial.
+        bool sweeping = _motionMode == MotionMode::SWEEP && _operationStarted;
+        bool updateDue = _stepperMotor->isUpdateDue();
+        if (!updateDue && !sweeping)
+        {
+            return true;
+        }
+        if (updateDue)
+        {
+            _stepperMotor->update();
+        }
 
         // === STATE A: Homing is Required ===
-        if (_stepperMotor->needsHoming())
+        // the motion events of update() keep the flags, see onMotionEvent()
+        if (!_motorHomed)
+        {
+            return _motorBusy;
+        }
+
+        // === STATE D: Sweeping, the hand follows the time continuously ===
+        if (_motionMode == MotionMode::SWEEP && _operationStarted)
+        {
+            sweep(time);
+            return true;
+        }
+
+        // === STATE B: Homing is Complete, busy with a final homing move or a previous tick ===
+        // after a tick the motor still needs updates until it has reduced the coil current
+        return _motorBusy || _stepperMotor->isPowerDownPending();
+    }
+
+    bool ClockHand::isReady() const
+    {
+        return _stepperMotor && _motorHomed && !_motorBusy;
+    }
+
+    void ClockHand::onMotionEvent(IStepperMotor &/*motor*/, stepper::api::MotionEvent event)
+    {
+        switch (event)
         {
-            if (_stepperMotor->isHomingFailed() && !_homingFailed)
+        case stepper::api::MotionEvent::HOMING_SUCCEEDED:
+            _motorHomed = true;
+            _motorBusy = false;
+            break;
+        case stepper::api::MotionEvent::HOMING_FAILED:
+            _motorHomed = false;
+            _motorBusy = false;
+            if (!_homingFailed)
             {
                 _logger.error("ClockHand: Homing has failed! Please check motor and limit switch. System halted.");
                 _homingFailed = true;
             }
+            break;
+        case stepper::api::MotionEvent::MOVE_COMPLETE:
+            _motorBusy = false;
+            if (_catchingUp)
+            {
+                endCatchUp();
+            }
+            break;
+        }
+    }
 
-            // While homing (or if failed), do not proceed to clock logic.
-            return;
+    void ClockHand::syncMotorState()
+    {
+        // a rejected command sends no event, ask the motor once
+        _motorHomed = !_stepperMotor->needsHoming() && !_stepperMotor->isHomingFailed();
+        _motorBusy = _stepperMotor->isBusy();
+    }
+
+    int ClockHand::unitFor(const soc::api::ITime::TimeComponents &time) const
+    {
+        switch (_type)
+        {
+        case HandType::HOUR:
+            return time.hours % 12;
+        case HandType::MINUTE:
+            return time.minutes;
+        case HandType::SECOND:
+            return time.seconds;
         }
+        return 0;
+    }
 
-        // === STATE B: Homing is Complete and Successful ===
-        // We can only proceed if the motor isn't busy with a final homing move or a previous tick.
-        if (_stepperMotor->isBusy())
+    bool ClockHand::needsMoveTo(const soc::api::ITime::TimeComponents &time) const
+    {
+        return !_operationStarted || unitFor(time) != _lastUnitProcessed;
+    }
+
+    bool ClockHand::showTime(const soc::api::ITime::TimeComponents &time, unsigned long currentTimeMs)
+    {
+        if (!isReady() || !needsMoveTo(time))
         {
-            return;
+            return false;
         }
+        _nowMs = currentTimeMs;
+        // the first move after homing positions the hand, it is no catch-up
+        bool positioned = _operationStarted;
 
         if (!_operationStarted)
         {
             _logger.info("ClockHand: Homing successful! Motor is at home position.");
             _logger.info("ClockHand: Initializing position...");
             _operationStarted = true;
+        }
 
-            soc::api::ITime::TimeComponents currentTime;
-            if (_timeProvider.asTimeComponents(currentTime))
+        if (_motionMode == MotionMode::SWEEP)
+        {
+            // position the hand, update() sweeps from there on
+            double targetAngle = _dialMapping.subStepsAt(sweepUnitFixed(time)) / _subStepsPerDegree;
+            _logger.debug("ClockHand: Moving to sweep start (Angle: %.2f)", targetAngle);
+            _motorBusy = true;
+            stepper::api::Status move = _stepperMotor->moveToAbsolute(targetAngle);
+            if (!move)
             {
-                int currentUnit = 0;
-                switch (_type)
-                {
-                case HandType::HOUR:
-                    currentUnit = currentTime.hours % 12;
-                    break;
-                case HandType::MINUTE:
-                    currentUnit = currentTime.minutes;
-                    break;
-                case HandType::SECOND:
-                    currentUnit = currentTime.seconds;
-                    break;
-                }
-                moveToUnit(currentUnit);
-                _lastUnitProcessed = currentUnit;
+                _logger.error("stepper motor did not move to %.2f: %s", targetAngle, stepper::api::stepperErrorName(move.error()));
+                syncMotorState();
             }
+            _lastUnitProcessed = unitFor(time);
+            return true;
         }
+
         // === STATE C: Normal Ticking Operation ===
-        else
+        int currentUnit = unitFor(time);
+        if (positioned && isTimeJump(currentUnit))
         {
-            soc::api::ITime::TimeComponents currentTime;
-            if (!_timeProvider.asTimeComponents(currentTime))
-            {
-                _logger.error("timeProvider did not return true. So I am doing nothing.");
-                return;
-            }
+            beginCatchUp((currentUnit - _lastUnitProcessed + _unitsOnDial) % _unitsOnDial);
+        }
+        moveToUnit(currentUnit);
+        _lastUnitProcessed = currentUnit;
+        return true;
+    }
 
-            int currentUnit = 0;
-            switch (_type)
-            {
-            case HandType::HOUR:
-                currentUnit = currentTime.hours % 12;
-                break;
-            case HandType::MINUTE:
-                currentUnit = currentTime.minutes;
-                break;
-            case HandType::SECOND:
-                currentUnit = currentTime.seconds;
-                break;
-            }
+    bool ClockHand::isSetUp() const
+    {
+        return !_stepperMotor || !_stepperMotor->isHoming();
+    }
 
-            if (currentUnit != _lastUnitProcessed)
-            {
-                moveToUnit(currentUnit);
-                _lastUnitProcessed = currentUnit;
-            }
+    const char *ClockHand::getName() const
+    {
+        switch (_type)
+        {
+        case HandType::HOUR:
+            return "hour hand";
+        case HandType::MINUTE:
+            return "minute hand";
+        default:
+            return "second hand";
         }
     }
 
+    const soc::api::ISocComponent *ClockHand::getDependency(size_t index) const
+    {
+        return index == 0 ? _dependency : nullptr;
+    }
+
+    void ClockHand::setDependency(const soc::api::ISocComponent *dependency)
+    {
+        _dependency = dependency;
+    }
+
+    ClockHand::HandType ClockHand::getType() const
+    {
+        return _type;
+    }
+
     void ClockHand::render()
     {
     }
@@ -186,6 +408,134 @@ namespace aviator_clock
     }
 
     // --- Private Methods ---
+    uint32_t ClockHand::sweepUnitFixed(const soc::api::ITime::TimeComponents &time) const
+    {
+        // the unit with its fraction in 16.16 fixed point, integer math only
+        uint32_t unit = 0;
+        uint64_t millisIntoUnit = 0;
+        uint64_t millisPerUnit = 1000;
+        switch (_type)
+        {
+        case HandType::HOUR:
+            unit = time.hours % 12;
+            millisIntoUnit = (static_cast<uint64_t>(time.minutes) * 60 + time.seconds) * 1000 + time.milliseconds;
+            millisPerUnit = 3600000;
+            break;
+        case HandType::MINUTE:
+            unit = time.minutes;
+            millisIntoUnit = static_cast<uint64_t>(time.seconds) * 1000 + time.milliseconds;
+            millisPerUnit = 60000;
+            break;
+        case HandType::SECOND:
+            unit = time.seconds;
+            millisIntoUnit = time.milliseconds;
+            millisPerUnit = 1000;
+            break;
+        }
+        return (unit << 16) + static_cast<uint32_t>((millisIntoUnit << 16) / millisPerUnit);
+    }
+
+    void ClockHand::sweep(const soc::api::ITime::TimeComponents &time)
+    {
+        // a catch-up move is in progress
+        if (_motorBusy && !_stepperMotor->isRunningAtVelocity())
+        {
+            return;
+        }
+
+        uint32_t unitFixed = sweepUnitFixed(time);
+        double targetAngle = _dialMapping.subStepsAt(unitFixed) / _subStepsPerDegree;
+        stepper::api::Result<double> position = _stepperMotor->getCurrentPositionDegrees();
+        if (!position)
+        {
+            return;
+        }
+        double error = targetAngle - position.value();
+        int unit = unitFor(time);
+        bool timeJumped = isTimeJump(unit);
+        _lastUnitProcessed = unit;
+
+        // end of the dial, or the time jumped: no velocity adjustment can catch up
+        if (fabs(error) > _degreesPerUnit)
+        {
+            // the flyback at the end of the dial runs at the tick profile, it is no catch-up
+            if (timeJumped)
+            {
+                beginCatchUp(static_cast<int>(error / _degreesPerUnit));
+            }
+            _motorBusy = true;
+            stepper::api::Status move = _stepperMotor->moveToAbsolute(targetAngle);
+            if (!move)
+            {
+                _logger.error("stepper motor did not move to %.2f: %s", targetAngle, stepper::api::stepperErrorName(move.error()));
+                syncMotorState();
+            }
+            _sweepVelocityDps = 0.0;
+            return;
+        }
+
+        // the phase error decays within two units, the adjustment stays within 10 %
+        // the slope of the dial, a non-linear one runs faster where the scale is wider
+        double nominalDps = _dialMapping.subStepsPerUnitAt(unitFixed) / _subStepsPerDegree / _unitDurationSeconds;
+        double velocityDps = nominalDps + error / (2.0 * _unitDurationSeconds);
+        velocityDps = fmax(0.9 * nominalDps, fmin(velocityDps, 1.1 * nominalDps));
+
+        if (!_stepperMotor->isRunningAtVelocity() || fabs(velocityDps - _sweepVelocityDps) > 0.001 * nominalDps)
+        {
+            if (_stepperMotor->runAtVelocity(velocityDps))
+            {
+                _sweepVelocityDps = velocityDps;
+                _motorBusy = true;
+            }
+        }
+    }
+
+    bool ClockHand::isTimeJump(int unit) const
+    {
+        if (_lastUnitProcessed < 0 || _unitsOnDial <= 0)
+        {
+            return false;
+        }
+        // a time set back is a jump almost around the dial
+        int unitsAhead = (unit - _lastUnitProcessed + _unitsOnDial) % _unitsOnDial;
+        return unitsAhead > _catchUpThresholdUnits;
+    }
+
+    void ClockHand::beginCatchUp(int units)
+    {
+        SOC_TRACE_BEGIN(this, "catchUp");
+        _logger.info("ClockHand: Time jumped by %d units, catching up.", units);
+        _stepperMotor->setSpeed(_catchUpSpeedDps);
+        _stepperMotor->setAcceleration(_catchUpAccelerationDps2);
+        _catchingUp = true;
+        _catchUpStartMs = _nowMs;
+    }
+
+    void ClockHand::endCatchUp()
+    {
+        _stepperMotor->setSpeed(_motorSpeedDps);
+        _stepperMotor->setAcceleration(_motorAccelerationDps2);
+        _catchingUp = false;
+
+        _lastCatchUpMs = _nowMs - _catchUpStartMs;
+        _catchUpCount++;
+        if (_lastCatchUpMs > _maxCatchUpMs)
+        {
+            _maxCatchUpMs = _lastCatchUpMs;
+        }
+        SOC_TRACE_END(this, "catchUp");
+
+        // the loop time adds to the planned duration, much more means lost steps or a stalled loop
+        if (_lastCatchUpMs > _catchUpBoundMs + _catchUpBoundMs / 2)
+        {
+            _logger.warn("ClockHand: Catch-up took %lu ms, planned were at most %lu ms.", _lastCatchUpMs, _catchUpBoundMs);
+        }
+        else
+        {
+            _logger.info("ClockHand: Caught up in %lu ms (bound %lu ms).", _lastCatchUpMs, _catchUpBoundMs);
+        }
+    }
+
     void ClockHand::moveToUnit(int unit)
     {
         if (!_stepperMotor)
@@ -200,12 +550,16 @@ namespace aviator_clock
             unitForCalc = 12;
         }
 
-        double targetAngle = _dialStartOffsetDegrees + (static_cast<double>(unitForCalc) * _degreesPerUnit);
+        long targetSteps = _dialMapping.stepsForUnit(unitForCalc);
 
-        _logger.debug("ClockHand: Moving to unit %d (Angle: %.2f)", unit, targetAngle);
-        if (!_stepperMotor->moveToAbsolute(targetAngle))
+        SOC_TRACE_INSTANT(this, "moveToUnit", unit);
+        _logger.debug("ClockHand: Moving to unit %d (Step: %ld)", unit, targetSteps);
+        _motorBusy = true;
+        stepper::api::Status move = _stepperMotor->moveToStep(targetSteps);
+        if (!move)
         {
-            _logger.error("stepper motor did not move to %.2f", targetAngle);
+            _logger.error("stepper motor did not move to step %ld: %s", targetSteps, stepper::api::stepperErrorName(move.error()));
+            syncMotorState();
         }
     }
 } // namespace aviator_clock
\ No newline at end of file
@@ -0,0 +1,214 @@
+#include <aviator-clock/DialMapping.h>
+#include <cmath>
+
+namespace aviator_clock
+{
+    // the whole dial in about 240 samples, 4 per minute or 20 per hour
+    static const uint32_t TABLE_SAMPLES = 240;
+
+    DialMapping DialMapping::linear(int unitsOnDial, double startDegrees, double totalDegrees)
+    {
+        return DialMapping(unitsOnDial, {{0.0, startDegrees}, {static_cast<double>(unitsOnDial), startDegrees + totalDegrees}});
+    }
+
+    DialMapping::DialMapping(int unitsOnDial, const std::vector<CalibrationPoint> &points)
+        : _unitsOnDial(unitsOnDial),
+          _points(points),
+          _valid(false),
+          _samplesPerUnit(1)
+    {
+        _valid = validate();
+        if (_valid)
+        {
+            computeTangents();
+            uint32_t samples = TABLE_SAMPLES / static_cast<uint32_t>(_unitsOnDial);
+            _samplesPerUnit = samples > 0 ? samples : 1;
+        }
+    }
+
+    bool DialMapping::isValid() const
+    {
+        return _valid;
+    }
+
+    int DialMapping::getUnitsOnDial() const
+    {
+        return _unitsOnDial;
+    }
+
+    bool DialMapping::validate() const
+    {
+        if (_unitsOnDial <= 0 || _points.size() < 2)
+        {
+            return false;
+        }
+        if (_points.front().unit != 0.0 || _points.back().unit != static_cast<double>(_unitsOnDial))
+        {
+            return false;
+        }
+        for (size_t i = 1; i < _points.size(); i++)
+        {
+            if (_points[i].unit <= _points[i - 1].unit || _points[i].degrees < _points[i - 1].degrees)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void DialMapping::computeTangents()
+    {
+        // Fritsch-Carlson: start with the mean of the neighbouring secants, then limit
+        // the tangents so that no segment overshoots.
+        size_t count = _points.size();
+        std::vector<double> secants(count - 1);
+        for (size_t i = 0; i + 1 < count; i++)
+        {
+            secants[i] = (_points[i + 1].degrees - _points[i].degrees) / (_points[i + 1].unit - _points[i].unit);
+        }
+
+        _tangents.assign(count, 0.0);
+        _tangents[0] = secants[0];
+        _tangents[count - 1] = secants[count - 2];
+        for (size_t i = 1; i + 1 < count; i++)
+        {
+            // a flat neighbour, or a local extremum, keeps the hand still
+            if (secants[i - 1] * secants[i] > 0.0)
+            {
+                _tangents[i] = (secants[i - 1] + secants[i]) / 2.0;
+            }
+        }
+
+        for (size_t i = 0; i + 1 < count; i++)
+        {
+            if (secants[i] == 0.0)
+            {
+                _tangents[i] = 0.0;
+                _tangents[i + 1] = 0.0;
+                continue;
+            }
+            double alpha = _tangents[i] / secants[i];
+            double beta = _tangents[i + 1] / secants[i];
+            double length = alpha * alpha + beta * beta;
+            if (length > 9.0)
+            {
+                double tau = 3.0 / sqrt(length);
+                _tangents[i] = tau * alpha * secants[i];
+                _tangents[i + 1] = tau * beta * secants[i];
+            }
+        }
+    }
+
+    double DialMapping::degreesAt(double unit) const
+    {
+        if (!_valid)
+        {
+            return 0.0;
+        }
+        if (unit <= _points.front().unit)
+        {
+            return _points.front().degrees;
+        }
+        if (unit >= _points.back().unit)
+        {
+            return _points.back().degrees;
+        }
+
+        size_t k = 0;
+        while (unit > _points[k + 1].unit)
+        {
+            k++;
+        }
+
+        // cubic Hermite segment between the calibration points k and k + 1
+        double h = _points[k + 1].unit - _points[k].unit;
+        double t = (unit - _points[k].unit) / h;
+        double t2 = t * t;
+        double t3 = t2 * t;
+        return (2.0 * t3 - 3.0 * t2 + 1.0) * _points[k].degrees +
+               (t3 - 2.0 * t2 + t) * h * _tangents[k] +
+               (-2.0 * t3 + 3.0 * t2) * _points[k + 1].degrees +
+               (t3 - t2) * h * _tangents[k + 1];
+    }
+
+    void DialMapping::bake(long stepsPerRevolution)
+    {
+        _table.clear();
+        if (!_valid)
+        {
+            return;
+        }
+
+        double subStepsPerDegree = static_cast<double>(stepsPerRevolution) * SUB_STEPS / 360.0;
+        size_t samples = static_cast<size_t>(_unitsOnDial) * _samplesPerUnit + 1;
+        _table.resize(samples);
+        for (size_t i = 0; i < samples; i++)
+        {
+            double unit = static_cast<double>(i) / _samplesPerUnit;
+            _table[i] = static_cast<int32_t>(lround(degreesAt(unit) * subStepsPerDegree));
+        }
+    }
+
+    bool DialMapping::isBaked() const
+    {
+        return !_table.empty();
+    }
+
+    long DialMapping::stepsForUnit(int unit) const
+    {
+        if (_table.empty())
+        {
+            return 0;
+        }
+        if (unit < 0)
+        {
+            unit = 0;
+        }
+        if (unit > _unitsOnDial)
+        {
+            unit = _unitsOnDial;
+        }
+
+        int32_t subSteps = _table[static_cast<size_t>(unit) * _samplesPerUnit];
+        // round half away from zero, like lround() of the exact position
+        return subSteps >= 0 ? (subSteps + SUB_STEPS / 2) / SUB_STEPS
+                             : -((-subSteps + SUB_STEPS / 2) / SUB_STEPS);
+    }
+
+    size_t DialMapping::segmentIndex(uint32_t unitFixed, uint32_t &fraction) const
+    {
+        uint64_t position = static_cast<uint64_t>(unitFixed) * _samplesPerUnit;
+        size_t index = static_cast<size_t>(position >> 16);
+        fraction = static_cast<uint32_t>(position & (UNIT_ONE - 1));
+        if (index + 1 >= _table.size())
+        {
+            // the end of the dial
+            index = _table.size() - 2;
+            fraction = UNIT_ONE;
+        }
+        return index;
+    }
+
+    int32_t DialMapping::subStepsAt(uint32_t unitFixed) const
+    {
+        if (_table.size() < 2)
+        {
+            return 0;
+        }
+        uint32_t fraction;
+        size_t index = segmentIndex(unitFixed, fraction);
+        int64_t delta = static_cast<int64_t>(_table[index + 1]) - _table[index];
+        return _table[index] + static_cast<int32_t>((delta * fraction) >> 16);
+    }
+
+    int32_t DialMapping::subStepsPerUnitAt(uint32_t unitFixed) const
+    {
+        if (_table.size() < 2)
+        {
+            return 0;
+        }
+        uint32_t fraction;
+        size_t index = segmentIndex(unitFixed, fraction);
+        return (_table[index + 1] - _table[index]) * static_cast<int32_t>(_samplesPerUnit);
+    }
+}
@@ -0,0 +1,321 @@
+#include <aviator-clock/TickProfileTuner.h>
+#include <cmath>
+
+namespace aviator_clock
+{
+    const uint32_t TickProfileTuner::SAVED_PROFILE_VERSION;
+
+    TickProfileTuner::Config TickProfileTuner::defaultConfig()
+    {
+        Config config;
+        config.start = {600.0, 15000.0};
+        config.limit = {4800.0, 240000.0};
+        config.growthFactor = 1.25;
+        config.marginFraction = 0.2;
+        config.tickDegrees = 5.5;
+        config.ticksPerLevel = 10;
+        config.longMoveDegrees = 240.0;
+        config.probe = {20.0, 2000.0};
+        config.probeStartDegrees = 30.0;
+        config.probeOvershootDegrees = 10.0;
+        config.switchDirectionSign = -1;
+        config.toleranceSteps = 2;
+        return config;
+    }
+
+    bool TickProfileTuner::loadProfile(soc::api::IPersistentStore &store, const char *storeKey, Profile &profile)
+    {
+        SavedProfile saved;
+        if (!store.load(storeKey, &saved, sizeof(saved)) ||
+            saved.version != SAVED_PROFILE_VERSION ||
+            !(saved.speedDps > 0.0f) || !(saved.accelerationDps2 > 0.0f))
+        {
+            return false;
+        }
+        profile.speedDps = saved.speedDps;
+        profile.accelerationDps2 = saved.accelerationDps2;
+        return true;
+    }
+
+    TickProfileTuner::TickProfileTuner(IStepperMotor &motor,
+                                       soc::api::IDigitalInput &limitSwitch,
+                                       soc::api::IPersistentStore &store,
+                                       const char *storeKey,
+                                       soc::api::ILogger &logger,
+                                       const Config &config)
+        : _motor(motor),
+          _limitSwitch(limitSwitch),
+          _store(store),
+          _storeKey(storeKey),
+          _logger(logger),
+          _config(config),
+          _state(State::IDLE),
+          _listening(false),
+          _probeStartSteps(0),
+          _probeEndSteps(0),
+          _tickSteps(0),
+          _longMoveSteps(0),
+          _hasReference(false),
+          _referenceSteps(0),
+          _triggered(false),
+          _triggerSteps(0),
+          _lastProbeErrorSteps(0),
+          _level(config.start),
+          _safe(config.start),
+          _safeLevels(0),
+          _tick(0),
+          _result(config.start)
+    {
+    }
+
+    TickProfileTuner::~TickProfileTuner()
+    {
+        if (_listening)
+        {
+            _motor.removeMotionListener(*this);
+        }
+    }
+
+    bool TickProfileTuner::begin()
+    {
+        // the switch is at 0 after homing, the ticks go away from it
+        int away = -_config.switchDirectionSign;
+        _probeStartSteps = away * toSteps(_config.probeStartDegrees);
+        _probeEndSteps = -away * toSteps(_config.probeOvershootDegrees);
+        _tickSteps = away * toSteps(_config.tickDegrees);
+        _longMoveSteps = away * toSteps(_config.longMoveDegrees);
+
+        if (!_motor.addMotionListener(*this))
+        {
+            _logger.error("TickProfileTuner: No listener slot left on the motor.");
+            _state = State::FAILED;
+            return false;
+        }
+        _listening = true;
+        _state = State::HOMING;
+        _logger.info("TickProfileTuner: Tuning the tick profile, homing.");
+        stepper::api::Status status = _motor.home();
+        if (!status && _state == State::HOMING)
+        {
+            fail(stepper::api::stepperErrorName(status.error()));
+        }
+        return _state != State::FAILED;
+    }
+
+    bool TickProfileTuner::update()
+    {
+        if (_state == State::SUCCEEDED || _state == State::FAILED || _state == State::IDLE)
+        {
+            if (_listening)
+            {
+                _motor.removeMotionListener(*this);
+                _listening = false;
+            }
+            return false;
+        }
+
+        _motor.update();
+        if (_state == State::PROBING && !_triggered && _limitSwitch.isActive())
+        {
+            _triggered = true;
+            _triggerSteps = currentSteps();
+            _motor.stop();
+        }
+        return true;
+    }
+
+    void TickProfileTuner::onMotionEvent(IStepperMotor &/*motor*/, stepper::api::MotionEvent event)
+    {
+        if (event == stepper::api::MotionEvent::HOMING_FAILED)
+        {
+            fail("Homing failed.");
+            return;
+        }
+
+        switch (_state)
+        {
+        case State::HOMING:
+            if (event == stepper::api::MotionEvent::HOMING_SUCCEEDED)
+            {
+                applyProfile(_config.probe);
+                _state = State::MOVING_TO_PROBE_START;
+                moveTo(_probeStartSteps);
+            }
+            break;
+        case State::MOVING_TO_PROBE_START:
+        case State::RETURNING:
+            startProbe();
+            break;
+        case State::PROBING:
+            evaluateProbe();
+            break;
+        case State::TICKING:
+            if (_tick < _config.ticksPerLevel)
+            {
+                _tick++;
+                moveTo(_probeStartSteps + _tick * _tickSteps);
+            }
+            else
+            {
+                _state = State::LONG_MOVE;
+                moveTo(_probeStartSteps + _config.ticksPerLevel * _tickSteps + _longMoveSteps);
+            }
+            break;
+        case State::LONG_MOVE:
+            applyProfile(_config.start);
+            _state = State::RETURNING;
+            moveTo(_probeStartSteps);
+            break;
+        default:
+            break;
+        }
+    }
+
+    TickProfileTuner::State TickProfileTuner::getState() const
+    {
+        return _state;
+    }
+
+    const TickProfileTuner::Profile &TickProfileTuner::getProfile() const
+    {
+        return _result;
+    }
+
+    int TickProfileTuner::getSafeLevelCount() const
+    {
+        return _safeLevels;
+    }
+
+    long TickProfileTuner::getLastProbeErrorSteps() const
+    {
+        return _lastProbeErrorSteps;
+    }
+
+    long TickProfileTuner::toSteps(double degrees) const
+    {
+        return lround(degrees * _motor.getStepsPerRevolution() / 360.0);
+    }
+
+    long TickProfileTuner::currentSteps() const
+    {
+        stepper::api::Result<double> degrees = _motor.getCurrentPositionDegrees();
+        return toSteps(degrees.valueOr(0.0));
+    }
+
+    void TickProfileTuner::applyProfile(const Profile &profile)
+    {
+        _motor.setSpeed(profile.speedDps);
+        _motor.setAcceleration(profile.accelerationDps2);
+    }
+
+    void TickProfileTuner::moveTo(long steps)
+    {
+        stepper::api::Status status = _motor.moveToStep(steps);
+        if (!status)
+        {
+            fail(stepper::api::stepperErrorName(status.error()));
+        }
+    }
+
+    void TickProfileTuner::startProbe()
+    {
+        if (_limitSwitch.isActive())
+        {
+            if (!_hasReference)
+            {
+                // the homing decelerates on the switch, the probe has to start beyond that
+                fail("The limit switch is still active at the start of the probe.");
+                return;
+            }
+            // the level lost so many steps that the hand came back onto the switch
+            _triggered = true;
+            _triggerSteps = currentSteps();
+            evaluateProbe();
+            return;
+        }
+        applyProfile(_config.probe);
+        _triggered = false;
+        _state = State::PROBING;
+        moveTo(_probeEndSteps);
+    }
+
+    void TickProfileTuner::evaluateProbe()
+    {
+        if (!_triggered)
+        {
+            fail("The limit switch did not trigger.");
+            return;
+        }
+        if (!_hasReference)
+        {
+            _hasReference = true;
+            _referenceSteps = _triggerSteps;
+            startLevel();
+            return;
+        }
+
+        _lastProbeErrorSteps = _triggerSteps - _referenceSteps;
+        long error = _lastProbeErrorSteps < 0 ? -_lastProbeErrorSteps : _lastProbeErrorSteps;
+        if (error > _config.toleranceSteps)
+        {
+            _logger.info("TickProfileTuner: %.0f deg/s, %.0f deg/s^2 lost %ld steps.",
+                         _level.speedDps, _level.accelerationDps2, _lastProbeErrorSteps);
+            if (_safeLevels == 0)
+            {
+                fail("Even the first level lost steps.");
+                return;
+            }
+            finish();
+            return;
+        }
+
+        _logger.info("TickProfileTuner: %.0f deg/s, %.0f deg/s^2 ok.", _level.speedDps, _level.accelerationDps2);
+        _safe = _level;
+        _safeLevels++;
+        if (_level.speedDps >= _config.limit.speedDps && _level.accelerationDps2 >= _config.limit.accelerationDps2)
+        {
+            finish();
+            return;
+        }
+        _level.speedDps = fmin(_level.speedDps * _config.growthFactor, _config.limit.speedDps);
+        _level.accelerationDps2 = fmin(_level.accelerationDps2 * _config.growthFactor, _config.limit.accelerationDps2);
+        startLevel();
+    }
+
+    void TickProfileTuner::startLevel()
+    {
+        applyProfile(_level);
+        _tick = 0;
+        _state = State::TICKING;
+        moveTo(_probeStartSteps);
+    }
+
+    void TickProfileTuner::finish()
+    {
+        _result.speedDps = _safe.speedDps * (1.0 - _config.marginFraction);
+        _result.accelerationDps2 = _safe.accelerationDps2 * (1.0 - _config.marginFraction);
+        _state = State::SUCCEEDED;
+
+        SavedProfile saved;
+        saved.version = SAVED_PROFILE_VERSION;
+        saved.speedDps = static_cast<float>(_result.speedDps);
+        saved.accelerationDps2 = static_cast<float>(_result.accelerationDps2);
+        if (!_store.save(_storeKey, &saved, sizeof(saved)))
+        {
+            _logger.warn("TickProfileTuner: Could not save the profile.");
+        }
+        _logger.info("TickProfileTuner: Tick profile %.0f deg/s, %.0f deg/s^2.",
+                     _result.speedDps, _result.accelerationDps2);
+    }
+
+    void TickProfileTuner::fail(const char *reason)
+    {
+        if (_state == State::FAILED)
+        {
+            return;
+        }
+        _state = State::FAILED;
+        _motor.stop();
+        _logger.warn("TickProfileTuner: Tuning failed: %s", reason);
+    }
+}
@@ -0,0 +1,97 @@
+#include <aviator-clock/TickProfileTuning.h>
+
+namespace aviator_clock
+{
+    TickProfileTuning::TickProfileTuning(ClockHand &hand,
+                                         IStepperMotor &motor,
+                                         soc::api::IDigitalInput &limitSwitch,
+                                         soc::api::IPersistentStore &store,
+                                         const char *storeKey,
+                                         soc::api::ILogger &logger,
+                                         const TickProfileTuner::Config &config,
+                                         bool retune)
+        : _hand(hand),
+          _motor(motor),
+          _limitSwitch(limitSwitch),
+          _store(store),
+          _storeKey(storeKey),
+          _logger(logger),
+          _config(config),
+          _retune(retune),
+          _done(false),
+          _tuned(false)
+    {
+    }
+
+    void TickProfileTuning::setup()
+    {
+        TickProfileTuner::Profile profile;
+        if (!_retune && TickProfileTuner::loadProfile(_store, _storeKey, profile))
+        {
+            _logger.info("Tick profile %s: %.0f deg/s, %.0f deg/s^2.", _storeKey, profile.speedDps,
+                         profile.accelerationDps2);
+            _hand.setTickProfile(profile.speedDps, profile.accelerationDps2);
+            _done = true;
+            return;
+        }
+
+        _tuner = std::make_unique<TickProfileTuner>(_motor, _limitSwitch, _store, _storeKey, _logger, _config);
+        if (!_tuner->begin())
+        {
+            finish();
+        }
+    }
+
+    void TickProfileTuning::advanceState(unsigned long /*currentTimeMs*/)
+    {
+        if (_tuner && !_tuner->update())
+        {
+            finish();
+        }
+    }
+
+    void TickProfileTuning::render()
+    {
+    }
+
+    void TickProfileTuning::teardown()
+    {
+        if (_tuner)
+        {
+            _motor.stop();
+            _tuner.reset();
+        }
+    }
+
+    bool TickProfileTuning::isSetUp() const
+    {
+        return _done;
+    }
+
+    const char *TickProfileTuning::getName() const
+    {
+        return _storeKey;
+    }
+
+    bool TickProfileTuning::isTuned() const
+    {
+        return _tuned;
+    }
+
+    void TickProfileTuning::finish()
+    {
+        if (_tuner->getState() == TickProfileTuner::State::SUCCEEDED)
+        {
+            const TickProfileTuner::Profile &profile = _tuner->getProfile();
+            _hand.setTickProfile(profile.speedDps, profile.accelerationDps2);
+            _tuned = true;
+        }
+        else
+        {
+            _logger.warn("Tick profile %s: tuning failed, keeping the default.", _storeKey);
+        }
+        // the hand takes over the motor, the tuner stops listening to it
+        _tuner.reset();
+        _done = true;
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace soc
+{
+    namespace api
+    {
+        /**
+         * @brief An I2C bus in controller mode.
+         *
+         * A transfer is slow compared to a loop iteration, a few hundred microseconds at
+         * 100 kHz, so devices on the bus should be read rarely and cached.
+         */
+        class II2cBus
+        {
+        public:
+            virtual ~II2cBus() = default;
+
+            virtual void begin() = 0;
+
+            /**
+             * @brief Writes writeLength bytes to the device, then reads readLength bytes from
+             * it after a repeated start. Either part may be empty, a register read writes
+             * the register address and reads the registers.
+             * @return False if the device did not acknowledge or returned fewer bytes.
+             */
+            virtual bool transfer(uint8_t address,
+                                  const uint8_t *writeData, size_t writeLength,
+                                  uint8_t *readData, size_t readLength) = 0;
+        };
+    }
+}
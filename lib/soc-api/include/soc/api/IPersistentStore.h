@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+
+namespace soc
+{
+    namespace api
+    {
+        /**
+         * @brief Small records that survive a reboot, e.g. in the flash.
+         *
+         * The flash wears with every write, save rarely and only what changed.
+         */
+        class IPersistentStore
+        {
+        public:
+            virtual ~IPersistentStore() = default;
+
+            virtual bool begin() = 0;
+
+            /**
+             * @brief Reads the record of key into data.
+             * @return False if there is no record of exactly size bytes, data is unchanged then.
+             */
+            virtual bool load(const char *key, void *data, size_t size) = 0;
+
+            /**
+             * @brief Writes size bytes of data as the record of key, replacing the old one.
+             * @param key At most 15 characters.
+             */
+            virtual bool save(const char *key, const void *data, size_t size) = 0;
+        };
+    }
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+namespace soc
+{
+    namespace api
+    {
+        /**
+         * @brief A pin driven by a PWM generator. The duty is the fraction of the period the
+         * output is active, in 1/DUTY_FULL. The implementation handles active low outputs.
+         */
+        class IPwmOutput
+        {
+        public:
+            static const uint16_t DUTY_FULL = 1000;
+
+            virtual ~IPwmOutput() = default;
+
+            virtual void begin() = 0;
+
+            /**
+             * @brief Sets the duty, 0 is always inactive, DUTY_FULL always active.
+             * Larger values are clamped.
+             */
+            virtual void setDuty(uint16_t duty) = 0;
+        };
+    }
+}
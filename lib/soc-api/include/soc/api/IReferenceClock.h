@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+namespace soc
+{
+    namespace api
+    {
+        /**
+         * @brief A clock that is more accurate than the crystal of the SoC in the long run,
+         * e.g. an RTC or a time server.
+         *
+         * A reading may take a bus transfer or longer, read it rarely and not per loop.
+         */
+        class IReferenceClock
+        {
+        public:
+            virtual ~IReferenceClock() = default;
+
+            /**
+             * @brief Reads the reference.
+             * @param epochMillis Milliseconds since 1970, in the middle of the resolution.
+             * @return False if the reference did not answer.
+             */
+            virtual bool readMillis(uint64_t &epochMillis) = 0;
+
+            /**
+             * @brief A reading is within half of this of the true reference time.
+             */
+            virtual unsigned long getResolutionMs() const = 0;
+        };
+    }
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace soc
+{
+    namespace api
+    {
+        /**
+         * @brief A chain of serial-in, parallel-out shift registers (74HC595 and alike).
+         *
+         * A frame holds one byte per register and is shifted out MSB first, so the first
+         * byte of a frame ends up in the last register of the chain. Every frame is latched
+         * to the outputs of all registers at once.
+         */
+        class IShiftOutput
+        {
+        public:
+            virtual ~IShiftOutput() = default;
+
+            virtual void begin() = 0;
+
+            /**
+             * @brief Shifts out frameCount frames of frameLength bytes in one burst and latches
+             * each of them, in order.
+             */
+            virtual void writeFrames(const uint8_t *frames, size_t frameLength, size_t frameCount) = 0;
+        };
+    }
+}
@@ -1,6 +1,8 @@
 // soc/api/ISocComponent.h
 #pragma once
 
+#include <cstddef>
+
 namespace soc
 {
     namespace api
@@ -26,6 +28,38 @@ namespace soc
              */
             virtual void setup() {}
 
+            /**
+             * @brief False while the setup continues in the loop, e.g. a motor that is
+             * still homing. Components that depend on this one are set up afterwards.
+             * A setup that failed is done as well.
+             */
+            virtual bool isSetUp() const { return true; }
+
+            /**
+             * @brief The components this one needs set up before its own setup().
+             * @param index From 0 on.
+             * @return The dependency at index, nullptr past the last one.
+             */
+            virtual const ISocComponent *getDependency(size_t /*index*/) const { return nullptr; }
+
+            /**
+             * @brief Name of the component in reports, e.g. the boot report.
+             */
+            virtual const char *getName() const { return "component"; }
+
+            /**
+             * @brief False if the component may be degraded when it overruns the loop,
+             * e.g. a display, but not a motor.
+             */
+            virtual bool isCritical() const { return true; }
+
+            /**
+             * @brief A non-critical component that overran the loop is degraded for a while:
+             * the soc skips its render() and tells it here, so it can shed more work, e.g.
+             * throttle its logs. Called again with false when the time is over.
+             */
+            virtual void setDegraded(bool /*degraded*/) {}
+
             /**
              * @brief Called repeatedly during the ISoc::advanceState phase.
              * Implement this method to update the component's internal state
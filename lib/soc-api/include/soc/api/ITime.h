@@ -18,6 +18,7 @@ namespace soc
                 unsigned long hours; // Hours elapsed since boot (can exceed 23)
                 int minutes;         // Minutes part of the elapsed time (0-59)
                 int seconds;         // Seconds part of the elapsed time (0-59)
+                int milliseconds;    // Milliseconds part of the elapsed time (0-999)
             };
 
             /**
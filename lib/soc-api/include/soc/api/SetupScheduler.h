@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <soc/api/ISocComponent.h>
+
+namespace soc
+{
+    namespace api
+    {
+        /**
+         * @brief Told by the SetupScheduler when the setup of a component begins and ends.
+         */
+        class ISetupListener
+        {
+        public:
+            virtual ~ISetupListener() = default;
+
+            /**
+             * @param index Of the component, in the order it was added.
+             */
+            virtual void onSetupBegun(size_t index) = 0;
+            virtual void onSetUp(size_t index) = 0;
+        };
+
+        /**
+         * @brief Sets up the components of an ISoc in the order of their dependencies.
+         *
+         * A component is set up as soon as all its dependencies are set up, see
+         * ISocComponent::getDependency(). Components without a dependency between them are
+         * set up one after the other and continue their setups side by side in the loop.
+         * A dependency that is not a component of this scheduler only has to report
+         * isSetUp(). A component that never gets its dependencies stays waiting.
+         */
+        class SetupScheduler
+        {
+        public:
+            enum class State : uint8_t
+            {
+                WAITING,    // for its dependencies
+                SETTING_UP, // setup() was called, isSetUp() not yet
+                SET_UP
+            };
+
+            /**
+             * @param listener May be null.
+             */
+            explicit SetupScheduler(ISetupListener *listener = nullptr);
+
+            /**
+             * @brief Adds the component as the next index and sets it up right away if its
+             * dependencies are set up. The component must outlive the scheduler.
+             */
+            void add(ISocComponent &component);
+
+            /**
+             * @brief Sets up the components whose dependencies are set up by now, and
+             * finishes the setups that are done. Call it every loop until isDone().
+             */
+            void advance();
+
+            /**
+             * @brief True once every component is set up.
+             */
+            bool isDone() const;
+
+            State getState(size_t index) const;
+
+            /**
+             * @brief True once setup() was called, from then on the component runs in the loop.
+             */
+            bool isStarted(size_t index) const;
+
+        private:
+            struct Entry
+            {
+                ISocComponent *component;
+                State state;
+            };
+
+            std::vector<Entry> _entries;
+            ISetupListener *_listener;
+            size_t _pending; // components not SET_UP
+
+            bool dependenciesSetUp(const ISocComponent &component) const;
+        };
+    } // namespace api
+} // namespace soc
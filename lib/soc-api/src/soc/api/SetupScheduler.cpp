@@ -0,0 +1,97 @@
+#include <soc/api/SetupScheduler.h>
+
+namespace soc
+{
+    namespace api
+    {
+        SetupScheduler::SetupScheduler(ISetupListener *listener)
+            : _listener(listener),
+              _pending(0)
+        {
+        }
+
+        void SetupScheduler::add(ISocComponent &component)
+        {
+            _entries.push_back(Entry{&component, State::WAITING});
+            _pending++;
+            advance();
+        }
+
+        void SetupScheduler::advance()
+        {
+            // a finished setup may release the components that wait for it, in the same call
+            bool progress = true;
+            while (progress)
+            {
+                progress = false;
+                for (size_t i = 0; i < _entries.size(); i++)
+                {
+                    if (_entries[i].state == State::WAITING && dependenciesSetUp(*_entries[i].component))
+                    {
+                        _entries[i].state = State::SETTING_UP;
+                        if (_listener)
+                        {
+                            _listener->onSetupBegun(i);
+                        }
+                        // may add components, no reference into the vector across it
+                        _entries[i].component->setup();
+                        progress = true;
+                    }
+                    Entry &entry = _entries[i];
+                    if (entry.state == State::SETTING_UP && entry.component->isSetUp())
+                    {
+                        entry.state = State::SET_UP;
+                        _pending--;
+                        if (_listener)
+                        {
+                            _listener->onSetUp(i);
+                        }
+                        progress = true;
+                    }
+                }
+            }
+        }
+
+        bool SetupScheduler::isDone() const
+        {
+            return _pending == 0;
+        }
+
+        SetupScheduler::State SetupScheduler::getState(size_t index) const
+        {
+            return _entries[index].state;
+        }
+
+        bool SetupScheduler::isStarted(size_t index) const
+        {
+            return _entries[index].state != State::WAITING;
+        }
+
+        bool SetupScheduler::dependenciesSetUp(const ISocComponent &component) const
+        {
+            for (size_t i = 0;; i++)
+            {
+                const ISocComponent *dependency = component.getDependency(i);
+                if (dependency == nullptr)
+                {
+                    return true;
+                }
+
+                // a dependency of another soc only has to be set up
+                bool setUp = dependency->isSetUp();
+                for (const Entry &entry : _entries)
+                {
+                    if (entry.component == dependency)
+                    {
+                        setUp = entry.state == State::SET_UP;
+                        break;
+                    }
+                }
+                if (!setUp)
+                {
+                    return false;
+                }
+            }
+        }
+    } // namespace api
+} // namespace soc
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+
+namespace soc
+{
+    namespace esp32
+    {
+        /**
+         * @brief Debounces up to 64 pins at once, GPIO n is bit n of every mask.
+         *
+         * Each sample() is one raw reading of all pins. The last HISTORY_LENGTH samples are
+         * kept bit-packed, one 64 bit word per sample. Both filters run bit-sliced, with
+         * the same few word operations for one pin or for all 64:
+         * - INTEGRATOR counts up while a pin reads high and down while it reads low,
+         *   saturating at 0 and threshold. The pin turns high at threshold and low at 0,
+         *   so a spike only delays the count instead of restarting it.
+         * - CONSECUTIVE changes a pin after threshold equal samples in a row.
+         * Without bounce both switch threshold samples after the edge. The first sample
+         * is taken as settled, so a switch that is already pressed at boot reads pressed
+         * right away.
+         */
+        class DebounceFilter
+        {
+        public:
+            enum class Mode
+            {
+                INTEGRATOR,
+                CONSECUTIVE
+            };
+
+            struct Config
+            {
+                Mode mode;
+                uint8_t threshold; // samples, 1 to HISTORY_LENGTH
+            };
+
+            static const uint8_t HISTORY_LENGTH = 32;
+
+            /**
+             * @param pins The pins to filter, all others always read low.
+             */
+            DebounceFilter(uint64_t pins, Config config);
+
+            void sample(uint64_t levels);
+
+            uint64_t getStates() const;
+
+            /**
+             * @brief Raw samples of a pin, bit 0 is the newest.
+             */
+            uint32_t getHistory(uint8_t pin) const;
+
+            unsigned long getSampleCount() const;
+
+        private:
+            static const uint8_t COUNTER_BITS = 6; // 0 to 63, enough for HISTORY_LENGTH
+
+            const uint64_t _pins;
+            const Mode _mode;
+            const uint8_t _threshold;
+
+            uint64_t _history[HISTORY_LENGTH]; // ring buffer, _history[_newest] is the last sample
+            uint8_t _newest;
+            uint64_t _counter[COUNTER_BITS];   // bit-sliced integrators, plane i holds bit i of every count
+            uint64_t _states;
+            unsigned long _sampleCount;
+
+            void prime(uint64_t levels);
+            void integrate(uint64_t levels);
+            void countConsecutive();
+            uint64_t counterEquals(uint8_t value) const;
+        };
+    }
+}
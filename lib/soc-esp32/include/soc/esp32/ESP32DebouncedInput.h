@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <soc/api/IDigitalInput.h>
+#include <soc/esp32/ESP32InputSampler.h>
+
+namespace soc
+{
+    namespace esp32
+    {
+        /**
+         * @brief Digital input that reports the debounced level of its pin, see ESP32InputSampler.
+         * A drop-in replacement for ESP32DigitalInput, e.g. for limit switches.
+         */
+        class ESP32DebouncedInput : public soc::api::IDigitalInput
+        {
+        public:
+            /**
+             * @param sampler Sampler that filters the pin, it must include it.
+             * @param activeLow Like ESP32DigitalInput, also selects the pull-up or pull-down.
+             */
+            ESP32DebouncedInput(const ESP32InputSampler &sampler, uint8_t pin, bool activeLow = true);
+
+            void begin() const override;
+            bool isActive() const override;
+
+        private:
+            const ESP32InputSampler &_sampler;
+            uint8_t _pin;
+            bool _activeLow;
+        };
+    }
+}
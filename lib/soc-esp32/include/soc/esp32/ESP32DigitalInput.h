@@ -34,6 +34,7 @@ namespace soc
 
         private:
             uint8_t _pin;
+            uint64_t _mask;
             bool _activeLow;
         };
     }
@@ -1,10 +1,14 @@
 #pragma once
+#include <cstdint>
 #include <soc/api/IDigitalOutput.h>
 
 namespace soc
 {
     namespace esp32
     {
+        /**
+         * @brief Output pin written through the GPIO set/clear registers, see FastGpio.
+         */
         class ESP32DigitalOutput : public soc::api::IDigitalOutput
         {
         public:
@@ -15,6 +19,7 @@ namespace soc
 
         private:
             int pin;
+            uint64_t mask;
         };
     }
 }
@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdint>
+#include <Wire.h>
+#include <soc/api/II2cBus.h>
+
+namespace soc
+{
+    namespace esp32
+    {
+        /**
+         * @brief The I2C controller of the ESP32 through the Wire library.
+         */
+        class ESP32I2cBus : public soc::api::II2cBus
+        {
+        public:
+            ESP32I2cBus(uint8_t sdaPin, uint8_t sclPin, uint32_t frequencyHz, TwoWire &wire = Wire);
+
+            void begin() override;
+            bool transfer(uint8_t address,
+                          const uint8_t *writeData, size_t writeLength,
+                          uint8_t *readData, size_t readLength) override;
+
+        private:
+            const uint8_t _sdaPin;
+            const uint8_t _sclPin;
+            const uint32_t _frequencyHz;
+            TwoWire &_wire;
+        };
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <soc/esp32/DebounceFilter.h>
+
+namespace soc
+{
+    namespace esp32
+    {
+        /**
+         * @brief Samples a set of input pins at a fixed rate and debounces them.
+         *
+         * On the target a periodic esp_timer reads all pins with one register read
+         * (FastGpio) and runs the DebounceFilter. The loop reads the published states,
+         * a single 32 bit word per pin, so it needs no lock. On native there is no timer,
+         * the tests call sampleNow() as the virtual clock advances.
+         */
+        class ESP32InputSampler
+        {
+        public:
+            ESP32InputSampler(uint64_t pins, uint32_t samplePeriodMicros, DebounceFilter::Config config);
+            ~ESP32InputSampler();
+
+            /**
+             * @brief Takes the first sample and starts the timer. Configure the pins first.
+             */
+            void begin();
+
+            /**
+             * @brief Reads and filters all pins once, called by the timer.
+             */
+            void sampleNow();
+
+            /**
+             * @brief Debounced level of a pin.
+             */
+            bool isHigh(uint8_t pin) const;
+
+            uint32_t getSamplePeriodMicros() const;
+            const DebounceFilter &getFilter() const;
+
+        private:
+            DebounceFilter _filter;
+            const uint32_t _samplePeriodMicros;
+            volatile uint32_t _published[2]; // GPIO 0-31 and 32-63
+            void *_timer;                    // esp_timer_handle_t on the target
+
+            static void onTimer(void *sampler);
+        };
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+#include <soc/api/IPwmOutput.h>
+
+namespace soc
+{
+    namespace esp32
+    {
+        /**
+         * @brief PWM output on one channel of the LEDC peripheral, 10 bit resolution.
+         *
+         * Used on the enable pin of a stepper driver to chop the coil current while the
+         * motor holds its position, see AccelStepperMotor::PowerConfig. The frequency
+         * should be above the audible range and well above the chopper of the driver.
+         */
+        class ESP32LedcPwmOutput : public soc::api::IPwmOutput
+        {
+        public:
+            static const uint8_t RESOLUTION_BITS = 10;
+
+            ESP32LedcPwmOutput(uint8_t pin, uint8_t channel, uint32_t frequencyHz = 25000, bool activeLow = false);
+
+            void begin() override;
+            void setDuty(uint16_t duty) override;
+
+            uint16_t getDuty() const;
+
+        private:
+            const uint8_t _pin;
+            const uint8_t _channel;
+            const uint32_t _frequencyHz;
+            const bool _activeLow;
+            uint16_t _duty;
+        };
+    }
+}
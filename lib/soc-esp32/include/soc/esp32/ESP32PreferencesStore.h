@@ -0,0 +1,32 @@
+#pragma once
+#include <Preferences.h>
+#include <soc/api/IPersistentStore.h>
+
+namespace soc
+{
+    namespace esp32
+    {
+        /**
+         * @brief Records in a namespace of the NVS partition through the Preferences library.
+         * NVS spreads the writes over its pages, a record a day does not wear the flash.
+         */
+        class ESP32PreferencesStore : public soc::api::IPersistentStore
+        {
+        public:
+            /**
+             * @param nameSpace At most 15 characters, must outlive the store.
+             */
+            explicit ESP32PreferencesStore(const char *nameSpace);
+            virtual ~ESP32PreferencesStore();
+
+            bool begin() override;
+            bool load(const char *key, void *data, size_t size) override;
+            bool save(const char *key, const void *data, size_t size) override;
+
+        private:
+            const char *_nameSpace;
+            Preferences _preferences;
+            bool _open;
+        };
+    }
+}
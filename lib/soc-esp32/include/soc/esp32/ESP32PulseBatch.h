@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+
+namespace soc
+{
+    namespace esp32
+    {
+        /**
+         * @brief Collects the pins that pulse in one loop and pulses them together.
+         *
+         * flush() raises all collected pins with one register write, holds them for the
+         * pulse width and lowers them with another, see FastGpio. Used for the step pins of
+         * several motors, so they step simultaneously and pay for the pulse width once.
+         */
+        class ESP32PulseBatch
+        {
+        public:
+            explicit ESP32PulseBatch(uint32_t pulseWidthMicros = 1);
+
+            bool isPending(uint64_t pins) const;
+
+            /**
+             * @brief Adds pins to the next pulse. A pin can pulse only once per flush(),
+             * check isPending() and flush first if needed.
+             */
+            void add(uint64_t pins);
+
+            /**
+             * @brief Pulses the collected pins, does nothing if there are none.
+             */
+            void flush();
+
+            unsigned long getPulseCount() const;
+
+        private:
+            const uint32_t _pulseWidthMicros;
+            uint64_t _pending;
+            unsigned long _pulseCount;
+        };
+    }
+}
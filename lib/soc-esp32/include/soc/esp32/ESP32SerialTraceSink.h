@@ -0,0 +1,38 @@
+#pragma once
+
+#include <soc/trace/ITraceSink.h>
+#include <soc/trace/TraceRecorder.h>
+
+namespace soc
+{
+    namespace esp32
+    {
+        /**
+         * @brief Dumps a trace over the primary Serial port as hex lines between marker lines.
+         *
+         * The text framing keeps the dump readable in a serial monitor that also shows
+         * log output. ChromeTraceConverter::extractFromLog() recovers the binary trace
+         * from a captured monitor log. Assumes Serial.begin() has been called elsewhere.
+         */
+        class ESP32SerialTraceSink : public soc::trace::ITraceSink
+        {
+        public:
+            static const char *const BEGIN_MARKER;
+            static const char *const END_MARKER;
+
+            ESP32SerialTraceSink();
+
+            /**
+             * @brief Writes the markers around the serialized recorder.
+             */
+            void dump(const soc::trace::TraceRecorder &recorder);
+
+            void write(const uint8_t *data, size_t length) override;
+
+        private:
+            static const size_t BYTES_PER_LINE = 32;
+
+            size_t _lineLength;
+        };
+    } // namespace esp32
+} // namespace soc
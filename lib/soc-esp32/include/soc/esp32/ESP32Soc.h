@@ -1,18 +1,66 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <vector>
+#include <soc/api/ILogger.h>
 #include <soc/api/ISoc.h>
 #include <soc/api/ISocComponent.h>
+#include <soc/api/SetupScheduler.h>
+#include <soc/trace/BootProfiler.h>
 
 namespace soc
 {
     namespace esp32
     {
-        class ESP32Soc : public soc::api::ISoc
+        /**
+         * @brief Runs its components in the order they were added and tears them down in reverse.
+         *
+         * The components are set up in the order of their dependencies, see
+         * soc::api::SetupScheduler, e.g. several motors homing at once. Until its setup()
+         * was called, a component is neither advanced nor rendered. Each setup, from setup() until the component reports isSetUp(), is a phase of
+         * the boot profiler.
+         *
+         * A soft watchdog, off by default, times every iteration from advanceState() to
+         * the end of render() against loopBudgetMicros, and every component within it
+         * against sliceMicros. An overrun is blamed on the component furthest beyond its
+         * slice, or on the loop outside of the components if none is, e.g. the step pulses
+         * or a blocking Serial in loop(). A blamed non-critical component is degraded for
+         * degradeLoops iterations, see ISocComponent::setDegraded(). While the watchdog is
+         * on, every component costs two micros() per phase.
+         */
+        class ESP32Soc : public soc::api::ISoc, public soc::api::ISetupListener
         {
         public:
-            ESP32Soc();
+            struct WatchdogConfig
+            {
+                unsigned long loopBudgetMicros; // a longer iteration is an overrun, 0 turns the watchdog off
+                unsigned long sliceMicros;      // of one component, advanceState() and render() together
+                unsigned long degradeLoops;     // a blamed non-critical component is degraded this long, 0 never
+            };
+
+            struct WatchdogStats
+            {
+                unsigned long iterations;
+                unsigned long overruns;
+                unsigned long maxIterationMicros;
+                unsigned long unattributedOverruns;        // no component beyond its slice
+                const soc::api::ISocComponent *lastBlamed; // nullptr if unattributed
+                unsigned long lastExcessMicros;            // of the last overrun, beyond the budget of the loop
+            };
+
+            struct ComponentOverruns
+            {
+                unsigned long count;            // overruns blamed on the component
+                unsigned long lastExcessMicros; // beyond its slice, at the last one
+                unsigned long maxExcessMicros;
+                unsigned long maxMicros;        // longest slice the component took, blamed or not
+            };
+
+            /**
+             * @param bootProfiler Records the setups of the components, may be null.
+             */
+            explicit ESP32Soc(soc::trace::BootProfiler *bootProfiler = nullptr);
 
             virtual ~ESP32Soc() override;
 
@@ -22,10 +70,59 @@ namespace soc
 
             void render() override;
 
+            /**
+             * @brief Sets the component up right away if its dependencies are set up,
+             * otherwise in the first loop they are.
+             */
             void addComponent(std::shared_ptr<soc::api::ISocComponent> component) override;
 
+            /**
+             * @brief True once every component is set up.
+             */
+            bool isBooted() const;
+
+            void setWatchdog(const WatchdogConfig &config);
+            const WatchdogStats &getWatchdogStats() const;
+
+            /**
+             * @return False if the component is not one of this soc.
+             */
+            bool getOverruns(const soc::api::ISocComponent &component, ComponentOverruns &overruns) const;
+
+            bool isDegraded(const soc::api::ISocComponent &component) const;
+
+            /**
+             * @brief Logs the overruns of the loop and of every component that overran.
+             */
+            void reportWatchdog(soc::api::ILogger &logger) const;
+
+            // the setups are phases of the boot profiler
+            void onSetupBegun(size_t index) override;
+            void onSetUp(size_t index) override;
+
         private:
-            std::vector<std::shared_ptr<soc::api::ISocComponent>> components;
+            struct Entry
+            {
+                std::shared_ptr<soc::api::ISocComponent> component;
+                int phase;                     // of the boot profiler
+                unsigned long iterationMicros; // taken in the current iteration
+                ComponentOverruns overruns;
+                bool degraded;
+                unsigned long degradedLoops;   // renders left to skip
+            };
+
+            std::vector<Entry> components;
+            soc::trace::BootProfiler *_bootProfiler;
+            soc::api::SetupScheduler _setups; // by the index into components
+
+            WatchdogConfig _watchdog;
+            WatchdogStats _watchdogStats;
+            unsigned long _iterationStartMicros;
+
+            void advanceWatched(unsigned long currentTimeMs);
+            void renderWatched();
+            void checkIteration(unsigned long iterationMicros);
+            const Entry *find(const soc::api::ISocComponent &component) const;
         };
     } // namespace esp32
-} // namespace soc
\ No newline at end of file
+} // namespace soc
@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+#include <SPI.h>
+#include <soc/api/IShiftOutput.h>
+
+namespace soc
+{
+    namespace esp32
+    {
+        /**
+         * @brief 74HC595 chain on the VSPI bus: MOSI to SER, SCK to SRCLK and a GPIO
+         * to RCLK, the latch. All frames of a burst share one SPI transaction.
+         */
+        class ESP32SpiShiftOutput : public soc::api::IShiftOutput
+        {
+        public:
+            ESP32SpiShiftOutput(uint8_t latchPin, uint32_t clockHz, SPIClass &spi = SPI);
+
+            void begin() override;
+            void writeFrames(const uint8_t *frames, size_t frameLength, size_t frameCount) override;
+
+        private:
+            const uint8_t _latchPin;
+            const SPISettings _settings;
+            SPIClass &_spi;
+        };
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <cstdint>
+
+#if defined(ESP32)
+#include <soc/gpio_struct.h>
+#else
+#include <FakeGpioRegisters.h>
+#endif
+
+namespace soc
+{
+    namespace esp32
+    {
+        /**
+         * @brief Direct access to the GPIO output set/clear and input registers.
+         *
+         * GPIO 0-39 are bits of one 64 bit mask, GPIO 0-31 are written through
+         * GPIO_OUT_W1TS/W1TC, GPIO 32-39 through GPIO_OUT1_W1TS/W1TC. All pins of a mask
+         * change with the same register write, without the pin lookup of digitalWrite().
+         * The pins must be configured with pinMode() beforehand. On native the registers
+         * are FakeGpioRegisters of the arduino mock.
+         */
+        class FastGpio
+        {
+        public:
+            static constexpr uint64_t mask(uint8_t pin)
+            {
+                return 1ULL << pin;
+            }
+
+            static inline void set(uint64_t pins)
+            {
+#if defined(ESP32)
+                uint32_t low = static_cast<uint32_t>(pins);
+                uint32_t high = static_cast<uint32_t>(pins >> 32);
+                if (low)
+                {
+                    GPIO.out_w1ts = low;
+                }
+                if (high)
+                {
+                    GPIO.out1_w1ts.val = high;
+                }
+#else
+                fakeGpioRegisters().writeSet(pins);
+#endif
+            }
+
+            static inline void clear(uint64_t pins)
+            {
+#if defined(ESP32)
+                uint32_t low = static_cast<uint32_t>(pins);
+                uint32_t high = static_cast<uint32_t>(pins >> 32);
+                if (low)
+                {
+                    GPIO.out_w1tc = low;
+                }
+                if (high)
+                {
+                    GPIO.out1_w1tc.val = high;
+                }
+#else
+                fakeGpioRegisters().writeClear(pins);
+#endif
+            }
+
+            static inline void write(uint64_t pins, bool high)
+            {
+                if (high)
+                {
+                    set(pins);
+                }
+                else
+                {
+                    clear(pins);
+                }
+            }
+
+            /**
+             * @brief Levels of all pins, reading back outputs as well as inputs.
+             */
+            static inline uint64_t read()
+            {
+#if defined(ESP32)
+                return static_cast<uint64_t>(GPIO.in) | (static_cast<uint64_t>(GPIO.in1.val) << 32);
+#else
+                return fakeGpioRegisters().readInputs();
+#endif
+            }
+        };
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "soc/api/ILogger.h"
+#include <cstdarg>
+#include <cstddef>
+
+namespace soc
+{
+    namespace esp32
+    {
+        /**
+         * @brief ILogger decorator that drops trace, debug and info messages while throttled.
+         *
+         * Give a non-critical component its own instance and throttle it from
+         * ISocComponent::setDegraded(), a logger that blocks on Serial then no longer
+         * stretches the loop. Warnings and errors always pass. The dropped messages are
+         * counted and reported once the throttle is lifted.
+         */
+        class ThrottledLogger : public soc::api::ILogger
+        {
+        public:
+            static const size_t MESSAGE_SIZE = 256;
+
+            explicit ThrottledLogger(soc::api::ILogger &target);
+            virtual ~ThrottledLogger() override = default;
+
+            void setThrottled(bool throttled);
+            bool isThrottled() const;
+
+            /**
+             * @brief Messages dropped since the throttle was last set.
+             */
+            unsigned long getDroppedCount() const;
+
+#ifdef __GNUC__
+            __attribute__((format(printf, 2, 3)))
+#endif
+            void
+            trace(const char *format, ...) override;
+
+#ifdef __GNUC__
+            __attribute__((format(printf, 2, 3)))
+#endif
+            void
+            debug(const char *format, ...) override;
+
+#ifdef __GNUC__
+            __attribute__((format(printf, 2, 3)))
+#endif
+            void
+            info(const char *format, ...) override;
+
+#ifdef __GNUC__
+            __attribute__((format(printf, 2, 3)))
+#endif
+            void
+            warn(const char *format, ...) override;
+
+#ifdef __GNUC__
+            __attribute__((format(printf, 2, 3)))
+#endif
+            void
+            error(const char *format, ...) override;
+
+        private:
+            soc::api::ILogger &_target;
+            bool _throttled;
+            unsigned long _dropped;
+
+            // formats here, the target only takes variadic arguments
+            void forward(LogLevel level, const char *format, va_list args);
+        };
+    }
+}
@@ -0,0 +1,119 @@
+#include <soc/esp32/DebounceFilter.h>
+
+namespace soc
+{
+    namespace esp32
+    {
+        DebounceFilter::DebounceFilter(uint64_t pins, Config config)
+            : _pins(pins),
+              _mode(config.mode),
+              _threshold(config.threshold < 1 ? 1 : (config.threshold > HISTORY_LENGTH ? HISTORY_LENGTH : config.threshold)),
+              _history{},
+              _newest(0),
+              _counter{},
+              _states(0),
+              _sampleCount(0)
+        {
+        }
+
+        void DebounceFilter::sample(uint64_t levels)
+        {
+            levels &= _pins;
+            if (_sampleCount++ == 0)
+            {
+                prime(levels);
+                return;
+            }
+
+            _newest = (_newest + 1) % HISTORY_LENGTH;
+            _history[_newest] = levels;
+            if (_mode == Mode::INTEGRATOR)
+            {
+                integrate(levels);
+            }
+            else
+            {
+                countConsecutive();
+            }
+        }
+
+        void DebounceFilter::prime(uint64_t levels)
+        {
+            for (uint64_t &sample : _history)
+            {
+                sample = levels;
+            }
+            for (uint8_t bit = 0; bit < COUNTER_BITS; bit++)
+            {
+                _counter[bit] = (_threshold >> bit) & 1 ? levels : 0;
+            }
+            _states = levels;
+        }
+
+        uint64_t DebounceFilter::counterEquals(uint8_t value) const
+        {
+            uint64_t equal = _pins;
+            for (uint8_t bit = 0; bit < COUNTER_BITS; bit++)
+            {
+                equal &= (value >> bit) & 1 ? _counter[bit] : ~_counter[bit];
+            }
+            return equal;
+        }
+
+        void DebounceFilter::integrate(uint64_t levels)
+        {
+            uint64_t atMax = counterEquals(_threshold);
+            uint64_t atZero = counterEquals(0);
+
+            // ripple increment and decrement, one plane after the other
+            uint64_t carry = levels & ~atMax;
+            uint64_t borrow = ~levels & _pins & ~atZero;
+            for (uint8_t bit = 0; bit < COUNTER_BITS; bit++)
+            {
+                uint64_t plane = _counter[bit];
+                _counter[bit] = plane ^ carry ^ borrow;
+                carry &= plane;
+                borrow &= ~plane;
+            }
+
+            _states |= counterEquals(_threshold);
+            _states &= ~counterEquals(0);
+        }
+
+        void DebounceFilter::countConsecutive()
+        {
+            uint64_t allHigh = _pins;
+            uint64_t allLow = _pins;
+            uint8_t index = _newest;
+            for (uint8_t i = 0; i < _threshold; i++)
+            {
+                allHigh &= _history[index];
+                allLow &= ~_history[index];
+                index = (index + HISTORY_LENGTH - 1) % HISTORY_LENGTH;
+            }
+            _states = (_states | allHigh) & ~allLow;
+        }
+
+        uint64_t DebounceFilter::getStates() const
+        {
+            return _states;
+        }
+
+        uint32_t DebounceFilter::getHistory(uint8_t pin) const
+        {
+            uint32_t history = 0;
+            uint8_t index = _newest;
+            for (uint8_t i = 0; i < HISTORY_LENGTH; i++)
+            {
+                history |= static_cast<uint32_t>((_history[index] >> pin) & 1) << i;
+                index = (index + HISTORY_LENGTH - 1) % HISTORY_LENGTH;
+            }
+            return history;
+        }
+
+        unsigned long DebounceFilter::getSampleCount() const
+        {
+            return _sampleCount;
+        }
+    }
+}
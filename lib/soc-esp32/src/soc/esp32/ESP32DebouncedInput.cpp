@@ -0,0 +1,23 @@
+#include <soc/esp32/ESP32DebouncedInput.h>
+#include <Arduino.h>
+
+namespace soc
+{
+    namespace esp32
+    {
+        ESP32DebouncedInput::ESP32DebouncedInput(const ESP32InputSampler &sampler, uint8_t pin, bool activeLow)
+            : _sampler(sampler), _pin(pin), _activeLow(activeLow)
+        {
+        }
+
+        void ESP32DebouncedInput::begin() const
+        {
+            pinMode(_pin, _activeLow ? INPUT_PULLUP : INPUT_PULLDOWN);
+        }
+
+        bool ESP32DebouncedInput::isActive() const
+        {
+            return _sampler.isHigh(_pin) != _activeLow;
+        }
+    }
+}
@@ -1,11 +1,12 @@
 #include <soc/esp32/ESP32DigitalInput.h>
+#include <soc/esp32/FastGpio.h>
 
 namespace soc
 {
     namespace esp32
     {
         ESP32DigitalInput::ESP32DigitalInput(uint8_t pin, bool activeLow)
-            : _pin(pin), _activeLow(activeLow)
+            : _pin(pin), _mask(FastGpio::mask(pin)), _activeLow(activeLow)
         {
         }
 
@@ -20,8 +21,9 @@ namespace soc
 
         bool ESP32DigitalInput::isActive() const
         {
-            int pinState = digitalRead(_pin);
-            return _activeLow ? (pinState == LOW) : (pinState == HIGH);
+            // one register read instead of digitalRead()
+            bool high = (FastGpio::read() & _mask) != 0;
+            return _activeLow ? !high : high;
         }
     }
 }
\ No newline at end of file
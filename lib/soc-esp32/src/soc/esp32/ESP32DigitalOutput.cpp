@@ -1,11 +1,12 @@
 #include <soc/esp32/ESP32DigitalOutput.h>
+#include <soc/esp32/FastGpio.h>
 #include <Arduino.h>
 
 namespace soc
 {
     namespace esp32
     {
-        ESP32DigitalOutput::ESP32DigitalOutput(int pin) : pin(pin)
+        ESP32DigitalOutput::ESP32DigitalOutput(int pin) : pin(pin), mask(FastGpio::mask(static_cast<uint8_t>(pin)))
         {
         }
 
@@ -16,12 +17,12 @@ namespace soc
 
         void ESP32DigitalOutput::on()
         {
-            digitalWrite(pin, HIGH);
+            FastGpio::set(mask);
         }
 
         void ESP32DigitalOutput::off()
         {
-            digitalWrite(pin, LOW);
+            FastGpio::clear(mask);
         }
     }
 }
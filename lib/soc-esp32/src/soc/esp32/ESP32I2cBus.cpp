@@ -0,0 +1,48 @@
+#include <soc/esp32/ESP32I2cBus.h>
+
+namespace soc
+{
+    namespace esp32
+    {
+        ESP32I2cBus::ESP32I2cBus(uint8_t sdaPin, uint8_t sclPin, uint32_t frequencyHz, TwoWire &wire)
+            : _sdaPin(sdaPin),
+              _sclPin(sclPin),
+              _frequencyHz(frequencyHz),
+              _wire(wire)
+        {
+        }
+
+        void ESP32I2cBus::begin()
+        {
+            _wire.begin(_sdaPin, _sclPin, _frequencyHz);
+        }
+
+        bool ESP32I2cBus::transfer(uint8_t address,
+                                   const uint8_t *writeData, size_t writeLength,
+                                   uint8_t *readData, size_t readLength)
+        {
+            if (writeLength > 0)
+            {
+                _wire.beginTransmission(address);
+                _wire.write(writeData, writeLength);
+                // a read follows with a repeated start, the bus stays ours
+                if (_wire.endTransmission(readLength == 0) != 0)
+                {
+                    return false;
+                }
+            }
+            if (readLength > 0)
+            {
+                if (_wire.requestFrom(static_cast<uint16_t>(address), readLength, true) != readLength)
+                {
+                    return false;
+                }
+                for (size_t i = 0; i < readLength; i++)
+                {
+                    readData[i] = static_cast<uint8_t>(_wire.read());
+                }
+            }
+            return true;
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#include <soc/esp32/ESP32InputSampler.h>
+#include <soc/esp32/FastGpio.h>
+
+#if defined(ESP32)
+#include <esp_timer.h>
+#endif
+
+namespace soc
+{
+    namespace esp32
+    {
+        ESP32InputSampler::ESP32InputSampler(uint64_t pins, uint32_t samplePeriodMicros, DebounceFilter::Config config)
+            : _filter(pins, config),
+              _samplePeriodMicros(samplePeriodMicros),
+              _published{0, 0},
+              _timer(nullptr)
+        {
+        }
+
+        ESP32InputSampler::~ESP32InputSampler()
+        {
+#if defined(ESP32)
+            if (_timer)
+            {
+                esp_timer_stop(static_cast<esp_timer_handle_t>(_timer));
+                esp_timer_delete(static_cast<esp_timer_handle_t>(_timer));
+            }
+#endif
+        }
+
+        void ESP32InputSampler::begin()
+        {
+            sampleNow();
+#if defined(ESP32)
+            esp_timer_create_args_t args = {};
+            args.callback = &ESP32InputSampler::onTimer;
+            args.arg = this;
+            args.dispatch_method = ESP_TIMER_TASK;
+            args.name = "inputs";
+            esp_timer_handle_t timer;
+            if (esp_timer_create(&args, &timer) == ESP_OK)
+            {
+                _timer = timer;
+                esp_timer_start_periodic(timer, _samplePeriodMicros);
+            }
+#endif
+        }
+
+        void ESP32InputSampler::onTimer(void *sampler)
+        {
+            static_cast<ESP32InputSampler *>(sampler)->sampleNow();
+        }
+
+        void ESP32InputSampler::sampleNow()
+        {
+            _filter.sample(FastGpio::read());
+            uint64_t states = _filter.getStates();
+            _published[0] = static_cast<uint32_t>(states);
+            _published[1] = static_cast<uint32_t>(states >> 32);
+        }
+
+        bool ESP32InputSampler::isHigh(uint8_t pin) const
+        {
+            return (_published[pin / 32] >> (pin % 32)) & 1;
+        }
+
+        uint32_t ESP32InputSampler::getSamplePeriodMicros() const
+        {
+            return _samplePeriodMicros;
+        }
+
+        const DebounceFilter &ESP32InputSampler::getFilter() const
+        {
+            return _filter;
+        }
+    }
+}
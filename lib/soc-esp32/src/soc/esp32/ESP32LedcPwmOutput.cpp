@@ -0,0 +1,38 @@
+#include <soc/esp32/ESP32LedcPwmOutput.h>
+#include <Arduino.h>
+
+namespace soc
+{
+    namespace esp32
+    {
+        static const uint32_t LEDC_MAX = (1UL << ESP32LedcPwmOutput::RESOLUTION_BITS) - 1;
+
+        ESP32LedcPwmOutput::ESP32LedcPwmOutput(uint8_t pin, uint8_t channel, uint32_t frequencyHz, bool activeLow)
+            : _pin(pin),
+              _channel(channel),
+              _frequencyHz(frequencyHz),
+              _activeLow(activeLow),
+              _duty(0)
+        {
+        }
+
+        void ESP32LedcPwmOutput::begin()
+        {
+            ledcSetup(_channel, _frequencyHz, RESOLUTION_BITS);
+            ledcAttachPin(_pin, _channel);
+            setDuty(_duty);
+        }
+
+        void ESP32LedcPwmOutput::setDuty(uint16_t duty)
+        {
+            _duty = duty < DUTY_FULL ? duty : DUTY_FULL;
+            uint32_t level = (static_cast<uint32_t>(_duty) * LEDC_MAX + DUTY_FULL / 2) / DUTY_FULL;
+            ledcWrite(_channel, _activeLow ? LEDC_MAX - level : level);
+        }
+
+        uint16_t ESP32LedcPwmOutput::getDuty() const
+        {
+            return _duty;
+        }
+    }
+}
@@ -18,6 +18,8 @@ namespace soc
         {
             unsigned long currentMillis = millis();
 
+            time.milliseconds = currentMillis % 1000;
+
             unsigned long totalSeconds = currentMillis / 1000;
 
             time.seconds = totalSeconds % 60;
@@ -0,0 +1,42 @@
+#include <soc/esp32/ESP32PreferencesStore.h>
+
+namespace soc
+{
+    namespace esp32
+    {
+        ESP32PreferencesStore::ESP32PreferencesStore(const char *nameSpace)
+            : _nameSpace(nameSpace),
+              _open(false)
+        {
+        }
+
+        ESP32PreferencesStore::~ESP32PreferencesStore()
+        {
+            if (_open)
+            {
+                _preferences.end();
+            }
+        }
+
+        bool ESP32PreferencesStore::begin()
+        {
+            _open = _preferences.begin(_nameSpace, false);
+            return _open;
+        }
+
+        bool ESP32PreferencesStore::load(const char *key, void *data, size_t size)
+        {
+            // a record of another size is from another version of the firmware
+            if (!_open || _preferences.getBytesLength(key) != size)
+            {
+                return false;
+            }
+            return _preferences.getBytes(key, data, size) == size;
+        }
+
+        bool ESP32PreferencesStore::save(const char *key, const void *data, size_t size)
+        {
+            return _open && _preferences.putBytes(key, data, size) == size;
+        }
+    }
+}
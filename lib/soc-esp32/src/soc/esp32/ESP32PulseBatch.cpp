@@ -0,0 +1,44 @@
+#include <soc/esp32/ESP32PulseBatch.h>
+#include <soc/esp32/FastGpio.h>
+#include <Arduino.h>
+
+namespace soc
+{
+    namespace esp32
+    {
+        ESP32PulseBatch::ESP32PulseBatch(uint32_t pulseWidthMicros)
+            : _pulseWidthMicros(pulseWidthMicros),
+              _pending(0),
+              _pulseCount(0)
+        {
+        }
+
+        bool ESP32PulseBatch::isPending(uint64_t pins) const
+        {
+            return (_pending & pins) != 0;
+        }
+
+        void ESP32PulseBatch::add(uint64_t pins)
+        {
+            _pending |= pins;
+        }
+
+        void ESP32PulseBatch::flush()
+        {
+            if (_pending == 0)
+            {
+                return;
+            }
+            FastGpio::set(_pending);
+            delayMicroseconds(_pulseWidthMicros);
+            FastGpio::clear(_pending);
+            _pending = 0;
+            _pulseCount++;
+        }
+
+        unsigned long ESP32PulseBatch::getPulseCount() const
+        {
+            return _pulseCount;
+        }
+    }
+}
@@ -0,0 +1,43 @@
+#include "soc/esp32/ESP32SerialTraceSink.h"
+#include <Arduino.h>
+
+namespace soc
+{
+    namespace esp32
+    {
+        const char *const ESP32SerialTraceSink::BEGIN_MARKER = "--- soc-trace begin ---";
+        const char *const ESP32SerialTraceSink::END_MARKER = "--- soc-trace end ---";
+
+        ESP32SerialTraceSink::ESP32SerialTraceSink() : _lineLength(0)
+        {
+        }
+
+        void ESP32SerialTraceSink::dump(const soc::trace::TraceRecorder &recorder)
+        {
+            Serial.println("");
+            Serial.println(BEGIN_MARKER);
+            _lineLength = 0;
+            recorder.serialize(*this);
+            if (_lineLength > 0)
+            {
+                Serial.println("");
+            }
+            Serial.println(END_MARKER);
+        }
+
+        void ESP32SerialTraceSink::write(const uint8_t *data, size_t length)
+        {
+            static const char HEX_DIGITS[] = "0123456789abcdef";
+            for (size_t i = 0; i < length; i++)
+            {
+                char hex[3] = {HEX_DIGITS[data[i] >> 4], HEX_DIGITS[data[i] & 0x0F], '\0'};
+                Serial.print(hex);
+                if (++_lineLength == BYTES_PER_LINE)
+                {
+                    Serial.println("");
+                    _lineLength = 0;
+                }
+            }
+        }
+    } // namespace esp32
+} // namespace soc
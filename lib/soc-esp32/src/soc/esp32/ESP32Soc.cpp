@@ -5,17 +5,22 @@ namespace soc
 {
     namespace esp32
     {
-        ESP32Soc::ESP32Soc()
+        ESP32Soc::ESP32Soc(soc::trace::BootProfiler *bootProfiler)
+            : _bootProfiler(bootProfiler),
+              _setups(this),
+              _watchdog{0, 0, 0},
+              _watchdogStats{0, 0, 0, 0, nullptr, 0},
+              _iterationStartMicros(0)
         {
         }
 
         ESP32Soc::~ESP32Soc()
         {
-            for (auto it = components.rbegin(); it != components.rend(); ++it)
+            for (size_t i = components.size(); i-- > 0;)
             {
-                if (*it)
+                if (_setups.isStarted(i))
                 {
-                    (*it)->teardown();
+                    components[i].component->teardown();
                 }
             }
             components.clear();
@@ -27,22 +32,38 @@ namespace soc
 
         void ESP32Soc::advanceState(unsigned long currentTimeMs)
         {
-            for (auto &component : components)
+            if (_watchdog.loopBudgetMicros > 0)
             {
-                if (component)
+                advanceWatched(currentTimeMs);
+            }
+            else
+            {
+                for (size_t i = 0; i < components.size(); i++)
                 {
-                    component->advanceState(currentTimeMs);
+                    if (_setups.isStarted(i))
+                    {
+                        components[i].component->advanceState(currentTimeMs);
+                    }
                 }
             }
+            if (!_setups.isDone())
+            {
+                _setups.advance();
+            }
         }
 
         void ESP32Soc::render()
         {
-            for (auto &component : components)
+            if (_watchdog.loopBudgetMicros > 0)
+            {
+                renderWatched();
+                return;
+            }
+            for (size_t i = 0; i < components.size(); i++)
             {
-                if (component)
+                if (_setups.isStarted(i))
                 {
-                    component->render();
+                    components[i].component->render();
                 }
             }
         }
@@ -51,8 +72,9 @@ namespace soc
         {
             if (component)
             {
-                component->setup();
-                components.push_back(component);
+                components.push_back(Entry{component, soc::trace::BootProfiler::NO_PHASE,
+                                           0, {0, 0, 0, 0}, false, 0});
+                _setups.add(*component);
             }
             else
             {
@@ -60,5 +82,204 @@ namespace soc
             }
         }
 
+        bool ESP32Soc::isBooted() const
+        {
+            return _setups.isDone();
+        }
+
+        void ESP32Soc::setWatchdog(const WatchdogConfig &config)
+        {
+            _watchdog = config;
+            if (config.loopBudgetMicros > 0 && config.degradeLoops > 0)
+            {
+                return;
+            }
+            for (auto &entry : components)
+            {
+                if (entry.degraded)
+                {
+                    entry.degraded = false;
+                    entry.degradedLoops = 0;
+                    entry.component->setDegraded(false);
+                }
+            }
+        }
+
+        const ESP32Soc::WatchdogStats &ESP32Soc::getWatchdogStats() const
+        {
+            return _watchdogStats;
+        }
+
+        bool ESP32Soc::getOverruns(const soc::api::ISocComponent &component, ComponentOverruns &overruns) const
+        {
+            const Entry *entry = find(component);
+            if (entry == nullptr)
+            {
+                return false;
+            }
+            overruns = entry->overruns;
+            return true;
+        }
+
+        bool ESP32Soc::isDegraded(const soc::api::ISocComponent &component) const
+        {
+            const Entry *entry = find(component);
+            return entry != nullptr && entry->degraded;
+        }
+
+        void ESP32Soc::reportWatchdog(soc::api::ILogger &logger) const
+        {
+            logger.info("Watchdog: %lu overruns in %lu loops, the longest took %lu us of %lu us.",
+                        _watchdogStats.overruns, _watchdogStats.iterations,
+                        _watchdogStats.maxIterationMicros, _watchdog.loopBudgetMicros);
+            if (_watchdogStats.unattributedOverruns > 0)
+            {
+                logger.info("Watchdog: %lu overruns outside of the components.", _watchdogStats.unattributedOverruns);
+            }
+            for (const Entry &entry : components)
+            {
+                if (entry.overruns.count > 0)
+                {
+                    logger.info("Watchdog: %s overran %lu times, up to %lu us beyond its slice, the longest took %lu us.",
+                                entry.component->getName(), entry.overruns.count,
+                                entry.overruns.maxExcessMicros, entry.overruns.maxMicros);
+                }
+            }
+        }
+
+        void ESP32Soc::advanceWatched(unsigned long currentTimeMs)
+        {
+            _iterationStartMicros = micros();
+            unsigned long start = _iterationStartMicros;
+            for (size_t i = 0; i < components.size(); i++)
+            {
+                Entry &entry = components[i];
+                entry.iterationMicros = 0;
+                if (_setups.isStarted(i))
+                {
+                    entry.component->advanceState(currentTimeMs);
+                    unsigned long end = micros();
+                    entry.iterationMicros = end - start;
+                    start = end;
+                }
+            }
+        }
+
+        void ESP32Soc::renderWatched()
+        {
+            unsigned long start = micros();
+            for (size_t i = 0; i < components.size(); i++)
+            {
+                Entry &entry = components[i];
+                if (!_setups.isStarted(i))
+                {
+                    continue;
+                }
+                if (entry.degraded && entry.degradedLoops > 0)
+                {
+                    entry.degradedLoops--;
+                    continue;
+                }
+                entry.component->render();
+                unsigned long end = micros();
+                entry.iterationMicros += end - start;
+                start = end;
+            }
+            checkIteration(micros() - _iterationStartMicros);
+        }
+
+        void ESP32Soc::checkIteration(unsigned long iterationMicros)
+        {
+            _watchdogStats.iterations++;
+            if (iterationMicros > _watchdogStats.maxIterationMicros)
+            {
+                _watchdogStats.maxIterationMicros = iterationMicros;
+            }
+
+            // the component furthest beyond its slice is to blame
+            Entry *blamed = nullptr;
+            unsigned long blamedExcess = 0;
+            for (auto &entry : components)
+            {
+                if (entry.iterationMicros > entry.overruns.maxMicros)
+                {
+                    entry.overruns.maxMicros = entry.iterationMicros;
+                }
+                if (entry.iterationMicros > _watchdog.sliceMicros &&
+                    entry.iterationMicros - _watchdog.sliceMicros > blamedExcess)
+                {
+                    blamed = &entry;
+                    blamedExcess = entry.iterationMicros - _watchdog.sliceMicros;
+                }
+            }
+
+            if (iterationMicros > _watchdog.loopBudgetMicros)
+            {
+                _watchdogStats.overruns++;
+                _watchdogStats.lastExcessMicros = iterationMicros - _watchdog.loopBudgetMicros;
+                _watchdogStats.lastBlamed = blamed ? blamed->component.get() : nullptr;
+                if (blamed == nullptr)
+                {
+                    _watchdogStats.unattributedOverruns++;
+                }
+                else
+                {
+                    blamed->overruns.count++;
+                    blamed->overruns.lastExcessMicros = blamedExcess;
+                    if (blamedExcess > blamed->overruns.maxExcessMicros)
+                    {
+                        blamed->overruns.maxExcessMicros = blamedExcess;
+                    }
+                    if (_watchdog.degradeLoops > 0 && !blamed->component->isCritical())
+                    {
+                        blamed->degradedLoops = _watchdog.degradeLoops;
+                        if (!blamed->degraded)
+                        {
+                            blamed->degraded = true;
+                            blamed->component->setDegraded(true);
+                        }
+                    }
+                }
+            }
+
+            // the ones that skipped their last render are back
+            for (auto &entry : components)
+            {
+                if (entry.degraded && entry.degradedLoops == 0)
+                {
+                    entry.degraded = false;
+                    entry.component->setDegraded(false);
+                }
+            }
+        }
+
+        const ESP32Soc::Entry *ESP32Soc::find(const soc::api::ISocComponent &component) const
+        {
+            for (const Entry &entry : components)
+            {
+                if (entry.component.get() == &component)
+                {
+                    return &entry;
+                }
+            }
+            return nullptr;
+        }
+
+        void ESP32Soc::onSetupBegun(size_t index)
+        {
+            if (_bootProfiler)
+            {
+                components[index].phase = _bootProfiler->begin(components[index].component->getName());
+            }
+        }
+
+        void ESP32Soc::onSetUp(size_t index)
+        {
+            if (_bootProfiler)
+            {
+                _bootProfiler->end(components[index].phase);
+            }
+        }
+
     } // namespace esp32
-} // namespace soc
\ No newline at end of file
+} // namespace soc
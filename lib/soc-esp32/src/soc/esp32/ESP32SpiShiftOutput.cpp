@@ -0,0 +1,35 @@
+#include <soc/esp32/ESP32SpiShiftOutput.h>
+#include <Arduino.h>
+
+namespace soc
+{
+    namespace esp32
+    {
+        ESP32SpiShiftOutput::ESP32SpiShiftOutput(uint8_t latchPin, uint32_t clockHz, SPIClass &spi)
+            : _latchPin(latchPin),
+              _settings(clockHz, MSBFIRST, SPI_MODE0),
+              _spi(spi)
+        {
+        }
+
+        void ESP32SpiShiftOutput::begin()
+        {
+            pinMode(_latchPin, OUTPUT);
+            digitalWrite(_latchPin, LOW);
+            _spi.begin();
+        }
+
+        void ESP32SpiShiftOutput::writeFrames(const uint8_t *frames, size_t frameLength, size_t frameCount)
+        {
+            _spi.beginTransaction(_settings);
+            for (size_t frame = 0; frame < frameCount; frame++)
+            {
+                _spi.writeBytes(frames + frame * frameLength, frameLength);
+                // the 74HC595 copies its shift register to the outputs on the rising edge of RCLK
+                digitalWrite(_latchPin, HIGH);
+                digitalWrite(_latchPin, LOW);
+            }
+            _spi.endTransaction();
+        }
+    }
+}
@@ -0,0 +1,114 @@
+#include "soc/esp32/ThrottledLogger.h"
+#include <cstdio>
+
+namespace soc
+{
+    namespace esp32
+    {
+        const size_t ThrottledLogger::MESSAGE_SIZE;
+
+        ThrottledLogger::ThrottledLogger(soc::api::ILogger &target)
+            : _target(target),
+              _throttled(false),
+              _dropped(0)
+        {
+        }
+
+        void ThrottledLogger::setThrottled(bool throttled)
+        {
+            if (throttled == _throttled)
+            {
+                return;
+            }
+            _throttled = throttled;
+            if (throttled)
+            {
+                _dropped = 0;
+            }
+            else if (_dropped > 0)
+            {
+                _target.info("%lu messages dropped while throttled.", _dropped);
+            }
+        }
+
+        bool ThrottledLogger::isThrottled() const
+        {
+            return _throttled;
+        }
+
+        unsigned long ThrottledLogger::getDroppedCount() const
+        {
+            return _dropped;
+        }
+
+        void ThrottledLogger::trace(const char *format, ...)
+        {
+            va_list args;
+            va_start(args, format);
+            forward(TRACE_LEVEL, format, args);
+            va_end(args);
+        }
+
+        void ThrottledLogger::debug(const char *format, ...)
+        {
+            va_list args;
+            va_start(args, format);
+            forward(DEBUG_LEVEL, format, args);
+            va_end(args);
+        }
+
+        void ThrottledLogger::info(const char *format, ...)
+        {
+            va_list args;
+            va_start(args, format);
+            forward(INFO_LEVEL, format, args);
+            va_end(args);
+        }
+
+        void ThrottledLogger::warn(const char *format, ...)
+        {
+            va_list args;
+            va_start(args, format);
+            forward(WARN_LEVEL, format, args);
+            va_end(args);
+        }
+
+        void ThrottledLogger::error(const char *format, ...)
+        {
+            va_list args;
+            va_start(args, format);
+            forward(ERROR_LEVEL, format, args);
+            va_end(args);
+        }
+
+        void ThrottledLogger::forward(LogLevel level, const char *format, va_list args)
+        {
+            if (_throttled && level < WARN_LEVEL)
+            {
+                _dropped++;
+                return;
+            }
+
+            char message[MESSAGE_SIZE];
+            vsnprintf(message, sizeof(message), format, args);
+            switch (level)
+            {
+            case TRACE_LEVEL:
+                _target.trace("%s", message);
+                break;
+            case DEBUG_LEVEL:
+                _target.debug("%s", message);
+                break;
+            case INFO_LEVEL:
+                _target.info("%s", message);
+                break;
+            case WARN_LEVEL:
+                _target.warn("%s", message);
+                break;
+            default:
+                _target.error("%s", message);
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <soc/api/IDigitalInput.h>
+#include <string>
+
+namespace soc
+{
+    namespace posix
+    {
+        /**
+         * @brief Stand-in for a digital input, set by the process or through a named pipe.
+         *
+         * Without a pipe the state lives in memory and setActive() changes it. With a
+         * pipe, begin() creates it if needed and opens it without blocking, and every
+         * '1' or '0' written to it activates or releases the input:
+         *
+         *   echo 1 > /tmp/limit-switch
+         *
+         * isActive() reads what arrived since the last call, the last character wins.
+         */
+        class PosixDigitalInput : public soc::api::IDigitalInput
+        {
+        public:
+            explicit PosixDigitalInput(bool active = false);
+
+            /**
+             * @param fifoPath Named pipe controlling the input.
+             */
+            explicit PosixDigitalInput(const char *fifoPath, bool active = false);
+
+            virtual ~PosixDigitalInput() override;
+
+            PosixDigitalInput(const PosixDigitalInput &) = delete;
+            PosixDigitalInput &operator=(const PosixDigitalInput &) = delete;
+
+            void begin() const override;
+            bool isActive() const override;
+
+            void setActive(bool active);
+
+            /**
+             * @return False if the pipe could not be opened, the input then keeps its state.
+             */
+            bool isPipeOpen() const;
+
+        private:
+            const std::string _fifoPath;
+            mutable int _fd;
+            mutable bool _active;
+        };
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <soc/api/IDigitalOutput.h>
+#include <string>
+
+namespace soc
+{
+    namespace posix
+    {
+        /**
+         * @brief Stand-in for a digital output, kept in memory and optionally reported
+         * through a named pipe.
+         *
+         * With a pipe, every change writes a line "1" or "0" to it, to be followed with
+         *
+         *   cat /tmp/led
+         *
+         * Changes without a reader are dropped, the output never blocks the loop. The
+         * process should ignore SIGPIPE, a reader going away then only closes the pipe.
+         */
+        class PosixDigitalOutput : public soc::api::IDigitalOutput
+        {
+        public:
+            PosixDigitalOutput();
+
+            /**
+             * @param fifoPath Named pipe reporting the output.
+             */
+            explicit PosixDigitalOutput(const char *fifoPath);
+
+            virtual ~PosixDigitalOutput() override;
+
+            PosixDigitalOutput(const PosixDigitalOutput &) = delete;
+            PosixDigitalOutput &operator=(const PosixDigitalOutput &) = delete;
+
+            void begin() const override;
+            void on() override;
+            void off() override;
+
+            bool isOn() const;
+
+            /**
+             * @brief Number of on()/off() calls that changed the output.
+             */
+            unsigned long getChangeCount() const;
+
+        private:
+            const std::string _fifoPath;
+            mutable int _fd;
+            bool _on;
+            unsigned long _changes;
+
+            void set(bool on);
+            bool openPipe() const;
+        };
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "soc/api/ILogger.h"
+#include <cstdarg>
+#include <cstdio>
+
+namespace soc
+{
+    namespace posix
+    {
+        /**
+         * @brief ILogger writing to stdout or to a file, buffered.
+         *
+         * Same format as the ESP32Logger. Messages collect in a buffer of the logger and
+         * reach the file in blocks, so logging costs no system call per message. Warnings
+         * and errors flush the buffer, they must not get lost when the process dies.
+         * Longer messages than the buffer are truncated.
+         */
+        class PosixLogger : public soc::api::ILogger
+        {
+        public:
+            static const size_t BUFFER_SIZE = 16384;
+
+            /**
+             * @brief Logs to stdout.
+             */
+            PosixLogger(LogLevel minLogLevel = WARN_LEVEL);
+
+            /**
+             * @brief Logs to a file, appending to it. Falls back to stdout if it cannot be opened.
+             */
+            PosixLogger(const char *fileName, LogLevel minLogLevel = WARN_LEVEL);
+
+            virtual ~PosixLogger() override;
+
+            PosixLogger(const PosixLogger &) = delete;
+            PosixLogger &operator=(const PosixLogger &) = delete;
+
+            // Printf-style formatted logging methods
+// The __attribute__ provides compile-time format string checking on GCC/Clang.
+#ifdef __GNUC__
+            __attribute__((format(printf, 2, 3)))
+#endif
+            void
+            trace(const char *format, ...) override;
+
+#ifdef __GNUC__
+            __attribute__((format(printf, 2, 3)))
+#endif
+            void
+            debug(const char *format, ...) override;
+
+#ifdef __GNUC__
+            __attribute__((format(printf, 2, 3)))
+#endif
+            void
+            info(const char *format, ...) override;
+
+#ifdef __GNUC__
+            __attribute__((format(printf, 2, 3)))
+#endif
+            void
+            warn(const char *format, ...) override;
+
+#ifdef __GNUC__
+            __attribute__((format(printf, 2, 3)))
+#endif
+            void
+            error(const char *format, ...) override;
+
+            /**
+             * @brief Writes the buffered messages out.
+             */
+            void flush();
+
+            /**
+             * @return False if the log file could not be opened and the logger writes to stdout.
+             */
+            bool isLoggingToFile() const;
+
+        protected:
+            /**
+             * @brief Helper to perform the actual buffered write.
+             * @param level The log level for the message.
+             * @param format The printf-style format string.
+             * @param args The variable argument list.
+             */
+            void _log_formatted(LogLevel level, const char *format, va_list args);
+
+        private:
+            LogLevel minLogLevel;
+            FILE *_file;
+            bool _ownsFile;
+            char _buffer[BUFFER_SIZE];
+            size_t _used;
+
+            bool appendText(const char *text);
+            bool appendFormatted(const char *format, va_list args);
+        };
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <soc/api/ISleeper.h>
+
+namespace soc
+{
+    namespace posix
+    {
+        /**
+         * @brief ISleeper on clock_nanosleep() and the monotonic clock.
+         *
+         * Sleeps until an absolute deadline, so a signal interrupting the sleep does not
+         * stretch it. With the time scale of a PosixSteadyTime the sleep lasts the same
+         * scaled time.
+         */
+        class PosixSleeper : public soc::api::ISleeper
+        {
+        public:
+            explicit PosixSleeper(double timeScale = 1.0);
+            void sleep(uint32_t millis) override;
+
+            /**
+             * @brief Sleeps for a number of scaled microseconds.
+             */
+            void sleepMicros(uint64_t micros);
+
+        private:
+            const double _timeScale;
+        };
+    }
+}
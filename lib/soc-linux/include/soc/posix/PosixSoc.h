@@ -0,0 +1,48 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <soc/api/ISoc.h>
+#include <soc/api/ISocComponent.h>
+#include <soc/api/SetupScheduler.h>
+
+namespace soc
+{
+    namespace posix
+    {
+        /**
+         * @brief The ESP32Soc for a host process: sets up the components in the order of
+         * their dependencies like it, see soc::api::SetupScheduler, runs them in the order
+         * they were added and tears them down in reverse. It has no loop watchdog and no
+         * boot profiler, the host times the loop itself.
+         */
+        class PosixSoc : public soc::api::ISoc
+        {
+        public:
+            PosixSoc();
+
+            virtual ~PosixSoc() override;
+
+            void processInput() override;
+
+            void advanceState(unsigned long currentTimeMs) override;
+
+            void render() override;
+
+            /**
+             * @brief Sets the component up right away if its dependencies are set up,
+             * otherwise in the first loop they are.
+             */
+            void addComponent(std::shared_ptr<soc::api::ISocComponent> component) override;
+
+            /**
+             * @brief True once every component is set up.
+             */
+            bool isBooted() const;
+
+        private:
+            std::vector<std::shared_ptr<soc::api::ISocComponent>> components;
+            soc::api::SetupScheduler _setups; // by the index into components
+        };
+    } // namespace posix
+} // namespace soc
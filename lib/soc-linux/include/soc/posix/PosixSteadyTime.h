@@ -0,0 +1,43 @@
+#pragma once
+
+#include <soc/api/ITime.h>
+#include <chrono>
+#include <cstdint>
+
+namespace soc
+{
+    namespace posix
+    {
+        /**
+         * @brief ITime on the monotonic clock of the host, for running the firmware as a process.
+         *
+         * Counts from construction, like millis() counts from boot. A time scale above 1
+         * lets the time pass faster than the wall clock, so a soak test covers a day in
+         * minutes. Setting the host clock does not affect it.
+         */
+        class PosixSteadyTime : public soc::api::ITime
+        {
+        public:
+            /**
+             * @param timeScale Seconds of time per second of wall clock, 1 for real time.
+             */
+            explicit PosixSteadyTime(double timeScale = 1.0);
+            virtual ~PosixSteadyTime() = default;
+
+            unsigned long now() override;
+            bool asTimeComponents(TimeComponents &time) override;
+
+            /**
+             * @brief Scaled time since construction in microseconds, the process feeds it
+             * to the Arduino time of the libraries.
+             */
+            uint64_t nowMicros() const;
+
+            double getTimeScale() const;
+
+        private:
+            const std::chrono::steady_clock::time_point _start;
+            const double _timeScale;
+        };
+    }
+}
@@ -0,0 +1,80 @@
+#include <soc/posix/PosixDigitalInput.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace soc
+{
+    namespace posix
+    {
+        PosixDigitalInput::PosixDigitalInput(bool active)
+            : _fd(-1),
+              _active(active)
+        {
+        }
+
+        PosixDigitalInput::PosixDigitalInput(const char *fifoPath, bool active)
+            : _fifoPath(fifoPath ? fifoPath : ""),
+              _fd(-1),
+              _active(active)
+        {
+        }
+
+        PosixDigitalInput::~PosixDigitalInput()
+        {
+            if (_fd >= 0)
+            {
+                close(_fd);
+            }
+        }
+
+        void PosixDigitalInput::begin() const
+        {
+            if (_fifoPath.empty() || _fd >= 0)
+            {
+                return;
+            }
+            // an existing pipe is fine, open() fails on anything else that is not one
+            mkfifo(_fifoPath.c_str(), 0600);
+            // opened for writing as well, so the pipe never reports the end of the
+            // input when a writer closes it
+            _fd = open(_fifoPath.c_str(), O_RDWR | O_NONBLOCK);
+            struct stat status;
+            if (_fd >= 0 && (fstat(_fd, &status) != 0 || !S_ISFIFO(status.st_mode)))
+            {
+                close(_fd);
+                _fd = -1;
+            }
+        }
+
+        bool PosixDigitalInput::isActive() const
+        {
+            if (_fd >= 0)
+            {
+                char buffer[64];
+                ssize_t count;
+                while ((count = read(_fd, buffer, sizeof(buffer))) > 0)
+                {
+                    for (ssize_t i = 0; i < count; i++)
+                    {
+                        if (buffer[i] == '1' || buffer[i] == '0')
+                        {
+                            _active = buffer[i] == '1';
+                        }
+                    }
+                }
+            }
+            return _active;
+        }
+
+        void PosixDigitalInput::setActive(bool active)
+        {
+            _active = active;
+        }
+
+        bool PosixDigitalInput::isPipeOpen() const
+        {
+            return _fd >= 0;
+        }
+    }
+}
@@ -0,0 +1,94 @@
+#include <soc/posix/PosixDigitalOutput.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace soc
+{
+    namespace posix
+    {
+        PosixDigitalOutput::PosixDigitalOutput()
+            : _fd(-1),
+              _on(false),
+              _changes(0)
+        {
+        }
+
+        PosixDigitalOutput::PosixDigitalOutput(const char *fifoPath)
+            : _fifoPath(fifoPath ? fifoPath : ""),
+              _fd(-1),
+              _on(false),
+              _changes(0)
+        {
+        }
+
+        PosixDigitalOutput::~PosixDigitalOutput()
+        {
+            if (_fd >= 0)
+            {
+                close(_fd);
+            }
+        }
+
+        void PosixDigitalOutput::begin() const
+        {
+            if (!_fifoPath.empty())
+            {
+                mkfifo(_fifoPath.c_str(), 0600);
+                openPipe();
+            }
+        }
+
+        bool PosixDigitalOutput::openPipe() const
+        {
+            if (_fd < 0 && !_fifoPath.empty())
+            {
+                // fails with ENXIO as long as nobody reads the pipe
+                _fd = open(_fifoPath.c_str(), O_WRONLY | O_NONBLOCK);
+            }
+            return _fd >= 0;
+        }
+
+        void PosixDigitalOutput::on()
+        {
+            set(true);
+        }
+
+        void PosixDigitalOutput::off()
+        {
+            set(false);
+        }
+
+        void PosixDigitalOutput::set(bool on)
+        {
+            if (on == _on)
+            {
+                return;
+            }
+            _on = on;
+            _changes++;
+
+            if (openPipe())
+            {
+                const char *line = on ? "1\n" : "0\n";
+                // a full pipe drops the change, a reader that went away closes it
+                if (write(_fd, line, 2) < 0 && errno != EAGAIN)
+                {
+                    close(_fd);
+                    _fd = -1;
+                }
+            }
+        }
+
+        bool PosixDigitalOutput::isOn() const
+        {
+            return _on;
+        }
+
+        unsigned long PosixDigitalOutput::getChangeCount() const
+        {
+            return _changes;
+        }
+    }
+}
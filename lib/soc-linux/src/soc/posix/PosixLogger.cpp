@@ -0,0 +1,210 @@
+#include "soc/posix/PosixLogger.h"
+
+namespace soc
+{
+    namespace posix
+    {
+        /**
+         * @brief The same prefixes as the ESP32Logger, so both logs read alike.
+         */
+        static const char *getLevelString(soc::api::ILogger::LogLevel level)
+        {
+            switch (level)
+            {
+            case soc::api::ILogger::TRACE_LEVEL:
+                return "TRACE: ";
+            case soc::api::ILogger::DEBUG_LEVEL:
+                return "DEBUG: ";
+            case soc::api::ILogger::INFO_LEVEL:
+                return "INFO: ";
+            case soc::api::ILogger::WARN_LEVEL:
+                return "WARN: ";
+            case soc::api::ILogger::ERROR_LEVEL:
+                return "ERROR: ";
+            default:
+                return "LOG: ";
+            }
+        }
+
+        PosixLogger::PosixLogger(LogLevel minLevel)
+            : minLogLevel(minLevel),
+              _file(stdout),
+              _ownsFile(false),
+              _used(0)
+        {
+        }
+
+        PosixLogger::PosixLogger(const char *fileName, LogLevel minLevel)
+            : minLogLevel(minLevel),
+              _file(fileName ? fopen(fileName, "a") : nullptr),
+              _ownsFile(_file != nullptr),
+              _used(0)
+        {
+            if (!_file)
+            {
+                _file = stdout;
+            }
+        }
+
+        PosixLogger::~PosixLogger()
+        {
+            flush();
+            if (_ownsFile)
+            {
+                fclose(_file);
+            }
+        }
+
+        void PosixLogger::flush()
+        {
+            if (_used > 0)
+            {
+                fwrite(_buffer, 1, _used, _file);
+                _used = 0;
+            }
+            fflush(_file);
+        }
+
+        bool PosixLogger::isLoggingToFile() const
+        {
+            return _ownsFile;
+        }
+
+        void PosixLogger::_log_formatted(LogLevel level, const char *format, va_list args)
+        {
+            if (level < minLogLevel)
+            {
+                return;
+            }
+
+            // the whole line goes into the buffer, or the buffer is written out first
+            size_t lineStart = _used;
+            va_list args_copy;
+            va_copy(args_copy, args);
+            bool complete = appendText(getLevelString(level)) && appendFormatted(format, args_copy);
+            va_end(args_copy);
+            if (!complete && lineStart > 0)
+            {
+                _used = lineStart;
+                flush();
+                va_copy(args_copy, args);
+                appendText(getLevelString(level)) && appendFormatted(format, args_copy);
+                va_end(args_copy);
+            }
+            // a truncated message still ends its line
+            if (_used == BUFFER_SIZE)
+            {
+                _used--;
+            }
+            _buffer[_used++] = '\n';
+
+            if (level >= WARN_LEVEL || _used == BUFFER_SIZE)
+            {
+                flush();
+            }
+        }
+
+        bool PosixLogger::appendText(const char *text)
+        {
+            while (*text && _used < BUFFER_SIZE)
+            {
+                _buffer[_used++] = *text++;
+            }
+            return *text == '\0';
+        }
+
+        bool PosixLogger::appendFormatted(const char *format, va_list args)
+        {
+            size_t available = BUFFER_SIZE - _used;
+            int length = vsnprintf(_buffer + _used, available, format, args);
+            if (length < 0)
+            {
+                return appendText("Log formatting error!");
+            }
+            // vsnprintf() always terminates, the terminator takes the last byte of a truncated message
+            if (static_cast<size_t>(length) >= available)
+            {
+                _used = BUFFER_SIZE - 1;
+                return false;
+            }
+            _used += static_cast<size_t>(length);
+            return true;
+        }
+
+        // --- Variadic Methods Implementation ---
+#ifdef __GNUC__
+        __attribute__((format(printf, 2, 3)))
+#endif
+        void
+        PosixLogger::trace(const char *format, ...)
+        {
+            if (TRACE_LEVEL >= minLogLevel)
+            {
+                va_list args;
+                va_start(args, format);
+                _log_formatted(TRACE_LEVEL, format, args);
+                va_end(args);
+            }
+        }
+
+#ifdef __GNUC__
+        __attribute__((format(printf, 2, 3)))
+#endif
+        void
+        PosixLogger::debug(const char *format, ...)
+        {
+            if (DEBUG_LEVEL >= minLogLevel)
+            {
+                va_list args;
+                va_start(args, format);
+                _log_formatted(DEBUG_LEVEL, format, args);
+                va_end(args);
+            }
+        }
+
+#ifdef __GNUC__
+        __attribute__((format(printf, 2, 3)))
+#endif
+        void
+        PosixLogger::info(const char *format, ...)
+        {
+            if (INFO_LEVEL >= minLogLevel)
+            {
+                va_list args;
+                va_start(args, format);
+                _log_formatted(INFO_LEVEL, format, args);
+                va_end(args);
+            }
+        }
+
+#ifdef __GNUC__
+        __attribute__((format(printf, 2, 3)))
+#endif
+        void
+        PosixLogger::warn(const char *format, ...)
+        {
+            if (WARN_LEVEL >= minLogLevel)
+            {
+                va_list args;
+                va_start(args, format);
+                _log_formatted(WARN_LEVEL, format, args);
+                va_end(args);
+            }
+        }
+
+#ifdef __GNUC__
+        __attribute__((format(printf, 2, 3)))
+#endif
+        void
+        PosixLogger::error(const char *format, ...)
+        {
+            if (ERROR_LEVEL >= minLogLevel)
+            {
+                va_list args;
+                va_start(args, format);
+                _log_formatted(ERROR_LEVEL, format, args);
+                va_end(args);
+            }
+        }
+    }
+}
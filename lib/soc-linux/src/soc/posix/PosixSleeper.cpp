@@ -0,0 +1,45 @@
+#include <soc/posix/PosixSleeper.h>
+#include <cerrno>
+#include <time.h>
+
+namespace soc
+{
+    namespace posix
+    {
+        static const long NANOS_PER_SECOND = 1000000000L;
+
+        PosixSleeper::PosixSleeper(double timeScale)
+            : _timeScale(timeScale > 0.0 ? timeScale : 1.0)
+        {
+        }
+
+        void PosixSleeper::sleep(uint32_t millis)
+        {
+            sleepMicros(static_cast<uint64_t>(millis) * 1000ULL);
+        }
+
+        void PosixSleeper::sleepMicros(uint64_t micros)
+        {
+            uint64_t nanos = static_cast<uint64_t>(static_cast<double>(micros) * 1000.0 / _timeScale);
+            if (nanos == 0)
+            {
+                return;
+            }
+
+            struct timespec deadline;
+            clock_gettime(CLOCK_MONOTONIC, &deadline);
+            deadline.tv_sec += static_cast<time_t>(nanos / NANOS_PER_SECOND);
+            deadline.tv_nsec += static_cast<long>(nanos % NANOS_PER_SECOND);
+            if (deadline.tv_nsec >= NANOS_PER_SECOND)
+            {
+                deadline.tv_sec++;
+                deadline.tv_nsec -= NANOS_PER_SECOND;
+            }
+
+            // clock_nanosleep() returns the error instead of setting errno
+            while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR)
+            {
+            }
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#include <soc/posix/PosixSoc.h>
+
+namespace soc
+{
+    namespace posix
+    {
+        PosixSoc::PosixSoc()
+        {
+        }
+
+        PosixSoc::~PosixSoc()
+        {
+            for (size_t i = components.size(); i-- > 0;)
+            {
+                if (_setups.isStarted(i))
+                {
+                    components[i]->teardown();
+                }
+            }
+            components.clear();
+        }
+
+        void PosixSoc::processInput()
+        {
+        }
+
+        void PosixSoc::advanceState(unsigned long currentTimeMs)
+        {
+            for (size_t i = 0; i < components.size(); i++)
+            {
+                if (_setups.isStarted(i))
+                {
+                    components[i]->advanceState(currentTimeMs);
+                }
+            }
+            if (!_setups.isDone())
+            {
+                _setups.advance();
+            }
+        }
+
+        void PosixSoc::render()
+        {
+            for (size_t i = 0; i < components.size(); i++)
+            {
+                if (_setups.isStarted(i))
+                {
+                    components[i]->render();
+                }
+            }
+        }
+
+        void PosixSoc::addComponent(std::shared_ptr<soc::api::ISocComponent> component)
+        {
+            if (component)
+            {
+                components.push_back(component);
+                _setups.add(*component);
+            }
+        }
+
+        bool PosixSoc::isBooted() const
+        {
+            return _setups.isDone();
+        }
+
+    } // namespace posix
+} // namespace soc
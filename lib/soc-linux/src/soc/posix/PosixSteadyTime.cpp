@@ -0,0 +1,48 @@
+#include <soc/posix/PosixSteadyTime.h>
+
+namespace soc
+{
+    namespace posix
+    {
+        PosixSteadyTime::PosixSteadyTime(double timeScale)
+            : _start(std::chrono::steady_clock::now()),
+              _timeScale(timeScale > 0.0 ? timeScale : 1.0)
+        {
+        }
+
+        uint64_t PosixSteadyTime::nowMicros() const
+        {
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _start);
+            return static_cast<uint64_t>(static_cast<double>(elapsed.count()) * _timeScale / 1000.0);
+        }
+
+        double PosixSteadyTime::getTimeScale() const
+        {
+            return _timeScale;
+        }
+
+        unsigned long PosixSteadyTime::now()
+        {
+            return static_cast<unsigned long>(nowMicros() / 1000ULL);
+        }
+
+        bool PosixSteadyTime::asTimeComponents(soc::api::ITime::TimeComponents &time)
+        {
+            unsigned long currentMillis = now();
+
+            time.milliseconds = currentMillis % 1000;
+
+            unsigned long totalSeconds = currentMillis / 1000;
+
+            time.seconds = totalSeconds % 60;
+
+            unsigned long totalMinutes = totalSeconds / 60;
+            time.minutes = totalMinutes % 60;
+
+            unsigned long totalHours = totalMinutes / 60;
+            time.hours = totalHours;
+
+            return true;
+        }
+    }
+}
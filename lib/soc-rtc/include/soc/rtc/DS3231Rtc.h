@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <soc/api/II2cBus.h>
+#include <soc/api/IReferenceClock.h>
+
+namespace soc
+{
+    namespace rtc
+    {
+        /**
+         * @brief The registers of a DS3231 class RTC. Every call is a transfer on the bus,
+         * see DS3231Time for a time to query per loop.
+         */
+        class DS3231Rtc : public soc::api::IReferenceClock
+        {
+        public:
+            static const uint8_t I2C_ADDRESS = 0x68;
+
+            explicit DS3231Rtc(soc::api::II2cBus &bus);
+            virtual ~DS3231Rtc() = default;
+
+            /**
+             * @brief Reads the oscillator stop flag. It is set at the first power up and
+             * whenever the oscillator stopped since, the time is invalid until it is set.
+             * @return False if the RTC did not answer.
+             */
+            bool readOscillatorStopped(bool &stopped);
+
+            /**
+             * @brief Reads the time, 24 or 12 hour mode, 2000 to 2199.
+             * @return False if the RTC did not answer or the registers are out of range.
+             */
+            bool readEpochSeconds(uint64_t &epochSeconds);
+
+            /**
+             * @brief The middle of the second the RTC shows. With a stopped oscillator the
+             * time is wrong but its rate is still the one of the RTC.
+             */
+            bool readMillis(uint64_t &epochMillis) override;
+
+            unsigned long getResolutionMs() const override;
+
+        private:
+            soc::api::II2cBus &_bus;
+        };
+    }
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include <soc/api/ILogger.h>
+#include <soc/api/ITime.h>
+#include <soc/rtc/DS3231Rtc.h>
+
+namespace soc
+{
+    namespace rtc
+    {
+        /**
+         * @brief Wall-clock time from a DS3231 class RTC, without touching the bus per loop.
+         *
+         * begin() reads the RTC once. In between, the time is extrapolated from an uptime
+         * source, so now() and asTimeComponents() cost some integer arithmetic and never touch
+         * the bus. Every resyncIntervalMs update() reads the RTC again, RtcSync runs it in
+         * the loop of a soc.
+         *
+         * The RTC counts whole seconds, a reading of S says the time is somewhere in
+         * [S, S + 1). A resync only corrects the time if the extrapolation lies outside of
+         * that window, and then towards its middle. Corrections up to stepThresholdMs are
+         * slewed at slewPpm, so the seconds get a little longer or shorter and the time never
+         * runs backwards. Larger ones, after the RTC was set or without an RTC at boot, are
+         * applied at once and the hands catch up.
+         *
+         * Without an RTC, or if it lost its time, the time counts from 00:00:00 at boot like
+         * the uptime, and every resync tries again.
+         */
+        class DS3231Time : public soc::api::ITime
+        {
+        public:
+            struct Config
+            {
+                unsigned long resyncIntervalMs; // the RTC is read this often
+                unsigned long stepThresholdMs;  // larger corrections are applied at once
+                uint32_t slewPpm;               // smaller ones at this rate
+            };
+
+            /**
+             * @brief An hour between the resyncs, the RTC and the crystal of the ESP32 part
+             * by less than 100 ms in that time. A correction of 1 s is slewed within 100 s.
+             */
+            static Config defaultConfig();
+
+            /**
+             * @param uptime Monotonic milliseconds since boot, e.g. millis().
+             */
+            DS3231Time(DS3231Rtc &rtc, soc::api::ITime &uptime, soc::api::ILogger &logger,
+                       const Config &config = defaultConfig());
+            virtual ~DS3231Time() = default;
+
+            /**
+             * @brief Reads the RTC for the first time.
+             * @return False if the RTC did not answer or lost its time.
+             */
+            bool begin();
+
+            /**
+             * @brief Milliseconds since 1970, truncated to an unsigned long.
+             */
+            unsigned long now() override;
+
+            /**
+             * @brief The time of day, hours from 0 to 23.
+             */
+            bool asTimeComponents(TimeComponents &time) override;
+
+            /**
+             * @brief Milliseconds since 1970, extrapolated from the last resync.
+             */
+            uint64_t nowMillis();
+
+            /**
+             * @brief Reads the RTC if the resync is due. Call it from the loop, at least once
+             * per resyncIntervalMs.
+             * @return True if it read the RTC.
+             */
+            bool update();
+
+            /**
+             * @return True once a reading of the RTC was accepted.
+             */
+            bool isSynced() const;
+
+            /**
+             * @brief Correction of the last resync that is not yet slewed in, signed.
+             */
+            int64_t getPendingCorrectionMs();
+
+            unsigned long getResyncCount() const;
+            unsigned long getFailedReadCount() const;
+
+        private:
+            DS3231Rtc &_rtc;
+            soc::api::ITime &_uptime;
+            soc::api::ILogger &_logger;
+            const Config _config;
+
+            // the time is _anchorMillis at _anchorUptimeMs, plus the uptime since then
+            // plus the part of _correctionMs slewed in since then
+            unsigned long _anchorUptimeMs;
+            uint64_t _anchorMillis;
+            int64_t _correctionMs;
+
+            bool _synced;
+            unsigned long _resyncs;
+            unsigned long _failedReads;
+
+            int64_t slewedMs(unsigned long elapsedMs) const;
+            uint64_t extrapolate(unsigned long uptimeMs) const;
+            void resync(unsigned long uptimeMs);
+            bool readRtc(uint64_t &epochSeconds);
+        };
+    }
+}
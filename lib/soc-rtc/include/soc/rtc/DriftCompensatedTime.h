@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstdint>
+#include <soc/api/ILogger.h>
+#include <soc/api/IPersistentStore.h>
+#include <soc/api/IReferenceClock.h>
+#include <soc/api/ITime.h>
+
+namespace soc
+{
+    namespace rtc
+    {
+        /**
+         * @brief An uptime that runs at the rate of a reference clock instead of the crystal
+         * of the SoC.
+         *
+         * The crystal behind millis() is off by tens of ppm, a second hand driven by it
+         * gains or loses seconds a day. This decorator adds a correction in 1/65536 ppm to
+         * the uptime it wraps, so it keeps step with the reference between its readings
+         * and whatever extrapolates from it, e.g. DS3231Time, needs small corrections only.
+         *
+         * The correction is learned: every sampleIntervalMs update() reads the reference
+         * and compares it to the uptime since the first reading of this boot. The longer that
+         * span, the smaller the uncertainty of the rate, resolution / span. A rate is
+         * accepted once its uncertainty is below acceptUncertaintyPpmQ16 and replaces the
+         * correction if it is more certain, or if both disagree, e.g. at another
+         * temperature. It is saved to the store, at most every saveIntervalMs, and applied
+         * from the next boot on until a better one is learned.
+         *
+         * now() and asTimeComponents() only compute, they are called every loop. The
+         * reading, a bus transfer for an RTC, and the save, a flash write, are left to
+         * update(), one of them per call.
+         */
+        class DriftCompensatedTime : public soc::api::ITime
+        {
+        public:
+            static const int32_t ONE_PPM = 65536; // fixed point, 1/65536 ppm
+            static const uint32_t NOT_CALIBRATED = 0xFFFFFFFFUL;
+
+            struct Config
+            {
+                unsigned long sampleIntervalMs;  // the reference is read this often
+                uint32_t acceptUncertaintyPpmQ16; // a rate this certain is used
+                int32_t maxCorrectionPpmQ16;      // more is a jump of the reference, not a drift
+                unsigned long saveIntervalMs;     // the store is written at most this often
+            };
+
+            /**
+             * @brief The record in the store, key CALIBRATION_KEY.
+             */
+            struct Calibration
+            {
+                uint32_t version;
+                int32_t correctionPpmQ16;
+                uint32_t uncertaintyPpmQ16;
+            };
+            static const char *const CALIBRATION_KEY;
+            static const uint32_t CALIBRATION_VERSION = 1;
+
+            /**
+             * @brief The reference is read hourly, a rate is used once it is good to 10 ppm,
+             * after 28 hours with an RTC of one second resolution. Saved once a day.
+             */
+            static Config defaultConfig();
+
+            /**
+             * @param uptime Monotonic milliseconds since boot, e.g. millis().
+             */
+            DriftCompensatedTime(soc::api::ITime &uptime, soc::api::IReferenceClock &reference,
+                                 soc::api::IPersistentStore &store, soc::api::ILogger &logger,
+                                 const Config &config = defaultConfig());
+            virtual ~DriftCompensatedTime() = default;
+
+            /**
+             * @brief Loads the saved correction and reads the reference for the first time.
+             * @return True if a correction was loaded.
+             */
+            bool begin();
+
+            /**
+             * @brief Corrected milliseconds since boot, wraps like millis().
+             */
+            unsigned long now() override;
+
+            /**
+             * @brief The corrected time since boot.
+             */
+            bool asTimeComponents(TimeComponents &time) override;
+
+            /**
+             * @brief Corrected milliseconds since boot.
+             */
+            uint64_t nowMillis();
+
+            /**
+             * @brief Saves a learned correction, or reads the reference if it is due. Call
+             * it from the loop, at least once per sampleIntervalMs.
+             * @return True if it read the reference or wrote the store.
+             */
+            bool update();
+
+            int32_t getCorrectionPpmQ16() const;
+
+            /**
+             * @return NOT_CALIBRATED until a rate was accepted or loaded.
+             */
+            uint32_t getUncertaintyPpmQ16() const;
+
+            unsigned long getSampleCount() const;
+            unsigned long getFailedSampleCount() const;
+            unsigned long getSaveCount() const;
+
+        private:
+            soc::api::ITime &_uptime;
+            soc::api::IReferenceClock &_reference;
+            soc::api::IPersistentStore &_store;
+            soc::api::ILogger &_logger;
+            const Config _config;
+
+            // the time is _anchorMillis at _anchorUptimeMs, plus the uptime since then with
+            // the correction; _anchorRemainder carries the fraction of a millisecond
+            unsigned long _anchorUptimeMs;
+            uint64_t _anchorMillis;
+            int64_t _anchorRemainder;
+            int32_t _correctionPpmQ16;
+            uint32_t _uncertaintyPpmQ16;
+
+            // the uptime without wrap at the readings of the reference
+            unsigned long _lastSampleUptimeMs;
+            uint64_t _sampleUptimeMillis;
+            bool _hasBaseline;
+            uint64_t _baselineUptimeMillis;
+            uint64_t _baselineReferenceMillis;
+
+            bool _savePending; // learned, saved by the next update()
+            bool _savedThisBoot;
+            uint64_t _lastSaveUptimeMillis;
+            unsigned long _samples;
+            unsigned long _failedSamples;
+            unsigned long _saves;
+
+            uint64_t corrected(unsigned long uptimeMs, int64_t &remainder) const;
+            void reanchor(unsigned long uptimeMs);
+            void sample(unsigned long uptimeMs);
+            void learn(uint64_t referenceMillis);
+            void save();
+        };
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <soc/api/ISocComponent.h>
+#include <soc/rtc/DriftCompensatedTime.h>
+
+namespace soc
+{
+    namespace rtc
+    {
+        /**
+         * @brief Runs DriftCompensatedTime::update() in the loop of a soc, so the readings of
+         * the reference and the saves stay out of the time queries of the clock.
+         *
+         * The time must be begun before, whatever extrapolates from it reads it at boot.
+         * A late correction costs nothing, so the sampler is not critical: while the watchdog
+         * of the soc degrades it after an overrun, it postpones the update.
+         */
+        class DriftSampler : public soc::api::ISocComponent
+        {
+        public:
+            explicit DriftSampler(DriftCompensatedTime &time);
+            virtual ~DriftSampler() override = default;
+
+            void advanceState(unsigned long currentTimeMs) override;
+            void render() override;
+            const char *getName() const override;
+            bool isCritical() const override;
+
+            /**
+             * @brief No update while degraded, e.g. the save does not follow a slow reading
+             * of the reference in the next loop.
+             */
+            void setDegraded(bool degraded) override;
+
+        private:
+            DriftCompensatedTime &_time;
+            bool _degraded;
+        };
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <soc/api/ISocComponent.h>
+#include <soc/rtc/DS3231Time.h>
+
+namespace soc
+{
+    namespace rtc
+    {
+        /**
+         * @brief Runs DS3231Time::update() in the loop of a soc, so the resyncs stay out of
+         * the time queries of the clock.
+         *
+         * A resync may come some loops late, the time is extrapolated meanwhile. So the
+         * component is not critical: while the watchdog of the soc degrades it after an
+         * overrun, it postpones the resync.
+         */
+        class RtcSync : public soc::api::ISocComponent
+        {
+        public:
+            explicit RtcSync(DS3231Time &time);
+            virtual ~RtcSync() override = default;
+
+            void advanceState(unsigned long currentTimeMs) override;
+            void render() override;
+            const char *getName() const override;
+            bool isCritical() const override;
+            void setDegraded(bool degraded) override;
+
+        private:
+            DS3231Time &_time;
+            bool _degraded;
+        };
+    }
+}
@@ -0,0 +1,95 @@
+#include <soc/rtc/DS3231Rtc.h>
+
+namespace soc
+{
+    namespace rtc
+    {
+        // --- DS3231 registers ---
+        static const uint8_t REGISTER_SECONDS = 0x00; // seconds to year, 7 registers in BCD
+        static const uint8_t REGISTER_STATUS = 0x0F;
+        static const uint8_t STATUS_OSCILLATOR_STOPPED = 0x80;
+        static const uint8_t HOURS_12 = 0x40;
+        static const uint8_t HOURS_PM = 0x20;
+        static const uint8_t MONTH_CENTURY = 0x80;
+
+        static uint8_t fromBcd(uint8_t value)
+        {
+            return static_cast<uint8_t>((value >> 4) * 10 + (value & 0x0F));
+        }
+
+        // days since 1970-01-01 of a date of the proleptic Gregorian calendar
+        static int64_t daysFromCivil(int year, unsigned month, unsigned day)
+        {
+            year -= month <= 2;
+            const int era = (year >= 0 ? year : year - 399) / 400;
+            const unsigned yearOfEra = static_cast<unsigned>(year - era * 400);
+            const unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+            const unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+            return static_cast<int64_t>(era) * 146097 + static_cast<int64_t>(dayOfEra) - 719468;
+        }
+
+        DS3231Rtc::DS3231Rtc(soc::api::II2cBus &bus)
+            : _bus(bus)
+        {
+        }
+
+        bool DS3231Rtc::readOscillatorStopped(bool &stopped)
+        {
+            uint8_t status;
+            if (!_bus.transfer(I2C_ADDRESS, &REGISTER_STATUS, 1, &status, 1))
+            {
+                return false;
+            }
+            stopped = (status & STATUS_OSCILLATOR_STOPPED) != 0;
+            return true;
+        }
+
+        bool DS3231Rtc::readEpochSeconds(uint64_t &epochSeconds)
+        {
+            uint8_t registers[7];
+            if (!_bus.transfer(I2C_ADDRESS, &REGISTER_SECONDS, 1, registers, sizeof(registers)))
+            {
+                return false;
+            }
+
+            unsigned seconds = fromBcd(registers[0] & 0x7F);
+            unsigned minutes = fromBcd(registers[1] & 0x7F);
+            unsigned hours;
+            if (registers[2] & HOURS_12)
+            {
+                hours = fromBcd(registers[2] & 0x1F) % 12 + ((registers[2] & HOURS_PM) ? 12 : 0);
+            }
+            else
+            {
+                hours = fromBcd(registers[2] & 0x3F);
+            }
+            unsigned day = fromBcd(registers[4] & 0x3F);
+            unsigned month = fromBcd(registers[5] & 0x1F);
+            int year = 2000 + fromBcd(registers[6]) + ((registers[5] & MONTH_CENTURY) ? 100 : 0);
+            if (seconds > 59 || minutes > 59 || hours > 23 || day < 1 || day > 31 || month < 1 || month > 12)
+            {
+                return false;
+            }
+
+            int64_t days = daysFromCivil(year, month, day);
+            epochSeconds = static_cast<uint64_t>(days * 86400 + hours * 3600 + minutes * 60 + seconds);
+            return true;
+        }
+
+        bool DS3231Rtc::readMillis(uint64_t &epochMillis)
+        {
+            uint64_t epochSeconds;
+            if (!readEpochSeconds(epochSeconds))
+            {
+                return false;
+            }
+            epochMillis = epochSeconds * 1000ULL + 500ULL;
+            return true;
+        }
+
+        unsigned long DS3231Rtc::getResolutionMs() const
+        {
+            return 1000UL;
+        }
+    }
+}
@@ -0,0 +1,184 @@
+#include <soc/rtc/DS3231Time.h>
+
+namespace soc
+{
+    namespace rtc
+    {
+        static const uint64_t MILLIS_PER_DAY = 86400000ULL;
+
+        DS3231Time::Config DS3231Time::defaultConfig()
+        {
+            Config config;
+            config.resyncIntervalMs = 3600000UL;
+            config.stepThresholdMs = 5000UL;
+            config.slewPpm = 10000UL;
+            return config;
+        }
+
+        DS3231Time::DS3231Time(DS3231Rtc &rtc, soc::api::ITime &uptime, soc::api::ILogger &logger,
+                               const Config &config)
+            : _rtc(rtc),
+              _uptime(uptime),
+              _logger(logger),
+              _config(config),
+              _anchorUptimeMs(0),
+              _anchorMillis(0),
+              _correctionMs(0),
+              _synced(false),
+              _resyncs(0),
+              _failedReads(0)
+        {
+        }
+
+        bool DS3231Time::begin()
+        {
+            resync(_uptime.now());
+            return _synced;
+        }
+
+        unsigned long DS3231Time::now()
+        {
+            return static_cast<unsigned long>(nowMillis());
+        }
+
+        bool DS3231Time::asTimeComponents(soc::api::ITime::TimeComponents &time)
+        {
+            uint64_t millisOfDay = nowMillis() % MILLIS_PER_DAY;
+
+            time.milliseconds = static_cast<int>(millisOfDay % 1000);
+
+            unsigned long totalSeconds = static_cast<unsigned long>(millisOfDay / 1000);
+
+            time.seconds = totalSeconds % 60;
+
+            unsigned long totalMinutes = totalSeconds / 60;
+            time.minutes = totalMinutes % 60;
+
+            time.hours = totalMinutes / 60;
+
+            return true;
+        }
+
+        uint64_t DS3231Time::nowMillis()
+        {
+            return extrapolate(_uptime.now());
+        }
+
+        bool DS3231Time::update()
+        {
+            unsigned long uptimeMs = _uptime.now();
+            if (uptimeMs - _anchorUptimeMs < _config.resyncIntervalMs)
+            {
+                return false;
+            }
+            resync(uptimeMs);
+            return true;
+        }
+
+        bool DS3231Time::isSynced() const
+        {
+            return _synced;
+        }
+
+        int64_t DS3231Time::getPendingCorrectionMs()
+        {
+            return _correctionMs - slewedMs(_uptime.now() - _anchorUptimeMs);
+        }
+
+        unsigned long DS3231Time::getResyncCount() const
+        {
+            return _resyncs;
+        }
+
+        unsigned long DS3231Time::getFailedReadCount() const
+        {
+            return _failedReads;
+        }
+
+        int64_t DS3231Time::slewedMs(unsigned long elapsedMs) const
+        {
+            int64_t slewed = static_cast<int64_t>(static_cast<uint64_t>(elapsedMs) * _config.slewPpm / 1000000ULL);
+            if (_correctionMs >= 0)
+            {
+                return slewed < _correctionMs ? slewed : _correctionMs;
+            }
+            return slewed < -_correctionMs ? -slewed : _correctionMs;
+        }
+
+        uint64_t DS3231Time::extrapolate(unsigned long uptimeMs) const
+        {
+            // wraps with the uptime, like every millis() difference
+            unsigned long elapsedMs = uptimeMs - _anchorUptimeMs;
+            return static_cast<uint64_t>(static_cast<int64_t>(_anchorMillis + elapsedMs) + slewedMs(elapsedMs));
+        }
+
+        void DS3231Time::resync(unsigned long uptimeMs)
+        {
+            // move the anchor here, with what is not slewed in yet
+            uint64_t current = extrapolate(uptimeMs);
+            int64_t remaining = _correctionMs - slewedMs(uptimeMs - _anchorUptimeMs);
+            _anchorUptimeMs = uptimeMs;
+            _anchorMillis = current;
+            _correctionMs = remaining;
+
+            uint64_t epochSeconds;
+            if (!readRtc(epochSeconds))
+            {
+                _failedReads++;
+                _logger.warn("DS3231Time: RTC not readable, extrapolating (%lu failed reads).", _failedReads);
+                return;
+            }
+            _resyncs++;
+
+            // the RTC is somewhere within its second, aim for the middle
+            int64_t windowStart = static_cast<int64_t>(epochSeconds * 1000ULL);
+            int64_t target = windowStart + 500;
+            if (!_synced)
+            {
+                _synced = true;
+                _anchorMillis = static_cast<uint64_t>(target);
+                _correctionMs = 0;
+                _logger.info("DS3231Time: Time set from the RTC.");
+                return;
+            }
+
+            // where the time is headed with the correction still being slewed in
+            int64_t shown = static_cast<int64_t>(current) + remaining;
+            if (shown >= windowStart && shown < windowStart + 1000)
+            {
+                return;
+            }
+            int64_t correction = target - static_cast<int64_t>(current);
+            int64_t magnitude = correction < 0 ? -correction : correction;
+            if (magnitude > static_cast<int64_t>(_config.stepThresholdMs))
+            {
+                _anchorMillis = static_cast<uint64_t>(static_cast<int64_t>(current) + correction);
+                _correctionMs = 0;
+                _logger.info("DS3231Time: RTC differs by %lld ms, time set.", static_cast<long long>(correction));
+            }
+            else
+            {
+                _correctionMs = correction;
+            }
+        }
+
+        bool DS3231Time::readRtc(uint64_t &epochSeconds)
+        {
+            // a stopped oscillator stays flagged until the time is set, no need to ask again once synced
+            if (!_synced)
+            {
+                bool stopped;
+                if (!_rtc.readOscillatorStopped(stopped))
+                {
+                    return false;
+                }
+                if (stopped)
+                {
+                    _logger.warn("DS3231Time: The RTC lost its time.");
+                    return false;
+                }
+            }
+            return _rtc.readEpochSeconds(epochSeconds);
+        }
+    }
+}
@@ -0,0 +1,274 @@
+#include <soc/rtc/DriftCompensatedTime.h>
+
+namespace soc
+{
+    namespace rtc
+    {
+        const int32_t DriftCompensatedTime::ONE_PPM;
+        const uint32_t DriftCompensatedTime::NOT_CALIBRATED;
+        const uint32_t DriftCompensatedTime::CALIBRATION_VERSION;
+        const char *const DriftCompensatedTime::CALIBRATION_KEY = "drift";
+
+        // a correction of ONE_PPM adds a millisecond every MILLION_Q16 milliseconds
+        static const int64_t MILLION_Q16 = 1000000LL * DriftCompensatedTime::ONE_PPM;
+
+        static int64_t floorDiv(int64_t value, int64_t divisor)
+        {
+            int64_t quotient = value / divisor;
+            return (value % divisor != 0 && value < 0) ? quotient - 1 : quotient;
+        }
+
+        static int64_t magnitude(int64_t value)
+        {
+            return value < 0 ? -value : value;
+        }
+
+        DriftCompensatedTime::Config DriftCompensatedTime::defaultConfig()
+        {
+            Config config;
+            config.sampleIntervalMs = 3600000UL;
+            config.acceptUncertaintyPpmQ16 = 10 * ONE_PPM;
+            config.maxCorrectionPpmQ16 = 200 * ONE_PPM;
+            config.saveIntervalMs = 86400000UL;
+            return config;
+        }
+
+        DriftCompensatedTime::DriftCompensatedTime(soc::api::ITime &uptime, soc::api::IReferenceClock &reference,
+                                                   soc::api::IPersistentStore &store, soc::api::ILogger &logger,
+                                                   const Config &config)
+            : _uptime(uptime),
+              _reference(reference),
+              _store(store),
+              _logger(logger),
+              _config(config),
+              _anchorUptimeMs(0),
+              _anchorMillis(0),
+              _anchorRemainder(0),
+              _correctionPpmQ16(0),
+              _uncertaintyPpmQ16(NOT_CALIBRATED),
+              _lastSampleUptimeMs(0),
+              _sampleUptimeMillis(0),
+              _hasBaseline(false),
+              _baselineUptimeMillis(0),
+              _baselineReferenceMillis(0),
+              _savePending(false),
+              _savedThisBoot(false),
+              _lastSaveUptimeMillis(0),
+              _samples(0),
+              _failedSamples(0),
+              _saves(0)
+        {
+        }
+
+        bool DriftCompensatedTime::begin()
+        {
+            unsigned long uptimeMs = _uptime.now();
+            reanchor(uptimeMs);
+
+            Calibration calibration;
+            bool loaded = _store.load(CALIBRATION_KEY, &calibration, sizeof(calibration)) &&
+                          calibration.version == CALIBRATION_VERSION &&
+                          magnitude(calibration.correctionPpmQ16) <= _config.maxCorrectionPpmQ16;
+            if (loaded)
+            {
+                _correctionPpmQ16 = calibration.correctionPpmQ16;
+                _uncertaintyPpmQ16 = calibration.uncertaintyPpmQ16;
+                _logger.info("DriftCompensatedTime: Correcting the crystal by %ld ppb.",
+                             static_cast<long>(static_cast<int64_t>(_correctionPpmQ16) * 1000 / ONE_PPM));
+            }
+            else
+            {
+                _logger.info("DriftCompensatedTime: Not calibrated yet.");
+            }
+
+            sample(uptimeMs);
+            return loaded;
+        }
+
+        unsigned long DriftCompensatedTime::now()
+        {
+            return static_cast<unsigned long>(nowMillis());
+        }
+
+        bool DriftCompensatedTime::asTimeComponents(soc::api::ITime::TimeComponents &time)
+        {
+            uint64_t currentMillis = nowMillis();
+
+            time.milliseconds = static_cast<int>(currentMillis % 1000);
+
+            uint64_t totalSeconds = currentMillis / 1000;
+
+            time.seconds = static_cast<int>(totalSeconds % 60);
+
+            uint64_t totalMinutes = totalSeconds / 60;
+            time.minutes = static_cast<int>(totalMinutes % 60);
+
+            time.hours = static_cast<unsigned long>(totalMinutes / 60);
+
+            return true;
+        }
+
+        uint64_t DriftCompensatedTime::nowMillis()
+        {
+            int64_t remainder;
+            return corrected(_uptime.now(), remainder);
+        }
+
+        bool DriftCompensatedTime::update()
+        {
+            // not in the same call as the reading, both block
+            if (_savePending)
+            {
+                _savePending = false;
+                save();
+                return true;
+            }
+            unsigned long uptimeMs = _uptime.now();
+            if (uptimeMs - _lastSampleUptimeMs < _config.sampleIntervalMs)
+            {
+                return false;
+            }
+            sample(uptimeMs);
+            return true;
+        }
+
+        int32_t DriftCompensatedTime::getCorrectionPpmQ16() const
+        {
+            return _correctionPpmQ16;
+        }
+
+        uint32_t DriftCompensatedTime::getUncertaintyPpmQ16() const
+        {
+            return _uncertaintyPpmQ16;
+        }
+
+        unsigned long DriftCompensatedTime::getSampleCount() const
+        {
+            return _samples;
+        }
+
+        unsigned long DriftCompensatedTime::getFailedSampleCount() const
+        {
+            return _failedSamples;
+        }
+
+        unsigned long DriftCompensatedTime::getSaveCount() const
+        {
+            return _saves;
+        }
+
+        uint64_t DriftCompensatedTime::corrected(unsigned long uptimeMs, int64_t &remainder) const
+        {
+            // wraps with the uptime, update() moves the anchor at least every sampleIntervalMs
+            unsigned long elapsedMs = uptimeMs - _anchorUptimeMs;
+            int64_t fraction = static_cast<int64_t>(elapsedMs) * _correctionPpmQ16 + _anchorRemainder;
+            int64_t correctionMs = floorDiv(fraction, MILLION_Q16);
+            remainder = fraction - correctionMs * MILLION_Q16;
+            return static_cast<uint64_t>(static_cast<int64_t>(_anchorMillis + elapsedMs) + correctionMs);
+        }
+
+        void DriftCompensatedTime::reanchor(unsigned long uptimeMs)
+        {
+            int64_t remainder;
+            _anchorMillis = corrected(uptimeMs, remainder);
+            _anchorRemainder = remainder;
+            _anchorUptimeMs = uptimeMs;
+        }
+
+        void DriftCompensatedTime::sample(unsigned long uptimeMs)
+        {
+            // before the correction may change, so the time goes on from here
+            reanchor(uptimeMs);
+            _sampleUptimeMillis += uptimeMs - _lastSampleUptimeMs;
+            _lastSampleUptimeMs = uptimeMs;
+
+            uint64_t referenceMillis;
+            if (!_reference.readMillis(referenceMillis))
+            {
+                _failedSamples++;
+                _logger.warn("DriftCompensatedTime: Reference not readable (%lu failed reads).", _failedSamples);
+                return;
+            }
+            _samples++;
+            learn(referenceMillis);
+        }
+
+        void DriftCompensatedTime::learn(uint64_t referenceMillis)
+        {
+            if (!_hasBaseline)
+            {
+                _hasBaseline = true;
+                _baselineUptimeMillis = _sampleUptimeMillis;
+                _baselineReferenceMillis = referenceMillis;
+                return;
+            }
+
+            int64_t spanMs = static_cast<int64_t>(_sampleUptimeMillis - _baselineUptimeMillis);
+            if (spanMs <= 0)
+            {
+                return;
+            }
+            int64_t deviationMs = static_cast<int64_t>(referenceMillis - _baselineReferenceMillis) - spanMs;
+
+            // the rate in whole ppm, then its fraction, without overflowing 64 bit
+            int64_t scaled = deviationMs * 1000000LL;
+            int64_t wholePpm = scaled / spanMs;
+            if (magnitude(wholePpm) >= _config.maxCorrectionPpmQ16 / ONE_PPM)
+            {
+                // the reference was set, the span starts again
+                _logger.info("DriftCompensatedTime: Reference jumped by %lld ms, learning again.",
+                             static_cast<long long>(deviationMs));
+                _baselineUptimeMillis = _sampleUptimeMillis;
+                _baselineReferenceMillis = referenceMillis;
+                return;
+            }
+            int64_t measuredPpmQ16 = wholePpm * ONE_PPM + (scaled - wholePpm * spanMs) * ONE_PPM / spanMs;
+
+            uint64_t uncertainty = static_cast<uint64_t>(_reference.getResolutionMs()) * MILLION_Q16 /
+                                   static_cast<uint64_t>(spanMs);
+            if (uncertainty > _config.acceptUncertaintyPpmQ16)
+            {
+                return;
+            }
+            bool moreCertain = uncertainty < _uncertaintyPpmQ16;
+            bool disagrees = _uncertaintyPpmQ16 != NOT_CALIBRATED &&
+                             static_cast<uint64_t>(magnitude(measuredPpmQ16 - _correctionPpmQ16)) >
+                                 uncertainty + _uncertaintyPpmQ16;
+            if (!moreCertain && !disagrees)
+            {
+                return;
+            }
+            if (disagrees)
+            {
+                _logger.info("DriftCompensatedTime: The crystal changed by %ld ppb.",
+                             static_cast<long>((measuredPpmQ16 - _correctionPpmQ16) * 1000 / ONE_PPM));
+            }
+            _correctionPpmQ16 = static_cast<int32_t>(measuredPpmQ16);
+            _uncertaintyPpmQ16 = static_cast<uint32_t>(uncertainty);
+
+            if (!_savedThisBoot || _sampleUptimeMillis - _lastSaveUptimeMillis >= _config.saveIntervalMs)
+            {
+                _savePending = true;
+            }
+        }
+
+        void DriftCompensatedTime::save()
+        {
+            Calibration calibration;
+            calibration.version = CALIBRATION_VERSION;
+            calibration.correctionPpmQ16 = _correctionPpmQ16;
+            calibration.uncertaintyPpmQ16 = _uncertaintyPpmQ16;
+            if (!_store.save(CALIBRATION_KEY, &calibration, sizeof(calibration)))
+            {
+                _logger.warn("DriftCompensatedTime: Could not save the correction.");
+                return;
+            }
+            _savedThisBoot = true;
+            _lastSaveUptimeMillis = _sampleUptimeMillis;
+            _saves++;
+            _logger.info("DriftCompensatedTime: Saved a correction of %ld ppb, +/- %lu ppb.",
+                         static_cast<long>(static_cast<int64_t>(_correctionPpmQ16) * 1000 / ONE_PPM),
+                         static_cast<unsigned long>(static_cast<uint64_t>(_uncertaintyPpmQ16) * 1000 / ONE_PPM));
+        }
+    }
+}
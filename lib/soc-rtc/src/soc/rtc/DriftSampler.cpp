@@ -0,0 +1,40 @@
+#include <soc/rtc/DriftSampler.h>
+
+namespace soc
+{
+    namespace rtc
+    {
+        DriftSampler::DriftSampler(DriftCompensatedTime &time)
+            : _time(time),
+              _degraded(false)
+        {
+        }
+
+        void DriftSampler::advanceState(unsigned long /*currentTimeMs*/)
+        {
+            if (!_degraded)
+            {
+                _time.update();
+            }
+        }
+
+        void DriftSampler::render()
+        {
+        }
+
+        const char *DriftSampler::getName() const
+        {
+            return "drift compensation";
+        }
+
+        bool DriftSampler::isCritical() const
+        {
+            return false;
+        }
+
+        void DriftSampler::setDegraded(bool degraded)
+        {
+            _degraded = degraded;
+        }
+    }
+}
@@ -0,0 +1,40 @@
+#include <soc/rtc/RtcSync.h>
+
+namespace soc
+{
+    namespace rtc
+    {
+        RtcSync::RtcSync(DS3231Time &time)
+            : _time(time),
+              _degraded(false)
+        {
+        }
+
+        void RtcSync::advanceState(unsigned long /*currentTimeMs*/)
+        {
+            if (!_degraded)
+            {
+                _time.update();
+            }
+        }
+
+        void RtcSync::render()
+        {
+        }
+
+        const char *RtcSync::getName() const
+        {
+            return "rtc sync";
+        }
+
+        bool RtcSync::isCritical() const
+        {
+            return false;
+        }
+
+        void RtcSync::setDegraded(bool degraded)
+        {
+            _degraded = degraded;
+        }
+    }
+}
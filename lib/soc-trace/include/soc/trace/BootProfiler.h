@@ -0,0 +1,94 @@
+#pragma once
+
+#include <Arduino.h>
+#include <cstddef>
+#include <soc/api/ILogger.h>
+
+namespace soc
+{
+    namespace trace
+    {
+        /**
+         * @brief Timestamps the phases of the boot with micros(), the constructions in
+         * setup() and the setups of the components, and reports them.
+         *
+         * A phase is ended by the index begin() returned. Phases may overlap: the setup of
+         * a component that continues in the loop, like homing, runs alongside the next ones.
+         * The report shows the sum of all phases and the time covered by any of them, the
+         * difference ran concurrently. Do not nest phases, a phase inside another one
+         * counts as concurrent.
+         *
+         * A fixed number of phases without allocation, the ones beyond are dropped and counted.
+         */
+        class BootProfiler
+        {
+        public:
+            static const size_t MAX_PHASES = 32;
+            static const int NO_PHASE = -1;
+
+            struct Phase
+            {
+                const char *name; // must outlive the profiler, usually a literal
+                unsigned long startMicros;
+                unsigned long endMicros;
+                bool ended;
+            };
+
+            /**
+             * @brief Begins a phase at its construction and ends it at its destruction.
+             */
+            class Scope
+            {
+            public:
+                /**
+                 * @param profiler May be null, nothing is recorded then.
+                 */
+                Scope(BootProfiler *profiler, const char *name);
+                ~Scope();
+
+                Scope(const Scope &) = delete;
+                Scope &operator=(const Scope &) = delete;
+
+            private:
+                BootProfiler *_profiler;
+                int _phase;
+            };
+
+            BootProfiler();
+
+            /**
+             * @return The index of the phase, NO_PHASE if all are used.
+             */
+            int begin(const char *name);
+
+            /**
+             * @brief Ends a phase, NO_PHASE and phases that already ended are ignored.
+             */
+            void end(int phase);
+
+            size_t getPhaseCount() const;
+            const Phase &getPhase(size_t index) const;
+            size_t getDroppedCount() const;
+
+            /**
+             * @brief Sum of the durations of the ended phases.
+             */
+            unsigned long getTotalMicros() const;
+
+            /**
+             * @brief Time during which at least one of the ended phases ran.
+             */
+            unsigned long getCoveredMicros() const;
+
+            /**
+             * @brief Logs every phase with its start since reset and its duration, then the totals.
+             */
+            void report(soc::api::ILogger &logger) const;
+
+        private:
+            Phase _phases[MAX_PHASES];
+            size_t _count;
+            size_t _dropped;
+        };
+    }
+}
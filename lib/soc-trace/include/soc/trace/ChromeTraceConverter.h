@@ -0,0 +1,50 @@
+#pragma once
+
+#include <iosfwd>
+#include <string>
+#include <soc/trace/ITraceSink.h>
+
+namespace soc
+{
+    namespace trace
+    {
+        /**
+         * @brief Writes a serialized trace into a std::ostream, e.g. a file on the host.
+         */
+        class StreamTraceSink : public ITraceSink
+        {
+        public:
+            explicit StreamTraceSink(std::ostream &out);
+
+            void write(const uint8_t *data, size_t length) override;
+
+        private:
+            std::ostream &_out;
+        };
+
+        /**
+         * @brief Converts the binary format of TraceRecorder::serialize() into Chrome trace
+         * JSON, which opens in Perfetto (ui.perfetto.dev) and chrome://tracing.
+         *
+         * Every track becomes a thread row. STATE events become back-to-back slices, the
+         * last state is closed at the end of the trace. The 32 bit timestamps are unwrapped,
+         * so traces spanning the micros() overflow stay monotonic.
+         */
+        class ChromeTraceConverter
+        {
+        public:
+            /**
+             * @return False if the input is not a valid trace, the reason is stored in error.
+             */
+            static bool convert(std::istream &binary, std::ostream &json, std::string *error = nullptr);
+
+            /**
+             * @brief Recovers the binary trace from a captured serial log, i.e. the hex lines
+             * between the "--- soc-trace begin ---" and "--- soc-trace end ---" markers.
+             * The last complete dump in the log wins.
+             * @return False if the log contains no complete dump.
+             */
+            static bool extractFromLog(std::istream &log, std::string &binary);
+        };
+    }
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace soc
+{
+    namespace trace
+    {
+        /**
+         * @brief Destination for a serialized trace, e.g. a file or the serial port.
+         */
+        class ITraceSink
+        {
+        public:
+            virtual ~ITraceSink() = default;
+
+            virtual void write(const uint8_t *data, size_t length) = 0;
+        };
+    }
+}
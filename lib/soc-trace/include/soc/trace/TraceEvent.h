@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+namespace soc
+{
+    namespace trace
+    {
+        enum class TraceEventType : uint8_t
+        {
+            BEGIN,   // a slice on the track starts
+            END,     // the innermost open slice on the track ends
+            STATE,   // the track enters a new state, ending the previous one
+            INSTANT, // a point in time, value as argument
+            COUNTER  // a value changes over time
+        };
+
+        /**
+         * @brief One recorded event. Names are not copied, they must be string literals
+         * or otherwise outlive the recorder.
+         */
+        struct TraceEvent
+        {
+            uint32_t timeMicros;
+            const char *name;
+            const void *track;
+            int32_t value;
+            TraceEventType type;
+        };
+    }
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <Arduino.h>
+#include <cstddef>
+#include <cstdint>
+#include <soc/trace/ITraceSink.h>
+#include <soc/trace/TraceEvent.h>
+
+// Number of events kept in the ring buffer, must be a power of two.
+// Older events are overwritten.
+#ifndef SOC_TRACE_CAPACITY
+#define SOC_TRACE_CAPACITY 1024
+#endif
+
+#ifndef SOC_TRACE_MAX_TRACKS
+#define SOC_TRACE_MAX_TRACKS 16
+#endif
+
+namespace soc
+{
+    namespace trace
+    {
+        /**
+         * @brief Lightweight recorder of begin/end, state change, instant and counter events.
+         *
+         * Recording stores a timestamp and three words into a fixed ring buffer, with no
+         * allocation and no formatting, so tracing can stay enabled in production builds.
+         * A track is the identity of the object that records (usually `this`), so
+         * several instances of a component end up on separate rows.
+         *
+         * The buffer is serialized into a compact binary format (see serialize()) that
+         * ChromeTraceConverter turns into Chrome trace JSON for Perfetto.
+         *
+         * Not thread safe, record from the main loop only.
+         */
+        class TraceRecorder
+        {
+        public:
+            static const uint32_t FORMAT_MAGIC = 0x54434F53; // "SOCT"
+            static const uint16_t FORMAT_VERSION = 1;
+
+            static_assert((SOC_TRACE_CAPACITY & (SOC_TRACE_CAPACITY - 1)) == 0,
+                          "SOC_TRACE_CAPACITY must be a power of two");
+
+            /**
+             * @brief The recorder used by the SOC_TRACE_* macros.
+             */
+            static TraceRecorder &instance();
+
+            TraceRecorder();
+
+            inline void record(TraceEventType type, const void *track, const char *name, int32_t value)
+            {
+                if (!_enabled)
+                {
+                    return;
+                }
+                TraceEvent &event = _events[_head & (SOC_TRACE_CAPACITY - 1)];
+                event.timeMicros = static_cast<uint32_t>(micros());
+                event.name = name;
+                event.track = track;
+                event.value = value;
+                event.type = type;
+                _head++;
+            }
+
+            /**
+             * @brief Gives a track a readable name, shown as the row title in Perfetto.
+             * @return False if all track slots are taken.
+             */
+            bool nameTrack(const void *track, const char *name);
+
+            void setEnabled(bool enabled);
+            bool isEnabled() const;
+
+            /**
+             * @brief Drops all recorded events, track names are kept.
+             */
+            void clear();
+
+            /** @brief Events currently in the buffer, at most SOC_TRACE_CAPACITY. */
+            size_t size() const;
+            /** @brief Events overwritten since the last clear(). */
+            uint32_t dropped() const;
+
+            /**
+             * @brief Event by age, 0 is the oldest event still in the buffer.
+             */
+            const TraceEvent &at(size_t index) const;
+
+            /**
+             * @brief Writes all events in the binary trace format, oldest first.
+             *
+             * Layout, little endian:
+             *   u32 magic, u16 version, u16 reserved, u32 stringCount, u32 trackCount, u32 eventCount
+             *   stringCount x (u16 length, bytes)
+             *   trackCount  x (u16 stringIndex)
+             *   eventCount  x (u32 timeMicros, u16 nameIndex, u16 trackIndex, i32 value, u8 type, 3 x pad)
+             * Track index 0xFFFF means "no track".
+             */
+            void serialize(ITraceSink &sink) const;
+
+        private:
+            struct TrackName
+            {
+                const void *track;
+                const char *name;
+            };
+
+            TraceEvent _events[SOC_TRACE_CAPACITY];
+            uint32_t _head;
+            TrackName _tracks[SOC_TRACE_MAX_TRACKS];
+            size_t _trackCount;
+            bool _enabled;
+        };
+    }
+}
+
+// --- Recording macros ---
+// Compile them out entirely with -DSOC_TRACE_DISABLED.
+#ifndef SOC_TRACE_DISABLED
+#define SOC_TRACE_TRACK(track, name) ::soc::trace::TraceRecorder::instance().nameTrack(track, name)
+#define SOC_TRACE_BEGIN(track, name) ::soc::trace::TraceRecorder::instance().record(::soc::trace::TraceEventType::BEGIN, track, name, 0)
+#define SOC_TRACE_END(track, name) ::soc::trace::TraceRecorder::instance().record(::soc::trace::TraceEventType::END, track, name, 0)
+#define SOC_TRACE_STATE(track, name) ::soc::trace::TraceRecorder::instance().record(::soc::trace::TraceEventType::STATE, track, name, 0)
+#define SOC_TRACE_INSTANT(track, name, value) ::soc::trace::TraceRecorder::instance().record(::soc::trace::TraceEventType::INSTANT, track, name, value)
+#define SOC_TRACE_COUNTER(track, name, value) ::soc::trace::TraceRecorder::instance().record(::soc::trace::TraceEventType::COUNTER, track, name, value)
+#else
+#define SOC_TRACE_TRACK(track, name) ((void)0)
+#define SOC_TRACE_BEGIN(track, name) ((void)0)
+#define SOC_TRACE_END(track, name) ((void)0)
+#define SOC_TRACE_STATE(track, name) ((void)0)
+#define SOC_TRACE_INSTANT(track, name, value) ((void)0)
+#define SOC_TRACE_COUNTER(track, name, value) ((void)0)
+#endif
@@ -0,0 +1,139 @@
+#include <soc/trace/BootProfiler.h>
+
+namespace soc
+{
+    namespace trace
+    {
+        const size_t BootProfiler::MAX_PHASES;
+        const int BootProfiler::NO_PHASE;
+
+        BootProfiler::Scope::Scope(BootProfiler *profiler, const char *name)
+            : _profiler(profiler),
+              _phase(profiler ? profiler->begin(name) : NO_PHASE)
+        {
+        }
+
+        BootProfiler::Scope::~Scope()
+        {
+            if (_profiler)
+            {
+                _profiler->end(_phase);
+            }
+        }
+
+        BootProfiler::BootProfiler()
+            : _phases{},
+              _count(0),
+              _dropped(0)
+        {
+        }
+
+        int BootProfiler::begin(const char *name)
+        {
+            if (_count >= MAX_PHASES)
+            {
+                _dropped++;
+                return NO_PHASE;
+            }
+            Phase &phase = _phases[_count];
+            phase.name = name;
+            phase.startMicros = micros();
+            phase.endMicros = phase.startMicros;
+            phase.ended = false;
+            return static_cast<int>(_count++);
+        }
+
+        void BootProfiler::end(int phase)
+        {
+            if (phase < 0 || static_cast<size_t>(phase) >= _count || _phases[phase].ended)
+            {
+                return;
+            }
+            _phases[phase].endMicros = micros();
+            _phases[phase].ended = true;
+        }
+
+        size_t BootProfiler::getPhaseCount() const
+        {
+            return _count;
+        }
+
+        const BootProfiler::Phase &BootProfiler::getPhase(size_t index) const
+        {
+            return _phases[index];
+        }
+
+        size_t BootProfiler::getDroppedCount() const
+        {
+            return _dropped;
+        }
+
+        unsigned long BootProfiler::getTotalMicros() const
+        {
+            unsigned long total = 0;
+            for (size_t i = 0; i < _count; i++)
+            {
+                if (_phases[i].ended)
+                {
+                    total += _phases[i].endMicros - _phases[i].startMicros;
+                }
+            }
+            return total;
+        }
+
+        unsigned long BootProfiler::getCoveredMicros() const
+        {
+            if (_count == 0)
+            {
+                return 0;
+            }
+            // the phases are in the order they began, relative to the first one micros() may wrap
+            unsigned long base = _phases[0].startMicros;
+            unsigned long covered = 0;
+            unsigned long coveredUntil = 0;
+            for (size_t i = 0; i < _count; i++)
+            {
+                if (!_phases[i].ended)
+                {
+                    continue;
+                }
+                unsigned long start = _phases[i].startMicros - base;
+                unsigned long end = _phases[i].endMicros - base;
+                if (end <= coveredUntil)
+                {
+                    continue;
+                }
+                covered += end - (start > coveredUntil ? start : coveredUntil);
+                coveredUntil = end;
+            }
+            return covered;
+        }
+
+        void BootProfiler::report(soc::api::ILogger &logger) const
+        {
+            logger.info("Boot: %10s %12s  %s", "start ms", "duration ms", "phase");
+            for (size_t i = 0; i < _count; i++)
+            {
+                const Phase &phase = _phases[i];
+                if (phase.ended)
+                {
+                    logger.info("Boot: %10.1f %12.1f  %s", phase.startMicros / 1000.0,
+                                (phase.endMicros - phase.startMicros) / 1000.0, phase.name);
+                }
+                else
+                {
+                    logger.info("Boot: %10.1f %12s  %s", phase.startMicros / 1000.0, "running", phase.name);
+                }
+            }
+            unsigned long total = getTotalMicros();
+            unsigned long covered = getCoveredMicros();
+            logger.info("Boot: %u phases, %.1f ms in total, %.1f ms covered, %.1f ms concurrent.",
+                        static_cast<unsigned>(_count), total / 1000.0, covered / 1000.0, (total - covered) / 1000.0);
+            if (_dropped > 0)
+            {
+                logger.warn("Boot: %u phases dropped, more than %u.",
+                            static_cast<unsigned>(_dropped), static_cast<unsigned>(MAX_PHASES));
+            }
+        }
+    }
+}
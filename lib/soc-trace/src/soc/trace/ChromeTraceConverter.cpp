@@ -0,0 +1,333 @@
+#include <soc/trace/ChromeTraceConverter.h>
+#include <soc/trace/TraceEvent.h>
+#include <soc/trace/TraceRecorder.h>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace soc
+{
+    namespace trace
+    {
+        static const uint16_t NO_TRACK = 0xFFFF;
+        static const int PROCESS_ID = 1;
+
+        StreamTraceSink::StreamTraceSink(std::ostream &out) : _out(out)
+        {
+        }
+
+        void StreamTraceSink::write(const uint8_t *data, size_t length)
+        {
+            _out.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(length));
+        }
+
+        /**
+         * @brief Little endian reader, counterpart of the writer in TraceRecorder.cpp.
+         */
+        class BinaryReader
+        {
+        public:
+            explicit BinaryReader(std::istream &in) : _in(in) {}
+
+            bool u8(uint8_t &value)
+            {
+                char byte;
+                if (!_in.get(byte))
+                {
+                    return false;
+                }
+                value = static_cast<uint8_t>(byte);
+                return true;
+            }
+
+            bool u16(uint16_t &value)
+            {
+                uint8_t low, high;
+                if (!u8(low) || !u8(high))
+                {
+                    return false;
+                }
+                value = static_cast<uint16_t>(low | (high << 8));
+                return true;
+            }
+
+            bool u32(uint32_t &value)
+            {
+                uint16_t low, high;
+                if (!u16(low) || !u16(high))
+                {
+                    return false;
+                }
+                value = static_cast<uint32_t>(low) | (static_cast<uint32_t>(high) << 16);
+                return true;
+            }
+
+            bool string(std::string &value, size_t length)
+            {
+                value.resize(length);
+                return length == 0 || static_cast<bool>(_in.read(&value[0], static_cast<std::streamsize>(length)));
+            }
+
+        private:
+            std::istream &_in;
+        };
+
+        static void writeJsonString(std::ostream &json, const std::string &value)
+        {
+            json << '"';
+            for (char c : value)
+            {
+                switch (c)
+                {
+                case '"':
+                    json << "\\\"";
+                    break;
+                case '\\':
+                    json << "\\\\";
+                    break;
+                case '\n':
+                    json << "\\n";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        json << ' ';
+                    }
+                    else
+                    {
+                        json << c;
+                    }
+                }
+            }
+            json << '"';
+        }
+
+        static bool fail(std::string *error, const char *message)
+        {
+            if (error != nullptr)
+            {
+                *error = message;
+            }
+            return false;
+        }
+
+        bool ChromeTraceConverter::convert(std::istream &binary, std::ostream &json, std::string *error)
+        {
+            BinaryReader reader(binary);
+
+            uint32_t magic, stringCount, trackCount, eventCount;
+            uint16_t version, reserved;
+            if (!reader.u32(magic) || magic != TraceRecorder::FORMAT_MAGIC)
+            {
+                return fail(error, "not a trace: bad magic");
+            }
+            if (!reader.u16(version) || version != TraceRecorder::FORMAT_VERSION || !reader.u16(reserved))
+            {
+                return fail(error, "unsupported trace version");
+            }
+            if (!reader.u32(stringCount) || !reader.u32(trackCount) || !reader.u32(eventCount))
+            {
+                return fail(error, "truncated header");
+            }
+
+            std::vector<std::string> strings(stringCount);
+            for (auto &string : strings)
+            {
+                uint16_t length;
+                if (!reader.u16(length) || !reader.string(string, length))
+                {
+                    return fail(error, "truncated string table");
+                }
+            }
+
+            std::vector<uint16_t> trackNames(trackCount);
+            for (auto &trackName : trackNames)
+            {
+                if (!reader.u16(trackName) || trackName >= stringCount)
+                {
+                    return fail(error, "bad track table");
+                }
+            }
+
+            json << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+            json << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << PROCESS_ID << ",\"tid\":0,\"args\":{\"name\":\"aviator-clock\"}}";
+            for (uint32_t track = 0; track < trackCount; track++)
+            {
+                json << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << PROCESS_ID << ",\"tid\":" << track + 1
+                     << ",\"args\":{\"name\":";
+                writeJsonString(json, strings[trackNames[track]]);
+                json << "}}";
+            }
+
+            // open STATE slice per track (tid), name index or -1
+            std::vector<long> openStates(trackCount + 1, -1);
+            // open BEGIN slices per track, an END whose BEGIN was overwritten in the ring is dropped
+            std::vector<uint32_t> openSlices(trackCount + 1, 0);
+            uint64_t epoch = 0;
+            uint32_t lastTime = 0;
+            uint64_t timestamp = 0;
+            bool first = true;
+
+            auto emit = [&json](const char *phase, const std::string &name, int tid, uint64_t ts)
+            {
+                json << ",\n{\"name\":";
+                writeJsonString(json, name);
+                json << ",\"ph\":\"" << phase << "\",\"ts\":" << ts << ",\"pid\":" << PROCESS_ID << ",\"tid\":" << tid;
+            };
+
+            for (uint32_t i = 0; i < eventCount; i++)
+            {
+                uint32_t time, rawValue;
+                uint16_t nameIndex, trackIndex;
+                uint8_t type, pad;
+                if (!reader.u32(time) || !reader.u16(nameIndex) || !reader.u16(trackIndex) ||
+                    !reader.u32(rawValue) || !reader.u8(type) || !reader.u8(pad) || !reader.u8(pad) || !reader.u8(pad))
+                {
+                    return fail(error, "truncated events");
+                }
+                if (nameIndex >= stringCount || (trackIndex != NO_TRACK && trackIndex >= trackCount))
+                {
+                    return fail(error, "bad event reference");
+                }
+
+                // unwrap the 32 bit micros() counter
+                if (!first && time < lastTime)
+                {
+                    epoch += 0x100000000ULL;
+                }
+                first = false;
+                lastTime = time;
+                timestamp = epoch + time;
+
+                int tid = trackIndex == NO_TRACK ? 0 : trackIndex + 1;
+                int32_t value = static_cast<int32_t>(rawValue);
+                const std::string &name = strings[nameIndex];
+
+                switch (static_cast<TraceEventType>(type))
+                {
+                case TraceEventType::BEGIN:
+                    emit("B", name, tid, timestamp);
+                    json << "}";
+                    openSlices[tid]++;
+                    break;
+                case TraceEventType::END:
+                    if (openSlices[tid] > 0)
+                    {
+                        emit("E", name, tid, timestamp);
+                        json << "}";
+                        openSlices[tid]--;
+                    }
+                    break;
+                case TraceEventType::STATE:
+                    if (openStates[tid] >= 0)
+                    {
+                        emit("E", strings[openStates[tid]], tid, timestamp);
+                        json << "}";
+                    }
+                    emit("B", name, tid, timestamp);
+                    json << "}";
+                    openStates[tid] = nameIndex;
+                    break;
+                case TraceEventType::INSTANT:
+                    emit("i", name, tid, timestamp);
+                    json << ",\"s\":\"t\",\"args\":{\"value\":" << value << "}}";
+                    break;
+                case TraceEventType::COUNTER:
+                    emit("C", name, tid, timestamp);
+                    json << ",\"args\":{\"value\":" << value << "}}";
+                    break;
+                default:
+                    return fail(error, "unknown event type");
+                }
+            }
+
+            // close the states that are still active at the end of the trace
+            for (size_t tid = 0; tid < openStates.size(); tid++)
+            {
+                if (openStates[tid] >= 0)
+                {
+                    emit("E", strings[openStates[tid]], static_cast<int>(tid), timestamp);
+                    json << "}";
+                }
+            }
+
+            json << "\n]}\n";
+            return true;
+        }
+
+        static int hexValue(char c)
+        {
+            if (c >= '0' && c <= '9')
+                return c - '0';
+            if (c >= 'a' && c <= 'f')
+                return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F')
+                return c - 'A' + 10;
+            return -1;
+        }
+
+        bool ChromeTraceConverter::extractFromLog(std::istream &log, std::string &binary)
+        {
+            static const char BEGIN_MARKER[] = "--- soc-trace begin ---";
+            static const char END_MARKER[] = "--- soc-trace end ---";
+
+            bool found = false;
+            bool inDump = false;
+            std::string current;
+            std::string line;
+            while (std::getline(log, line))
+            {
+                if (line.find(BEGIN_MARKER) != std::string::npos)
+                {
+                    inDump = true;
+                    current.clear();
+                    continue;
+                }
+                if (!inDump)
+                {
+                    continue;
+                }
+                if (line.find(END_MARKER) != std::string::npos)
+                {
+                    inDump = false;
+                    binary = current;
+                    found = true;
+                    continue;
+                }
+
+                // lines with anything but hex digits are log output interleaved with the dump
+                std::string bytes;
+                int high = -1;
+                bool hexLine = true;
+                for (char c : line)
+                {
+                    if (c == '\r' || c == ' ')
+                    {
+                        continue;
+                    }
+                    int nibble = hexValue(c);
+                    if (nibble < 0)
+                    {
+                        hexLine = false;
+                        break;
+                    }
+                    if (high < 0)
+                    {
+                        high = nibble;
+                    }
+                    else
+                    {
+                        bytes.push_back(static_cast<char>((high << 4) | nibble));
+                        high = -1;
+                    }
+                }
+                if (hexLine)
+                {
+                    current += bytes;
+                }
+            }
+            return found;
+        }
+    }
+}
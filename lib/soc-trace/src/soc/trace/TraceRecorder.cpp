@@ -0,0 +1,201 @@
+#include <soc/trace/TraceRecorder.h>
+#include <cstring>
+#include <vector>
+
+namespace soc
+{
+    namespace trace
+    {
+        static const uint16_t NO_TRACK = 0xFFFF;
+
+        /**
+         * @brief Little endian writer on top of a sink, independent of the host byte order.
+         */
+        class BinaryWriter
+        {
+        public:
+            explicit BinaryWriter(ITraceSink &sink) : _sink(sink) {}
+
+            void u8(uint8_t value)
+            {
+                _sink.write(&value, 1);
+            }
+
+            void u16(uint16_t value)
+            {
+                uint8_t bytes[2] = {static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8)};
+                _sink.write(bytes, sizeof(bytes));
+            }
+
+            void u32(uint32_t value)
+            {
+                uint8_t bytes[4] = {static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8),
+                                    static_cast<uint8_t>(value >> 16), static_cast<uint8_t>(value >> 24)};
+                _sink.write(bytes, sizeof(bytes));
+            }
+
+            void bytes(const char *data, size_t length)
+            {
+                _sink.write(reinterpret_cast<const uint8_t *>(data), length);
+            }
+
+        private:
+            ITraceSink &_sink;
+        };
+
+        TraceRecorder &TraceRecorder::instance()
+        {
+            static TraceRecorder _recorder;
+            return _recorder;
+        }
+
+        TraceRecorder::TraceRecorder()
+            : _head(0),
+              _trackCount(0),
+              _enabled(true)
+        {
+        }
+
+        bool TraceRecorder::nameTrack(const void *track, const char *name)
+        {
+            for (size_t i = 0; i < _trackCount; i++)
+            {
+                if (_tracks[i].track == track)
+                {
+                    _tracks[i].name = name;
+                    return true;
+                }
+            }
+            if (_trackCount >= SOC_TRACE_MAX_TRACKS)
+            {
+                return false;
+            }
+            _tracks[_trackCount++] = TrackName{track, name};
+            return true;
+        }
+
+        void TraceRecorder::setEnabled(bool enabled)
+        {
+            _enabled = enabled;
+        }
+
+        bool TraceRecorder::isEnabled() const
+        {
+            return _enabled;
+        }
+
+        void TraceRecorder::clear()
+        {
+            _head = 0;
+        }
+
+        size_t TraceRecorder::size() const
+        {
+            return _head < SOC_TRACE_CAPACITY ? _head : SOC_TRACE_CAPACITY;
+        }
+
+        uint32_t TraceRecorder::dropped() const
+        {
+            return _head < SOC_TRACE_CAPACITY ? 0 : _head - SOC_TRACE_CAPACITY;
+        }
+
+        const TraceEvent &TraceRecorder::at(size_t index) const
+        {
+            uint32_t oldest = _head - static_cast<uint32_t>(size());
+            return _events[(oldest + index) & (SOC_TRACE_CAPACITY - 1)];
+        }
+
+        void TraceRecorder::serialize(ITraceSink &sink) const
+        {
+            // string table: every distinct name pointer once, track names first
+            std::vector<const char *> strings;
+            auto stringIndex = [&strings](const char *name) -> uint16_t
+            {
+                for (size_t i = 0; i < strings.size(); i++)
+                {
+                    if (strings[i] == name)
+                    {
+                        return static_cast<uint16_t>(i);
+                    }
+                }
+                strings.push_back(name);
+                return static_cast<uint16_t>(strings.size() - 1);
+            };
+
+            std::vector<uint16_t> trackStrings;
+            for (size_t i = 0; i < _trackCount; i++)
+            {
+                trackStrings.push_back(stringIndex(_tracks[i].name));
+            }
+            // tracks that recorded events without ever being named
+            std::vector<const void *> tracks;
+            for (size_t i = 0; i < _trackCount; i++)
+            {
+                tracks.push_back(_tracks[i].track);
+            }
+            static const char UNNAMED[] = "track";
+            std::vector<uint16_t> nameIndexes(size());
+            std::vector<uint16_t> trackIndexes(size());
+            for (size_t i = 0; i < size(); i++)
+            {
+                const TraceEvent &event = at(i);
+                nameIndexes[i] = stringIndex(event.name != nullptr ? event.name : UNNAMED);
+
+                trackIndexes[i] = NO_TRACK;
+                if (event.track == nullptr)
+                {
+                    continue;
+                }
+                for (size_t t = 0; t < tracks.size(); t++)
+                {
+                    if (tracks[t] == event.track)
+                    {
+                        trackIndexes[i] = static_cast<uint16_t>(t);
+                        break;
+                    }
+                }
+                if (trackIndexes[i] == NO_TRACK)
+                {
+                    tracks.push_back(event.track);
+                    trackStrings.push_back(stringIndex(UNNAMED));
+                    trackIndexes[i] = static_cast<uint16_t>(tracks.size() - 1);
+                }
+            }
+
+            BinaryWriter writer(sink);
+            writer.u32(FORMAT_MAGIC);
+            writer.u16(FORMAT_VERSION);
+            writer.u16(0);
+            writer.u32(static_cast<uint32_t>(strings.size()));
+            writer.u32(static_cast<uint32_t>(trackStrings.size()));
+            writer.u32(static_cast<uint32_t>(size()));
+
+            for (const char *string : strings)
+            {
+                size_t length = strlen(string);
+                if (length > 0xFFFF)
+                {
+                    length = 0xFFFF;
+                }
+                writer.u16(static_cast<uint16_t>(length));
+                writer.bytes(string, length);
+            }
+            for (uint16_t trackString : trackStrings)
+            {
+                writer.u16(trackString);
+            }
+            for (size_t i = 0; i < size(); i++)
+            {
+                const TraceEvent &event = at(i);
+                writer.u32(event.timeMicros);
+                writer.u16(nameIndexes[i]);
+                writer.u16(trackIndexes[i]);
+                writer.u32(static_cast<uint32_t>(event.value));
+                writer.u8(static_cast<uint8_t>(event.type));
+                writer.u8(0);
+                writer.u8(0);
+                writer.u8(0);
+            }
+        }
+    }
+}
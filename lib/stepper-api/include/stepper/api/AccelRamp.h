@@ -0,0 +1,101 @@
+#pragma once
+
+namespace stepper
+{
+    namespace api
+    {
+        /**
+         * @brief The speed profile of AccelStepper (David Austin's "Generate stepper-motor
+         * speed profiles in real time"), without the step generation.
+         *
+         * Keeps the position, the target and the interval to the next step. The owner
+         * times and executes the steps, counts each one with step() and, while it
+         * accelerates towards the target, computes the next interval with computeNewSpeed().
+         * Shared by the IStepperController backends that step by themselves, so their
+         * ramps cannot diverge.
+         */
+        class AccelRamp
+        {
+        public:
+            enum class Direction
+            {
+                CCW,
+                CW
+            };
+
+            /**
+             * @brief Same defaults as AccelStepper, a speed and an acceleration of 1.
+             */
+            AccelRamp();
+
+            void setMaxSpeed(float speed);
+            void setAcceleration(float acceleration);
+            void moveTo(long absoluteSteps);
+            void move(long relativeSteps);
+            long getCurrentPosition() const;
+            long getTargetPosition() const;
+
+            /**
+             * @brief Also stops the motor, like AccelStepper.
+             */
+            void setCurrentPosition(long absoluteSteps);
+            long distanceToGo() const;
+
+            /**
+             * @brief Sets the target to where the motor stops at the current deceleration.
+             */
+            void stop();
+
+            /**
+             * @brief Constant speed, limited to the maximum speed, see runSpeed() of AccelStepper.
+             */
+            void setSpeed(float speed);
+            float getSpeed() const;
+
+            /**
+             * @brief Microseconds from the last step to the next one, 0 for none.
+             */
+            unsigned long getStepInterval() const
+            {
+                return _stepInterval;
+            }
+
+            Direction getDirection() const
+            {
+                return _direction;
+            }
+
+            /**
+             * @brief True while the motor has a speed or a distance to go.
+             */
+            bool isRunning() const;
+
+            /**
+             * @brief Counts a step in the current direction.
+             */
+            void step()
+            {
+                _currentPos += (_direction == Direction::CW) ? 1 : -1;
+            }
+
+            /**
+             * @brief The interval to the next step towards the target, accelerating or
+             * decelerating. Call it after every step of a move.
+             */
+            void computeNewSpeed();
+
+        private:
+            long _currentPos;
+            long _targetPos;
+            float _speed;
+            float _maxSpeed;
+            float _acceleration;
+            unsigned long _stepInterval;
+            long _n;
+            float _c0;
+            float _cn;
+            float _cmin;
+            Direction _direction;
+        };
+    }
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stepper/api/MotionEvent.h>
+
+class IStepperMotor;
+
+namespace stepper
+{
+    namespace api
+    {
+        class IMotionListener
+        {
+        public:
+            virtual ~IMotionListener() = default;
+
+            /**
+             * @brief Called by the motor when a move or the homing ended, from its update() or
+             * from the command that ended at once. The listener may command the motor again.
+             */
+            virtual void onMotionEvent(IStepperMotor &motor, MotionEvent event) = 0;
+        };
+    }
+}
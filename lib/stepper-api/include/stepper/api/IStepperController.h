@@ -28,6 +28,18 @@ namespace stepper
 
             virtual bool run() = 0;
             virtual void stop() = 0;
+
+            // micros() time of the next step of run() or runSpeed(), calling them earlier does
+            // nothing. It is not later than micros() if a step is due now or none is planned,
+            // a command (moveTo(), setSpeed(), ...) may make the next step due earlier.
+            virtual unsigned long nextStepDueMicros() = 0;
+
+            // --- Constant speed mode, as in AccelStepper ---
+            // setSpeed() sets a signed speed in steps per second, limited by the max speed,
+            // runSpeed() steps at that speed without acceleration and ignores the target.
+            virtual void setSpeed(float speed) = 0;
+            virtual float getSpeed() = 0;
+            virtual bool runSpeed() = 0;
         };
     }
 }
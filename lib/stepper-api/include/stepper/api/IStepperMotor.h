@@ -1,5 +1,7 @@
 #pragma once
 
+#include "IMotionListener.h"
+#include "Result.h"
 #include "StepperMotorState.h"
 
 /**
@@ -10,6 +12,10 @@
  * frequently to process motor movements and state changes.
  *
  * Units are generally in degrees, degrees per second, and degrees per second squared.
+ * Commands and queries that can fail return a stepper::api::Status or Result with the
+ * StepperError, the interface throws no exceptions.
+ * The end of a move or of the homing is reported to the motion listeners, so a caller
+ * does not have to poll isBusy() or needsHoming() in every loop.
  */
 class IStepperMotor
 {
@@ -25,9 +31,10 @@ public:
      * that works with the state machine and update() method.
      * This current implementation is non-blocking and immediate.
      *
-     * @return True if the homing command was accepted (always true for this soft home), false otherwise.
+     * @return Ok if the homing was started, BUSY or HOMING_IN_PROGRESS while the motor is
+     * moving or homing, HOMING_REJECTED if the homing strategy could not begin.
      */
-    virtual bool home() = 0;
+    virtual stepper::api::Status home() = 0;
 
     virtual bool isHomingFailed() const = 0;
 
@@ -45,18 +52,49 @@ public:
      * Assumes the motor has been homed. 0 degrees is the homed position.
      *
      * @param degreesAbsolute The target absolute angular position in degrees.
-     * @return True if the move command was accepted (e.g., not busy, homed), false otherwise.
+     * @return Ok if the move was accepted, otherwise NOT_HOMED, HOMING_IN_PROGRESS, HOMING_FAILED or BUSY.
      */
-    virtual bool moveToAbsolute(double degreesAbsolute) = 0;
+    virtual stepper::api::Status moveToAbsolute(double degreesAbsolute) = 0;
+
+    /**
+     * @brief Commands the motor to move to an absolute position in (micro)steps, without any
+     * conversion from degrees. Otherwise the same as moveToAbsolute().
+     *
+     * @param stepsAbsolute The target absolute position in steps, 0 is the homed position.
+     * @return Ok if the move was accepted, otherwise the error as for moveToAbsolute().
+     */
+    virtual stepper::api::Status moveToStep(long stepsAbsolute) = 0;
+
+    /**
+     * @brief Steps (including microsteps) of one full revolution, to map positions to steps.
+     */
+    virtual long getStepsPerRevolution() const = 0;
 
     /**
      * @brief Commands the motor to rotate by a relative number of degrees from its current position.
      * This is a non-blocking call. `update()` must be called to perform the movement.
      *
      * @param degreesRelative The number of degrees to rotate. Positive for one direction, negative for the other.
-     * @return True if the rotation command was accepted (e.g., not busy), false otherwise.
+     * @return Ok if the rotation was accepted, otherwise HOMING_IN_PROGRESS, HOMING_FAILED or BUSY.
      */
-    virtual bool rotateRelative(double degreesRelative) = 0;
+    virtual stepper::api::Status rotateRelative(double degreesRelative) = 0;
+
+    /**
+     * @brief Runs the motor continuously at a constant velocity, without acceleration ramps.
+     * Calling it again while running changes the velocity at once, so keep the changes small.
+     * moveToAbsolute(), rotateRelative() and stop() end the velocity mode.
+     * This is a non-blocking call. `update()` must be called to perform the steps.
+     * Assumes the motor has been homed.
+     *
+     * @param degreesPerSecond Signed velocity, positive towards increasing positions.
+     * @return Ok if the command was accepted, otherwise the error as for moveToAbsolute().
+     */
+    virtual stepper::api::Status runAtVelocity(double degreesPerSecond) = 0;
+
+    /**
+     * @brief Checks if the motor runs in velocity mode, see runAtVelocity().
+     */
+    virtual bool isRunningAtVelocity() const = 0;
 
     /**
      * @brief Sets the target speed for subsequent movements.
@@ -73,12 +111,10 @@ public:
     /**
      * @brief Gets the current estimated angular position of the motor in degrees.
      * This position is relative to the homed (zero) position.
-     * Throws std::runtime_error if the motor has not been homed.
      *
-     * @return The current angular position in degrees.
-     * @throws std::runtime_error if needsHoming() is true.
+     * @return The current angular position in degrees, or NOT_HOMED if needsHoming() is true.
      */
-    virtual double getCurrentPositionDegrees() const = 0;
+    virtual stepper::api::Result<double> getCurrentPositionDegrees() const = 0;
 
     virtual stepper::api::StepperMotorState getState() const = 0;
 
@@ -111,4 +147,32 @@ public:
      * `update()` will handle the deceleration process.
      */
     virtual void stop() = 0;
+
+    /**
+     * @brief Checks if the motor is idle but waits to reduce the coil current, see the idle
+     * power management of the implementation. `update()` must still be called until then.
+     * @return True while a power down is due, false if the coils are settled or the motor is busy.
+     */
+    virtual bool isPowerDownPending() const = 0;
+
+    /**
+     * @brief Checks if update() has anything to do now. A move spends most of its time
+     * between two steps, update() would change nothing then and the caller may skip it.
+     * @return False while a move waits for its next step, true otherwise.
+     */
+    virtual bool isUpdateDue() const = 0;
+
+    /**
+     * @brief Registers a listener for the motion events, see stepper::api::MotionEvent.
+     * A move or velocity run ends with one MOVE_COMPLETE when the motor comes to rest, a
+     * move of zero steps reports it from the command. A move that takes over a velocity
+     * run reports once, at its own end. An accepted homing ends with HOMING_SUCCEEDED or
+     * HOMING_FAILED, a rejected one reports HOMING_FAILED from home().
+     * The listeners are kept in a fixed number of slots, nothing is allocated.
+     *
+     * @return False if all slots are taken.
+     */
+    virtual bool addMotionListener(stepper::api::IMotionListener &listener) = 0;
+
+    virtual void removeMotionListener(stepper::api::IMotionListener &listener) = 0;
 };
@@ -0,0 +1,15 @@
+#pragma once
+
+namespace stepper
+{
+    namespace api
+    {
+        // What an IStepperMotor reports to its IMotionListeners, once per transition.
+        enum class MotionEvent
+        {
+            MOVE_COMPLETE,    // a move, a velocity run or a stop() came to rest, the motor is idle
+            HOMING_SUCCEEDED, // the motor is at its home position and takes moves
+            HOMING_FAILED     // the homing could not begin or did not find home
+        };
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <stepper/api/IMotionListener.h>
+
+namespace stepper
+{
+    namespace api
+    {
+        /**
+         * @brief The listeners of one motor in a fixed array, adding and notifying never allocates.
+         * A motor has few listeners, e.g. its clock hand and a power or sleep manager.
+         */
+        class MotionListeners
+        {
+        public:
+            static const size_t CAPACITY = 4;
+
+            MotionListeners() : _listeners{}, _count(0) {}
+
+            /**
+             * @return False if all slots are taken. Adding a listener twice keeps one slot.
+             */
+            bool add(IMotionListener &listener)
+            {
+                for (size_t i = 0; i < _count; i++)
+                {
+                    if (_listeners[i] == &listener)
+                    {
+                        return true;
+                    }
+                }
+                if (_count == CAPACITY)
+                {
+                    return false;
+                }
+                _listeners[_count++] = &listener;
+                return true;
+            }
+
+            void remove(IMotionListener &listener)
+            {
+                for (size_t i = 0; i < _count; i++)
+                {
+                    if (_listeners[i] == &listener)
+                    {
+                        _listeners[i] = _listeners[--_count];
+                        return;
+                    }
+                }
+            }
+
+            void notify(IStepperMotor &motor, MotionEvent event) const
+            {
+                for (size_t i = 0; i < _count; i++)
+                {
+                    _listeners[i]->onMotionEvent(motor, event);
+                }
+            }
+
+            size_t size() const
+            {
+                return _count;
+            }
+
+        private:
+            IMotionListener *_listeners[CAPACITY];
+            size_t _count;
+        };
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <stepper/api/StepperError.h>
+
+namespace stepper
+{
+    namespace api
+    {
+        /**
+         * @brief The value of a query or the error why there is none, like std::expected but
+         * without exceptions: the firmware is built with -fno-exceptions. A failed result holds
+         * a value initialised T, value() never aborts. Check it before using the value:
+         *
+         *     Result<double> position = motor.getCurrentPositionDegrees();
+         *     if (!position)
+         *         logger.error("no position: %s", stepperErrorName(position.error()));
+         */
+        template <typename T>
+        class Result
+        {
+        public:
+            Result(const T &value) : _value(value), _error(StepperError::NONE) {}
+            Result(StepperError error) : _value(), _error(error) {}
+
+            bool hasValue() const { return _error == StepperError::NONE; }
+            explicit operator bool() const { return hasValue(); }
+
+            const T &value() const { return _value; }
+            T valueOr(const T &fallback) const { return hasValue() ? _value : fallback; }
+            StepperError error() const { return _error; }
+
+        private:
+            T _value;
+            StepperError _error;
+        };
+
+        /**
+         * @brief The outcome of a command: accepted, or the error why not.
+         */
+        template <>
+        class Result<void>
+        {
+        public:
+            Result(StepperError error) : _error(error) {}
+
+            static Result ok() { return Result(StepperError::NONE); }
+
+            bool hasValue() const { return _error == StepperError::NONE; }
+            explicit operator bool() const { return hasValue(); }
+
+            StepperError error() const { return _error; }
+
+        private:
+            StepperError _error;
+        };
+
+        using Status = Result<void>;
+    }
+}
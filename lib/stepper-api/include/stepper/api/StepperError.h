@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+
+namespace stepper
+{
+    namespace api
+    {
+        /**
+         * @brief Why a motor rejected a command or cannot answer a query.
+         */
+        enum class StepperError : uint8_t
+        {
+            NONE,               // no error, the command was accepted
+            NOT_HOMED,          // the position is unknown until the motor was homed
+            HOMING_IN_PROGRESS, // the motor is homing, it takes no other command
+            HOMING_FAILED,      // the last homing failed, home the motor again
+            HOMING_REJECTED,    // the homing strategy could not begin, e.g. the switch is broken
+            BUSY                // a position move is in progress, wait for it or stop() it
+        };
+
+        inline const char *stepperErrorName(StepperError error)
+        {
+            switch (error)
+            {
+            case StepperError::NONE:
+                return "NONE";
+            case StepperError::NOT_HOMED:
+                return "NOT_HOMED";
+            case StepperError::HOMING_IN_PROGRESS:
+                return "HOMING_IN_PROGRESS";
+            case StepperError::HOMING_FAILED:
+                return "HOMING_FAILED";
+            case StepperError::HOMING_REJECTED:
+                return "HOMING_REJECTED";
+            case StepperError::BUSY:
+                return "BUSY";
+            }
+            return "UNKNOWN";
+        }
+    }
+}
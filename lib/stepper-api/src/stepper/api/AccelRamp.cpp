@@ -0,0 +1,226 @@
+#include <stepper/api/AccelRamp.h>
+#include <algorithm>
+#include <cmath>
+
+namespace stepper
+{
+    namespace api
+    {
+        AccelRamp::AccelRamp()
+            : _currentPos(0),
+              _targetPos(0),
+              _speed(0.0),
+              _maxSpeed(0.0),
+              _acceleration(0.0),
+              _stepInterval(0),
+              _n(0),
+              _c0(0.0),
+              _cn(0.0),
+              _cmin(1.0),
+              _direction(Direction::CCW)
+        {
+            // same defaults as AccelStepper
+            setAcceleration(1);
+            setMaxSpeed(1);
+        }
+
+        void AccelRamp::setMaxSpeed(float speed)
+        {
+            if (speed < 0.0)
+            {
+                speed = -speed;
+            }
+            if (_maxSpeed != speed)
+            {
+                _maxSpeed = speed;
+                _cmin = 1000000.0 / speed;
+                // Recompute _n from current speed and adjust speed if accelerating or cruising
+                if (_n > 0)
+                {
+                    _n = (long)((_speed * _speed) / (2.0 * _acceleration));
+                    computeNewSpeed();
+                }
+            }
+        }
+
+        void AccelRamp::setAcceleration(float acceleration)
+        {
+            if (acceleration == 0.0)
+            {
+                return;
+            }
+            if (acceleration < 0.0)
+            {
+                acceleration = -acceleration;
+            }
+            if (_acceleration != acceleration)
+            {
+                // Recompute _n per Equation 17
+                _n = _n * (_acceleration / acceleration);
+                // New c0 per Equation 7, with correction per Equation 15
+                _c0 = 0.676 * std::sqrt(2.0 / acceleration) * 1000000.0;
+                _acceleration = acceleration;
+                computeNewSpeed();
+            }
+        }
+
+        void AccelRamp::moveTo(long absoluteSteps)
+        {
+            if (_targetPos != absoluteSteps)
+            {
+                _targetPos = absoluteSteps;
+                computeNewSpeed();
+            }
+        }
+
+        void AccelRamp::move(long relativeSteps)
+        {
+            moveTo(_currentPos + relativeSteps);
+        }
+
+        long AccelRamp::getCurrentPosition() const
+        {
+            return _currentPos;
+        }
+
+        long AccelRamp::getTargetPosition() const
+        {
+            return _targetPos;
+        }
+
+        void AccelRamp::setCurrentPosition(long absoluteSteps)
+        {
+            _targetPos = _currentPos = absoluteSteps;
+            _n = 0;
+            _stepInterval = 0;
+            _speed = 0.0;
+        }
+
+        long AccelRamp::distanceToGo() const
+        {
+            return _targetPos - _currentPos;
+        }
+
+        void AccelRamp::stop()
+        {
+            if (_speed != 0.0)
+            {
+                long stepsToStop = (long)((_speed * _speed) / (2.0 * _acceleration)) + 1; // Equation 16 (+integer rounding)
+                if (_speed > 0)
+                {
+                    move(stepsToStop);
+                }
+                else
+                {
+                    move(-stepsToStop);
+                }
+            }
+        }
+
+        void AccelRamp::setSpeed(float speed)
+        {
+            if (speed == _speed)
+            {
+                return;
+            }
+            speed = std::max(-_maxSpeed, std::min(speed, _maxSpeed));
+            if (speed == 0.0)
+            {
+                _stepInterval = 0;
+            }
+            else
+            {
+                _stepInterval = fabs(1000000.0 / speed);
+                _direction = (speed > 0.0) ? Direction::CW : Direction::CCW;
+            }
+            _speed = speed;
+        }
+
+        float AccelRamp::getSpeed() const
+        {
+            return _speed;
+        }
+
+        bool AccelRamp::isRunning() const
+        {
+            return _speed != 0.0 || distanceToGo() != 0;
+        }
+
+        void AccelRamp::computeNewSpeed()
+        {
+            long distanceTo = distanceToGo();
+            long stepsToStop = (long)((_speed * _speed) / (2.0 * _acceleration)); // Equation 16
+
+            if (distanceTo == 0 && stepsToStop <= 1)
+            {
+                // We are at the target and its time to stop
+                _stepInterval = 0;
+                _speed = 0.0;
+                _n = 0;
+                return;
+            }
+
+            if (distanceTo > 0)
+            {
+                // We are anticlockwise from the target
+                // Need to go clockwise from here, maybe decelerate now
+                if (_n > 0)
+                {
+                    // Currently accelerating, need to decel now? Or maybe going the wrong way?
+                    if ((stepsToStop >= distanceTo) || _direction == Direction::CCW)
+                    {
+                        _n = -stepsToStop; // Start deceleration
+                    }
+                }
+                else if (_n < 0)
+                {
+                    // Currently decelerating, need to accel again?
+                    if ((stepsToStop < distanceTo) && _direction == Direction::CW)
+                    {
+                        _n = -_n; // Start accceleration
+                    }
+                }
+            }
+            else if (distanceTo < 0)
+            {
+                // We are clockwise from the target
+                // Need to go anticlockwise from here, maybe decelerate
+                if (_n > 0)
+                {
+                    if ((stepsToStop >= -distanceTo) || _direction == Direction::CW)
+                    {
+                        _n = -stepsToStop; // Start deceleration
+                    }
+                }
+                else if (_n < 0)
+                {
+                    if ((stepsToStop < -distanceTo) && _direction == Direction::CCW)
+                    {
+                        _n = -_n; // Start accceleration
+                    }
+                }
+            }
+
+            // Need to accelerate or decelerate
+            if (_n == 0)
+            {
+                // First step from stopped
+                _cn = _c0;
+                _direction = (distanceTo > 0) ? Direction::CW : Direction::CCW;
+            }
+            else
+            {
+                // Subsequent step. Works for accel (n is +_ve) and decel (n is -ve).
+                _cn = _cn - ((2.0 * _cn) / ((4.0 * _n) + 1)); // Equation 13
+                _cn = std::max(_cn, _cmin);
+            }
+            _n++;
+            _stepInterval = _cn;
+            _speed = 1000000.0 / _cn;
+            if (_direction == Direction::CCW)
+            {
+                _speed = -_speed;
+            }
+        }
+    }
+}
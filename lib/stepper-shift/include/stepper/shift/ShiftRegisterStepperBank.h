@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <soc/api/IShiftOutput.h>
+#include <stepper/shift/ShiftRegisterStepperController.h>
+
+namespace stepper
+{
+    namespace shift
+    {
+        /**
+         * @brief Step scheduler for many motors whose step, dir and enable pins hang off
+         * a chain of 74HC595 shift registers.
+         *
+         * Every motor owns a nibble of the chain: bit 0 step, bit 1 dir, bit 2 enable,
+         * two motors per register, motor 0 in the low nibble of the register next to the
+         * microcontroller. run() is the only place that steps: it reads the time once,
+         * collects the due steps of all motors and writes them in one burst, a frame with
+         * the step pins high followed by one with them low. A direction or enable change
+         * is latched before the motor's next step, never together with it, so the driver
+         * always sees the setup time of one tick. Loops without a due step or a pin change
+         * do not touch the bus.
+         */
+        class ShiftRegisterStepperBank
+        {
+        public:
+            static const size_t MOTORS_PER_REGISTER = 2;
+
+            ShiftRegisterStepperBank(soc::api::IShiftOutput &output, size_t motorCount);
+
+            /**
+             * @brief Starts the bus and latches the initial state of all motors.
+             */
+            void begin();
+
+            /**
+             * @brief Steps all due motors, call it once per loop.
+             * @return True if a burst has been written.
+             */
+            bool run();
+
+            ShiftRegisterStepperController &controller(size_t motor);
+
+            size_t getMotorCount() const;
+            size_t getRegisterCount() const;
+            unsigned long getBurstCount() const;
+            unsigned long getStepCount() const;
+
+        private:
+            soc::api::IShiftOutput &_output;
+            std::vector<std::unique_ptr<ShiftRegisterStepperController>> _controllers;
+            std::vector<uint8_t> _latched;  // outputs of every motor with the step pin low
+            std::vector<uint8_t> _frames;   // step frame followed by the idle frame, in shift order
+            std::vector<size_t> _stepping;  // motors stepping in the current burst
+            const size_t _registerCount;
+
+            unsigned long _burstCount;
+            unsigned long _stepCount;
+
+            void setNibble(uint8_t *frame, size_t motor, uint8_t bits) const;
+        };
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <stepper/api/AccelRamp.h>
+#include <stepper/api/IStepperController.h>
+
+namespace stepper
+{
+    namespace shift
+    {
+        /**
+         * @brief One motor of a ShiftRegisterStepperBank.
+         *
+         * Keeps the AccelStepper ramp of the motor, see stepper::api::AccelRamp, but does
+         * not step by itself: the bank steps all motors in its run(). run() and runSpeed()
+         * only select how the next step interval is computed, with or without acceleration,
+         * and report whether the motor is still moving. The enable pin is a bit in the shift chain, setEnablePin() is ignored.
+         */
+        class ShiftRegisterStepperController : public stepper::api::IStepperController
+        {
+        public:
+            // bits of a motor in its nibble of the shift chain
+            static const uint8_t STEP_BIT = 0x01;
+            static const uint8_t DIR_BIT = 0x02;
+            static const uint8_t ENABLE_BIT = 0x04;
+
+            ShiftRegisterStepperController();
+
+            // --- IStepperController Interface Implementation ---
+            void setEnablePin(uint8_t enablePin) override;
+            void setPinsInverted(bool dirInvert, bool stepInvert, bool enableInvert) override;
+            void enableOutputs() override;
+            void disableOutputs() override;
+            void setMaxSpeed(float speed) override;
+            void setAcceleration(float acceleration) override;
+            void moveTo(long absoluteSteps) override;
+            void move(long relativeSteps) override;
+            long getCurrentPosition() override;
+            void setCurrentPosition(long absoluteSteps) override;
+            long distanceToGo() override;
+            bool run() override;
+            void stop() override;
+            unsigned long nextStepDueMicros() override;
+            void setSpeed(float speed) override;
+            float getSpeed() override;
+            bool runSpeed() override;
+
+            // --- Used by ShiftRegisterStepperBank ---
+
+            /**
+             * @brief Output bits of the motor with the step pin high or low, inversion applied.
+             */
+            uint8_t outputs(bool stepHigh) const
+            {
+                uint8_t bits = _enableInvert ? 0 : ENABLE_BIT;
+                if (!_outputsEnabled)
+                {
+                    bits ^= ENABLE_BIT;
+                }
+                if ((_ramp.getDirection() == stepper::api::AccelRamp::Direction::CW) != _dirInvert)
+                {
+                    bits |= DIR_BIT;
+                }
+                if (stepHigh != _stepInvert)
+                {
+                    bits |= STEP_BIT;
+                }
+                return bits;
+            }
+
+            bool isStepDue(unsigned long nowMicros) const
+            {
+                unsigned long stepInterval = _ramp.getStepInterval();
+                return stepInterval != 0 && nowMicros - _lastStepTime >= stepInterval;
+            }
+
+            /**
+             * @brief Counts the step the bank latches now and computes the next interval.
+             */
+            void step(unsigned long nowMicros);
+
+        private:
+            stepper::api::AccelRamp _ramp;
+            unsigned long _lastStepTime;
+            bool _outputsEnabled;
+            bool _constantSpeed;
+            bool _dirInvert;
+            bool _stepInvert;
+            bool _enableInvert;
+        };
+    }
+}
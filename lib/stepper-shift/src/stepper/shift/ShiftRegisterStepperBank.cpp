@@ -0,0 +1,121 @@
+#include <stepper/shift/ShiftRegisterStepperBank.h>
+#include <Arduino.h>
+#include <cstring>
+
+namespace stepper
+{
+    namespace shift
+    {
+        ShiftRegisterStepperBank::ShiftRegisterStepperBank(soc::api::IShiftOutput &output, size_t motorCount)
+            : _output(output),
+              _latched(motorCount, 0),
+              _stepping(motorCount, 0),
+              _registerCount((motorCount + MOTORS_PER_REGISTER - 1) / MOTORS_PER_REGISTER),
+              _burstCount(0),
+              _stepCount(0)
+        {
+            _controllers.reserve(motorCount);
+            for (size_t motor = 0; motor < motorCount; motor++)
+            {
+                _controllers.push_back(std::make_unique<ShiftRegisterStepperController>());
+            }
+            _frames.assign(2 * _registerCount, 0);
+        }
+
+        void ShiftRegisterStepperBank::begin()
+        {
+            uint8_t *idleFrame = _frames.data() + _registerCount;
+            for (size_t motor = 0; motor < _controllers.size(); motor++)
+            {
+                _latched[motor] = _controllers[motor]->outputs(false);
+                setNibble(idleFrame, motor, _latched[motor]);
+            }
+            _output.begin();
+            _output.writeFrames(idleFrame, _registerCount, 1);
+            _burstCount++;
+        }
+
+        bool ShiftRegisterStepperBank::run()
+        {
+            unsigned long now = micros();
+            uint8_t *stepFrame = _frames.data();
+            uint8_t *idleFrame = _frames.data() + _registerCount;
+
+            bool pinsChanged = false;
+            size_t steppingCount = 0;
+            for (size_t motor = 0; motor < _controllers.size(); motor++)
+            {
+                ShiftRegisterStepperController &controller = *_controllers[motor];
+                uint8_t idle = controller.outputs(false);
+                if (idle != _latched[motor])
+                {
+                    // dir or enable first, a due step waits for the next run()
+                    _latched[motor] = idle;
+                    setNibble(idleFrame, motor, idle);
+                    pinsChanged = true;
+                    continue;
+                }
+                if (controller.isStepDue(now))
+                {
+                    controller.step(now);
+                    _stepping[steppingCount++] = motor;
+                }
+            }
+
+            if (steppingCount == 0)
+            {
+                if (!pinsChanged)
+                {
+                    return false;
+                }
+                _output.writeFrames(idleFrame, _registerCount, 1);
+                _burstCount++;
+                return true;
+            }
+
+            memcpy(stepFrame, idleFrame, _registerCount);
+            for (size_t i = 0; i < steppingCount; i++)
+            {
+                size_t motor = _stepping[i];
+                setNibble(stepFrame, motor, _latched[motor] ^ ShiftRegisterStepperController::STEP_BIT);
+            }
+            _output.writeFrames(_frames.data(), _registerCount, 2);
+            _burstCount++;
+            _stepCount += steppingCount;
+            return true;
+        }
+
+        ShiftRegisterStepperController &ShiftRegisterStepperBank::controller(size_t motor)
+        {
+            return *_controllers[motor];
+        }
+
+        size_t ShiftRegisterStepperBank::getMotorCount() const
+        {
+            return _controllers.size();
+        }
+
+        size_t ShiftRegisterStepperBank::getRegisterCount() const
+        {
+            return _registerCount;
+        }
+
+        unsigned long ShiftRegisterStepperBank::getBurstCount() const
+        {
+            return _burstCount;
+        }
+
+        unsigned long ShiftRegisterStepperBank::getStepCount() const
+        {
+            return _stepCount;
+        }
+
+        void ShiftRegisterStepperBank::setNibble(uint8_t *frame, size_t motor, uint8_t bits) const
+        {
+            // the first byte of a frame is shifted through to the last register
+            size_t byte = _registerCount - 1 - motor / MOTORS_PER_REGISTER;
+            unsigned shift = (motor % MOTORS_PER_REGISTER) * 4;
+            frame[byte] = static_cast<uint8_t>((frame[byte] & ~(0x0F << shift)) | ((bits & 0x0F) << shift));
+        }
+    }
+}
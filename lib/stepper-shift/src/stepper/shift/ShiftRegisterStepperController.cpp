@@ -0,0 +1,130 @@
+#include <stepper/shift/ShiftRegisterStepperController.h>
+#include <Arduino.h>
+
+namespace stepper
+{
+    namespace shift
+    {
+        ShiftRegisterStepperController::ShiftRegisterStepperController()
+            : _ramp(),
+              _lastStepTime(0),
+              _outputsEnabled(true),
+              _constantSpeed(false),
+              _dirInvert(false),
+              _stepInvert(false),
+              _enableInvert(false)
+        {
+        }
+
+        void ShiftRegisterStepperController::setEnablePin(uint8_t /*enablePin*/)
+        {
+        }
+
+        void ShiftRegisterStepperController::setPinsInverted(bool dirInvert, bool stepInvert, bool enableInvert)
+        {
+            _dirInvert = dirInvert;
+            _stepInvert = stepInvert;
+            _enableInvert = enableInvert;
+        }
+
+        void ShiftRegisterStepperController::enableOutputs()
+        {
+            _outputsEnabled = true;
+        }
+
+        void ShiftRegisterStepperController::disableOutputs()
+        {
+            _outputsEnabled = false;
+        }
+
+        void ShiftRegisterStepperController::setMaxSpeed(float speed)
+        {
+            _ramp.setMaxSpeed(speed);
+        }
+
+        void ShiftRegisterStepperController::setAcceleration(float acceleration)
+        {
+            _ramp.setAcceleration(acceleration);
+        }
+
+        void ShiftRegisterStepperController::moveTo(long absoluteSteps)
+        {
+            _constantSpeed = false;
+            _ramp.moveTo(absoluteSteps);
+        }
+
+        void ShiftRegisterStepperController::move(long relativeSteps)
+        {
+            moveTo(_ramp.getCurrentPosition() + relativeSteps);
+        }
+
+        long ShiftRegisterStepperController::getCurrentPosition()
+        {
+            return _ramp.getCurrentPosition();
+        }
+
+        void ShiftRegisterStepperController::setCurrentPosition(long absoluteSteps)
+        {
+            _ramp.setCurrentPosition(absoluteSteps);
+        }
+
+        long ShiftRegisterStepperController::distanceToGo()
+        {
+            return _ramp.distanceToGo();
+        }
+
+        bool ShiftRegisterStepperController::run()
+        {
+            _constantSpeed = false;
+            return _ramp.isRunning();
+        }
+
+        void ShiftRegisterStepperController::stop()
+        {
+            // stopping moves to where the motor comes to rest, with acceleration
+            if (_ramp.getSpeed() != 0.0)
+            {
+                _constantSpeed = false;
+            }
+            _ramp.stop();
+        }
+
+        unsigned long ShiftRegisterStepperController::nextStepDueMicros()
+        {
+            // the bank latches the step, the motor sees it in the first run() after that
+            unsigned long now = micros();
+            if (_ramp.getStepInterval() == 0 || isStepDue(now))
+            {
+                return now;
+            }
+            return _lastStepTime + _ramp.getStepInterval();
+        }
+
+        void ShiftRegisterStepperController::setSpeed(float speed)
+        {
+            _constantSpeed = true;
+            _ramp.setSpeed(speed);
+        }
+
+        float ShiftRegisterStepperController::getSpeed()
+        {
+            return _ramp.getSpeed();
+        }
+
+        bool ShiftRegisterStepperController::runSpeed()
+        {
+            _constantSpeed = true;
+            return _ramp.getStepInterval() != 0;
+        }
+
+        void ShiftRegisterStepperController::step(unsigned long nowMicros)
+        {
+            _ramp.step();
+            _lastStepTime = nowMicros;
+            if (!_constantSpeed)
+            {
+                _ramp.computeNewSpeed();
+            }
+        }
+    }
+}
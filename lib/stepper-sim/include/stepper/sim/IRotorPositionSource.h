@@ -0,0 +1,25 @@
+#pragma once
+
+namespace stepper
+{
+    namespace sim
+    {
+        /**
+         * @brief Source of the physical rotor position of a simulated motor.
+         *
+         * In contrast to IStepperController::getCurrentPosition(), this position is
+         * never changed by setCurrentPosition(). It is what sensors like a limit switch
+         * mounted on the dial actually see.
+         */
+        class IRotorPositionSource
+        {
+        public:
+            virtual ~IRotorPositionSource() = default;
+
+            /**
+             * @return The physical rotor position in (micro)steps.
+             */
+            virtual long getRotorPosition() const = 0;
+        };
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+namespace stepper
+{
+    namespace sim
+    {
+        /**
+         * @brief Distribution of the virtual time one main loop iteration takes.
+         *
+         * Step generators like AccelStepper can only step when run() is called, so the
+         * loop latency directly shapes the step timing. The simulation draws the
+         * duration of every iteration from this model.
+         */
+        class LoopLatencyModel
+        {
+        public:
+            enum class Kind
+            {
+                CONSTANT, // every iteration takes baseMicros
+                UNIFORM,  // uniformly between baseMicros and maxMicros
+                SPIKY     // baseMicros, with occasional spikes of spikeMicros (e.g. a blocking log)
+            };
+
+            static LoopLatencyModel constant(unsigned long micros);
+            static LoopLatencyModel uniform(unsigned long minMicros, unsigned long maxMicros, uint32_t seed = 1);
+            static LoopLatencyModel spiky(unsigned long baseMicros,
+                                          double spikeProbability,
+                                          unsigned long spikeMicros,
+                                          uint32_t seed = 1);
+
+            /**
+             * @return The duration of the next loop iteration in microseconds, at least 1.
+             */
+            unsigned long next();
+
+            Kind getKind() const;
+            double getMeanMicros() const;
+
+        private:
+            LoopLatencyModel(Kind kind,
+                             unsigned long baseMicros,
+                             unsigned long maxMicros,
+                             double spikeProbability,
+                             unsigned long spikeMicros,
+                             uint32_t seed);
+
+            Kind _kind;
+            unsigned long _baseMicros;
+            unsigned long _maxMicros;
+            double _spikeProbability;
+            unsigned long _spikeMicros;
+            std::mt19937 _random;
+        };
+    }
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstdint>
+#include <soc/api/IPwmOutput.h>
+#include <stepper/api/IStepperController.h>
+#include <stepper/sim/IRotorPositionSource.h>
+
+namespace stepper
+{
+    namespace sim
+    {
+        /**
+         * @brief IStepperController decorator that feeds the steps of another controller
+         * into a physical model of a hybrid stepper motor with a hand attached.
+         *
+         * The decorated controller generates the steps (e.g. a SimulatedStepperController).
+         * Every executed step advances the commanded field angle. The rotor follows it
+         * through the motor torque T(w) * sin(Nr * (commanded - rotor)), against inertia,
+         * friction, damping and an unbalanced hand. If the rotor lags more than one full
+         * step behind the field it is past the peak torque and cannot follow anymore,
+         * if it lags more than two full steps it falls back to the next stable position
+         * and four full steps are lost.
+         *
+         * The driver is modelled as a constant current chopper: while enabled both coils
+         * draw the rated current, whether the rotor moves or not. After the driver is
+         * enabled the current, and with it the torque, rises with the time constant of
+         * the coils. Disabled, the rotor is left to the detent torque and falls into a
+         * full step. The controller is also the PWM output on the enable pin, the duty
+         * scales the current for a reduced hold current. The energy is the copper loss
+         * of both phases, I^2 * R.
+         *
+         * The model is integrated lazily in virtual time (micros() of the arduino mock)
+         * and sleeps while the rotor is at rest, so long simulations stay cheap.
+         */
+        class PhysicsStepperController : public stepper::api::IStepperController,
+                                         public IRotorPositionSource,
+                                         public soc::api::IPwmOutput
+        {
+        public:
+            struct Config
+            {
+                int fullStepsPerRevolution;    // 200 for a 1.8 degree motor
+                int microsteps;                // microsteps per full step of the driver
+                double holdingTorqueNm;        // torque at standstill and up to the corner speed
+                double detentTorqueNm;         // cogging towards the full steps, also when disabled
+                double cornerSpeedRps;         // above this the torque falls off with 1/w
+                double rotorInertiaKgM2;       // rotor inertia from the datasheet
+                double loadInertiaKgM2;        // inertia of hand and gears, reflected to the rotor
+                double frictionTorqueNm;       // coulomb friction
+                double dampingNmsPerRad;       // viscous and back-EMF damping
+                double unbalanceTorqueNm;      // gravity on an unbalanced hand, peak value
+                double ratedCurrentA;          // phase current set at the driver
+                double phaseResistanceOhm;     // resistance of one coil
+                unsigned long currentRiseMicros; // time constant of the coil current after a change
+                unsigned long integrationStepMicros;
+            };
+
+            /**
+             * @brief A small NEMA 17 with a light hand, useful defaults for tuning.
+             */
+            static Config defaultConfig();
+
+            PhysicsStepperController(stepper::api::IStepperController &stepGenerator,
+                                     const Config &config,
+                                     long initialRotorPosition = 0);
+
+            // --- IStepperController Interface Implementation ---
+            void setEnablePin(uint8_t enablePin) override;
+            void setPinsInverted(bool dirInvert, bool stepInvert, bool enableInvert) override;
+            void enableOutputs() override;
+            void disableOutputs() override;
+            void setMaxSpeed(float speed) override;
+            void setAcceleration(float acceleration) override;
+            void moveTo(long absoluteSteps) override;
+            void move(long relativeSteps) override;
+            long getCurrentPosition() override;
+            void setCurrentPosition(long absoluteSteps) override;
+            long distanceToGo() override;
+            bool run() override;
+            void stop() override;
+            unsigned long nextStepDueMicros() override;
+            void setSpeed(float speed) override;
+            float getSpeed() override;
+            bool runSpeed() override;
+
+            // --- IRotorPositionSource Interface Implementation ---
+            long getRotorPosition() const override;
+
+            // --- IPwmOutput Interface Implementation, the enable pin ---
+            void begin() override;
+            void setDuty(uint16_t duty) override;
+
+            /**
+             * @brief Integrates the model up to the current virtual time.
+             * Called by run(), call it directly to let the rotor settle after a move.
+             */
+            void settle();
+
+            // --- Simulation results, positions in physical (micro)steps ---
+            long getCommandedRotorPosition() const;
+            double getExactRotorPosition() const;
+            double getRotorSpeedStepsPerSec() const;
+            bool isAtRest() const;
+
+            /** @brief Largest distance between commanded and actual rotor position, in microsteps. */
+            double getMaxLagSteps() const;
+            /** @brief Steps issued while the rotor was already past the peak torque angle. */
+            unsigned long getUnfollowableSteps() const;
+            /** @brief Times the rotor fell back or jumped ahead to another stable position. */
+            unsigned long getSlipEvents() const;
+            /** @brief Steps currently lost, a multiple of four full steps. */
+            long getLostSteps() const;
+            uint64_t getExecutedSteps() const;
+            /** @brief Time the driver was enabled since the statistics were reset. */
+            unsigned long getEnabledMicros() const;
+            /** @brief Average coil current, both phases summed, since the statistics were reset, in A. */
+            double getAverageCurrentA() const;
+            /** @brief Energy dissipated in the coils since the statistics were reset, in J. */
+            double getEnergyJ() const;
+            /**
+             * @brief Average coil power since the statistics were reset, relative to both phases
+             * at the rated current. Unlike the enabled time it weighs a reduced hold current.
+             */
+            double getAveragePowerFraction() const;
+            /** @brief Current of one phase relative to the rated current, with the rise after a change. */
+            double getCurrentFraction() const;
+
+            void resetStatistics();
+
+        private:
+            stepper::api::IStepperController &_stepGenerator;
+            const Config _config;
+            const double _radiansPerStep;
+            const double _polePairs;
+
+            bool _enabled;
+            long _lastGeneratorPosition;
+            long _commandedPosition;
+
+            double _rotorAngle;        // radians
+            double _rotorSpeed;        // radians per second
+            unsigned long _lastIntegrationMicros;
+            bool _atRest;
+
+            double _maxLagSteps;
+            unsigned long _unfollowableSteps;
+            unsigned long _slipEvents;
+            uint64_t _executedSteps;
+            long _stablePositionIndex;
+
+            unsigned long _statisticsStartMicros;
+            unsigned long _enabledSinceMicros;
+            unsigned long _enabledMicros;   // completed enabled periods since the reset
+
+            double _dutyFraction;           // of the PWM on the enable pin
+            double _currentFrom;            // current fraction when it last changed
+            unsigned long _currentChangeMicros;
+            double _chargeAs;               // both phases, completed periods since the reset
+            double _energyJ;
+            unsigned long _accountedMicros;
+
+            void integrateTo(unsigned long nowMicros);
+            void integrationStep(double dt);
+            double availableTorque(double rotorSpeed) const;
+            double detentTorque() const;
+            double targetCurrentFraction() const;
+            double currentFractionAt(unsigned long atMicros) const;
+            void changeCurrent();
+            void accountEnergy();
+            double electricalLag() const;
+            void trackGeneratorSteps();
+        };
+    }
+}
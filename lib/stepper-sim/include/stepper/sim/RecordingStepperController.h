@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <stepper/api/IStepperController.h>
+
+namespace stepper
+{
+    namespace sim
+    {
+        /**
+         * @brief IStepperController decorator that timestamps every executed step.
+         *
+         * A step is detected by a position change across run() or runSpeed(). Steps are
+         * grouped into moves: a move starts with every new target and ends with the next
+         * one, a stop(), a setCurrentPosition() or a setSpeed(). Moves that did not start
+         * from standstill or were cut short are marked, an analyzer cannot compare them
+         * with an ideal profile. Steps of the constant speed mode belong to no move.
+         */
+        class RecordingStepperController : public stepper::api::IStepperController
+        {
+        public:
+            struct StepRecord
+            {
+                unsigned long timeMicros;
+                long position;
+            };
+
+            struct MoveRecord
+            {
+                long startPosition;
+                long targetPosition;
+                float maxSpeed;         // steps per second
+                float acceleration;     // steps per second squared
+                size_t firstStep;       // index into getSteps()
+                size_t stepCount;
+                bool fromStandstill;
+                bool interrupted;
+            };
+
+            explicit RecordingStepperController(stepper::api::IStepperController &stepperController);
+
+            // --- IStepperController Interface Implementation ---
+            void setEnablePin(uint8_t enablePin) override;
+            void setPinsInverted(bool dirInvert, bool stepInvert, bool enableInvert) override;
+            void enableOutputs() override;
+            void disableOutputs() override;
+            void setMaxSpeed(float speed) override;
+            void setAcceleration(float acceleration) override;
+            void moveTo(long absoluteSteps) override;
+            void move(long relativeSteps) override;
+            long getCurrentPosition() override;
+            void setCurrentPosition(long absoluteSteps) override;
+            long distanceToGo() override;
+            bool run() override;
+            void stop() override;
+            unsigned long nextStepDueMicros() override;
+            void setSpeed(float speed) override;
+            float getSpeed() override;
+            bool runSpeed() override;
+
+            const std::vector<StepRecord> &getSteps() const;
+            const std::vector<MoveRecord> &getMoves() const;
+
+            /**
+             * @brief Drops all recorded steps and moves, e.g. after they have been analyzed.
+             */
+            void clear();
+
+        private:
+            stepper::api::IStepperController &_stepperController;
+            std::vector<StepRecord> _steps;
+            std::vector<MoveRecord> _moves;
+            float _maxSpeed;
+            float _acceleration;
+            bool _running;
+            bool _moveOpen;
+
+            void beginMove(long absoluteSteps);
+            void closeMove(bool interrupted);
+        };
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <soc/api/IDigitalInput.h>
+#include <stepper/sim/IRotorPositionSource.h>
+
+namespace stepper
+{
+    namespace sim
+    {
+        /**
+         * @brief Limit switch mounted at a fixed physical rotor position.
+         *
+         * The switch is active as soon as the rotor reaches its position, and stays
+         * active beyond it, like a hand pressing against a lever.
+         */
+        class SimulatedLimitSwitch : public soc::api::IDigitalInput
+        {
+        public:
+            /**
+             * @param rotor Source of the physical rotor position.
+             * @param switchPosition Physical position of the switch in steps.
+             * @param triggerDirectionSign -1 if the switch triggers at and below its position,
+             * +1 if it triggers at and above it. Matches the homing moveDirectionSign.
+             */
+            SimulatedLimitSwitch(const IRotorPositionSource &rotor,
+                                 long switchPosition,
+                                 int triggerDirectionSign);
+
+            void begin() const override;
+            bool isActive() const override;
+
+        private:
+            const IRotorPositionSource &_rotor;
+            const long _switchPosition;
+            const int _triggerDirectionSign;
+        };
+    }
+}
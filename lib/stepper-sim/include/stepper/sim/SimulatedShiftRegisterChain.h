@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <soc/api/IShiftOutput.h>
+
+namespace stepper
+{
+    namespace sim
+    {
+        /**
+         * @brief 74HC595 chain with stepper drivers on its outputs, wired like a
+         * ShiftRegisterStepperBank expects them.
+         *
+         * Frames are shifted in bit by bit and latched like in the real chips, then the
+         * drivers decode the pins of their motor: a rising step edge is a step in the
+         * latched direction, as long as the driver is enabled. The drivers check their
+         * timing at the resolution of a latch: the direction must be stable from the latch
+         * before a rising step edge until the falling one, and a pulse must end within
+         * its burst, otherwise the next rising edge would be lost.
+         */
+        class SimulatedShiftRegisterChain : public soc::api::IShiftOutput
+        {
+        public:
+            struct MotorRecord
+            {
+                long position;                     // steps seen by the driver
+                unsigned long steps;               // rising step edges
+                unsigned long stepsWhileDisabled;  // rising edges the disabled driver ignored
+                unsigned long dirSetupViolations;  // direction changed with or during a pulse
+                unsigned long openPulses;          // bursts that ended with the step pin high
+                std::vector<unsigned long> stepTimes;
+            };
+
+            /**
+             * @param enableActiveLow Whether the drivers are enabled with their enable pin low.
+             */
+            explicit SimulatedShiftRegisterChain(size_t motorCount, bool enableActiveLow = false);
+
+            // --- IShiftOutput Interface Implementation ---
+            void begin() override;
+            void writeFrames(const uint8_t *frames, size_t frameLength, size_t frameCount) override;
+
+            // --- Simulation state ---
+            size_t getRegisterCount() const;
+            uint8_t getRegisterOutputs(size_t index) const;
+            const MotorRecord &getMotor(size_t motor) const;
+            bool isEnabled(size_t motor) const;
+            bool getDirection(size_t motor) const;
+
+            unsigned long getBurstCount() const;
+            unsigned long getLatchCount() const;
+            unsigned long getMalformedBursts() const; // frames not as long as the chain
+
+        private:
+            const size_t _motorCount;
+            const bool _enableActiveLow;
+            std::vector<uint8_t> _shiftRegisters; // index 0 is the register next to the microcontroller
+            std::vector<uint8_t> _outputs;        // storage registers driving the pins
+            std::vector<MotorRecord> _motors;
+            bool _begun;
+
+            unsigned long _burstCount;
+            unsigned long _latchCount;
+            unsigned long _malformedBursts;
+
+            void shiftIn(uint8_t byte);
+            void latch();
+            uint8_t pins(const std::vector<uint8_t> &registers, size_t motor) const;
+        };
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <stepper/api/AccelRamp.h>
+#include <stepper/api/IStepperController.h>
+#include <stepper/sim/IRotorPositionSource.h>
+
+namespace stepper
+{
+    namespace sim
+    {
+        /**
+         * @brief IStepperController that generates steps in virtual time.
+         *
+         * Uses the same ramp as AccelStepper, see stepper::api::AccelRamp, driven by
+         * micros() of the arduino mock. Every step is executed immediately and perfectly, there
+         * is no motor physics involved. The physical rotor position is tracked
+         * separately from the logical position, so homing can be simulated.
+         */
+        class SimulatedStepperController : public stepper::api::IStepperController,
+                                           public IRotorPositionSource
+        {
+        public:
+            /**
+             * @param initialRotorPosition Physical position of the rotor at power up,
+             * e.g. somewhere away from the limit switch.
+             */
+            explicit SimulatedStepperController(long initialRotorPosition = 0);
+
+            // --- IStepperController Interface Implementation ---
+            void setEnablePin(uint8_t enablePin) override;
+            void setPinsInverted(bool dirInvert, bool stepInvert, bool enableInvert) override;
+            void enableOutputs() override;
+            void disableOutputs() override;
+            void setMaxSpeed(float speed) override;
+            void setAcceleration(float acceleration) override;
+            void moveTo(long absoluteSteps) override;
+            void move(long relativeSteps) override;
+            long getCurrentPosition() override;
+            void setCurrentPosition(long absoluteSteps) override;
+            long distanceToGo() override;
+            bool run() override;
+            void stop() override;
+            unsigned long nextStepDueMicros() override;
+            void setSpeed(float speed) override;
+            float getSpeed() override;
+            bool runSpeed() override;
+
+            // --- IRotorPositionSource Interface Implementation ---
+            long getRotorPosition() const override;
+
+            // --- Simulation state ---
+            bool isRunning() const;
+            bool areOutputsEnabled() const;
+            long getTargetPosition() const;
+            uint64_t getTotalSteps() const;
+            unsigned long getMoveCommandCount() const;
+
+        private:
+            stepper::api::AccelRamp _ramp;
+            long _rotorPos;
+            unsigned long _lastStepTime;
+            bool _outputsEnabled;
+
+            uint64_t _totalSteps;
+            unsigned long _moveCommandCount;
+        };
+    }
+}
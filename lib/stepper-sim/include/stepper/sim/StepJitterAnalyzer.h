@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <stepper/sim/RecordingStepperController.h>
+
+namespace stepper
+{
+    namespace sim
+    {
+        /**
+         * @brief Compares recorded step timing with the ideal trapezoidal profile.
+         *
+         * The ideal profile of a move accelerates with the configured acceleration up to
+         * the maximum speed, cruises and decelerates symmetrically, triangular for short
+         * moves. Step i (counting from the first executed step of a move) ideally happens
+         * when the continuous profile has covered i steps. Every recorded interval is
+         * compared with the ideal interval between the same two steps, so both the
+         * approximation of the step generator and the jitter of the loop driving it show up.
+         *
+         * Only complete moves that started from standstill can be compared, others are
+         * counted as skipped. Results accumulate over all analyzed moves.
+         */
+        class StepJitterAnalyzer
+        {
+        public:
+            struct Report
+            {
+                unsigned long moves;
+                unsigned long skippedMoves;
+                uint64_t intervals;
+                double meanIntervalErrorMicros;
+                double p99IntervalErrorMicros;
+                double maxIntervalErrorMicros;
+                unsigned long maxGapMicros;          // largest interval between two steps of a move
+                double meanVelocityErrorPercent;     // mean speed of a move vs. the ideal mean speed
+                double maxVelocityErrorPercent;
+            };
+
+            StepJitterAnalyzer();
+
+            /**
+             * @brief Analyzes all moves recorded so far. Call clear() on the recorder
+             * afterwards, otherwise the moves are analyzed again on the next call.
+             */
+            void addMoves(const RecordingStepperController &recorder);
+
+            Report getReport() const;
+            void reset();
+
+            /**
+             * @brief Time in seconds the ideal profile needs to cover a distance.
+             * @param distance Steps covered so far, 0 <= distance <= totalDistance.
+             * @param totalDistance Length of the whole move in steps.
+             */
+            static double idealTime(double distance, double totalDistance, double maxSpeed, double acceleration);
+
+        private:
+            static const size_t HISTOGRAM_BINS = 100000; // 1 us bins, everything above lands in the last
+
+            std::vector<uint32_t> _histogram;
+            unsigned long _moves;
+            unsigned long _skippedMoves;
+            uint64_t _intervals;
+            double _errorSumMicros;
+            double _maxErrorMicros;
+            unsigned long _maxGapMicros;
+            double _velocityErrorSumPercent;
+            double _maxVelocityErrorPercent;
+
+            void addMove(const RecordingStepperController::MoveRecord &move,
+                         const std::vector<RecordingStepperController::StepRecord> &steps);
+        };
+    }
+}
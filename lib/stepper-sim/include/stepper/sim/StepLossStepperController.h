@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <stepper/api/IStepperController.h>
+#include <stepper/sim/IRotorPositionSource.h>
+
+namespace stepper
+{
+    namespace sim
+    {
+        /**
+         * @brief IStepperController decorator for a motor that follows every speed profile
+         * up to a speed and an acceleration, and loses the steps beyond.
+         *
+         * A step is judged by the profile that generated it, the speed of the step
+         * generator and the acceleration it was given, not by the step intervals, which
+         * jitter with the loop. A step faster than maxStepsPerSec, or a step of a ramp
+         * (accelerating or braking) with an acceleration above maxStepsPerSecSq, is not
+         * followed by the rotor. Simpler and more predictable than the
+         * PhysicsStepperController, for tests that need to know where the limit is.
+         */
+        class StepLossStepperController : public stepper::api::IStepperController,
+                                          public IRotorPositionSource
+        {
+        public:
+            struct Config
+            {
+                double maxStepsPerSec;   // faster steps are lost
+                double maxStepsPerSecSq; // the steps of a ramp with a higher acceleration are lost
+            };
+
+            StepLossStepperController(stepper::api::IStepperController &stepGenerator,
+                                      const Config &config,
+                                      long initialRotorPosition = 0);
+
+            // --- IStepperController Interface Implementation ---
+            void setEnablePin(uint8_t enablePin) override;
+            void setPinsInverted(bool dirInvert, bool stepInvert, bool enableInvert) override;
+            void enableOutputs() override;
+            void disableOutputs() override;
+            void setMaxSpeed(float speed) override;
+            void setAcceleration(float acceleration) override;
+            void moveTo(long absoluteSteps) override;
+            void move(long relativeSteps) override;
+            long getCurrentPosition() override;
+            void setCurrentPosition(long absoluteSteps) override;
+            long distanceToGo() override;
+            bool run() override;
+            void stop() override;
+            unsigned long nextStepDueMicros() override;
+            void setSpeed(float speed) override;
+            float getSpeed() override;
+            bool runSpeed() override;
+
+            // --- IRotorPositionSource Interface Implementation ---
+            long getRotorPosition() const override;
+
+            unsigned long getLostSteps() const;
+            uint64_t getExecutedSteps() const;
+
+        private:
+            stepper::api::IStepperController &_stepGenerator;
+            const Config _config;
+
+            long _lastGeneratorPosition;
+            long _rotorPosition;
+            double _acceleration;
+            double _lastStepsPerSec;
+            unsigned long _lostSteps;
+            uint64_t _executedSteps;
+
+            void trackGeneratorSteps();
+        };
+    }
+}
@@ -0,0 +1,77 @@
+#include <stepper/sim/LoopLatencyModel.h>
+
+namespace stepper
+{
+    namespace sim
+    {
+        LoopLatencyModel::LoopLatencyModel(Kind kind,
+                                           unsigned long baseMicros,
+                                           unsigned long maxMicros,
+                                           double spikeProbability,
+                                           unsigned long spikeMicros,
+                                           uint32_t seed)
+            : _kind(kind),
+              _baseMicros(baseMicros > 0 ? baseMicros : 1),
+              _maxMicros(maxMicros > baseMicros ? maxMicros : baseMicros),
+              _spikeProbability(spikeProbability),
+              _spikeMicros(spikeMicros),
+              _random(seed)
+        {
+        }
+
+        LoopLatencyModel LoopLatencyModel::constant(unsigned long micros)
+        {
+            return LoopLatencyModel(Kind::CONSTANT, micros, micros, 0.0, 0, 1);
+        }
+
+        LoopLatencyModel LoopLatencyModel::uniform(unsigned long minMicros, unsigned long maxMicros, uint32_t seed)
+        {
+            return LoopLatencyModel(Kind::UNIFORM, minMicros, maxMicros, 0.0, 0, seed);
+        }
+
+        LoopLatencyModel LoopLatencyModel::spiky(unsigned long baseMicros,
+                                                 double spikeProbability,
+                                                 unsigned long spikeMicros,
+                                                 uint32_t seed)
+        {
+            return LoopLatencyModel(Kind::SPIKY, baseMicros, baseMicros, spikeProbability, spikeMicros, seed);
+        }
+
+        unsigned long LoopLatencyModel::next()
+        {
+            switch (_kind)
+            {
+            case Kind::CONSTANT:
+                return _baseMicros;
+            case Kind::UNIFORM:
+                return std::uniform_int_distribution<unsigned long>(_baseMicros, _maxMicros)(_random);
+            case Kind::SPIKY:
+                if (std::uniform_real_distribution<double>(0.0, 1.0)(_random) < _spikeProbability)
+                {
+                    return _baseMicros + _spikeMicros;
+                }
+                return _baseMicros;
+            }
+            return _baseMicros;
+        }
+
+        LoopLatencyModel::Kind LoopLatencyModel::getKind() const
+        {
+            return _kind;
+        }
+
+        double LoopLatencyModel::getMeanMicros() const
+        {
+            switch (_kind)
+            {
+            case Kind::UNIFORM:
+                return (_baseMicros + _maxMicros) / 2.0;
+            case Kind::SPIKY:
+                return _baseMicros + _spikeProbability * _spikeMicros;
+            case Kind::CONSTANT:
+            default:
+                return _baseMicros;
+            }
+        }
+    }
+}
@@ -0,0 +1,509 @@
+#include <stepper/sim/PhysicsStepperController.h>
+#include <Arduino.h>
+#include <cmath>
+
+namespace stepper
+{
+    namespace sim
+    {
+        static const double TWO_PI = 6.283185307179586;
+
+        PhysicsStepperController::Config PhysicsStepperController::defaultConfig()
+        {
+            Config config;
+            config.fullStepsPerRevolution = 200;
+            config.microsteps = 8;
+            config.holdingTorqueNm = 0.26;
+            config.detentTorqueNm = 0.012;
+            config.cornerSpeedRps = 2.5;
+            config.rotorInertiaKgM2 = 3.5e-6;
+            config.loadInertiaKgM2 = 1.5e-6;
+            config.frictionTorqueNm = 0.01;
+            config.dampingNmsPerRad = 0.0008;
+            config.unbalanceTorqueNm = 0.005;
+            config.ratedCurrentA = 1.0;
+            config.phaseResistanceOhm = 2.0;
+            // a chopper driver at 12 V forces the current into 3 mH in a few hundred us
+            config.currentRiseMicros = 300;
+            config.integrationStepMicros = 10;
+            return config;
+        }
+
+        PhysicsStepperController::PhysicsStepperController(stepper::api::IStepperController &stepGenerator,
+                                                           const Config &config,
+                                                           long initialRotorPosition)
+            : _stepGenerator(stepGenerator),
+              _config(config),
+              _radiansPerStep(TWO_PI / (static_cast<double>(config.fullStepsPerRevolution) * config.microsteps)),
+              // a hybrid stepper has one electrical period per four full steps
+              _polePairs(config.fullStepsPerRevolution / 4.0),
+              // without an enable pin the driver is energized from power up
+              _enabled(true),
+              _lastGeneratorPosition(stepGenerator.getCurrentPosition()),
+              _commandedPosition(initialRotorPosition),
+              _rotorAngle(initialRotorPosition * _radiansPerStep),
+              _rotorSpeed(0.0),
+              _lastIntegrationMicros(micros()),
+              _atRest(true),
+              _maxLagSteps(0.0),
+              _unfollowableSteps(0),
+              _slipEvents(0),
+              _executedSteps(0),
+              _stablePositionIndex(0),
+              _statisticsStartMicros(micros()),
+              _enabledSinceMicros(micros()),
+              _enabledMicros(0),
+              _dutyFraction(1.0),
+              _currentFrom(1.0),
+              _currentChangeMicros(micros()),
+              _chargeAs(0.0),
+              _energyJ(0.0),
+              _accountedMicros(micros())
+        {
+        }
+
+        void PhysicsStepperController::setEnablePin(uint8_t enablePin)
+        {
+            _stepGenerator.setEnablePin(enablePin);
+        }
+
+        void PhysicsStepperController::setPinsInverted(bool dirInvert, bool stepInvert, bool enableInvert)
+        {
+            _stepGenerator.setPinsInverted(dirInvert, stepInvert, enableInvert);
+        }
+
+        void PhysicsStepperController::enableOutputs()
+        {
+            settle();
+            if (!_enabled)
+            {
+                // the field snaps to the nearest stable position of the current commanded phase
+                _stablePositionIndex = lround(electricalLag() / TWO_PI);
+                _enabledSinceMicros = micros();
+                changeCurrent();
+            }
+            _enabled = true;
+            _atRest = false;
+            _stepGenerator.enableOutputs();
+        }
+
+        void PhysicsStepperController::disableOutputs()
+        {
+            settle();
+            if (_enabled)
+            {
+                _enabledMicros += micros() - _enabledSinceMicros;
+                changeCurrent();
+                // the driver feeds the coil energy back to the supply, fast decay
+                _currentFrom = 0.0;
+            }
+            _enabled = false;
+            _atRest = false;
+            _stepGenerator.disableOutputs();
+        }
+
+        void PhysicsStepperController::setMaxSpeed(float speed)
+        {
+            _stepGenerator.setMaxSpeed(speed);
+        }
+
+        void PhysicsStepperController::setAcceleration(float acceleration)
+        {
+            _stepGenerator.setAcceleration(acceleration);
+        }
+
+        void PhysicsStepperController::moveTo(long absoluteSteps)
+        {
+            _stepGenerator.moveTo(absoluteSteps);
+        }
+
+        void PhysicsStepperController::move(long relativeSteps)
+        {
+            _stepGenerator.move(relativeSteps);
+        }
+
+        long PhysicsStepperController::getCurrentPosition()
+        {
+            return _stepGenerator.getCurrentPosition();
+        }
+
+        void PhysicsStepperController::setCurrentPosition(long absoluteSteps)
+        {
+            // only the logical position changes, the rotor stays where it is
+            _stepGenerator.setCurrentPosition(absoluteSteps);
+            _lastGeneratorPosition = _stepGenerator.getCurrentPosition();
+        }
+
+        long PhysicsStepperController::distanceToGo()
+        {
+            return _stepGenerator.distanceToGo();
+        }
+
+        bool PhysicsStepperController::run()
+        {
+            settle();
+            bool running = _stepGenerator.run();
+            trackGeneratorSteps();
+            return running;
+        }
+
+        void PhysicsStepperController::stop()
+        {
+            _stepGenerator.stop();
+        }
+
+        unsigned long PhysicsStepperController::nextStepDueMicros()
+        {
+            // the rotor is integrated up to the next run(), whenever it comes
+            return _stepGenerator.nextStepDueMicros();
+        }
+
+        void PhysicsStepperController::setSpeed(float speed)
+        {
+            _stepGenerator.setSpeed(speed);
+        }
+
+        float PhysicsStepperController::getSpeed()
+        {
+            return _stepGenerator.getSpeed();
+        }
+
+        bool PhysicsStepperController::runSpeed()
+        {
+            settle();
+            bool stepped = _stepGenerator.runSpeed();
+            trackGeneratorSteps();
+            return stepped;
+        }
+
+        long PhysicsStepperController::getRotorPosition() const
+        {
+            return lround(getExactRotorPosition());
+        }
+
+        void PhysicsStepperController::begin()
+        {
+        }
+
+        void PhysicsStepperController::setDuty(uint16_t duty)
+        {
+            settle();
+            changeCurrent();
+            _dutyFraction = static_cast<double>(duty < DUTY_FULL ? duty : DUTY_FULL) / DUTY_FULL;
+            _atRest = false;
+        }
+
+        void PhysicsStepperController::settle()
+        {
+            integrateTo(micros());
+        }
+
+        long PhysicsStepperController::getCommandedRotorPosition() const
+        {
+            return _commandedPosition;
+        }
+
+        double PhysicsStepperController::getExactRotorPosition() const
+        {
+            return _rotorAngle / _radiansPerStep;
+        }
+
+        double PhysicsStepperController::getRotorSpeedStepsPerSec() const
+        {
+            return _rotorSpeed / _radiansPerStep;
+        }
+
+        bool PhysicsStepperController::isAtRest() const
+        {
+            return _atRest;
+        }
+
+        double PhysicsStepperController::getMaxLagSteps() const
+        {
+            return _maxLagSteps;
+        }
+
+        unsigned long PhysicsStepperController::getUnfollowableSteps() const
+        {
+            return _unfollowableSteps;
+        }
+
+        unsigned long PhysicsStepperController::getSlipEvents() const
+        {
+            return _slipEvents;
+        }
+
+        long PhysicsStepperController::getLostSteps() const
+        {
+            // every stable position away from the commanded one is one electrical period
+            return _stablePositionIndex * 4L * _config.microsteps;
+        }
+
+        uint64_t PhysicsStepperController::getExecutedSteps() const
+        {
+            return _executedSteps;
+        }
+
+        unsigned long PhysicsStepperController::getEnabledMicros() const
+        {
+            return _enabled ? _enabledMicros + (micros() - _enabledSinceMicros) : _enabledMicros;
+        }
+
+        // integrals of the current fraction f(t) = a + b * exp(-t / tau) and of its square
+        // since the last change, from u0 to u1 microseconds after it, in fraction seconds
+        static void integrateCurrent(double a, double b, double tauMicros, double u0, double u1,
+                                     double &current, double &currentSquared)
+        {
+            double seconds = (u1 - u0) * 1e-6;
+            current = a * seconds;
+            currentSquared = a * a * seconds;
+            if (tauMicros > 0.0 && b != 0.0)
+            {
+                double tau = tauMicros * 1e-6;
+                double decay = exp(-u0 / tauMicros) - exp(-u1 / tauMicros);
+                double decaySquared = exp(-2.0 * u0 / tauMicros) - exp(-2.0 * u1 / tauMicros);
+                current += b * tau * decay;
+                currentSquared += 2.0 * a * b * tau * decay + b * b * tau / 2.0 * decaySquared;
+            }
+        }
+
+        double PhysicsStepperController::getAverageCurrentA() const
+        {
+            unsigned long now = micros();
+            unsigned long elapsed = now - _statisticsStartMicros;
+            if (elapsed == 0)
+            {
+                return 2.0 * _config.ratedCurrentA * getCurrentFraction();
+            }
+            double current, currentSquared;
+            double a = targetCurrentFraction();
+            integrateCurrent(a, _currentFrom - a, _config.currentRiseMicros,
+                             _accountedMicros - _currentChangeMicros, now - _currentChangeMicros,
+                             current, currentSquared);
+            // two phases
+            return (_chargeAs + 2.0 * _config.ratedCurrentA * current) / (elapsed * 1e-6);
+        }
+
+        double PhysicsStepperController::getEnergyJ() const
+        {
+            double current, currentSquared;
+            double a = targetCurrentFraction();
+            integrateCurrent(a, _currentFrom - a, _config.currentRiseMicros,
+                             _accountedMicros - _currentChangeMicros, micros() - _currentChangeMicros,
+                             current, currentSquared);
+            double ratedPower = 2.0 * _config.ratedCurrentA * _config.ratedCurrentA * _config.phaseResistanceOhm;
+            return _energyJ + ratedPower * currentSquared;
+        }
+
+        double PhysicsStepperController::getAveragePowerFraction() const
+        {
+            unsigned long elapsed = micros() - _statisticsStartMicros;
+            if (elapsed == 0)
+            {
+                double fraction = getCurrentFraction();
+                return fraction * fraction;
+            }
+            double ratedPower = 2.0 * _config.ratedCurrentA * _config.ratedCurrentA * _config.phaseResistanceOhm;
+            return getEnergyJ() / (ratedPower * elapsed * 1e-6);
+        }
+
+        double PhysicsStepperController::getCurrentFraction() const
+        {
+            return currentFractionAt(micros());
+        }
+
+        double PhysicsStepperController::targetCurrentFraction() const
+        {
+            return _enabled ? _dutyFraction : 0.0;
+        }
+
+        double PhysicsStepperController::currentFractionAt(unsigned long atMicros) const
+        {
+            double target = targetCurrentFraction();
+            if (_config.currentRiseMicros == 0)
+            {
+                return target;
+            }
+            unsigned long elapsed = atMicros - _currentChangeMicros;
+            // settled for good, spares the exp() in every integration step
+            if (elapsed >= 20 * _config.currentRiseMicros)
+            {
+                return target;
+            }
+            return target + (_currentFrom - target) * exp(-static_cast<double>(elapsed) / _config.currentRiseMicros);
+        }
+
+        void PhysicsStepperController::changeCurrent()
+        {
+            // call it before the enable state or the duty changes
+            accountEnergy();
+            _currentFrom = currentFractionAt(micros());
+            _currentChangeMicros = micros();
+        }
+
+        void PhysicsStepperController::accountEnergy()
+        {
+            unsigned long now = micros();
+            double current, currentSquared;
+            double a = targetCurrentFraction();
+            integrateCurrent(a, _currentFrom - a, _config.currentRiseMicros,
+                             _accountedMicros - _currentChangeMicros, now - _currentChangeMicros,
+                             current, currentSquared);
+            _chargeAs += 2.0 * _config.ratedCurrentA * current;
+            _energyJ += 2.0 * _config.ratedCurrentA * _config.ratedCurrentA * _config.phaseResistanceOhm * currentSquared;
+            _accountedMicros = now;
+        }
+
+        void PhysicsStepperController::resetStatistics()
+        {
+            accountEnergy();
+            _chargeAs = 0.0;
+            _energyJ = 0.0;
+            _statisticsStartMicros = micros();
+            _enabledSinceMicros = micros();
+            _enabledMicros = 0;
+            _maxLagSteps = 0.0;
+            _unfollowableSteps = 0;
+            _slipEvents = 0;
+            _executedSteps = 0;
+        }
+
+        void PhysicsStepperController::trackGeneratorSteps()
+        {
+            long position = _stepGenerator.getCurrentPosition();
+            long delta = position - _lastGeneratorPosition;
+            if (delta == 0)
+            {
+                return;
+            }
+            _lastGeneratorPosition = position;
+            _commandedPosition += delta;
+            _executedSteps += delta > 0 ? delta : -delta;
+            _atRest = false;
+
+            if (_enabled)
+            {
+                // lag relative to the stable position the rotor is currently locked to
+                double lag = electricalLag() - _stablePositionIndex * TWO_PI;
+                if (fabs(lag) > TWO_PI / 4.0)
+                {
+                    _unfollowableSteps++;
+                }
+            }
+        }
+
+        double PhysicsStepperController::electricalLag() const
+        {
+            double commandedAngle = _commandedPosition * _radiansPerStep;
+            return _polePairs * (commandedAngle - _rotorAngle);
+        }
+
+        double PhysicsStepperController::detentTorque() const
+        {
+            // the permanent magnet pulls the rotor to a full step, enabled or not
+            return _config.detentTorqueNm * sin(_config.fullStepsPerRevolution * _rotorAngle);
+        }
+
+        double PhysicsStepperController::availableTorque(double rotorSpeed) const
+        {
+            double cornerSpeed = _config.cornerSpeedRps * TWO_PI;
+            double speed = fabs(rotorSpeed);
+            if (speed <= cornerSpeed)
+            {
+                return _config.holdingTorqueNm;
+            }
+            return _config.holdingTorqueNm * cornerSpeed / speed;
+        }
+
+        void PhysicsStepperController::integrateTo(unsigned long nowMicros)
+        {
+            if (nowMicros <= _lastIntegrationMicros)
+            {
+                return;
+            }
+            if (_atRest)
+            {
+                _lastIntegrationMicros = nowMicros;
+                return;
+            }
+
+            unsigned long stepMicros = _config.integrationStepMicros > 0 ? _config.integrationStepMicros : 1;
+            while (_lastIntegrationMicros < nowMicros && !_atRest)
+            {
+                unsigned long remaining = nowMicros - _lastIntegrationMicros;
+                unsigned long dtMicros = remaining < stepMicros ? remaining : stepMicros;
+                integrationStep(dtMicros * 1e-6);
+                _lastIntegrationMicros += dtMicros;
+            }
+            _lastIntegrationMicros = nowMicros;
+        }
+
+        void PhysicsStepperController::integrationStep(double dt)
+        {
+            double motorTorque = 0.0;
+            double lag = electricalLag();
+            // the torque is proportional to the current
+            double current = currentFractionAt(_lastIntegrationMicros);
+            if (_enabled)
+            {
+                motorTorque = availableTorque(_rotorSpeed) * current * sin(lag);
+            }
+
+            double driveTorque = motorTorque
+                                 - detentTorque()
+                                 - _config.dampingNmsPerRad * _rotorSpeed
+                                 - _config.unbalanceTorqueNm * sin(_rotorAngle);
+            double friction = _config.frictionTorqueNm;
+
+            // coulomb friction with stiction, the rotor sticks while friction can hold it
+            if (fabs(_rotorSpeed) < 1e-6 && fabs(driveTorque) <= friction)
+            {
+                _rotorSpeed = 0.0;
+            }
+            else
+            {
+                double direction = _rotorSpeed != 0.0 ? (_rotorSpeed > 0 ? 1.0 : -1.0) : (driveTorque > 0 ? 1.0 : -1.0);
+                double inertia = _config.rotorInertiaKgM2 + _config.loadInertiaKgM2;
+                double newSpeed = _rotorSpeed + (driveTorque - direction * friction) / inertia * dt;
+                // friction can stop the rotor but never reverse it
+                if (_rotorSpeed != 0.0 && (newSpeed > 0) != (_rotorSpeed > 0))
+                {
+                    newSpeed = 0.0;
+                }
+                _rotorSpeed = newSpeed;
+                _rotorAngle += _rotorSpeed * dt;
+            }
+
+            if (_enabled)
+            {
+                double lagSteps = fabs(lag - _stablePositionIndex * TWO_PI) / _polePairs / _radiansPerStep;
+                if (lagSteps > _maxLagSteps)
+                {
+                    _maxLagSteps = lagSteps;
+                }
+
+                // past half an electrical period the rotor is pulled to the next stable position
+                long index = lround(lag / TWO_PI);
+                if (index != _stablePositionIndex)
+                {
+                    _stablePositionIndex = index;
+                    _slipEvents++;
+                }
+            }
+
+            // at rest: no motion, a settled current and the forces are in balance with stiction,
+            // a reduced current holds the rotor further away from the field
+            double restingLag = _enabled ? fabs(lag - _stablePositionIndex * TWO_PI) * current : 0.0;
+            bool currentSettled = _lastIntegrationMicros - _currentChangeMicros >= 5 * _config.currentRiseMicros;
+            if (_rotorSpeed == 0.0 && currentSettled && (!_enabled || restingLag < 0.5 * _polePairs * _radiansPerStep))
+            {
+                double holdingTorque = _enabled ? availableTorque(0.0) * current * sin(lag) : 0.0;
+                double staticTorque = holdingTorque - detentTorque() - _config.unbalanceTorqueNm * sin(_rotorAngle);
+                if (fabs(staticTorque) <= _config.frictionTorqueNm)
+                {
+                    _atRest = true;
+                }
+            }
+        }
+    }
+}
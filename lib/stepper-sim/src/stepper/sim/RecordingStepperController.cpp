@@ -0,0 +1,189 @@
+#include <stepper/sim/RecordingStepperController.h>
+#include <Arduino.h>
+
+namespace stepper
+{
+    namespace sim
+    {
+        RecordingStepperController::RecordingStepperController(stepper::api::IStepperController &stepperController)
+            : _stepperController(stepperController),
+              _maxSpeed(1.0),
+              _acceleration(1.0),
+              _running(false),
+              _moveOpen(false)
+        {
+        }
+
+        void RecordingStepperController::setEnablePin(uint8_t enablePin)
+        {
+            _stepperController.setEnablePin(enablePin);
+        }
+
+        void RecordingStepperController::setPinsInverted(bool dirInvert, bool stepInvert, bool enableInvert)
+        {
+            _stepperController.setPinsInverted(dirInvert, stepInvert, enableInvert);
+        }
+
+        void RecordingStepperController::enableOutputs()
+        {
+            _stepperController.enableOutputs();
+        }
+
+        void RecordingStepperController::disableOutputs()
+        {
+            _stepperController.disableOutputs();
+        }
+
+        void RecordingStepperController::setMaxSpeed(float speed)
+        {
+            _maxSpeed = speed < 0 ? -speed : speed;
+            _stepperController.setMaxSpeed(speed);
+        }
+
+        void RecordingStepperController::setAcceleration(float acceleration)
+        {
+            if (acceleration != 0.0)
+            {
+                _acceleration = acceleration < 0 ? -acceleration : acceleration;
+            }
+            _stepperController.setAcceleration(acceleration);
+        }
+
+        void RecordingStepperController::moveTo(long absoluteSteps)
+        {
+            long currentTarget = _stepperController.getCurrentPosition() + _stepperController.distanceToGo();
+            if (absoluteSteps != currentTarget)
+            {
+                beginMove(absoluteSteps);
+            }
+            _stepperController.moveTo(absoluteSteps);
+        }
+
+        void RecordingStepperController::move(long relativeSteps)
+        {
+            moveTo(_stepperController.getCurrentPosition() + relativeSteps);
+        }
+
+        long RecordingStepperController::getCurrentPosition()
+        {
+            return _stepperController.getCurrentPosition();
+        }
+
+        void RecordingStepperController::setCurrentPosition(long absoluteSteps)
+        {
+            closeMove(_running);
+            _running = false;
+            _stepperController.setCurrentPosition(absoluteSteps);
+        }
+
+        long RecordingStepperController::distanceToGo()
+        {
+            return _stepperController.distanceToGo();
+        }
+
+        bool RecordingStepperController::run()
+        {
+            long before = _stepperController.getCurrentPosition();
+            _running = _stepperController.run();
+            long after = _stepperController.getCurrentPosition();
+
+            if (after != before && _moveOpen)
+            {
+                _steps.push_back(StepRecord{micros(), after});
+                _moves.back().stepCount++;
+            }
+            if (!_running)
+            {
+                closeMove(false);
+            }
+            return _running;
+        }
+
+        void RecordingStepperController::stop()
+        {
+            if (_moveOpen)
+            {
+                _moves.back().interrupted = true;
+            }
+            _stepperController.stop();
+        }
+
+        unsigned long RecordingStepperController::nextStepDueMicros()
+        {
+            return _stepperController.nextStepDueMicros();
+        }
+
+        void RecordingStepperController::setSpeed(float speed)
+        {
+            closeMove(_running);
+            _stepperController.setSpeed(speed);
+        }
+
+        float RecordingStepperController::getSpeed()
+        {
+            return _stepperController.getSpeed();
+        }
+
+        bool RecordingStepperController::runSpeed()
+        {
+            long before = _stepperController.getCurrentPosition();
+            bool stepped = _stepperController.runSpeed();
+            long after = _stepperController.getCurrentPosition();
+
+            if (after != before)
+            {
+                _steps.push_back(StepRecord{micros(), after});
+            }
+            _running = _stepperController.getSpeed() != 0.0;
+            return stepped;
+        }
+
+        const std::vector<RecordingStepperController::StepRecord> &RecordingStepperController::getSteps() const
+        {
+            return _steps;
+        }
+
+        const std::vector<RecordingStepperController::MoveRecord> &RecordingStepperController::getMoves() const
+        {
+            return _moves;
+        }
+
+        void RecordingStepperController::clear()
+        {
+            _steps.clear();
+            _moves.clear();
+            _moveOpen = false;
+        }
+
+        void RecordingStepperController::beginMove(long absoluteSteps)
+        {
+            bool fromStandstill = !_running;
+            closeMove(_running);
+
+            MoveRecord move;
+            move.startPosition = _stepperController.getCurrentPosition();
+            move.targetPosition = absoluteSteps;
+            move.maxSpeed = _maxSpeed;
+            move.acceleration = _acceleration;
+            move.firstStep = _steps.size();
+            move.stepCount = 0;
+            move.fromStandstill = fromStandstill;
+            move.interrupted = false;
+            _moves.push_back(move);
+            _moveOpen = true;
+        }
+
+        void RecordingStepperController::closeMove(bool interrupted)
+        {
+            if (!_moveOpen)
+            {
+                return;
+            }
+            if (interrupted)
+            {
+                _moves.back().interrupted = true;
+            }
+            _moveOpen = false;
+        }
+    }
+}
@@ -0,0 +1,30 @@
+#include <stepper/sim/SimulatedLimitSwitch.h>
+
+namespace stepper
+{
+    namespace sim
+    {
+        SimulatedLimitSwitch::SimulatedLimitSwitch(const IRotorPositionSource &rotor,
+                                                   long switchPosition,
+                                                   int triggerDirectionSign)
+            : _rotor(rotor),
+              _switchPosition(switchPosition),
+              _triggerDirectionSign(triggerDirectionSign < 0 ? -1 : 1)
+        {
+        }
+
+        void SimulatedLimitSwitch::begin() const
+        {
+        }
+
+        bool SimulatedLimitSwitch::isActive() const
+        {
+            long rotorPosition = _rotor.getRotorPosition();
+            if (_triggerDirectionSign < 0)
+            {
+                return rotorPosition <= _switchPosition;
+            }
+            return rotorPosition >= _switchPosition;
+        }
+    }
+}
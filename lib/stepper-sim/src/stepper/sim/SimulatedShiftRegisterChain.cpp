@@ -0,0 +1,153 @@
+#include <stepper/sim/SimulatedShiftRegisterChain.h>
+#include <stepper/shift/ShiftRegisterStepperBank.h>
+#include <Arduino.h>
+
+using stepper::shift::ShiftRegisterStepperBank;
+using stepper::shift::ShiftRegisterStepperController;
+
+namespace stepper
+{
+    namespace sim
+    {
+        SimulatedShiftRegisterChain::SimulatedShiftRegisterChain(size_t motorCount, bool enableActiveLow)
+            : _motorCount(motorCount),
+              _enableActiveLow(enableActiveLow),
+              _shiftRegisters((motorCount + ShiftRegisterStepperBank::MOTORS_PER_REGISTER - 1) / ShiftRegisterStepperBank::MOTORS_PER_REGISTER, 0),
+              _outputs(_shiftRegisters.size(), 0),
+              _motors(motorCount, MotorRecord{0, 0, 0, 0, 0, {}}),
+              _begun(false),
+              _burstCount(0),
+              _latchCount(0),
+              _malformedBursts(0)
+        {
+        }
+
+        void SimulatedShiftRegisterChain::begin()
+        {
+            _begun = true;
+        }
+
+        void SimulatedShiftRegisterChain::writeFrames(const uint8_t *frames, size_t frameLength, size_t frameCount)
+        {
+            _burstCount++;
+            if (!_begun || frameLength != _shiftRegisters.size())
+            {
+                _malformedBursts++;
+            }
+            for (size_t frame = 0; frame < frameCount; frame++)
+            {
+                for (size_t i = 0; i < frameLength; i++)
+                {
+                    shiftIn(frames[frame * frameLength + i]);
+                }
+                latch();
+            }
+
+            // a pulse must not outlive its burst
+            for (size_t motor = 0; motor < _motorCount; motor++)
+            {
+                if (pins(_outputs, motor) & ShiftRegisterStepperController::STEP_BIT)
+                {
+                    _motors[motor].openPulses++;
+                }
+            }
+        }
+
+        void SimulatedShiftRegisterChain::shiftIn(uint8_t byte)
+        {
+            // MSB first, every clock moves QH of a register into SER of the next one
+            for (int bit = 7; bit >= 0; bit--)
+            {
+                uint8_t carry = (byte >> bit) & 0x01;
+                for (uint8_t &reg : _shiftRegisters)
+                {
+                    uint8_t out = reg >> 7;
+                    reg = static_cast<uint8_t>((reg << 1) | carry);
+                    carry = out;
+                }
+            }
+        }
+
+        void SimulatedShiftRegisterChain::latch()
+        {
+            _latchCount++;
+            std::vector<uint8_t> previous = _outputs;
+            _outputs = _shiftRegisters;
+
+            for (size_t motor = 0; motor < _motorCount; motor++)
+            {
+                uint8_t before = pins(previous, motor);
+                uint8_t after = pins(_outputs, motor);
+                bool stepBefore = before & ShiftRegisterStepperController::STEP_BIT;
+                bool stepAfter = after & ShiftRegisterStepperController::STEP_BIT;
+                bool dirChanged = (before ^ after) & ShiftRegisterStepperController::DIR_BIT;
+
+                MotorRecord &record = _motors[motor];
+                if (dirChanged && stepAfter)
+                {
+                    record.dirSetupViolations++;
+                }
+                if (!stepBefore && stepAfter)
+                {
+                    if (isEnabled(motor))
+                    {
+                        record.position += getDirection(motor) ? 1 : -1;
+                        record.steps++;
+                        record.stepTimes.push_back(micros());
+                    }
+                    else
+                    {
+                        record.stepsWhileDisabled++;
+                    }
+                }
+            }
+        }
+
+        uint8_t SimulatedShiftRegisterChain::pins(const std::vector<uint8_t> &registers, size_t motor) const
+        {
+            uint8_t reg = registers[motor / ShiftRegisterStepperBank::MOTORS_PER_REGISTER];
+            return (reg >> ((motor % ShiftRegisterStepperBank::MOTORS_PER_REGISTER) * 4)) & 0x0F;
+        }
+
+        size_t SimulatedShiftRegisterChain::getRegisterCount() const
+        {
+            return _outputs.size();
+        }
+
+        uint8_t SimulatedShiftRegisterChain::getRegisterOutputs(size_t index) const
+        {
+            return _outputs[index];
+        }
+
+        const SimulatedShiftRegisterChain::MotorRecord &SimulatedShiftRegisterChain::getMotor(size_t motor) const
+        {
+            return _motors[motor];
+        }
+
+        bool SimulatedShiftRegisterChain::isEnabled(size_t motor) const
+        {
+            bool enableBit = pins(_outputs, motor) & ShiftRegisterStepperController::ENABLE_BIT;
+            return enableBit != _enableActiveLow;
+        }
+
+        bool SimulatedShiftRegisterChain::getDirection(size_t motor) const
+        {
+            return pins(_outputs, motor) & ShiftRegisterStepperController::DIR_BIT;
+        }
+
+        unsigned long SimulatedShiftRegisterChain::getBurstCount() const
+        {
+            return _burstCount;
+        }
+
+        unsigned long SimulatedShiftRegisterChain::getLatchCount() const
+        {
+            return _latchCount;
+        }
+
+        unsigned long SimulatedShiftRegisterChain::getMalformedBursts() const
+        {
+            return _malformedBursts;
+        }
+    }
+}
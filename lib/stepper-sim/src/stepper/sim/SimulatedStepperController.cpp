@@ -0,0 +1,163 @@
+#include <stepper/sim/SimulatedStepperController.h>
+#include <Arduino.h>
+
+namespace stepper
+{
+    namespace sim
+    {
+        SimulatedStepperController::SimulatedStepperController(long initialRotorPosition)
+            : _ramp(),
+              _rotorPos(initialRotorPosition),
+              _lastStepTime(0),
+              _outputsEnabled(false),
+              _totalSteps(0),
+              _moveCommandCount(0)
+        {
+        }
+
+        void SimulatedStepperController::setEnablePin(uint8_t /*enablePin*/)
+        {
+        }
+
+        void SimulatedStepperController::setPinsInverted(bool /*dirInvert*/, bool /*stepInvert*/, bool /*enableInvert*/)
+        {
+        }
+
+        void SimulatedStepperController::enableOutputs()
+        {
+            _outputsEnabled = true;
+        }
+
+        void SimulatedStepperController::disableOutputs()
+        {
+            _outputsEnabled = false;
+        }
+
+        void SimulatedStepperController::setMaxSpeed(float speed)
+        {
+            _ramp.setMaxSpeed(speed);
+        }
+
+        void SimulatedStepperController::setAcceleration(float acceleration)
+        {
+            _ramp.setAcceleration(acceleration);
+        }
+
+        void SimulatedStepperController::moveTo(long absoluteSteps)
+        {
+            _moveCommandCount++;
+            _ramp.moveTo(absoluteSteps);
+        }
+
+        void SimulatedStepperController::move(long relativeSteps)
+        {
+            moveTo(_ramp.getCurrentPosition() + relativeSteps);
+        }
+
+        long SimulatedStepperController::getCurrentPosition()
+        {
+            return _ramp.getCurrentPosition();
+        }
+
+        void SimulatedStepperController::setCurrentPosition(long absoluteSteps)
+        {
+            _ramp.setCurrentPosition(absoluteSteps);
+        }
+
+        long SimulatedStepperController::distanceToGo()
+        {
+            return _ramp.distanceToGo();
+        }
+
+        bool SimulatedStepperController::run()
+        {
+            if (runSpeed())
+            {
+                _ramp.computeNewSpeed();
+            }
+            return _ramp.isRunning();
+        }
+
+        void SimulatedStepperController::stop()
+        {
+            // stopping moves to where the motor comes to rest
+            if (_ramp.getSpeed() != 0.0)
+            {
+                _moveCommandCount++;
+            }
+            _ramp.stop();
+        }
+
+        unsigned long SimulatedStepperController::nextStepDueMicros()
+        {
+            unsigned long now = micros();
+            unsigned long stepInterval = _ramp.getStepInterval();
+            if (!stepInterval || now - _lastStepTime >= stepInterval)
+            {
+                return now;
+            }
+            return _lastStepTime + stepInterval;
+        }
+
+        long SimulatedStepperController::getRotorPosition() const
+        {
+            return _rotorPos;
+        }
+
+        bool SimulatedStepperController::isRunning() const
+        {
+            return _ramp.isRunning();
+        }
+
+        bool SimulatedStepperController::areOutputsEnabled() const
+        {
+            return _outputsEnabled;
+        }
+
+        void SimulatedStepperController::setSpeed(float speed)
+        {
+            _ramp.setSpeed(speed);
+        }
+
+        float SimulatedStepperController::getSpeed()
+        {
+            return _ramp.getSpeed();
+        }
+
+        long SimulatedStepperController::getTargetPosition() const
+        {
+            return _ramp.getTargetPosition();
+        }
+
+        uint64_t SimulatedStepperController::getTotalSteps() const
+        {
+            return _totalSteps;
+        }
+
+        unsigned long SimulatedStepperController::getMoveCommandCount() const
+        {
+            return _moveCommandCount;
+        }
+
+        bool SimulatedStepperController::runSpeed()
+        {
+            // Don't do anything unless we actually have a step interval
+            unsigned long stepInterval = _ramp.getStepInterval();
+            if (!stepInterval)
+            {
+                return false;
+            }
+
+            unsigned long time = micros();
+            if (time - _lastStepTime >= stepInterval)
+            {
+                _ramp.step();
+                _rotorPos += (_ramp.getDirection() == stepper::api::AccelRamp::Direction::CW) ? 1 : -1;
+                _totalSteps++;
+                _lastStepTime = time;
+                return true;
+            }
+            return false;
+        }
+    }
+}
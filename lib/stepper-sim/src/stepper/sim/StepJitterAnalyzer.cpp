@@ -0,0 +1,139 @@
+#include <stepper/sim/StepJitterAnalyzer.h>
+#include <algorithm>
+#include <cmath>
+
+namespace stepper
+{
+    namespace sim
+    {
+        StepJitterAnalyzer::StepJitterAnalyzer()
+            : _histogram(HISTOGRAM_BINS, 0)
+        {
+            reset();
+        }
+
+        void StepJitterAnalyzer::reset()
+        {
+            std::fill(_histogram.begin(), _histogram.end(), 0);
+            _moves = 0;
+            _skippedMoves = 0;
+            _intervals = 0;
+            _errorSumMicros = 0.0;
+            _maxErrorMicros = 0.0;
+            _maxGapMicros = 0;
+            _velocityErrorSumPercent = 0.0;
+            _maxVelocityErrorPercent = 0.0;
+        }
+
+        double StepJitterAnalyzer::idealTime(double distance, double totalDistance, double maxSpeed, double acceleration)
+        {
+            double accelerationDistance = (maxSpeed * maxSpeed) / (2.0 * acceleration);
+            double accelerationTime = maxSpeed / acceleration;
+            if (2.0 * accelerationDistance > totalDistance)
+            {
+                // triangular profile, never reaches maxSpeed
+                accelerationDistance = totalDistance / 2.0;
+                accelerationTime = sqrt(2.0 * accelerationDistance / acceleration);
+                maxSpeed = acceleration * accelerationTime;
+            }
+            double cruiseDistance = totalDistance - 2.0 * accelerationDistance;
+            double totalTime = 2.0 * accelerationTime + cruiseDistance / maxSpeed;
+
+            if (distance <= accelerationDistance)
+            {
+                return sqrt(2.0 * distance / acceleration);
+            }
+            if (distance <= accelerationDistance + cruiseDistance)
+            {
+                return accelerationTime + (distance - accelerationDistance) / maxSpeed;
+            }
+            double remaining = totalDistance - distance;
+            return totalTime - sqrt(2.0 * (remaining > 0.0 ? remaining : 0.0) / acceleration);
+        }
+
+        void StepJitterAnalyzer::addMoves(const RecordingStepperController &recorder)
+        {
+            for (const auto &move : recorder.getMoves())
+            {
+                addMove(move, recorder.getSteps());
+            }
+        }
+
+        void StepJitterAnalyzer::addMove(const RecordingStepperController::MoveRecord &move,
+                                         const std::vector<RecordingStepperController::StepRecord> &steps)
+        {
+            long distance = labs(move.targetPosition - move.startPosition);
+            if (!move.fromStandstill || move.interrupted || move.stepCount < 2 ||
+                static_cast<long>(move.stepCount) != distance ||
+                move.maxSpeed <= 0.0 || move.acceleration <= 0.0)
+            {
+                _skippedMoves++;
+                return;
+            }
+
+            // the first step starts the profile, the remaining steps span distance - 1
+            double totalDistance = static_cast<double>(distance - 1);
+            unsigned long startMicros = steps[move.firstStep].timeMicros;
+            for (size_t i = 1; i < move.stepCount; i++)
+            {
+                const auto &previous = steps[move.firstStep + i - 1];
+                const auto &current = steps[move.firstStep + i];
+                unsigned long actualInterval = current.timeMicros - previous.timeMicros;
+                double idealInterval = 1e6 * (idealTime(i, totalDistance, move.maxSpeed, move.acceleration) -
+                                              idealTime(i - 1, totalDistance, move.maxSpeed, move.acceleration));
+                double error = fabs(static_cast<double>(actualInterval) - idealInterval);
+
+                _intervals++;
+                _errorSumMicros += error;
+                if (error > _maxErrorMicros)
+                {
+                    _maxErrorMicros = error;
+                }
+                size_t bin = static_cast<size_t>(error);
+                _histogram[bin < HISTOGRAM_BINS ? bin : HISTOGRAM_BINS - 1]++;
+
+                if (actualInterval > _maxGapMicros)
+                {
+                    _maxGapMicros = actualInterval;
+                }
+            }
+
+            double actualDuration = static_cast<double>(steps[move.firstStep + move.stepCount - 1].timeMicros - startMicros);
+            double idealDuration = 1e6 * idealTime(totalDistance, totalDistance, move.maxSpeed, move.acceleration);
+            double velocityError = 100.0 * fabs(idealDuration - actualDuration) / actualDuration;
+            _velocityErrorSumPercent += velocityError;
+            if (velocityError > _maxVelocityErrorPercent)
+            {
+                _maxVelocityErrorPercent = velocityError;
+            }
+            _moves++;
+        }
+
+        StepJitterAnalyzer::Report StepJitterAnalyzer::getReport() const
+        {
+            Report report;
+            report.moves = _moves;
+            report.skippedMoves = _skippedMoves;
+            report.intervals = _intervals;
+            report.meanIntervalErrorMicros = _intervals ? _errorSumMicros / _intervals : 0.0;
+            report.maxIntervalErrorMicros = _maxErrorMicros;
+            report.maxGapMicros = _maxGapMicros;
+            report.meanVelocityErrorPercent = _moves ? _velocityErrorSumPercent / _moves : 0.0;
+            report.maxVelocityErrorPercent = _maxVelocityErrorPercent;
+
+            report.p99IntervalErrorMicros = 0.0;
+            uint64_t threshold = (_intervals * 99 + 99) / 100;
+            uint64_t count = 0;
+            for (size_t bin = 0; bin < HISTOGRAM_BINS && _intervals > 0; bin++)
+            {
+                count += _histogram[bin];
+                if (count >= threshold)
+                {
+                    report.p99IntervalErrorMicros = static_cast<double>(bin);
+                    break;
+                }
+            }
+            return report;
+        }
+    }
+}
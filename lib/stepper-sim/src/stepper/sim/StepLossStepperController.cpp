@@ -0,0 +1,153 @@
+#include <stepper/sim/StepLossStepperController.h>
+#include <cmath>
+
+namespace stepper
+{
+    namespace sim
+    {
+        StepLossStepperController::StepLossStepperController(stepper::api::IStepperController &stepGenerator,
+                                                             const Config &config,
+                                                             long initialRotorPosition)
+            : _stepGenerator(stepGenerator),
+              _config(config),
+              _lastGeneratorPosition(stepGenerator.getCurrentPosition()),
+              _rotorPosition(initialRotorPosition),
+              _acceleration(0.0),
+              _lastStepsPerSec(0.0),
+              _lostSteps(0),
+              _executedSteps(0)
+        {
+        }
+
+        void StepLossStepperController::setEnablePin(uint8_t enablePin)
+        {
+            _stepGenerator.setEnablePin(enablePin);
+        }
+
+        void StepLossStepperController::setPinsInverted(bool dirInvert, bool stepInvert, bool enableInvert)
+        {
+            _stepGenerator.setPinsInverted(dirInvert, stepInvert, enableInvert);
+        }
+
+        void StepLossStepperController::enableOutputs()
+        {
+            _stepGenerator.enableOutputs();
+        }
+
+        void StepLossStepperController::disableOutputs()
+        {
+            _stepGenerator.disableOutputs();
+        }
+
+        void StepLossStepperController::setMaxSpeed(float speed)
+        {
+            _stepGenerator.setMaxSpeed(speed);
+        }
+
+        void StepLossStepperController::setAcceleration(float acceleration)
+        {
+            _acceleration = acceleration;
+            _stepGenerator.setAcceleration(acceleration);
+        }
+
+        void StepLossStepperController::moveTo(long absoluteSteps)
+        {
+            _stepGenerator.moveTo(absoluteSteps);
+        }
+
+        void StepLossStepperController::move(long relativeSteps)
+        {
+            _stepGenerator.move(relativeSteps);
+        }
+
+        long StepLossStepperController::getCurrentPosition()
+        {
+            return _stepGenerator.getCurrentPosition();
+        }
+
+        void StepLossStepperController::setCurrentPosition(long absoluteSteps)
+        {
+            // only the logical position changes, the rotor stays where it is
+            _stepGenerator.setCurrentPosition(absoluteSteps);
+            _lastGeneratorPosition = _stepGenerator.getCurrentPosition();
+        }
+
+        long StepLossStepperController::distanceToGo()
+        {
+            return _stepGenerator.distanceToGo();
+        }
+
+        bool StepLossStepperController::run()
+        {
+            bool running = _stepGenerator.run();
+            trackGeneratorSteps();
+            return running;
+        }
+
+        void StepLossStepperController::stop()
+        {
+            _stepGenerator.stop();
+        }
+
+        unsigned long StepLossStepperController::nextStepDueMicros()
+        {
+            return _stepGenerator.nextStepDueMicros();
+        }
+
+        void StepLossStepperController::setSpeed(float speed)
+        {
+            _stepGenerator.setSpeed(speed);
+        }
+
+        float StepLossStepperController::getSpeed()
+        {
+            return _stepGenerator.getSpeed();
+        }
+
+        bool StepLossStepperController::runSpeed()
+        {
+            bool stepped = _stepGenerator.runSpeed();
+            trackGeneratorSteps();
+            return stepped;
+        }
+
+        long StepLossStepperController::getRotorPosition() const
+        {
+            return _rotorPosition;
+        }
+
+        unsigned long StepLossStepperController::getLostSteps() const
+        {
+            return _lostSteps;
+        }
+
+        uint64_t StepLossStepperController::getExecutedSteps() const
+        {
+            return _executedSteps;
+        }
+
+        void StepLossStepperController::trackGeneratorSteps()
+        {
+            long position = _stepGenerator.getCurrentPosition();
+            long delta = position - _lastGeneratorPosition;
+            if (delta == 0)
+            {
+                return;
+            }
+            _lastGeneratorPosition = position;
+            unsigned long steps = static_cast<unsigned long>(delta > 0 ? delta : -delta);
+            _executedSteps += steps;
+
+            // the speed after the step, a ramp changes it with every step
+            double stepsPerSec = fabs(_stepGenerator.getSpeed());
+            bool ramping = stepsPerSec != _lastStepsPerSec;
+            _lastStepsPerSec = stepsPerSec;
+            if (stepsPerSec > _config.maxStepsPerSec || (ramping && _acceleration > _config.maxStepsPerSecSq))
+            {
+                _lostSteps += steps;
+                return;
+            }
+            _rotorPosition += delta;
+        }
+    }
+}
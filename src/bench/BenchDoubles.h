@@ -0,0 +1,152 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stepper/api/IStepperController.h>
+#include <stepper/api/IHomingStrategy.h>
+#include <stepper/api/IMotionListener.h>
+#include <soc/api/ISocComponent.h>
+#include <soc/api/IShiftOutput.h>
+#include <soc/api/II2cBus.h>
+
+// =========================================================================
+// --- BENCHMARK DOUBLES ---
+// Minimal, deterministic stand-ins so the benchmarks measure the code
+// under test and not a mock framework.
+// =========================================================================
+namespace bench
+{
+    /**
+     * @brief Controller that never finishes a move while distanceToGo is non-zero.
+     */
+    class FixedStepperController : public stepper::api::IStepperController
+    {
+    public:
+        long distance = 0;
+        bool running = false;
+        long position = 0;
+
+        void setEnablePin(uint8_t) override {}
+        void setPinsInverted(bool, bool, bool) override {}
+        void enableOutputs() override {}
+        void disableOutputs() override {}
+        void setMaxSpeed(float) override {}
+        void setAcceleration(float) override {}
+        void moveTo(long) override {}
+        void move(long) override {}
+        long getCurrentPosition() override { return position; }
+        void setCurrentPosition(long absoluteSteps) override { position = absoluteSteps; }
+        long distanceToGo() override { return distance; }
+        bool run() override { return running; }
+        void stop() override {}
+        unsigned long nextStepDueMicros() override { return micros(); } // a step on every update()
+        void setSpeed(float) override {}
+        float getSpeed() override { return 0; }
+        bool runSpeed() override { return running; }
+    };
+
+    /**
+     * @brief Passes everything to another controller and counts how often it is polled.
+     */
+    class CountingStepperController : public stepper::api::IStepperController
+    {
+    public:
+        unsigned long polls = 0; // run() and runSpeed()
+
+        explicit CountingStepperController(stepper::api::IStepperController &controller) : _controller(controller) {}
+
+        void setEnablePin(uint8_t enablePin) override { _controller.setEnablePin(enablePin); }
+        void setPinsInverted(bool dirInvert, bool stepInvert, bool enableInvert) override { _controller.setPinsInverted(dirInvert, stepInvert, enableInvert); }
+        void enableOutputs() override { _controller.enableOutputs(); }
+        void disableOutputs() override { _controller.disableOutputs(); }
+        void setMaxSpeed(float speed) override { _controller.setMaxSpeed(speed); }
+        void setAcceleration(float acceleration) override { _controller.setAcceleration(acceleration); }
+        void moveTo(long absoluteSteps) override { _controller.moveTo(absoluteSteps); }
+        void move(long relativeSteps) override { _controller.move(relativeSteps); }
+        long getCurrentPosition() override { return _controller.getCurrentPosition(); }
+        void setCurrentPosition(long absoluteSteps) override { _controller.setCurrentPosition(absoluteSteps); }
+        long distanceToGo() override { return _controller.distanceToGo(); }
+        bool run() override
+        {
+            polls++;
+            return _controller.run();
+        }
+        void stop() override { _controller.stop(); }
+        unsigned long nextStepDueMicros() override { return _controller.nextStepDueMicros(); }
+        void setSpeed(float speed) override { _controller.setSpeed(speed); }
+        float getSpeed() override { return _controller.getSpeed(); }
+        bool runSpeed() override
+        {
+            polls++;
+            return _controller.runSpeed();
+        }
+
+    private:
+        stepper::api::IStepperController &_controller;
+    };
+
+    /**
+     * @brief Homing strategy that reports a fixed result.
+     */
+    class FixedHomingStrategy : public stepper::api::IHomingStrategy
+    {
+    public:
+        bool begins = true;
+        stepper::api::HomingResult result = stepper::api::HomingResult::IN_PROGRESS;
+
+        bool beginHoming() override { return begins; }
+        stepper::api::HomingResult updateHoming() override { return result; }
+        stepper::api::HomingResult getHomingResult() const override { return result; }
+        void cancelHoming() override {}
+        void resetStrategy() override {}
+    };
+
+    class CountingMotionListener : public stepper::api::IMotionListener
+    {
+    public:
+        unsigned long events = 0;
+
+        void onMotionEvent(IStepperMotor &, stepper::api::MotionEvent) override { events++; }
+    };
+
+    class EmptyComponent : public soc::api::ISocComponent
+    {
+    public:
+        unsigned long lastTime = 0;
+
+        void advanceState(unsigned long currentTimeMs) override { lastTime = currentTimeMs; }
+        void render() override {}
+    };
+
+    /**
+     * @brief Shift chain that only counts the bytes it is given.
+     */
+    class CountingShiftOutput : public soc::api::IShiftOutput
+    {
+    public:
+        unsigned long bytes = 0;
+
+        void begin() override {}
+        void writeFrames(const uint8_t *, size_t frameLength, size_t frameCount) override { bytes += frameLength * frameCount; }
+    };
+
+    /**
+     * @brief RTC that always reads 13:37:42 on 2026-10-19, and counts its transfers.
+     */
+    class FixedRtcBus : public soc::api::II2cBus
+    {
+    public:
+        unsigned long transfers = 0;
+
+        void begin() override {}
+        bool transfer(uint8_t, const uint8_t *writeData, size_t, uint8_t *readData, size_t readLength) override
+        {
+            static const uint8_t REGISTERS[0x10] = {0x42, 0x37, 0x13, 0x02, 0x19, 0x10, 0x26};
+            transfers++;
+            for (size_t i = 0; i < readLength; i++)
+            {
+                readData[i] = REGISTERS[(writeData[0] + i) % sizeof(REGISTERS)];
+            }
+            return true;
+        }
+    };
+}
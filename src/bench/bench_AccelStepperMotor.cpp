@@ -0,0 +1,193 @@
+#include <benchmark/benchmark.h>
+#include <soc/esp32/ESP32Logger.h>
+#include <memory>
+#include <stepper/accel/AccelStepperMotor.h>
+#include <stepper/accel/CachingStepperController.h>
+#include <stepper/sim/SimulatedStepperController.h>
+#include "BenchDoubles.h"
+
+using stepper::accel::AccelStepperMotor;
+using stepper::api::HomingResult;
+
+static const int STEPS_PER_REVOLUTION = 1600;
+static const uint8_t ENABLE_PIN = 27;
+
+static void BM_AccelStepperMotor_Update_Idle(benchmark::State &state)
+{
+  bench::FixedStepperController controller;
+  bench::FixedHomingStrategy homing;
+  soc::esp32::ESP32Logger logger(soc::api::ILogger::ERROR_LEVEL);
+  AccelStepperMotor motor(controller, STEPS_PER_REVOLUTION, homing, logger, ENABLE_PIN, true);
+
+  for (auto _ : state)
+  {
+    motor.update();
+  }
+}
+BENCHMARK(BM_AccelStepperMotor_Update_Idle);
+
+static void BM_AccelStepperMotor_Update_Moving(benchmark::State &state)
+{
+  bench::FixedStepperController controller;
+  bench::FixedHomingStrategy homing;
+  homing.result = HomingResult::SUCCESS;
+  soc::esp32::ESP32Logger logger(soc::api::ILogger::ERROR_LEVEL);
+  AccelStepperMotor motor(controller, STEPS_PER_REVOLUTION, homing, logger, ENABLE_PIN, true);
+  motor.home();
+
+  // the move never completes, every update() runs the controller
+  controller.distance = 100;
+  controller.running = true;
+  motor.moveToAbsolute(90.0);
+
+  for (auto _ : state)
+  {
+    motor.update();
+  }
+}
+BENCHMARK(BM_AccelStepperMotor_Update_Moving);
+
+static void BM_AccelStepperMotor_Update_HomingInProgress(benchmark::State &state)
+{
+  bench::FixedStepperController controller;
+  bench::FixedHomingStrategy homing;
+  soc::esp32::ESP32Logger logger(soc::api::ILogger::ERROR_LEVEL);
+  AccelStepperMotor motor(controller, STEPS_PER_REVOLUTION, homing, logger, ENABLE_PIN, true);
+  motor.home();
+
+  for (auto _ : state)
+  {
+    motor.update();
+  }
+}
+BENCHMARK(BM_AccelStepperMotor_Update_HomingInProgress);
+
+static void BM_AccelStepperMotor_Update_HomingFailed(benchmark::State &state)
+{
+  bench::FixedStepperController controller;
+  bench::FixedHomingStrategy homing;
+  homing.begins = false;
+  soc::esp32::ESP32Logger logger(soc::api::ILogger::ERROR_LEVEL);
+  AccelStepperMotor motor(controller, STEPS_PER_REVOLUTION, homing, logger, ENABLE_PIN, true);
+  motor.home();
+
+  for (auto _ : state)
+  {
+    motor.update();
+  }
+}
+BENCHMARK(BM_AccelStepperMotor_Update_HomingFailed);
+
+static void BM_AccelStepperMotor_GetCurrentPositionDegrees(benchmark::State &state)
+{
+  bench::FixedStepperController controller;
+  bench::FixedHomingStrategy homing;
+  homing.result = HomingResult::SUCCESS;
+  soc::esp32::ESP32Logger logger(soc::api::ILogger::ERROR_LEVEL);
+  AccelStepperMotor motor(controller, STEPS_PER_REVOLUTION, homing, logger, ENABLE_PIN, true);
+  motor.home();
+
+  for (auto _ : state)
+  {
+    stepper::api::Result<double> position = motor.getCurrentPositionDegrees();
+    benchmark::DoNotOptimize(position);
+  }
+}
+BENCHMARK(BM_AccelStepperMotor_GetCurrentPositionDegrees);
+
+// the query of a motor that lost its position, it used to throw
+static void BM_AccelStepperMotor_GetCurrentPositionDegrees_NotHomed(benchmark::State &state)
+{
+  bench::FixedStepperController controller;
+  bench::FixedHomingStrategy homing;
+  soc::esp32::ESP32Logger logger(soc::api::ILogger::ERROR_LEVEL);
+  AccelStepperMotor motor(controller, STEPS_PER_REVOLUTION, homing, logger, ENABLE_PIN, true);
+
+  for (auto _ : state)
+  {
+    stepper::api::Result<double> position = motor.getCurrentPositionDegrees();
+    benchmark::DoNotOptimize(position);
+  }
+}
+BENCHMARK(BM_AccelStepperMotor_GetCurrentPositionDegrees_NotHomed);
+
+static void BM_AccelStepperMotor_MoveToStep_Rejected(benchmark::State &state)
+{
+  bench::FixedStepperController controller;
+  bench::FixedHomingStrategy homing;
+  soc::esp32::ESP32Logger logger(soc::api::ILogger::ERROR_LEVEL);
+  AccelStepperMotor motor(controller, STEPS_PER_REVOLUTION, homing, logger, ENABLE_PIN, true);
+  motor.home();
+
+  for (auto _ : state)
+  {
+    stepper::api::Status status = motor.moveToStep(400);
+    benchmark::DoNotOptimize(status);
+  }
+}
+BENCHMARK(BM_AccelStepperMotor_MoveToStep_Rejected);
+
+static void BM_AccelStepperMotor_PollMotionState(benchmark::State &state)
+{
+  bench::FixedStepperController controller;
+  bench::FixedHomingStrategy homing;
+  homing.result = HomingResult::SUCCESS;
+  soc::esp32::ESP32Logger logger(soc::api::ILogger::ERROR_LEVEL);
+  AccelStepperMotor motor(controller, STEPS_PER_REVOLUTION, homing, logger, ENABLE_PIN, true);
+  motor.home();
+  controller.distance = 100;
+  controller.running = true;
+  motor.moveToAbsolute(90.0);
+  IStepperMotor &polled = motor;
+
+  // what a hand asked its motor in every loop before the motion events
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(polled.needsHoming() || polled.isHomingFailed() || polled.isBusy());
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_AccelStepperMotor_PollMotionState);
+
+static void BM_AccelStepperMotor_MoveComplete(benchmark::State &state)
+{
+  bench::FixedStepperController controller;
+  bench::FixedHomingStrategy homing;
+  homing.result = HomingResult::SUCCESS;
+  soc::esp32::ESP32Logger logger(soc::api::ILogger::ERROR_LEVEL);
+  AccelStepperMotor motor(controller, STEPS_PER_REVOLUTION, homing, logger, ENABLE_PIN, true);
+  motor.home();
+  bench::CountingMotionListener listener;
+  for (int64_t i = 0; i < state.range(0); i++)
+  {
+    motor.addMotionListener(listener);
+  }
+
+  // a move of zero steps completes in the command, with or without the event
+  for (auto _ : state)
+  {
+    motor.moveToStep(0);
+  }
+  benchmark::DoNotOptimize(listener.events);
+}
+BENCHMARK(BM_AccelStepperMotor_MoveComplete)->ArgName("listeners")->Arg(0)->Arg(1);
+
+static void BM_AccelStepperMotor_MoveToStep_Profile(benchmark::State &state)
+{
+  stepper::sim::SimulatedStepperController simulated;
+  stepper::accel::CachingStepperController cache(simulated);
+  stepper::api::IStepperController &controller = state.range(0) ? static_cast<stepper::api::IStepperController &>(cache) : simulated;
+  bench::FixedHomingStrategy homing;
+  homing.result = HomingResult::SUCCESS;
+  soc::esp32::ESP32Logger logger(soc::api::ILogger::ERROR_LEVEL);
+  AccelStepperMotor motor(controller, STEPS_PER_REVOLUTION, homing, logger, ENABLE_PIN, true);
+  motor.home();
+
+  // a move command sets the unchanged profile and enables the driver, the move itself has no steps
+  for (auto _ : state)
+  {
+    motor.moveToStep(0);
+  }
+  state.counters["skipped"] = benchmark::Counter(static_cast<double>(cache.getSkippedCount()), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_AccelStepperMotor_MoveToStep_Profile)->ArgName("cache")->Arg(0)->Arg(1);
@@ -0,0 +1,156 @@
+#include <Arduino.h>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+#include <soc/esp32/ESP32Logger.h>
+#include <soc/esp32/ESP32MillisTime.h>
+#include <stepper/accel/AccelStepperMotor.h>
+#include <stepper/homing/NoHomingStrategy.h>
+#include <stepper/sim/SimulatedStepperController.h>
+#include <aviator-clock/AviatorClock.h>
+#include "BenchDoubles.h"
+
+using aviator_clock::AviatorClock;
+using aviator_clock::ClockHand;
+
+/**
+ * @brief A clock with N hands, all homed and positioned. The hands cycle through the
+ * three types, so a rollover concerns only a part of them.
+ */
+struct OperatingAviatorClock
+{
+  soc::esp32::ESP32Logger logger{soc::api::ILogger::ERROR_LEVEL};
+  soc::esp32::ESP32MillisTime timeProvider;
+  std::vector<std::unique_ptr<bench::FixedStepperController>> controllers;
+  stepper::homing::NoHomingStrategy homing;
+  AviatorClock clock{timeProvider, logger, 0};
+
+  explicit OperatingAviatorClock(int hands)
+  {
+    virtualClock().reset();
+    for (int i = 0; i < hands; i++)
+    {
+      controllers.push_back(std::make_unique<bench::FixedStepperController>());
+      clock.addHand(std::make_unique<ClockHand>(
+          static_cast<ClockHand::HandType>(i % 3),
+          timeProvider,
+          std::make_unique<stepper::accel::AccelStepperMotor>(*controllers.back(), 1600, homing, logger, 27, true),
+          logger,
+          330.0,
+          0.0,
+          2400.0,
+          60000.0));
+    }
+    clock.setup();
+    clock.advanceState(millis());
+    clock.advanceState(millis());
+  }
+};
+
+// settled between two ticks: should not grow with the number of hands
+static void BM_AviatorClock_AdvanceState_Idle(benchmark::State &state)
+{
+  OperatingAviatorClock clock(static_cast<int>(state.range(0)));
+
+  for (auto _ : state)
+  {
+    clock.clock.advanceState(millis());
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_AviatorClock_AdvanceState_Idle)->RangeMultiplier(2)->Range(3, 96)->Complexity();
+
+// every call sees the next second, only the second hands move
+static void BM_AviatorClock_AdvanceState_NewSecond(benchmark::State &state)
+{
+  OperatingAviatorClock clock(static_cast<int>(state.range(0)));
+
+  for (auto _ : state)
+  {
+    virtualClock().advanceMillis(1000);
+    clock.clock.advanceState(millis());
+    // the fixed controllers finish every move at once
+    clock.clock.advanceState(millis());
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_AviatorClock_AdvanceState_NewSecond)->RangeMultiplier(2)->Range(3, 96)->Complexity();
+
+/**
+ * @brief A clock with an hour, a minute and a second hand on simulated controllers, run
+ * by 20 us loops in virtual time like the firmware.
+ */
+struct SimulatedAviatorClock
+{
+  static const unsigned long LOOP_MICROS = 20;
+
+  soc::esp32::ESP32Logger logger{soc::api::ILogger::ERROR_LEVEL};
+  soc::esp32::ESP32MillisTime timeProvider;
+  std::vector<std::unique_ptr<stepper::sim::SimulatedStepperController>> simulated;
+  std::vector<std::unique_ptr<bench::CountingStepperController>> controllers;
+  stepper::homing::NoHomingStrategy homing;
+  AviatorClock clock{timeProvider, logger, 0};
+
+  SimulatedAviatorClock()
+  {
+    virtualClock().reset();
+    for (int i = 0; i < 3; i++)
+    {
+      simulated.push_back(std::make_unique<stepper::sim::SimulatedStepperController>());
+      controllers.push_back(std::make_unique<bench::CountingStepperController>(*simulated.back()));
+      clock.addHand(std::make_unique<ClockHand>(
+          static_cast<ClockHand::HandType>(i),
+          timeProvider,
+          std::make_unique<stepper::accel::AccelStepperMotor>(*controllers.back(), 1600, homing, logger, 27, true),
+          logger,
+          330.0,
+          0.0,
+          2400.0,
+          60000.0));
+    }
+    clock.setup();
+    runUntilSettled();
+  }
+
+  // returns the number of loops
+  unsigned long runUntilSettled()
+  {
+    unsigned long loops = 0;
+    do
+    {
+      clock.advanceState(millis());
+      virtualClock().advanceMicros(LOOP_MICROS);
+      loops++;
+    } while (!clock.isSettled());
+    return loops;
+  }
+
+  unsigned long polls() const
+  {
+    unsigned long polls = 0;
+    for (const auto &controller : controllers)
+    {
+      polls += controller->polls;
+    }
+    return polls;
+  }
+};
+
+// the loop during a tick of the second hand: the hand polls its controller only when a
+// step is due, the time of the other loops is free for other components or for sleep
+static void BM_AviatorClock_Loop_Tick(benchmark::State &state)
+{
+  SimulatedAviatorClock clock;
+  unsigned long loops = 0;
+  unsigned long pollsBefore = clock.polls();
+
+  for (auto _ : state)
+  {
+    virtualClock().advanceMillis(1000 - millis() % 1000);
+    loops += clock.runUntilSettled();
+  }
+  state.counters["loops"] = benchmark::Counter(loops, benchmark::Counter::kAvgIterations);
+  state.counters["polls"] = benchmark::Counter(clock.polls() - pollsBefore, benchmark::Counter::kAvgIterations);
+  state.counters["loops/s"] = benchmark::Counter(loops, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_AviatorClock_Loop_Tick);
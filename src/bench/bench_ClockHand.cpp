@@ -0,0 +1,117 @@
+#include <Arduino.h>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <soc/esp32/ESP32Logger.h>
+#include <soc/esp32/ESP32MillisTime.h>
+#include <stepper/accel/AccelStepperMotor.h>
+#include <stepper/homing/NoHomingStrategy.h>
+#include <aviator-clock/ClockHand.h>
+#include <aviator-clock/DialMapping.h>
+#include "BenchDoubles.h"
+
+using aviator_clock::ClockHand;
+using aviator_clock::DialMapping;
+
+/**
+ * @brief A SECOND hand that has finished homing and its initial positioning move.
+ */
+struct OperatingClockHand
+{
+  bench::FixedStepperController controller;
+  stepper::homing::NoHomingStrategy homing;
+  soc::esp32::ESP32Logger logger{soc::api::ILogger::ERROR_LEVEL};
+  soc::esp32::ESP32MillisTime timeProvider;
+  std::unique_ptr<ClockHand> hand;
+
+  OperatingClockHand()
+  {
+    virtualClock().reset();
+    hand = std::make_unique<ClockHand>(
+        ClockHand::HandType::SECOND,
+        timeProvider,
+        std::make_unique<stepper::accel::AccelStepperMotor>(controller, 1600, homing, logger, 27, true),
+        logger,
+        330.0,
+        0.0,
+        2400.0,
+        60000.0);
+    hand->setup();
+    hand->advanceState(millis());
+  }
+};
+
+static void BM_ClockHand_AdvanceState_Idle(benchmark::State &state)
+{
+  OperatingClockHand clock;
+
+  // settled between two ticks, same second
+  for (auto _ : state)
+  {
+    clock.hand->advanceState(millis());
+  }
+}
+BENCHMARK(BM_ClockHand_AdvanceState_Idle);
+
+static void BM_ClockHand_AdvanceState_Ticking(benchmark::State &state)
+{
+  OperatingClockHand clock;
+
+  // a tick in progress, the motor is busy on every call
+  virtualClock().advanceMillis(1000);
+  clock.controller.distance = 24;
+  clock.controller.running = true;
+  clock.hand->advanceState(millis());
+
+  for (auto _ : state)
+  {
+    clock.hand->advanceState(millis());
+  }
+}
+BENCHMARK(BM_ClockHand_AdvanceState_Ticking);
+
+static void BM_ClockHand_AdvanceState_NewUnit(benchmark::State &state)
+{
+  OperatingClockHand clock;
+
+  // every call sees the next second and starts a move
+  for (auto _ : state)
+  {
+    virtualClock().advanceMillis(1000);
+    clock.hand->advanceState(millis());
+  }
+}
+BENCHMARK(BM_ClockHand_AdvanceState_NewUnit);
+
+static DialMapping gaugeMapping()
+{
+  // wide in the middle, compressed towards the stop
+  return DialMapping(60, {{0.0, 0.0}, {10.0, 40.0}, {40.0, 250.0}, {50.0, 295.0}, {55.0, 310.0}, {60.0, 318.0}});
+}
+
+static void BM_DialMapping_Spline(benchmark::State &state)
+{
+  DialMapping mapping = gaugeMapping();
+  double unit = 0.0;
+
+  // what every sweep step would cost without the table
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(mapping.degreesAt(unit));
+    unit = unit < 59.0 ? unit + 0.37 : 0.0;
+  }
+}
+BENCHMARK(BM_DialMapping_Spline);
+
+static void BM_DialMapping_Table(benchmark::State &state)
+{
+  DialMapping mapping = gaugeMapping();
+  mapping.bake(1600);
+  uint32_t unit = 0;
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(mapping.subStepsAt(unit));
+    unit = unit < (59UL << 16) ? unit + 24248 : 0;
+  }
+}
+BENCHMARK(BM_DialMapping_Table);
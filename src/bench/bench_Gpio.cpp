@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+#include <Arduino.h>
+#include <soc/esp32/FastGpio.h>
+#include <soc/esp32/ESP32PulseBatch.h>
+#include <soc/esp32/DebounceFilter.h>
+
+using soc::esp32::ESP32PulseBatch;
+using soc::esp32::FastGpio;
+
+// On native both paths end in the pin map of the arduino mock, which dominates the
+// time. The counters show what the target pays for: calls into the GPIO driver
+// against register writes.
+static const uint8_t STEP_PINS[] = {14, 33, 18};
+
+// one step pulse for each of the three hands, the way AccelStepper does it
+static void BM_Gpio_StepPulses_DigitalWrite(benchmark::State &state)
+{
+  for (auto _ : state)
+  {
+    for (uint8_t pin : STEP_PINS)
+    {
+      digitalWrite(pin, HIGH);
+      digitalWrite(pin, LOW);
+    }
+  }
+  state.counters["gpioCalls"] = benchmark::Counter(2.0 * sizeof(STEP_PINS) * state.iterations(), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_Gpio_StepPulses_DigitalWrite);
+
+// the same pulses batched into one set and one clear write
+static void BM_Gpio_StepPulses_Batch(benchmark::State &state)
+{
+  fakeGpioRegisters().reset();
+  fakeGpioRegisters().logWrites = false;
+  ESP32PulseBatch batch(0);
+
+  for (auto _ : state)
+  {
+    for (uint8_t pin : STEP_PINS)
+    {
+      batch.add(FastGpio::mask(pin));
+    }
+    batch.flush();
+  }
+  state.counters["registerWrites"] = benchmark::Counter(
+      static_cast<double>(fakeGpioRegisters().setWrites + fakeGpioRegisters().clearWrites), benchmark::Counter::kAvgIterations);
+  fakeGpioRegisters().reset();
+}
+BENCHMARK(BM_Gpio_StepPulses_Batch);
+
+// one sample of 64 pins through the bit-sliced filters
+static void BM_DebounceFilter_Sample(benchmark::State &state)
+{
+  soc::esp32::DebounceFilter::Mode mode = state.range(0) ? soc::esp32::DebounceFilter::Mode::CONSECUTIVE
+                                                         : soc::esp32::DebounceFilter::Mode::INTEGRATOR;
+  soc::esp32::DebounceFilter filter(~0ULL, {mode, 4});
+  uint64_t levels = 0x5555AAAA0F0FF0F0ULL;
+
+  for (auto _ : state)
+  {
+    levels = levels * 6364136223846793005ULL + 1442695040888963407ULL;
+    filter.sample(levels);
+    benchmark::DoNotOptimize(filter.getStates());
+  }
+}
+BENCHMARK(BM_DebounceFilter_Sample)->ArgName("consecutive")->Arg(0)->Arg(1);
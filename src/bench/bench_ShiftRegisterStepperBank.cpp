@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+#include <Arduino.h>
+#include <stepper/shift/ShiftRegisterStepperBank.h>
+#include "BenchDoubles.h"
+
+using stepper::shift::ShiftRegisterStepperBank;
+
+// one scheduler tick for state.range(0) motors, nothing due
+static void BM_ShiftRegisterStepperBank_Run_Idle(benchmark::State &state)
+{
+  virtualClock().reset();
+  bench::CountingShiftOutput output;
+  ShiftRegisterStepperBank bank(output, static_cast<size_t>(state.range(0)));
+  bank.begin();
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(bank.run());
+  }
+}
+BENCHMARK(BM_ShiftRegisterStepperBank_Run_Idle)->Arg(8)->Arg(32)->Arg(64);
+
+// one scheduler tick in which every motor steps, a burst of two frames
+static void BM_ShiftRegisterStepperBank_Run_AllStepping(benchmark::State &state)
+{
+  virtualClock().reset();
+  bench::CountingShiftOutput output;
+  ShiftRegisterStepperBank bank(output, static_cast<size_t>(state.range(0)));
+  bank.begin();
+  for (size_t motor = 0; motor < bank.getMotorCount(); motor++)
+  {
+    bank.controller(motor).setMaxSpeed(1000);
+    bank.controller(motor).setSpeed(1000);
+  }
+  bank.run(); // latches the direction
+
+  for (auto _ : state)
+  {
+    virtualClock().advanceMicros(1000);
+    benchmark::DoNotOptimize(bank.run());
+  }
+  state.counters["steps"] = benchmark::Counter(static_cast<double>(bank.getStepCount()), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_ShiftRegisterStepperBank_Run_AllStepping)->Arg(8)->Arg(32)->Arg(64);
@@ -0,0 +1,92 @@
+#include <Arduino.h>
+#include <benchmark/benchmark.h>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <soc/esp32/ESP32Logger.h>
+#include <soc/esp32/ESP32MillisTime.h>
+#include <soc/esp32/ESP32Soc.h>
+#include <soc/rtc/DS3231Time.h>
+#include "BenchDoubles.h"
+
+static void BM_ESP32MillisTime_AsTimeComponents(benchmark::State &state)
+{
+  virtualClock().reset();
+  virtualClock().advanceMillis(((13UL * 60 + 37) * 60 + 42) * 1000);
+  soc::esp32::ESP32MillisTime timeProvider;
+  soc::api::ITime::TimeComponents time;
+
+  for (auto _ : state)
+  {
+    timeProvider.asTimeComponents(time);
+    benchmark::DoNotOptimize(time);
+  }
+}
+BENCHMARK(BM_ESP32MillisTime_AsTimeComponents);
+
+// what the hands pay per loop for the time of the RTC: the extrapolation, no bus transfer
+static void BM_DS3231Time_AsTimeComponents(benchmark::State &state)
+{
+  virtualClock().reset();
+  bench::FixedRtcBus bus;
+  soc::rtc::DS3231Rtc rtc(bus);
+  soc::esp32::ESP32MillisTime uptime;
+  soc::esp32::ESP32Logger logger(soc::api::ILogger::ERROR_LEVEL);
+  soc::rtc::DS3231Time timeProvider(rtc, uptime, logger);
+  timeProvider.begin();
+  soc::api::ITime::TimeComponents time;
+
+  for (auto _ : state)
+  {
+    timeProvider.asTimeComponents(time);
+    benchmark::DoNotOptimize(time);
+  }
+  state.counters["transfers"] = static_cast<double>(bus.transfers);
+}
+BENCHMARK(BM_DS3231Time_AsTimeComponents);
+
+static void BM_ESP32Logger_Filtered(benchmark::State &state)
+{
+  soc::esp32::ESP32Logger logger(soc::api::ILogger::WARN_LEVEL);
+
+  for (auto _ : state)
+  {
+    logger.debug("ClockHand: Moving to unit %d (Angle: %.2f)", 42, 231.0);
+  }
+}
+BENCHMARK(BM_ESP32Logger_Filtered);
+
+static void BM_ESP32Logger_Emitted(benchmark::State &state)
+{
+  soc::esp32::ESP32Logger logger(soc::api::ILogger::WARN_LEVEL);
+
+  // MockSerial writes to std::cout, keep the output out of the report
+  std::ostringstream sink;
+  std::streambuf *original = std::cout.rdbuf(sink.rdbuf());
+  for (auto _ : state)
+  {
+    logger.warn("ClockHand: Moving to unit %d (Angle: %.2f)", 42, 231.0);
+    sink.str("");
+  }
+  std::cout.rdbuf(original);
+}
+BENCHMARK(BM_ESP32Logger_Emitted);
+
+static void BM_ESP32Soc_Dispatch(benchmark::State &state)
+{
+  soc::esp32::ESP32Soc soc;
+  for (int64_t i = 0; i < state.range(0); i++)
+  {
+    soc.addComponent(std::make_shared<bench::EmptyComponent>());
+  }
+
+  unsigned long time = 0;
+  for (auto _ : state)
+  {
+    soc.processInput();
+    soc.advanceState(time++);
+    soc.render();
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_ESP32Soc_Dispatch)->RangeMultiplier(2)->Range(1, 64)->Complexity();
@@ -0,0 +1,44 @@
+#include <Arduino.h>
+#include <benchmark/benchmark.h>
+#include <soc/trace/TraceRecorder.h>
+
+static void BM_TraceRecorder_State(benchmark::State &state)
+{
+  soc::trace::TraceRecorder recorder;
+  int track = 0;
+
+  for (auto _ : state)
+  {
+    recorder.record(soc::trace::TraceEventType::STATE, &track, "MOVING", 0);
+  }
+  benchmark::DoNotOptimize(recorder.size());
+}
+BENCHMARK(BM_TraceRecorder_State);
+
+// the macro path goes through TraceRecorder::instance()
+static void BM_TraceRecorder_BeginEndMacro(benchmark::State &state)
+{
+  static const char TRACK[] = "bench";
+
+  for (auto _ : state)
+  {
+    SOC_TRACE_BEGIN(TRACK, "loop");
+    SOC_TRACE_END(TRACK, "loop");
+  }
+  soc::trace::TraceRecorder::instance().clear();
+}
+BENCHMARK(BM_TraceRecorder_BeginEndMacro);
+
+static void BM_TraceRecorder_Disabled(benchmark::State &state)
+{
+  soc::trace::TraceRecorder recorder;
+  recorder.setEnabled(false);
+  int track = 0;
+
+  for (auto _ : state)
+  {
+    recorder.record(soc::trace::TraceEventType::INSTANT, &track, "moveToUnit", 7);
+  }
+  benchmark::DoNotOptimize(recorder.size());
+}
+BENCHMARK(BM_TraceRecorder_Disabled);
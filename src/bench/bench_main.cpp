@@ -0,0 +1,46 @@
+// =========================================================================
+// --- NATIVE BENCHMARKS ---
+// Google Benchmark suite for the hot paths of the clock. Results are
+// written as JSON to bench_output.json unless --benchmark_out is given,
+// so the per-iteration cost can be tracked across commits.
+//
+//   .pio/build/benchmarks/program [--benchmark_filter=REGEX] [--benchmark_out=FILE]
+// =========================================================================
+#include <Arduino.h>
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <vector>
+
+MockSerial Serial;
+
+int main(int argc, char **argv)
+{
+  std::vector<char *> args(argv, argv + argc);
+
+  bool hasOutput = false;
+  for (int i = 1; i < argc; i++)
+  {
+    if (strncmp(argv[i], "--benchmark_out=", strlen("--benchmark_out=")) == 0)
+    {
+      hasOutput = true;
+    }
+  }
+
+  static char defaultOutput[] = "--benchmark_out=bench_output.json";
+  static char defaultFormat[] = "--benchmark_out_format=json";
+  if (!hasOutput)
+  {
+    args.push_back(defaultOutput);
+    args.push_back(defaultFormat);
+  }
+
+  int count = static_cast<int>(args.size());
+  benchmark::Initialize(&count, args.data());
+  if (benchmark::ReportUnrecognizedArguments(count, args.data()))
+  {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,123 @@
+#include <ClockComposition.h>
+
+using aviator_clock::ClockHand;
+
+// where the tick profiles are saved, by HandType
+static const char *const TICK_PROFILE_KEYS[] = {"tick-hour", "tick-minute", "tick-second"};
+
+ClockComposition::ClockComposition(IClockLeaves &leaves,
+                                   soc::api::ITime &timeProvider,
+                                   soc::api::ILogger &logger,
+                                   soc::api::IPersistentStore *store,
+                                   const Settings &settings)
+    : _leaves(leaves),
+      _timeProvider(timeProvider),
+      _logger(logger),
+      _store(store),
+      _settings(settings),
+      _parts{},
+      _clock(nullptr)
+{
+}
+
+void ClockComposition::compose(soc::api::ISoc &soc)
+{
+  auto clock = std::make_shared<aviator_clock::AviatorClock>(_timeProvider, _logger, HAND_MOVE_STAGGER_MS);
+  // the hands do not depend on each other, one homes while another is still tuned
+  static const ClockHand::HandType ORDER[] = {ClockHand::HandType::SECOND,
+                                              ClockHand::HandType::MINUTE,
+                                              ClockHand::HandType::HOUR};
+  for (ClockHand::HandType type : ORDER)
+  {
+    clock->addHand(createHand(type));
+  }
+  _clock = clock.get();
+
+  // the soc sets up the tunings and the clock, the clock every hand once its tuning is done
+  for (ClockHand::HandType type : ORDER)
+  {
+    if (_parts[static_cast<int>(type)].tuning)
+    {
+      soc.addComponent(_parts[static_cast<int>(type)].tuning);
+    }
+  }
+  soc.addComponent(clock);
+}
+
+aviator_clock::AviatorClock &ClockComposition::clock() const
+{
+  return *_clock;
+}
+
+ClockHand &ClockComposition::hand(ClockHand::HandType type) const
+{
+  return *_parts[static_cast<int>(type)].hand;
+}
+
+stepper::accel::AccelStepperMotor &ClockComposition::motor(ClockHand::HandType type) const
+{
+  return *_parts[static_cast<int>(type)].motor;
+}
+
+stepper::accel::CachingStepperController &ClockComposition::commandCache(ClockHand::HandType type) const
+{
+  return *_parts[static_cast<int>(type)].commandCache;
+}
+
+aviator_clock::TickProfileTuning *ClockComposition::tuning(ClockHand::HandType type) const
+{
+  return _parts[static_cast<int>(type)].tuning.get();
+}
+
+std::unique_ptr<ClockHand> ClockComposition::createHand(ClockHand::HandType type)
+{
+  HandParts &parts = _parts[static_cast<int>(type)];
+  soc::api::IDigitalInput &limitSwitch = _leaves.limitSwitch(type);
+
+  // the motor and the homing configure the controller through the same cache
+  parts.commandCache = std::make_unique<stepper::accel::CachingStepperController>(_leaves.controller(type));
+  parts.homingStrategy = std::make_unique<stepper::homing::LimitSwitchHomingStrategy>(
+      *parts.commandCache,
+      limitSwitch,
+      homingConfig,
+      _logger);
+
+  // a reduced hold current chops the enable pin, the PWM output takes it over from the driver
+  bool reducedHold = _settings.power.idlePower == stepper::accel::AccelStepperMotor::IdlePower::REDUCED;
+  auto motor = std::make_unique<stepper::accel::AccelStepperMotor>(
+      *parts.commandCache,
+      EFFECTIVE_STEPS_PER_REVOLUTION,
+      *parts.homingStrategy,
+      _logger,
+      reducedHold ? INVALID_PIN : _leaves.enablePin(type),
+      true // enablePinActiveLow
+  );
+  motor->setPowerConfig(_settings.power, reducedHold ? &_leaves.enablePwm(type) : nullptr);
+  parts.motor = motor.get();
+
+  auto hand = std::make_unique<ClockHand>(
+      type,
+      _timeProvider,
+      std::move(motor),
+      _logger,
+      DIAL_TOTAL_ACTIVE_ANGLE,
+      DIAL_START_OFFSET_DEGREES,
+      _settings.tickSpeedDps,
+      _settings.tickAccelerationDps2);
+  hand->setCatchUpProfile(CATCH_UP_SPEED_DPS, CATCH_UP_ACCELERATION_DPS2, CATCH_UP_THRESHOLD_UNITS);
+  if (type == ClockHand::HandType::SECOND && _settings.secondHandSweeps)
+  {
+    hand->setMotionMode(ClockHand::MotionMode::SWEEP);
+  }
+  parts.hand = hand.get();
+
+  // the hand waits for its tick profile, the saved one or a tuned one
+  if (_store)
+  {
+    parts.tuning = std::make_shared<aviator_clock::TickProfileTuning>(
+        *hand, *parts.motor, limitSwitch, *_store, TICK_PROFILE_KEYS[static_cast<int>(type)], _logger,
+        TICK_PROFILE_TUNING, _settings.retune);
+    hand->setDependency(parts.tuning.get());
+  }
+  return hand;
+}
@@ -0,0 +1,337 @@
+// =========================================================================
+// --- THE CLOCK AS A LINUX PROCESS ---
+// Runs the composition of main.cpp, ClockComposition, on the soc-linux library, in real time
+// or accelerated, for soak and performance tests. The stepper drivers are
+// SimulatedStepperControllers and the limit switches SimulatedLimitSwitches,
+// like in the simulation, but time is the monotonic clock of the host and
+// the loop really runs, with all the scheduling noise of the host.
+//
+//   .pio/build/linux/program [--speed N] [--seconds N] [--status N]
+//                            [--log FILE] [--switch-fifo PATH]
+//
+// --speed lets the time pass N times faster than the wall clock. The loop
+// does not run faster, so the steps get coarser with the speed: a tick
+// takes ~20 ms, above about 10 the hands start to miss steps and ticks.
+//
+// --seconds stops after N seconds of clock time, 0 runs until Ctrl-C.
+// --status prints a status line every N seconds of clock time.
+//
+// --log writes the log of the clock to a file instead of stdout.
+//
+// --switch-fifo replaces the limit switch of the second hand with a named
+// pipe, to press and release it by hand: echo 1 > PATH, echo 0 > PATH.
+//
+// The Arduino time the libraries read (millis(), micros()) follows the
+// steady clock, it is the virtual clock of the arduino mock set forward
+// before every loop iteration. Idle loops sleep until the next second.
+// =========================================================================
+#include <Arduino.h>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+// --- Framework/SoC Includes ---
+#include <soc/api/ISocComponent.h>
+#include <soc/posix/PosixDigitalInput.h>
+#include <soc/posix/PosixLogger.h>
+#include <soc/posix/PosixSleeper.h>
+#include <soc/posix/PosixSoc.h>
+#include <soc/posix/PosixSteadyTime.h>
+
+// --- Stepper Includes ---
+#include <stepper/api/IStepperController.h>
+#include <stepper/sim/SimulatedStepperController.h>
+#include <stepper/sim/SimulatedLimitSwitch.h>
+
+// --- Application Includes ---
+#include <aviator-clock/AviatorClock.h>
+#include <aviator-clock/ClockHand.h>
+#include <ClockComposition.h>
+#include <ClockConfig.h>
+
+MockSerial Serial;
+
+// --- Process Settings ---
+struct ProcessSettings
+{
+  double speed = 1.0;
+  double seconds = 0.0;         // clock time to run, 0 until interrupted
+  double statusSeconds = 60.0;  // clock time between two status lines
+  const char *logFile = nullptr;
+  const char *switchFifo = nullptr;
+  long rotorStartPosition = 500; // physical hand position at power up, switch is at 0
+};
+
+// The enable pins with a reduced hold current, the chopping is not modelled here.
+class UnconnectedPwmOutput : public soc::api::IPwmOutput
+{
+public:
+  void begin() override {}
+  void setDuty(uint16_t /*duty*/) override {}
+};
+UnconnectedPwmOutput unconnectedPwm;
+
+// =========================================================================
+// --- GLOBAL DECLARATIONS ---
+// Same as main.cpp, on the soc-linux leaves.
+// =========================================================================
+std::unique_ptr<soc::posix::PosixLogger> logger;
+std::unique_ptr<soc::posix::PosixSteadyTime> timeProvider;
+std::unique_ptr<soc::posix::PosixSleeper> sleeper;
+std::unique_ptr<soc::posix::PosixSoc> soc_;
+
+struct ProcessHandHardware
+{
+  std::unique_ptr<stepper::sim::SimulatedStepperController> stepper;
+  std::unique_ptr<soc::api::IDigitalInput> limitSwitch;
+};
+ProcessHandHardware handHardware[3]; // by HandType
+
+// The leaves of the composition, the limit switch of the second hand may be a named pipe.
+class ProcessLeaves : public IClockLeaves
+{
+public:
+  explicit ProcessLeaves(const ProcessSettings &settings)
+  {
+    for (int type = 0; type < 3; type++)
+    {
+      ProcessHandHardware &hardware = handHardware[type];
+      hardware.stepper = std::make_unique<stepper::sim::SimulatedStepperController>(settings.rotorStartPosition);
+      if (type == static_cast<int>(aviator_clock::ClockHand::HandType::SECOND) && settings.switchFifo)
+      {
+        hardware.limitSwitch = std::make_unique<soc::posix::PosixDigitalInput>(settings.switchFifo);
+      }
+      else
+      {
+        hardware.limitSwitch = std::make_unique<stepper::sim::SimulatedLimitSwitch>(
+            *hardware.stepper,
+            0,
+            homingConfig.moveDirectionSign);
+      }
+      hardware.limitSwitch->begin();
+    }
+  }
+
+  stepper::api::IStepperController &controller(aviator_clock::ClockHand::HandType type) override
+  {
+    return *handHardware[static_cast<int>(type)].stepper;
+  }
+
+  soc::api::IDigitalInput &limitSwitch(aviator_clock::ClockHand::HandType type) override
+  {
+    return *handHardware[static_cast<int>(type)].limitSwitch;
+  }
+
+  soc::api::IPwmOutput &enablePwm(aviator_clock::ClockHand::HandType /*type*/) override
+  {
+    return unconnectedPwm;
+  }
+
+  uint8_t enablePin(aviator_clock::ClockHand::HandType /*type*/) const override
+  {
+    return ENABLE_PIN_HW;
+  }
+};
+std::unique_ptr<ProcessLeaves> handLeaves;
+std::unique_ptr<ClockComposition> composition;
+
+// Observer only, the clock is owned by the soc.
+aviator_clock::AviatorClock *clockView = nullptr;
+
+static volatile std::sig_atomic_t stopRequested = 0;
+
+static void requestStop(int)
+{
+  stopRequested = 1;
+}
+
+void setup(const ProcessSettings &settings)
+{
+  logger = settings.logFile
+               ? std::make_unique<soc::posix::PosixLogger>(settings.logFile, soc::api::ILogger::INFO_LEVEL)
+               : std::make_unique<soc::posix::PosixLogger>(soc::api::ILogger::INFO_LEVEL);
+  timeProvider = std::make_unique<soc::posix::PosixSteadyTime>(settings.speed);
+  sleeper = std::make_unique<soc::posix::PosixSleeper>(settings.speed);
+  soc_ = std::make_unique<soc::posix::PosixSoc>();
+
+  logger->info("=================================================");
+  logger->info(" Linux Aviator Clock, time x%.1f", settings.speed);
+  logger->info("=================================================");
+
+  // no store: the hands are not tuned, they tick at the default profile
+  handLeaves = std::make_unique<ProcessLeaves>(settings);
+  composition = std::make_unique<ClockComposition>(*handLeaves, *timeProvider, *logger, nullptr,
+                                                   ClockComposition::Settings());
+  // the soc sets the clock up, and the clock its hands
+  composition->compose(*soc_);
+  clockView = &composition->clock();
+  logger->info("All components created and wired up successfully.");
+}
+
+void loop()
+{
+  soc_->processInput();
+  soc_->advanceState(millis());
+  soc_->render();
+}
+
+// --- Statistics ---
+struct LoopStatistics
+{
+  unsigned long long loops = 0;
+  unsigned long long sleeps = 0;
+  double busySeconds = 0.0;    // wall clock spent in loop()
+  double maxLoopMicros = 0.0;  // wall clock of the longest loop() since the last status
+};
+
+static void printStatus(const LoopStatistics &statistics, double wallSeconds)
+{
+  // the log may share stdout, it goes first
+  logger->flush();
+  soc::api::ITime::TimeComponents time;
+  timeProvider->asTimeComponents(time);
+  printf("%3lu:%02d:%02d  loops %llu (%.0f/s), busy %.1f %%, max loop %.1f us, steps %llu/%llu/%llu\n",
+         time.hours, time.minutes, time.seconds,
+         statistics.loops, wallSeconds > 0 ? statistics.loops / wallSeconds : 0.0,
+         wallSeconds > 0 ? 100.0 * statistics.busySeconds / wallSeconds : 0.0,
+         statistics.maxLoopMicros,
+         static_cast<unsigned long long>(handHardware[2].stepper->getTotalSteps()),
+         static_cast<unsigned long long>(handHardware[1].stepper->getTotalSteps()),
+         static_cast<unsigned long long>(handHardware[0].stepper->getTotalSteps()));
+  fflush(stdout);
+}
+
+static bool parseArguments(int argc, char **argv, ProcessSettings &settings)
+{
+  for (int i = 1; i < argc; i++)
+  {
+    bool hasValue = i + 1 < argc;
+    if (strcmp(argv[i], "--speed") == 0 && hasValue)
+    {
+      settings.speed = atof(argv[++i]);
+    }
+    else if (strcmp(argv[i], "--seconds") == 0 && hasValue)
+    {
+      settings.seconds = atof(argv[++i]);
+    }
+    else if (strcmp(argv[i], "--status") == 0 && hasValue)
+    {
+      settings.statusSeconds = atof(argv[++i]);
+    }
+    else if (strcmp(argv[i], "--log") == 0 && hasValue)
+    {
+      settings.logFile = argv[++i];
+    }
+    else if (strcmp(argv[i], "--switch-fifo") == 0 && hasValue)
+    {
+      settings.switchFifo = argv[++i];
+    }
+    else
+    {
+      fprintf(stderr, "usage: %s [--speed N] [--seconds N] [--status N] [--log FILE] [--switch-fifo PATH]\n", argv[0]);
+      return false;
+    }
+  }
+  if (settings.speed <= 0.0)
+  {
+    settings.speed = 1.0;
+  }
+  if (settings.statusSeconds <= 0.0)
+  {
+    settings.statusSeconds = 60.0;
+  }
+  return true;
+}
+
+int main(int argc, char **argv)
+{
+  ProcessSettings settings;
+  if (!parseArguments(argc, argv, settings))
+  {
+    return 2;
+  }
+
+  std::signal(SIGINT, requestStop);
+  std::signal(SIGTERM, requestStop);
+  // a pipe reader going away must not end the process
+  std::signal(SIGPIPE, SIG_IGN);
+
+  const unsigned long long SECOND_MICROS = 1000000ULL;
+  const unsigned long long endMicros = static_cast<unsigned long long>(settings.seconds * SECOND_MICROS);
+  const unsigned long long statusMicros = static_cast<unsigned long long>(settings.statusSeconds * SECOND_MICROS);
+
+  virtualClock().reset();
+  auto wallStart = std::chrono::steady_clock::now();
+  setup(settings);
+
+  LoopStatistics statistics;
+  unsigned long long nextStatusMicros = statusMicros;
+  while (!stopRequested)
+  {
+    unsigned long long now = timeProvider->nowMicros();
+    if (endMicros > 0 && now >= endMicros)
+    {
+      break;
+    }
+    // the libraries read the Arduino time
+    virtualClock().advanceTo(now);
+
+    auto loopStart = std::chrono::steady_clock::now();
+    loop();
+    double loopSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - loopStart).count();
+    statistics.loops++;
+    statistics.busySeconds += loopSeconds;
+    if (loopSeconds * 1e6 > statistics.maxLoopMicros)
+    {
+      statistics.maxLoopMicros = loopSeconds * 1e6;
+    }
+
+    if (now >= nextStatusMicros)
+    {
+      printStatus(statistics, std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count());
+      statistics.maxLoopMicros = 0.0;
+      nextStatusMicros += statusMicros;
+    }
+
+    // Nothing happens before the next second once the clock is settled, a hand that
+    // failed to home included, and the hands waiting for their move slot or to power
+    // down wait in whole milliseconds. Only a stepping motor keeps the loop busy.
+    bool stepping = false;
+    for (const ProcessHandHardware &hardware : handHardware)
+    {
+      stepping = stepping || hardware.stepper->isRunning();
+    }
+    if (clockView->isSettled())
+    {
+      sleeper->sleepMicros(SECOND_MICROS - now % SECOND_MICROS);
+      statistics.sleeps++;
+    }
+    else if (!stepping)
+    {
+      sleeper->sleep(1);
+      statistics.sleeps++;
+    }
+  }
+
+  soc_.reset(); // tears the clock down
+  double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+  double clockSeconds = static_cast<double>(virtualClock().nowMicros()) / SECOND_MICROS;
+  logger->flush();
+
+  printf("=================================================\n");
+  printf(" Aviator Clock on Linux\n");
+  printf("=================================================\n");
+  printf("clock time:              %.1f s\n", clockSeconds);
+  printf("wall time:               %.1f s (x%.1f)\n", wallSeconds, settings.speed);
+  printf("loop iterations:         %llu (%.0f/s)\n", statistics.loops, wallSeconds > 0 ? statistics.loops / wallSeconds : 0.0);
+  printf("sleeps:                  %llu\n", statistics.sleeps);
+  printf("busy:                    %.1f %% of the wall time\n", wallSeconds > 0 ? 100.0 * statistics.busySeconds / wallSeconds : 0.0);
+  printf("steps second/min/hour:   %llu/%llu/%llu\n",
+         static_cast<unsigned long long>(handHardware[2].stepper->getTotalSteps()),
+         static_cast<unsigned long long>(handHardware[1].stepper->getTotalSteps()),
+         static_cast<unsigned long long>(handHardware[0].stepper->getTotalSteps()));
+  return 0;
+}
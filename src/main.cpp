@@ -1,39 +1,38 @@
 #include <Arduino.h>
 #include <memory>
+#include <vector>
 
 // --- Framework/SoC Includes ---
 #include <soc/api/ISocComponent.h>
 #include <soc/esp32/ESP32MillisTime.h>
+#include <soc/esp32/ESP32I2cBus.h>
+#include <soc/esp32/ESP32PreferencesStore.h>
+#include <soc/rtc/DS3231Rtc.h>
+#include <soc/rtc/DS3231Time.h>
+#include <soc/rtc/DriftCompensatedTime.h>
+#include <soc/rtc/DriftSampler.h>
+#include <soc/rtc/RtcSync.h>
 #include <soc/esp32/ESP32Logger.h>
-#include <soc/esp32/ESP32Logger.h>
+#include <soc/esp32/ThrottledLogger.h>
+#include <soc/esp32/ESP32SerialTraceSink.h>
+#include <soc/esp32/ESP32Soc.h>
+#include <soc/trace/BootProfiler.h>
+#include <soc/trace/TraceRecorder.h>
 
 // --- Stepper Includes ---
 #include <stepper/api/IStepperController.h>
-#include <stepper/api/IHomingStrategy.h>
 #include <stepper/accel/AccelStepperWrapper.h>
-#include <stepper/accel/AccelStepperMotor.h>
-#include <stepper/homing/LimitSwitchHomingStrategy.h>
-#include <soc/esp32/ESP32DigitalInput.h>
+#include <soc/esp32/ESP32DebouncedInput.h>
+#include <soc/esp32/ESP32InputSampler.h>
+#include <soc/esp32/ESP32LedcPwmOutput.h>
+#include <soc/esp32/ESP32PulseBatch.h>
+#include <soc/esp32/FastGpio.h>
 
 // --- Application Includes ---
 #include <aviator-clock/ClockHand.h>
-
-// --- Pin Definitions ---
-#define DIR_PIN_HW 12
-#define STEP_PIN_HW 14
-#define ENABLE_PIN_HW 27
-#define LIMIT_SWITCH_PIN_HW 26
-
-// --- Motor Configuration ---
-const int EFFECTIVE_STEPS_PER_REVOLUTION = 1600;
-
-// --- Clock Face Configuration ---
-const double DIAL_TOTAL_ACTIVE_ANGLE = 330.0;
-const double DIAL_START_OFFSET_DEGREES = 0.0;
-
-// --- Settings for Sharper Movement ---
-const double SHARP_TICK_SPEED_DPS = 2400.0;
-const double SHARP_TICK_ACCELERATION_DPS2 = 60000.0;
+#include <ClockComposition.h>
+#include <ClockConfig.h>
+#include <FirmwareConfig.h>
 
 // =========================================================================
 // --- GLOBAL DECLARATIONS ---
@@ -41,100 +40,265 @@ const double SHARP_TICK_ACCELERATION_DPS2 = 60000.0;
 // This decouples our application from concrete implementations.
 // see "The Static Initialization Order Fiasco"
 // =========================================================================
+// Times the phases of setup() and the setups of the components, reported once the clock is homed.
+std::unique_ptr<soc::trace::BootProfiler> bootProfiler;
 std::unique_ptr<soc::api::ILogger> logger;
 std::unique_ptr<soc::api::ITime> timeProvider;
-std::unique_ptr<stepper::api::IStepperController> accelWrapper;
-std::unique_ptr<soc::api::IDigitalInput> limitSwitch;
-std::unique_ptr<stepper::api::IHomingStrategy> homingStrategy;
-std::unique_ptr<IStepperMotor> motor;
-std::unique_ptr<soc::api::ISocComponent> clockHand;
+// the time since boot, corrected to the rate of the RTC; the RTC time extrapolates with it
+std::unique_ptr<soc::api::ITime> uptime;
+std::unique_ptr<soc::api::ITime> compensatedUptime;
+// takes the readings of the RTC for the drift compensation in the loop
+std::shared_ptr<soc::rtc::DriftSampler> driftSampler;
+// the drift compensation logs through it, see ThrottledDriftSampler
+std::unique_ptr<soc::esp32::ThrottledLogger> driftLogger;
+// reads the RTC for the time of the clock in the loop, see DS3231Time
+std::shared_ptr<soc::rtc::RtcSync> rtcSync;
+std::unique_ptr<soc::api::II2cBus> i2cBus;
+std::unique_ptr<soc::rtc::DS3231Rtc> rtc;
+std::unique_ptr<soc::api::IPersistentStore> store;
+
+// The step pulses of all hands of a loop, written with one register write.
+std::unique_ptr<soc::esp32::ESP32PulseBatch> stepPulses;
+
+// Samples and debounces the limit switches of all hands from a timer.
+std::unique_ptr<soc::esp32::ESP32InputSampler> limitSwitchSampler;
+
+// Throttles the logs of the drift compensation while the watchdog degrades it. It and the
+// RTC sync are the non-critical components of the world, the tunings and the clock drive motors.
+class ThrottledDriftSampler : public soc::rtc::DriftSampler
+{
+public:
+  ThrottledDriftSampler(soc::rtc::DriftCompensatedTime &time, soc::esp32::ThrottledLogger &logger)
+      : soc::rtc::DriftSampler(time), _logger(logger)
+  {
+  }
+
+  void setDegraded(bool degraded) override
+  {
+    soc::rtc::DriftSampler::setDegraded(degraded);
+    _logger.setThrottled(degraded);
+  }
+
+private:
+  soc::esp32::ThrottledLogger &_logger;
+};
+
+// The leaves of the hands on the board, the composition builds the clock on them.
+class BoardLeaves : public IClockLeaves
+{
+public:
+  BoardLeaves(soc::esp32::ESP32PulseBatch &stepPulses, soc::esp32::ESP32InputSampler &limitSwitchSampler)
+  {
+    for (int i = 0; i < 3; i++)
+    {
+      _hands[i].accelWrapper = std::make_unique<stepper::accel::AccelStepperWrapper>(PINS[i].step, PINS[i].dir, stepPulses);
+      _hands[i].limitSwitch = std::make_unique<soc::esp32::ESP32DebouncedInput>(limitSwitchSampler, PINS[i].limitSwitch, true);
+      _hands[i].limitSwitch->begin();
+    }
+  }
+
+  stepper::api::IStepperController &controller(aviator_clock::ClockHand::HandType type) override
+  {
+    return *_hands[static_cast<int>(type)].accelWrapper;
+  }
+
+  soc::api::IDigitalInput &limitSwitch(aviator_clock::ClockHand::HandType type) override
+  {
+    return *_hands[static_cast<int>(type)].limitSwitch;
+  }
+
+  // reduces the hold current, see COIL_POWER
+  soc::api::IPwmOutput &enablePwm(aviator_clock::ClockHand::HandType type) override
+  {
+    int i = static_cast<int>(type);
+    if (!_hands[i].enablePwm)
+    {
+      _hands[i].enablePwm = std::make_unique<soc::esp32::ESP32LedcPwmOutput>(
+          PINS[i].enable, PINS[i].enablePwmChannel, ENABLE_PWM_FREQUENCY_HZ, true);
+    }
+    return *_hands[i].enablePwm;
+  }
+
+  uint8_t enablePin(aviator_clock::ClockHand::HandType type) const override
+  {
+    return PINS[static_cast<int>(type)].enable;
+  }
+
+private:
+  struct HandPins
+  {
+    uint8_t step;
+    uint8_t dir;
+    uint8_t enable;
+    uint8_t enablePwmChannel;
+    uint8_t limitSwitch;
+  };
+  // by HandType
+  static constexpr HandPins PINS[3] = {
+      {HOUR_STEP_PIN_HW, HOUR_DIR_PIN_HW, HOUR_ENABLE_PIN_HW, HOUR_ENABLE_PWM_CHANNEL, HOUR_LIMIT_SWITCH_PIN_HW},
+      {MINUTE_STEP_PIN_HW, MINUTE_DIR_PIN_HW, MINUTE_ENABLE_PIN_HW, MINUTE_ENABLE_PWM_CHANNEL, MINUTE_LIMIT_SWITCH_PIN_HW},
+      {STEP_PIN_HW, DIR_PIN_HW, ENABLE_PIN_HW, ENABLE_PWM_CHANNEL, LIMIT_SWITCH_PIN_HW}};
+
+  struct HandLeaves
+  {
+    std::unique_ptr<stepper::api::IStepperController> accelWrapper;
+    std::unique_ptr<soc::api::IDigitalInput> limitSwitch;
+    std::unique_ptr<soc::api::IPwmOutput> enablePwm;
+  };
+  HandLeaves _hands[3];
+};
+std::unique_ptr<BoardLeaves> handLeaves;
+
+// The motors, hands and tunings on the leaves. The motors are owned by the hands,
+// the hands by the clock and the clock and the tunings by the world.
+std::unique_ptr<ClockComposition> composition;
+
+// Runs the clock, it is booted once the clock finished its setup, the homing.
+std::unique_ptr<soc::esp32::ESP32Soc> world;
+
+// Track of the main loop in the trace, see lib/soc-trace
+static const char LOOP_TRACK[] = "loop";
 
 // --- State Flags of the main program---
 bool clockOperationSetupDone = false;
 bool failureLogged = false;
-
-// --- Homing Configuration ---
-const stepper::homing::LimitSwitchHomingStrategy::Config homingConfig = {
-    .homingSpeedStepsPerSec = 400,                              // Slower speed for homing (e.g., 1/4 revolution per sec if 1600 steps/rev)
-    .homingAccelerationStepsPerSecSq = 800,                     // Gentle acceleration
-    .maxHomingTravelSteps = EFFECTIVE_STEPS_PER_REVOLUTION * 2, // e.g., allow 2 full revolutions to find switch
-    .moveDirectionSign = -1                                     // IMPORTANT: Set this to +1 or -1 depending on your setup!
-                                                                // -1 usually means counter-clockwise for AccelStepper
-};
+bool bootReported = false;
 
 void setup()
 {
-  Serial.begin(115200);
+  // first, it times everything else; every block of setup() is a phase
+  bootProfiler = std::make_unique<soc::trace::BootProfiler>();
+  using BootPhase = soc::trace::BootProfiler::Scope;
+  {
+    BootPhase phase(bootProfiler.get(), "serial");
+    Serial.begin(115200);
+  }
   // =========================================================================
   // --- INSTANTIATION AND WIRING (Dependency Injection) ---
   // Create all objects in a controlled order, satisfying dependencies.
   // This is our "Composition Root".
   // see "The Static Initialization Order Fiasco"
   // =========================================================================
-  logger = std::make_unique<soc::esp32::ESP32Logger>(soc::api::ILogger::INFO_LEVEL);
-  timeProvider = std::make_unique<soc::esp32::ESP32MillisTime>();
-  accelWrapper = std::make_unique<stepper::accel::AccelStepperWrapper>(STEP_PIN_HW, DIR_PIN_HW);
-  limitSwitch = std::make_unique<soc::esp32::ESP32DigitalInput>(LIMIT_SWITCH_PIN_HW, true);
-  limitSwitch->begin();
+  {
+    BootPhase phase(bootProfiler.get(), "logger");
+    logger = std::make_unique<soc::esp32::ESP32Logger>(soc::api::ILogger::INFO_LEVEL);
+    uptime = std::make_unique<soc::esp32::ESP32MillisTime>();
+  }
+  {
+    BootPhase phase(bootProfiler.get(), "i2c bus");
+    i2cBus = std::make_unique<soc::esp32::ESP32I2cBus>(RTC_SDA_PIN_HW, RTC_SCL_PIN_HW, RTC_I2C_FREQUENCY_HZ);
+    i2cBus->begin();
+    rtc = std::make_unique<soc::rtc::DS3231Rtc>(*i2cBus);
+  }
+  {
+    BootPhase phase(bootProfiler.get(), "nvs");
+    store = std::make_unique<soc::esp32::ESP32PreferencesStore>(PREFERENCES_NAMESPACE);
+    if (!store->begin())
+    {
+      logger->warn("NVS not available, nothing is saved.");
+    }
+  }
+  {
+    BootPhase phase(bootProfiler.get(), "step pulses and switches");
+    stepPulses = std::make_unique<soc::esp32::ESP32PulseBatch>();
+    limitSwitchSampler = std::make_unique<soc::esp32::ESP32InputSampler>(
+        soc::esp32::FastGpio::mask(LIMIT_SWITCH_PIN_HW) |
+            soc::esp32::FastGpio::mask(MINUTE_LIMIT_SWITCH_PIN_HW) |
+            soc::esp32::FastGpio::mask(HOUR_LIMIT_SWITCH_PIN_HW),
+        LIMIT_SWITCH_SAMPLE_PERIOD_US,
+        LIMIT_SWITCH_DEBOUNCE);
+  }
 
   // Now we can use the logger
-  logger->info("=================================================");
-  logger->info(" ESP32 Aviator Clock");
-  logger->info(" System Booted: %s, %s", __DATE__, __TIME__);
-  logger->info("=================================================");
-  logger->info("Level 0 components created.");
-
-  // Pass dependencies by reference by DEREFERENCING the smart pointers with *.
-  homingStrategy = std::make_unique<stepper::homing::LimitSwitchHomingStrategy>(
-      *accelWrapper,
-      *limitSwitch,
-      homingConfig,
-      *logger);
-  logger->info("Level 1 components (HomingStrategy) created.");
-
-  motor = std::make_unique<stepper::accel::AccelStepperMotor>(
-      *accelWrapper,
-      EFFECTIVE_STEPS_PER_REVOLUTION,
-      *homingStrategy,
-      *logger,
-      ENABLE_PIN_HW,
-      true // enablePinActiveLow
-  );
-  logger->info("Level 2 components (Motor) created.");
-
-  clockHand = std::make_unique<aviator_clock::ClockHand>(
-      aviator_clock::ClockHand::HandType::SECOND,
-      *timeProvider,
-      std::move(motor),
-      *logger,
-      DIAL_TOTAL_ACTIVE_ANGLE,
-      DIAL_START_OFFSET_DEGREES,
-      SHARP_TICK_SPEED_DPS,
-      SHARP_TICK_ACCELERATION_DPS2);
-  logger->info("Level 3 components (ClockHands) created.");
-  logger->info("All components created and wired up successfully.");
-
-  // --- Now, proceed with operational logic using the initialized objects ---
-  // simply setup the root component, it will setup its children
-  if (clockHand)
   {
-    clockHand->setup();
+    BootPhase phase(bootProfiler.get(), "banner");
+    logger->info("=================================================");
+    logger->info(" ESP32 Aviator Clock");
+    logger->info(" System Booted: %s, %s", __DATE__, __TIME__);
+    logger->info("=================================================");
+  }
+  {
+    BootPhase phase(bootProfiler.get(), "drift compensation");
+    driftLogger = std::make_unique<soc::esp32::ThrottledLogger>(*logger);
+    auto driftCompensated = std::make_unique<soc::rtc::DriftCompensatedTime>(*uptime, *rtc, *store, *driftLogger,
+                                                                            DRIFT_COMPENSATION);
+    driftCompensated->begin();
+    driftSampler = std::make_shared<ThrottledDriftSampler>(*driftCompensated, *driftLogger);
+    compensatedUptime = std::move(driftCompensated);
+  }
+  // without an RTC the clock shows the time since boot
+  {
+    BootPhase phase(bootProfiler.get(), "rtc time");
+    auto rtcTime = std::make_unique<soc::rtc::DS3231Time>(*rtc, *compensatedUptime, *logger, RTC_TIME);
+    if (!rtcTime->begin())
+    {
+      logger->warn("No valid time from the RTC, counting from 00:00:00.");
+    }
+    rtcSync = std::make_shared<soc::rtc::RtcSync>(*rtcTime);
+    timeProvider = std::move(rtcTime);
   }
+  {
+    BootPhase phase(bootProfiler.get(), "hand leaves");
+    handLeaves = std::make_unique<BoardLeaves>(*stepPulses, *limitSwitchSampler);
+    // the pins are configured by now, homing and tuning read the switches from here on
+    limitSwitchSampler->begin();
+    composition = std::make_unique<ClockComposition>(*handLeaves, *timeProvider, *logger, store.get(),
+                                                     ClockComposition::Settings());
+  }
+
+  SOC_TRACE_TRACK(LOOP_TRACK, "loop");
+  logger->info("Send 't' to dump the trace, 'w' to log the loop watchdog.");
+
+  // --- Now, proceed with operational logic using the initialized objects ---
+  // the world sets up the tunings and the clock, they tune and home in the loop; the clock
+  // sets up every hand once its tuning is done
+  world = std::make_unique<soc::esp32::ESP32Soc>(bootProfiler.get());
+  world->setWatchdog(LOOP_WATCHDOG);
+  world->addComponent(driftSampler);
+  world->addComponent(rtcSync);
+  composition->compose(*world);
+  logger->info("AviatorClock with its ClockHands created.");
+  logger->info("All components created and wired up successfully.");
 }
 
 void loop()
 {
   {
-    // do not check for the motor, because its not owned anymore
-    // by the main program. It has been moved to the clock.
+    // do not check for the motors and hands, because they are not owned
+    // anymore by the main program. They have been moved to the clock.
     // see The Static Initialization Order Fiasco
-    if (!logger || !clockHand)
+    if (!logger || !world || !stepPulses)
     {
       Serial.printf("Objects not initialized correctly\n");
       return;
     }
 
-    clockHand->advanceState(millis());
-    clockHand->render();
+    SOC_TRACE_BEGIN(LOOP_TRACK, "loop");
+    world->advanceState(millis());
+    // the motors stepped during advanceState, pulse all of them at once
+    stepPulses->flush();
+    world->render();
+    SOC_TRACE_END(LOOP_TRACK, "loop");
+
+    if (!bootReported && world->isBooted())
+    {
+      bootProfiler->report(*logger);
+      bootReported = true;
+    }
+
+    if (Serial.available() > 0)
+    {
+      int command = Serial.read();
+      // dump the trace on request, convert it with the trace2json tool
+      if (command == 't')
+      {
+        soc::esp32::ESP32SerialTraceSink traceSink;
+        traceSink.dump(soc::trace::TraceRecorder::instance());
+      }
+      else if (command == 'w')
+      {
+        world->reportWatchdog(*logger);
+      }
+    }
   }
 }
\ No newline at end of file
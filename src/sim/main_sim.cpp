@@ -0,0 +1,771 @@
+// =========================================================================
+// --- NATIVE CLOCK SIMULATION ---
+// Runs the composition of main.cpp, ClockComposition, on the host. Only the
+// leaves that touch hardware are replaced: the stepper drivers by
+// SimulatedStepperControllers and the limit switches by
+// SimulatedLimitSwitches. Without a store the hands are not tuned, they
+// tick at --speed and --accel. The detailed statistics
+// and the options below concern the second hand. Time is the virtual clock
+// of the arduino mock, so weeks of operation run as fast as the CPU allows.
+//
+//   .pio/build/simulation/program [--days N] [--loop-us N] [--rotor-start N] [--seed N]
+//                                 [--physics] [--speed DPS] [--accel DPS2]
+//                                 [--latency constant|uniform|spiky] [--jitter]
+//                                 [--trace FILE] [--sweep] [--jump-at S --jump-by S]
+//                                 [--idle-power full|disable|hold] [--idle-timeout-ms N]
+//                                 [--hold-duty N] [--wake-lead-us N]
+//
+// With --physics the steps drive a PhysicsStepperController, so the tick
+// speed and acceleration can be tuned offline for the fastest settings
+// that still lose no steps.
+//
+// --latency draws the duration of every loop iteration from a distribution
+// around --loop-us, --jitter records every step and compares the step
+// intervals with the ideal profile.
+//
+// --sweep lets the second hand sweep instead of tick. A sweeping hand
+// needs every loop iteration, so there is no fast forward: use a short
+// --days. The report shows the phase error against the ideal continuous
+// position, and the step intervals of both modes show how smooth it runs.
+//
+// --jump-at/--jump-by set the time by whole seconds, like an RTC sync or
+// a resume from sleep, and report how long the hands need to catch up.
+//
+// --idle-power and its options override the coil power management of
+// ClockConfig.h for all hands. With --physics the report shows the energy
+// the coils of the second hand dissipate per hour, and whether the wake
+// lead is long enough to lose no steps after the coils were powered down.
+//
+// --trace writes the last SOC_TRACE_CAPACITY trace events as Chrome trace
+// JSON, open it in https://ui.perfetto.dev. Timestamps are virtual time.
+// =========================================================================
+#include <Arduino.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+
+// --- Framework/SoC Includes ---
+#include <soc/api/ISocComponent.h>
+#include <soc/esp32/ESP32MillisTime.h>
+#include <soc/esp32/ESP32Logger.h>
+#include <soc/esp32/ESP32Soc.h>
+#include <soc/trace/TraceRecorder.h>
+#include <soc/trace/ChromeTraceConverter.h>
+
+// --- Stepper Includes ---
+#include <stepper/api/IStepperController.h>
+#include <stepper/accel/AccelStepperMotor.h>
+#include <stepper/sim/SimulatedStepperController.h>
+#include <stepper/sim/SimulatedLimitSwitch.h>
+#include <stepper/sim/PhysicsStepperController.h>
+#include <stepper/sim/RecordingStepperController.h>
+#include <stepper/sim/StepJitterAnalyzer.h>
+#include <stepper/sim/LoopLatencyModel.h>
+
+// --- Application Includes ---
+#include <aviator-clock/AviatorClock.h>
+#include <aviator-clock/ClockHand.h>
+#include <ClockComposition.h>
+#include <ClockConfig.h>
+
+MockSerial Serial;
+
+// --- Simulation Settings ---
+struct SimulationSettings
+{
+  double days = 7.0;
+  unsigned long loopMicros = 50;  // virtual CPU time of one loop() iteration
+  long rotorStartPosition = 500;  // physical hand position at power up, switch is at 0
+  unsigned long seed = 1;
+  bool physics = false;
+  double tickSpeedDps = SHARP_TICK_SPEED_DPS;
+  double tickAccelerationDps2 = SHARP_TICK_ACCELERATION_DPS2;
+  stepper::sim::LoopLatencyModel::Kind latency = stepper::sim::LoopLatencyModel::Kind::CONSTANT;
+  bool jitter = false;
+  const char *traceFile = nullptr;
+  bool sweep = false;
+  long jumpAtSeconds = -1; // virtual time at which the shown time jumps, -1 for never
+  long jumpBySeconds = 0;
+  stepper::accel::AccelStepperMotor::PowerConfig power = COIL_POWER;
+};
+
+// The enable pins of the hands without a physical model, REDUCED needs a PWM output.
+class UnconnectedPwmOutput : public soc::api::IPwmOutput
+{
+public:
+  void begin() override {}
+  void setDuty(uint16_t /*duty*/) override {}
+};
+UnconnectedPwmOutput unconnectedPwm;
+
+// The time of main.cpp, set ahead or back once, like an RTC sync would do.
+class JumpingTime : public soc::api::ITime
+{
+public:
+  JumpingTime(long jumpAtSeconds, long jumpBySeconds)
+      : _jumpAtMillis(jumpAtSeconds * 1000L), _jumpByMillis(jumpBySeconds * 1000L) {}
+
+  unsigned long now() override
+  {
+    return millis() + offsetMillis();
+  }
+
+  bool asTimeComponents(TimeComponents &time) override
+  {
+    unsigned long currentMillis = now();
+    time.milliseconds = currentMillis % 1000;
+    unsigned long totalSeconds = currentMillis / 1000;
+    time.seconds = totalSeconds % 60;
+    unsigned long totalMinutes = totalSeconds / 60;
+    time.minutes = totalMinutes % 60;
+    time.hours = totalMinutes / 60;
+    return true;
+  }
+
+  long offsetMillis() const
+  {
+    return _jumpAtMillis >= 0 && static_cast<long>(millis()) >= _jumpAtMillis ? _jumpByMillis : 0;
+  }
+
+private:
+  const long _jumpAtMillis;
+  const long _jumpByMillis;
+};
+
+// =========================================================================
+// --- GLOBAL DECLARATIONS ---
+// Same as main.cpp, plus the concrete simulated leaves so the
+// simulation can observe them.
+// =========================================================================
+std::unique_ptr<soc::api::ILogger> logger;
+std::unique_ptr<soc::api::ITime> timeProvider;
+std::unique_ptr<stepper::sim::SimulatedStepperController> simulatedStepper;
+std::unique_ptr<stepper::sim::PhysicsStepperController> physicsStepper;
+std::unique_ptr<stepper::sim::RecordingStepperController> stepRecorder;
+
+// The minute and hour hands run on plain simulated leaves.
+struct SimulatedHandHardware
+{
+  std::unique_ptr<stepper::sim::SimulatedStepperController> stepper;
+  std::unique_ptr<soc::api::IDigitalInput> limitSwitch;
+};
+SimulatedHandHardware minuteHandHardware;
+SimulatedHandHardware hourHandHardware;
+
+// The leaves of the composition: the second hand on simulatedStepper, behind the
+// physics and the recorder if asked for, the others on their SimulatedHandHardware.
+class SimulatedLeaves : public IClockLeaves
+{
+public:
+  explicit SimulatedLeaves(const SimulationSettings &settings)
+  {
+    simulatedStepper = std::make_unique<stepper::sim::SimulatedStepperController>(settings.rotorStartPosition);
+
+    // the controller the second hand talks to, and what its limit switch sees
+    _secondController = simulatedStepper.get();
+    stepper::sim::IRotorPositionSource *rotor = simulatedStepper.get();
+    if (settings.physics)
+    {
+      physicsStepper = std::make_unique<stepper::sim::PhysicsStepperController>(
+          *simulatedStepper,
+          stepper::sim::PhysicsStepperController::defaultConfig(),
+          settings.rotorStartPosition);
+      _secondController = physicsStepper.get();
+      rotor = physicsStepper.get();
+    }
+    if (settings.jitter)
+    {
+      stepRecorder = std::make_unique<stepper::sim::RecordingStepperController>(*_secondController);
+      _secondController = stepRecorder.get();
+    }
+    _secondLimitSwitch = std::make_unique<stepper::sim::SimulatedLimitSwitch>(*rotor, 0, homingConfig.moveDirectionSign);
+    _secondLimitSwitch->begin();
+
+    for (SimulatedHandHardware *hardware : {&minuteHandHardware, &hourHandHardware})
+    {
+      hardware->stepper = std::make_unique<stepper::sim::SimulatedStepperController>(settings.rotorStartPosition);
+      hardware->limitSwitch = std::make_unique<stepper::sim::SimulatedLimitSwitch>(
+          *hardware->stepper,
+          0,
+          homingConfig.moveDirectionSign);
+      hardware->limitSwitch->begin();
+    }
+  }
+
+  stepper::api::IStepperController &controller(aviator_clock::ClockHand::HandType type) override
+  {
+    return type == aviator_clock::ClockHand::HandType::SECOND ? *_secondController : *hardware(type).stepper;
+  }
+
+  soc::api::IDigitalInput &limitSwitch(aviator_clock::ClockHand::HandType type) override
+  {
+    return type == aviator_clock::ClockHand::HandType::SECOND ? *_secondLimitSwitch : *hardware(type).limitSwitch;
+  }
+
+  // the physics model draws the coil current of the second hand, the others are not modelled
+  soc::api::IPwmOutput &enablePwm(aviator_clock::ClockHand::HandType type) override
+  {
+    if (type == aviator_clock::ClockHand::HandType::SECOND && physicsStepper)
+    {
+      return *physicsStepper;
+    }
+    return unconnectedPwm;
+  }
+
+  uint8_t enablePin(aviator_clock::ClockHand::HandType /*type*/) const override
+  {
+    return ENABLE_PIN_HW;
+  }
+
+private:
+  stepper::api::IStepperController *_secondController;
+  std::unique_ptr<soc::api::IDigitalInput> _secondLimitSwitch;
+
+  static SimulatedHandHardware &hardware(aviator_clock::ClockHand::HandType type)
+  {
+    return type == aviator_clock::ClockHand::HandType::MINUTE ? minuteHandHardware : hourHandHardware;
+  }
+};
+std::unique_ptr<SimulatedLeaves> handLeaves;
+std::unique_ptr<ClockComposition> composition;
+std::unique_ptr<soc::esp32::ESP32Soc> world;
+
+// Observers only, the motor is owned by the second hand, the hands by the clock and the clock by the world.
+IStepperMotor *motorView = nullptr;
+stepper::accel::AccelStepperMotor *secondMotorView = nullptr;
+aviator_clock::AviatorClock *clockView = nullptr;
+JumpingTime *timeView = nullptr;
+aviator_clock::ClockHand *handViews[3] = {nullptr, nullptr, nullptr}; // by HandType
+
+void setup(const SimulationSettings &settings)
+{
+  logger = std::make_unique<soc::esp32::ESP32Logger>(soc::api::ILogger::WARN_LEVEL);
+  auto time = std::make_unique<JumpingTime>(settings.jumpAtSeconds, settings.jumpBySeconds);
+  timeView = time.get();
+  timeProvider = std::move(time);
+  handLeaves = std::make_unique<SimulatedLeaves>(settings);
+
+  // no store: the hands are not tuned, they tick at --speed and --accel
+  ClockComposition::Settings clockSettings;
+  clockSettings.tickSpeedDps = settings.tickSpeedDps;
+  clockSettings.tickAccelerationDps2 = settings.tickAccelerationDps2;
+  clockSettings.power = settings.power;
+  clockSettings.secondHandSweeps = settings.sweep;
+  composition = std::make_unique<ClockComposition>(*handLeaves, *timeProvider, *logger, nullptr, clockSettings);
+  world = std::make_unique<soc::esp32::ESP32Soc>();
+  composition->compose(*world);
+
+  secondMotorView = &composition->motor(aviator_clock::ClockHand::HandType::SECOND);
+  motorView = secondMotorView;
+  clockView = &composition->clock();
+  for (int type = 0; type < 3; type++)
+  {
+    handViews[type] = &composition->hand(static_cast<aviator_clock::ClockHand::HandType>(type));
+  }
+}
+
+static const char LOOP_TRACK[] = "loop";
+
+void loop()
+{
+  SOC_TRACE_BEGIN(LOOP_TRACK, "loop");
+  world->advanceState(millis());
+  world->render();
+  SOC_TRACE_END(LOOP_TRACK, "loop");
+}
+
+// --- Statistics ---
+struct SimulationReport
+{
+  unsigned long long loopIterations = 0;
+  // the iterations that ran for their loop time, not fast forwarded to the next second or millisecond
+  unsigned long long activeLoopIterations = 0;
+  unsigned long long activeMicros = 0;
+  unsigned long long homingDoneMicros = 0;
+  bool homed = false;
+
+  unsigned long ticks = 0;
+  unsigned long missedTicks = 0;
+  unsigned long long tickLatencySumMicros = 0;
+  unsigned long long tickLatencyMaxMicros = 0;
+  unsigned long long moveDurationSumMicros = 0;
+  unsigned long long moveDurationMaxMicros = 0;
+  unsigned long moveDurations = 0;
+  long maxPositionErrorSteps = 0;
+
+  // sweep mode: distance to the ideal continuous position while sweeping
+  unsigned long long sweepSamples = 0;
+  double sweepErrorSumDegrees = 0.0;
+  double sweepErrorMaxDegrees = 0.0;
+  unsigned long flyBacks = 0;
+
+  // intervals between the steps of the second hand while it moves
+  unsigned long long stepIntervals = 0;
+  double stepIntervalSumMicros = 0.0;
+  double stepIntervalSumSquaresMicros = 0.0;
+  unsigned long long stepIntervalMaxMicros = 0;
+};
+
+static long expectedStepsForUnit(int unit, int unitsOnDial)
+{
+  // mirrors the step table of ClockHand: the exact position of the unit, rounded
+  double degreesPerUnit = DIAL_TOTAL_ACTIVE_ANGLE / unitsOnDial;
+  double angle = DIAL_START_OFFSET_DEGREES + static_cast<double>(unit) * degreesPerUnit;
+  return lround((angle / 360.0) * EFFECTIVE_STEPS_PER_REVOLUTION);
+}
+
+static long expectedStepsForSecond(unsigned long second)
+{
+  return expectedStepsForUnit(second % 60, 60);
+}
+
+static double sweepTargetDegrees(unsigned long long nowMicros)
+{
+  // mirrors ClockHand in SWEEP mode, the time is truncated to whole milliseconds
+  double seconds = static_cast<double>((nowMicros / 1000) % 60000) / 1000.0;
+  return DIAL_START_OFFSET_DEGREES + seconds * (DIAL_TOTAL_ACTIVE_ANGLE / 60.0);
+}
+
+static bool parseArguments(int argc, char **argv, SimulationSettings &settings)
+{
+  for (int i = 1; i < argc; i++)
+  {
+    bool hasValue = i + 1 < argc;
+    if (strcmp(argv[i], "--days") == 0 && hasValue)
+    {
+      settings.days = atof(argv[++i]);
+    }
+    else if (strcmp(argv[i], "--loop-us") == 0 && hasValue)
+    {
+      settings.loopMicros = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--rotor-start") == 0 && hasValue)
+    {
+      settings.rotorStartPosition = strtol(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--seed") == 0 && hasValue)
+    {
+      settings.seed = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--physics") == 0)
+    {
+      settings.physics = true;
+    }
+    else if (strcmp(argv[i], "--speed") == 0 && hasValue)
+    {
+      settings.tickSpeedDps = atof(argv[++i]);
+    }
+    else if (strcmp(argv[i], "--accel") == 0 && hasValue)
+    {
+      settings.tickAccelerationDps2 = atof(argv[++i]);
+    }
+    else if (strcmp(argv[i], "--latency") == 0 && hasValue)
+    {
+      const char *kind = argv[++i];
+      if (strcmp(kind, "uniform") == 0)
+      {
+        settings.latency = stepper::sim::LoopLatencyModel::Kind::UNIFORM;
+      }
+      else if (strcmp(kind, "spiky") == 0)
+      {
+        settings.latency = stepper::sim::LoopLatencyModel::Kind::SPIKY;
+      }
+      else
+      {
+        settings.latency = stepper::sim::LoopLatencyModel::Kind::CONSTANT;
+      }
+    }
+    else if (strcmp(argv[i], "--jitter") == 0)
+    {
+      settings.jitter = true;
+    }
+    else if (strcmp(argv[i], "--trace") == 0 && hasValue)
+    {
+      settings.traceFile = argv[++i];
+    }
+    else if (strcmp(argv[i], "--sweep") == 0)
+    {
+      settings.sweep = true;
+    }
+    else if (strcmp(argv[i], "--jump-at") == 0 && hasValue)
+    {
+      settings.jumpAtSeconds = strtol(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--jump-by") == 0 && hasValue)
+    {
+      settings.jumpBySeconds = strtol(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--idle-power") == 0 && hasValue)
+    {
+      const char *mode = argv[++i];
+      if (strcmp(mode, "disable") == 0)
+      {
+        settings.power.idlePower = stepper::accel::AccelStepperMotor::IdlePower::DISABLED;
+      }
+      else if (strcmp(mode, "hold") == 0)
+      {
+        settings.power.idlePower = stepper::accel::AccelStepperMotor::IdlePower::REDUCED;
+      }
+      else
+      {
+        settings.power.idlePower = stepper::accel::AccelStepperMotor::IdlePower::FULL;
+      }
+    }
+    else if (strcmp(argv[i], "--idle-timeout-ms") == 0 && hasValue)
+    {
+      settings.power.idleTimeoutMs = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--hold-duty") == 0 && hasValue)
+    {
+      settings.power.holdDuty = static_cast<uint16_t>(strtoul(argv[++i], nullptr, 10));
+    }
+    else if (strcmp(argv[i], "--wake-lead-us") == 0 && hasValue)
+    {
+      settings.power.wakeLeadMicros = strtoul(argv[++i], nullptr, 10);
+    }
+    else
+    {
+      fprintf(stderr, "usage: %s [--days N] [--loop-us N] [--rotor-start N] [--seed N] [--physics] [--speed DPS] [--accel DPS2]"
+                      " [--latency constant|uniform|spiky] [--jitter] [--trace FILE] [--sweep]"
+                      " [--jump-at S --jump-by S] [--idle-power full|disable|hold] [--idle-timeout-ms N]"
+                      " [--hold-duty N] [--wake-lead-us N]\n",
+              argv[0]);
+      return false;
+    }
+  }
+  if (settings.loopMicros == 0)
+  {
+    settings.loopMicros = 1;
+  }
+  if (settings.jumpAtSeconds >= 0 && settings.jumpBySeconds < -settings.jumpAtSeconds)
+  {
+    // the shown time starts at 0 and cannot go further back
+    settings.jumpBySeconds = -settings.jumpAtSeconds;
+  }
+  return true;
+}
+
+static stepper::sim::LoopLatencyModel createLatencyModel(const SimulationSettings &settings)
+{
+  switch (settings.latency)
+  {
+  case stepper::sim::LoopLatencyModel::Kind::UNIFORM:
+    return stepper::sim::LoopLatencyModel::uniform(settings.loopMicros / 2, settings.loopMicros * 3 / 2, settings.seed);
+  case stepper::sim::LoopLatencyModel::Kind::SPIKY:
+    // e.g. a log line blocking on a full serial buffer once in a while
+    return stepper::sim::LoopLatencyModel::spiky(settings.loopMicros, 0.001, 5000, settings.seed);
+  case stepper::sim::LoopLatencyModel::Kind::CONSTANT:
+  default:
+    return stepper::sim::LoopLatencyModel::constant(settings.loopMicros);
+  }
+}
+
+static bool writeTrace(const char *fileName)
+{
+  soc::trace::TraceRecorder &recorder = soc::trace::TraceRecorder::instance();
+  std::stringstream binary;
+  soc::trace::StreamTraceSink sink(binary);
+  recorder.serialize(sink);
+
+  std::ofstream json(fileName);
+  std::string error;
+  if (!json || !soc::trace::ChromeTraceConverter::convert(binary, json, &error))
+  {
+    fprintf(stderr, "cannot write trace %s %s\n", fileName, error.c_str());
+    return false;
+  }
+  printf("trace:                   %lu events (%lu dropped) -> %s\n",
+         static_cast<unsigned long>(recorder.size()), static_cast<unsigned long>(recorder.dropped()), fileName);
+  return true;
+}
+
+int main(int argc, char **argv)
+{
+  SimulationSettings settings;
+  if (!parseArguments(argc, argv, settings))
+  {
+    return 2;
+  }
+
+  const unsigned long long SECOND_MICROS = 1000000ULL;
+  const unsigned long long endMicros = static_cast<unsigned long long>(settings.days * 86400.0 * SECOND_MICROS);
+
+  virtualClock().reset();
+  srand(settings.seed);
+  soc::trace::TraceRecorder::instance().setEnabled(settings.traceFile != nullptr);
+  SOC_TRACE_TRACK(LOOP_TRACK, "loop");
+
+  auto wallStart = std::chrono::steady_clock::now();
+  setup(settings);
+
+  SimulationReport report;
+  stepper::sim::LoopLatencyModel latency = createLatencyModel(settings);
+  stepper::sim::StepJitterAnalyzer jitterAnalyzer;
+  unsigned long lastMoveCommands = simulatedStepper->getMoveCommandCount();
+  unsigned long long currentSecond = 0;
+  bool tickInCurrentSecond = false;
+  bool ticking = false;
+  unsigned long long moveStartMicros = 0;
+  bool moveInProgress = false;
+  unsigned long long lastLoopMicros = 0;
+  uint64_t lastTotalSteps = simulatedStepper->getTotalSteps();
+  unsigned long long lastStepMicros = 0;
+  bool stepping = false;
+
+  while (virtualClock().nowMicros() < endMicros)
+  {
+    loop();
+    report.loopIterations++;
+
+    unsigned long long now = virtualClock().nowMicros();
+    lastLoopMicros = now;
+
+    // a new second started: account for the one that has passed
+    unsigned long long second = now / SECOND_MICROS;
+    // the time the hands show, ahead or behind after a time jump
+    unsigned long long shownMicros = now + timeView->offsetMillis() * 1000LL;
+    if (second != currentSecond)
+    {
+      if (ticking && !tickInCurrentSecond && !settings.sweep)
+      {
+        report.missedTicks++;
+      }
+      currentSecond = second;
+      tickInCurrentSecond = false;
+    }
+
+    if (!report.homed && !motorView->needsHoming())
+    {
+      report.homed = true;
+      report.homingDoneMicros = now;
+    }
+
+    unsigned long moveCommands = simulatedStepper->getMoveCommandCount();
+    if (report.homed && moveCommands != lastMoveCommands)
+    {
+      if (ticking && settings.sweep)
+      {
+        report.flyBacks++;
+      }
+      else if (ticking)
+      {
+        unsigned long long latency = now % SECOND_MICROS;
+        report.ticks++;
+        report.tickLatencySumMicros += latency;
+        if (latency > report.tickLatencyMaxMicros)
+        {
+          report.tickLatencyMaxMicros = latency;
+        }
+      }
+      ticking = true; // the first move after homing initializes the position
+      stepping = false; // no interval to the last step of the previous move
+      tickInCurrentSecond = true;
+      moveStartMicros = now;
+      moveInProgress = true;
+    }
+    lastMoveCommands = moveCommands;
+
+    // step intervals, a pause between two ticks or after a fly back is no interval
+    bool handStepping = settings.sweep ? motorView->isRunningAtVelocity() : moveInProgress;
+    uint64_t totalSteps = simulatedStepper->getTotalSteps();
+    if (report.homed && handStepping && totalSteps != lastTotalSteps)
+    {
+      if (stepping)
+      {
+        unsigned long long interval = now - lastStepMicros;
+        report.stepIntervals++;
+        report.stepIntervalSumMicros += interval;
+        report.stepIntervalSumSquaresMicros += static_cast<double>(interval) * interval;
+        if (interval > report.stepIntervalMaxMicros)
+        {
+          report.stepIntervalMaxMicros = interval;
+        }
+      }
+      lastStepMicros = now;
+      stepping = true;
+    }
+    else if (!handStepping)
+    {
+      stepping = false;
+    }
+    lastTotalSteps = totalSteps;
+
+    if (report.homed && handStepping && settings.sweep)
+    {
+      double position = simulatedStepper->getCurrentPosition() * 360.0 / EFFECTIVE_STEPS_PER_REVOLUTION;
+      double error = fabs(position - sweepTargetDegrees(shownMicros));
+      report.sweepSamples++;
+      report.sweepErrorSumDegrees += error;
+      if (error > report.sweepErrorMaxDegrees)
+      {
+        report.sweepErrorMaxDegrees = error;
+      }
+    }
+
+    if (moveInProgress && !simulatedStepper->isRunning())
+    {
+      unsigned long long duration = now - moveStartMicros;
+      report.moveDurations++;
+      report.moveDurationSumMicros += duration;
+      if (duration > report.moveDurationMaxMicros)
+      {
+        report.moveDurationMaxMicros = duration;
+      }
+      moveInProgress = false;
+
+      if (stepRecorder)
+      {
+        jitterAnalyzer.addMoves(*stepRecorder);
+        stepRecorder->clear();
+      }
+
+      long error = labs(simulatedStepper->getCurrentPosition() - expectedStepsForSecond(shownMicros / SECOND_MICROS));
+      if (!settings.sweep && error > report.maxPositionErrorSteps)
+      {
+        report.maxPositionErrorSteps = error;
+      }
+    }
+
+    // Nothing can happen before the next second once the hands are settled,
+    // so fast forward to the first loop iteration after the boundary.
+    bool handsIdle = handViews[0]->isReady() && handViews[1]->isReady() && handViews[2]->isReady();
+    if (ticking && clockView->isSettled())
+    {
+      unsigned long long phase = static_cast<unsigned long long>(rand()) % settings.loopMicros;
+      virtualClock().advanceTo((second + 1) * SECOND_MICROS + phase);
+    }
+    else if (ticking && handsIdle)
+    {
+      // The hands only wait to power down the coils or for their move slot, both
+      // timed in whole milliseconds, so a millisecond per loop iteration is enough.
+      unsigned long long phase = static_cast<unsigned long long>(rand()) % settings.loopMicros;
+      unsigned long long nextSecond = (second + 1) * SECOND_MICROS + phase;
+      virtualClock().advanceTo(now + 1000 < nextSecond ? now + 1000 : nextSecond);
+    }
+    else
+    {
+      unsigned long loopMicros = latency.next();
+      virtualClock().advanceMicros(loopMicros);
+      report.activeLoopIterations++;
+      report.activeMicros += loopMicros;
+    }
+  }
+
+  // a sweeping second hand never settles, only look at the others then
+  bool handsSettled = settings.sweep
+                          ? !minuteHandHardware.stepper->isRunning() && !hourHandHardware.stepper->isRunning()
+                          : clockView->isSettled();
+  // the world tears the clock down once more on exit, a stopped hand stays stopped
+  clockView->teardown();
+  double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+  double virtualSeconds = static_cast<double>(virtualClock().nowMicros()) / SECOND_MICROS;
+
+  printf("=================================================\n");
+  printf(" Aviator Clock Simulation\n");
+  printf("=================================================\n");
+  printf("virtual time:            %.1f s (%.2f days)\n", virtualSeconds, virtualSeconds / 86400.0);
+  printf("wall time:               %.3f s (x%.0f real time)\n", wallSeconds, wallSeconds > 0 ? virtualSeconds / wallSeconds : 0.0);
+  printf("homing:                  %s after %.3f s\n", report.homed ? "done" : "NOT DONE", report.homingDoneMicros / 1e6);
+  if (settings.sweep)
+  {
+    printf("second hand:             sweeping\n");
+    printf("fly backs:               %lu\n", report.flyBacks);
+    printf("phase error mean/max:    %.3f / %.3f deg\n",
+           report.sweepSamples ? report.sweepErrorSumDegrees / report.sweepSamples : 0.0,
+           report.sweepErrorMaxDegrees);
+  }
+  else
+  {
+    printf("ticks:                   %lu\n", report.ticks);
+    printf("missed ticks:            %lu\n", report.missedTicks);
+    printf("tick latency mean/max:   %.1f / %llu us\n",
+           report.ticks ? static_cast<double>(report.tickLatencySumMicros) / report.ticks : 0.0,
+           report.tickLatencyMaxMicros);
+    printf("move duration mean/max:  %.1f / %llu us\n",
+           report.moveDurations ? static_cast<double>(report.moveDurationSumMicros) / report.moveDurations : 0.0,
+           report.moveDurationMaxMicros);
+    printf("max position error:      %ld steps\n", report.maxPositionErrorSteps);
+  }
+  if (report.stepIntervals > 0)
+  {
+    // the coefficient of variation: 0 for perfectly even steps
+    double mean = report.stepIntervalSumMicros / report.stepIntervals;
+    double variance = report.stepIntervalSumSquaresMicros / report.stepIntervals - mean * mean;
+    double deviation = variance > 0.0 ? sqrt(variance) : 0.0;
+    printf("step interval mean/sd:   %.1f / %.1f us (cv %.3f, max %llu us)\n",
+           mean, deviation, deviation / mean, report.stepIntervalMaxMicros);
+  }
+
+  // the minute and hour hands show the time of the last loop, 12 o'clock is the end of the dial
+  unsigned long long elapsedSeconds = (lastLoopMicros + timeView->offsetMillis() * 1000LL) / SECOND_MICROS;
+  int hourUnit = static_cast<int>((elapsedSeconds / 3600) % 12);
+  long minuteError = labs(minuteHandHardware.stepper->getCurrentPosition() - expectedStepsForUnit((elapsedSeconds / 60) % 60, 60));
+  long hourError = labs(hourHandHardware.stepper->getCurrentPosition() - expectedStepsForUnit(hourUnit == 0 ? 12 : hourUnit, 12));
+  printf("minute hand moves/error: %lu / %ld steps%s\n",
+         minuteHandHardware.stepper->getMoveCommandCount(), minuteError, handsSettled ? "" : " (moving)");
+  printf("hour hand moves/error:   %lu / %ld steps%s\n",
+         hourHandHardware.stepper->getMoveCommandCount(), hourError, handsSettled ? "" : " (moving)");
+  static const char *const CATCH_UP_LABELS[] = {"hour catch-ups:          ",
+                                                 "minute catch-ups:        ",
+                                                 "second catch-ups:        "};
+  for (int type = 0; type < 3; type++)
+  {
+    const aviator_clock::ClockHand *hand = handViews[type];
+    if (hand->getCatchUpCount() > 0)
+    {
+      printf("%s%lu, max %lu ms (bound %lu ms)\n",
+             CATCH_UP_LABELS[type], hand->getCatchUpCount(), hand->getMaxCatchUpMs(), hand->getCatchUpBoundMs());
+    }
+  }
+  printf("total steps:             %llu\n", static_cast<unsigned long long>(simulatedStepper->getTotalSteps()));
+  double activeSeconds = static_cast<double>(report.activeMicros) / SECOND_MICROS;
+  printf("loop iterations:         %llu (%.1f per active virtual second, active %.3f s)\n",
+         report.loopIterations, activeSeconds > 0 ? report.activeLoopIterations / activeSeconds : 0.0, activeSeconds);
+  printf("profile/enable commands: %lu passed on, %lu dropped\n",
+         composition->commandCache(aviator_clock::ClockHand::HandType::SECOND).getForwardedCount(),
+         composition->commandCache(aviator_clock::ClockHand::HandType::SECOND).getSkippedCount());
+
+  if (stepRecorder)
+  {
+    stepper::sim::StepJitterAnalyzer::Report jitter = jitterAnalyzer.getReport();
+    printf("analyzed moves:          %lu (%lu skipped)\n", jitter.moves, jitter.skippedMoves);
+    printf("interval error mean/p99: %.1f / %.0f us (max %.0f us)\n",
+           jitter.meanIntervalErrorMicros, jitter.p99IntervalErrorMicros, jitter.maxIntervalErrorMicros);
+    printf("max step gap:            %lu us\n", jitter.maxGapMicros);
+    printf("velocity error mean/max: %.2f / %.2f %%\n", jitter.meanVelocityErrorPercent, jitter.maxVelocityErrorPercent);
+  }
+
+  bool stepsLost = false;
+  if (physicsStepper)
+  {
+    physicsStepper->settle();
+    stepsLost = physicsStepper->getLostSteps() != 0 || physicsStepper->getSlipEvents() != 0;
+    printf("tick profile:            %.0f dps, %.0f dps^2\n", settings.tickSpeedDps, settings.tickAccelerationDps2);
+    printf("lost steps:              %ld\n", physicsStepper->getLostSteps());
+    printf("slip events:             %lu\n", physicsStepper->getSlipEvents());
+    printf("unfollowable steps:      %lu\n", physicsStepper->getUnfollowableSteps());
+    printf("max rotor lag:           %.2f steps\n", physicsStepper->getMaxLagSteps());
+    // enabled at a reduced hold current counts fully in the enabled share, not in the power
+    printf("average coil current:    %.3f A (enabled %.1f %%, coil power %.1f %% of full)\n",
+           physicsStepper->getAverageCurrentA(),
+           virtualSeconds > 0 ? 100.0 * physicsStepper->getEnabledMicros() / 1e6 / virtualSeconds : 0.0,
+           100.0 * physicsStepper->getAveragePowerFraction());
+    // the average power over an hour, in Wh per hour
+    printf("coil energy per hour:    %.3f Wh (%.1f J in total, %lu wake ups)\n",
+           virtualSeconds > 0 ? physicsStepper->getEnergyJ() / virtualSeconds : 0.0,
+           physicsStepper->getEnergyJ(), secondMotorView->getWakeCount());
+  }
+
+  if (settings.traceFile != nullptr && !writeTrace(settings.traceFile))
+  {
+    return 1;
+  }
+
+  bool handsWrong = handsSettled && (minuteError != 0 || hourError != 0);
+  return (report.homed && report.missedTicks == 0 && !stepsLost && !handsWrong) ? 0 : 1;
+}
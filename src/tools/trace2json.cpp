@@ -0,0 +1,85 @@
+// =========================================================================
+// --- TRACE CONVERTER ---
+// Converts a trace recorded by soc::trace::TraceRecorder into Chrome trace
+// JSON that opens in https://ui.perfetto.dev or chrome://tracing.
+//
+//   .pio/build/trace2json/program INPUT [OUTPUT]
+//
+// INPUT is either a binary trace (TraceRecorder::serialize()) or a captured
+// serial monitor log that contains a dump of the ESP32SerialTraceSink, e.g.
+//   pio device monitor | tee monitor.log      (send 't' to dump)
+// Without OUTPUT the JSON is written to stdout.
+// =========================================================================
+#include <Arduino.h>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <soc/trace/ChromeTraceConverter.h>
+#include <soc/trace/TraceRecorder.h>
+
+MockSerial Serial;
+
+static bool isBinaryTrace(const std::string &content)
+{
+  if (content.size() < 4)
+  {
+    return false;
+  }
+  uint32_t magic = static_cast<uint8_t>(content[0]) |
+                   (static_cast<uint8_t>(content[1]) << 8) |
+                   (static_cast<uint8_t>(content[2]) << 16) |
+                   (static_cast<uint32_t>(static_cast<uint8_t>(content[3])) << 24);
+  return magic == soc::trace::TraceRecorder::FORMAT_MAGIC;
+}
+
+int main(int argc, char **argv)
+{
+  if (argc < 2 || argc > 3)
+  {
+    fprintf(stderr, "usage: %s INPUT [OUTPUT]\n", argv[0]);
+    return 2;
+  }
+
+  std::ifstream input(argv[1], std::ios::binary);
+  if (!input)
+  {
+    fprintf(stderr, "cannot open %s\n", argv[1]);
+    return 1;
+  }
+  std::stringstream content;
+  content << input.rdbuf();
+
+  std::string binary = content.str();
+  if (!isBinaryTrace(binary))
+  {
+    std::istringstream log(binary);
+    if (!soc::trace::ChromeTraceConverter::extractFromLog(log, binary))
+    {
+      fprintf(stderr, "%s contains neither a binary trace nor a complete serial dump\n", argv[1]);
+      return 1;
+    }
+  }
+
+  std::istringstream trace(binary);
+  std::ofstream file;
+  if (argc == 3)
+  {
+    file.open(argv[2]);
+    if (!file)
+    {
+      fprintf(stderr, "cannot write %s\n", argv[2]);
+      return 1;
+    }
+  }
+
+  std::string error;
+  if (!soc::trace::ChromeTraceConverter::convert(trace, argc == 3 ? file : std::cout, &error))
+  {
+    fprintf(stderr, "conversion failed: %s\n", error.c_str());
+    return 1;
+  }
+  return 0;
+}
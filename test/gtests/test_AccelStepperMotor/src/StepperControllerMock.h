@@ -27,6 +27,11 @@ namespace stepper
 
             MOCK_METHOD(bool, run, (), (override));
             MOCK_METHOD(void, stop, (), (override));
+            MOCK_METHOD(unsigned long, nextStepDueMicros, (), (override));
+
+            MOCK_METHOD(void, setSpeed, (float speed), (override));
+            MOCK_METHOD(float, getSpeed, (), (override));
+            MOCK_METHOD(bool, runSpeed, (), (override));
         };
     }
 }
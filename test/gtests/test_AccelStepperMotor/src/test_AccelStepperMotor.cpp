@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <Arduino.h>
 #include <memory>
+#include <vector>
 
 // --- Mocks and Class Under Test ---
 #include "StepperControllerMock.h"
@@ -70,10 +72,12 @@ TEST_F(AccelStepperMotorTest, Home_WhenBeginHomingFails_TransitionsToHomingFaile
     EXPECT_CALL(mockHomingStrategy, beginHoming()).WillOnce(Return(false));
     
     // act
-    motor->home();
+    Status result = motor->home();
     
     // assert
+    ASSERT_EQ(StepperError::HOMING_REJECTED, result.error());
     ASSERT_EQ(motor->getState(), StepperMotorState::HOMING_FAILED);
+    ASSERT_EQ(StepperError::HOMING_FAILED, motor->moveToAbsolute(180.0).error());
 }
 
 TEST_F(AccelStepperMotorTest, Home_WhenAlreadyHoming_StaysInHomingInProgress)
@@ -83,10 +87,12 @@ TEST_F(AccelStepperMotorTest, Home_WhenAlreadyHoming_StaysInHomingInProgress)
     ASSERT_EQ(motor->getState(), StepperMotorState::HOMING_IN_PROGRESS);
 
     // act
-    bool result = motor->home();
+    Status result = motor->home();
 
     // assert
     ASSERT_FALSE(result);
+    ASSERT_EQ(StepperError::HOMING_IN_PROGRESS, result.error());
+    ASSERT_EQ(StepperError::HOMING_IN_PROGRESS, motor->moveToAbsolute(180.0).error());
     ASSERT_EQ(motor->getState(), StepperMotorState::HOMING_IN_PROGRESS);
 }
 
@@ -122,13 +128,56 @@ TEST_F(AccelStepperMotorTest, MoveToAbsolute_WhenNotHomed_IsRejectedAndStaysIdle
     ASSERT_TRUE(motor->needsHoming());
 
     // act
-    bool result = motor->moveToAbsolute(180.0);
+    Status result = motor->moveToAbsolute(180.0);
 
     // assert
     ASSERT_FALSE(result);
+    ASSERT_EQ(StepperError::NOT_HOMED, result.error());
     ASSERT_EQ(motor->getState(), StepperMotorState::IDLE);
 }
 
+TEST_F(AccelStepperMotorTest, GetCurrentPositionDegrees_WhenNotHomed_ReturnsAnError)
+{
+    // act
+    Result<double> position = motor->getCurrentPositionDegrees();
+
+    // assert
+    ASSERT_FALSE(position);
+    ASSERT_EQ(StepperError::NOT_HOMED, position.error());
+    ASSERT_DOUBLE_EQ(-1.0, position.valueOr(-1.0));
+}
+
+TEST_F(AccelStepperMotorTest, GetCurrentPositionDegrees_WhenHomed_ConvertsTheSteps)
+{
+    // arrange
+    motor->home();
+    ON_CALL(mockHomingStrategy, updateHoming()).WillByDefault(Return(HomingResult::SUCCESS));
+    motor->update();
+    EXPECT_CALL(mockStepperController, getCurrentPosition()).WillOnce(Return(800));
+
+    // act
+    Result<double> position = motor->getCurrentPositionDegrees();
+
+    // assert
+    ASSERT_TRUE(position);
+    ASSERT_DOUBLE_EQ(90.0, position.value());
+}
+
+TEST_F(AccelStepperMotorTest, MoveToAbsolute_WhileMoving_IsRejectedAsBusy)
+{
+    // arrange
+    motor->home();
+    ON_CALL(mockHomingStrategy, updateHoming()).WillByDefault(Return(HomingResult::SUCCESS));
+    motor->update();
+    EXPECT_CALL(mockStepperController, distanceToGo()).WillOnce(Return(1000));
+    ASSERT_TRUE(motor->moveToAbsolute(180.0));
+
+    // act & assert
+    ASSERT_EQ(StepperError::BUSY, motor->moveToAbsolute(90.0).error());
+    ASSERT_EQ(StepperError::BUSY, motor->rotateRelative(90.0).error());
+    ASSERT_EQ(StepperError::BUSY, motor->home().error());
+}
+
 TEST_F(AccelStepperMotorTest, MoveToAbsolute_WhenHomed_AndDistanceToGo_TransitionsToMoving)
 {
     // arrange
@@ -189,4 +238,405 @@ TEST_F(AccelStepperMotorTest, Stop_WhenMoving_AndStopsImmediately_TransitionsToI
 
     // assert
     ASSERT_EQ(motor->getState(), StepperMotorState::IDLE);
-}
\ No newline at end of file
+}
+
+TEST_F(AccelStepperMotorTest, RunAtVelocity_WhenNotHomed_IsRejected)
+{
+    EXPECT_CALL(mockStepperController, setSpeed(_)).Times(0);
+
+    ASSERT_FALSE(motor->runAtVelocity(6.0));
+    ASSERT_FALSE(motor->isRunningAtVelocity());
+}
+
+TEST_F(AccelStepperMotorTest, RunAtVelocity_WhenHomed_RunsAtConstantSpeedWithoutRamp)
+{
+    // arrange
+    motor->home();
+    ON_CALL(mockHomingStrategy, updateHoming()).WillByDefault(Return(HomingResult::SUCCESS));
+    motor->update();
+
+    // 6 degrees per second are 3200 * 6 / 360 steps per second, not truncated
+    EXPECT_CALL(mockStepperController, setSpeed(::testing::FloatEq(3200.0f * 6.0f / 360.0f))).Times(1);
+    EXPECT_CALL(mockStepperController, runSpeed()).Times(2);
+    EXPECT_CALL(mockStepperController, run()).Times(0);
+
+    // act
+    ASSERT_TRUE(motor->runAtVelocity(6.0));
+    motor->update();
+    motor->update();
+
+    // assert
+    ASSERT_EQ(motor->getState(), StepperMotorState::MOVING);
+    ASSERT_TRUE(motor->isRunningAtVelocity());
+    ASSERT_TRUE(motor->isBusy());
+}
+
+TEST_F(AccelStepperMotorTest, MoveToAbsolute_WhileRunningAtVelocity_TakesOver)
+{
+    // arrange
+    motor->home();
+    ON_CALL(mockHomingStrategy, updateHoming()).WillByDefault(Return(HomingResult::SUCCESS));
+    motor->update();
+    ASSERT_TRUE(motor->runAtVelocity(6.0));
+
+    EXPECT_CALL(mockStepperController, distanceToGo()).WillOnce(Return(1000));
+    EXPECT_CALL(mockStepperController, moveTo(0)).Times(1);
+
+    // act
+    ASSERT_TRUE(motor->moveToAbsolute(0.0));
+
+    // assert
+    ASSERT_EQ(motor->getState(), StepperMotorState::MOVING);
+    ASSERT_FALSE(motor->isRunningAtVelocity());
+    ASSERT_FALSE(motor->runAtVelocity(6.0));
+}
+
+TEST_F(AccelStepperMotorTest, MoveToStep_WhenHomed_MovesToTheStepWithoutConversion)
+{
+    // arrange
+    motor->home();
+    ON_CALL(mockHomingStrategy, updateHoming()).WillByDefault(Return(HomingResult::SUCCESS));
+    motor->update();
+
+    EXPECT_CALL(mockStepperController, moveTo(1234)).Times(1);
+    EXPECT_CALL(mockStepperController, distanceToGo()).WillOnce(Return(1234));
+
+    // act
+    ASSERT_TRUE(motor->moveToStep(1234));
+
+    // assert
+    ASSERT_EQ(motor->getState(), StepperMotorState::MOVING);
+    ASSERT_EQ(motor->getStepsPerRevolution(), 200 * 16);
+}
+
+// a PWM output on the enable pin, records every duty
+class FakeEnablePwm : public soc::api::IPwmOutput
+{
+public:
+    void begin() override { begun = true; }
+    void setDuty(uint16_t duty) override { duties.push_back(duty); }
+
+    bool begun = false;
+    std::vector<uint16_t> duties;
+};
+
+class AccelStepperMotorPowerTest : public AccelStepperMotorTest
+{
+protected:
+    static const unsigned long IDLE_TIMEOUT_MS = 100;
+    static const unsigned long WAKE_LEAD_MICROS = 2000;
+
+    void SetUp() override
+    {
+        virtualClock().reset();
+        AccelStepperMotorTest::SetUp();
+    }
+
+    void TearDown() override
+    {
+        virtualClock().reset();
+    }
+
+    static AccelStepperMotor::PowerConfig config(AccelStepperMotor::IdlePower idlePower)
+    {
+        return {idlePower, IDLE_TIMEOUT_MS, 250, WAKE_LEAD_MICROS};
+    }
+
+    void homeNow()
+    {
+        motor->home();
+        ON_CALL(mockHomingStrategy, updateHoming()).WillByDefault(Return(HomingResult::SUCCESS));
+        motor->update();
+        ASSERT_EQ(motor->getState(), StepperMotorState::IDLE);
+    }
+};
+
+TEST_F(AccelStepperMotorPowerTest, Disabled_SwitchesTheDriverOffAfterTheIdleTimeout)
+{
+    // arrange
+    motor->setPowerConfig(config(AccelStepperMotor::IdlePower::DISABLED));
+    motor->enable();
+    homeNow();
+    ASSERT_TRUE(motor->isPowerDownPending());
+
+    // act & assert: full current until the timeout
+    EXPECT_CALL(mockStepperController, disableOutputs()).Times(0);
+    virtualClock().advanceMillis(IDLE_TIMEOUT_MS - 1);
+    motor->update();
+    ::testing::Mock::VerifyAndClearExpectations(&mockStepperController);
+
+    EXPECT_CALL(mockStepperController, disableOutputs()).Times(1);
+    virtualClock().advanceMillis(1);
+    motor->update();
+    motor->update();
+
+    EXPECT_EQ(AccelStepperMotor::CoilPower::OFF, motor->getCoilPower());
+    EXPECT_FALSE(motor->isPowerDownPending());
+    EXPECT_FALSE(motor->isBusy());
+}
+
+TEST_F(AccelStepperMotorPowerTest, Disabled_NextMoveWaitsTheWakeLeadBeforeStepping)
+{
+    // arrange: powered down
+    motor->setPowerConfig(config(AccelStepperMotor::IdlePower::DISABLED));
+    motor->enable();
+    homeNow();
+    virtualClock().advanceMillis(IDLE_TIMEOUT_MS);
+    motor->update();
+    ASSERT_EQ(AccelStepperMotor::CoilPower::OFF, motor->getCoilPower());
+
+    // act: the move energizes the coils at once, the steps wait
+    EXPECT_CALL(mockStepperController, enableOutputs()).Times(1);
+    EXPECT_CALL(mockStepperController, distanceToGo()).WillOnce(Return(100));
+    ASSERT_TRUE(motor->moveToStep(100));
+    EXPECT_EQ(AccelStepperMotor::CoilPower::ON, motor->getCoilPower());
+
+    EXPECT_CALL(mockStepperController, run()).Times(0);
+    virtualClock().advanceMicros(WAKE_LEAD_MICROS - 1);
+    motor->update();
+    ::testing::Mock::VerifyAndClearExpectations(&mockStepperController);
+
+    // assert
+    EXPECT_CALL(mockStepperController, distanceToGo()).WillRepeatedly(Return(99));
+    EXPECT_CALL(mockStepperController, run()).Times(1).WillOnce(Return(true));
+    virtualClock().advanceMicros(1);
+    motor->update();
+    EXPECT_EQ(1u, motor->getWakeCount());
+}
+
+TEST_F(AccelStepperMotorPowerTest, Disabled_MoveWhileStillPoweredStartsAtOnce)
+{
+    // arrange
+    motor->setPowerConfig(config(AccelStepperMotor::IdlePower::DISABLED));
+    motor->enable();
+    homeNow();
+    virtualClock().advanceMillis(IDLE_TIMEOUT_MS / 2);
+    motor->update();
+
+    // act
+    EXPECT_CALL(mockStepperController, distanceToGo()).WillOnce(Return(100)).WillRepeatedly(Return(99));
+    EXPECT_CALL(mockStepperController, run()).Times(1).WillOnce(Return(true));
+    ASSERT_TRUE(motor->moveToStep(100));
+    motor->update();
+
+    // assert
+    EXPECT_FALSE(motor->isPowerDownPending());
+    EXPECT_EQ(0u, motor->getWakeCount());
+}
+
+TEST_F(AccelStepperMotorPowerTest, Reduced_ChopsTheEnablePinToTheHoldDuty)
+{
+    // arrange: the PWM output owns the enable pin
+    motor = std::make_unique<AccelStepperMotor>(mockStepperController, 200 * 16, mockHomingStrategy, loggerMock);
+    FakeEnablePwm pwm;
+    EXPECT_CALL(mockStepperController, enableOutputs()).Times(0);
+    EXPECT_CALL(mockStepperController, disableOutputs()).Times(0);
+    motor->setPowerConfig(config(AccelStepperMotor::IdlePower::REDUCED), &pwm);
+    ASSERT_TRUE(pwm.begun);
+    homeNow();
+
+    // act
+    virtualClock().advanceMillis(IDLE_TIMEOUT_MS);
+    motor->update();
+    EXPECT_CALL(mockStepperController, distanceToGo()).WillOnce(Return(100));
+    motor->moveToStep(100);
+    motor->disable();
+
+    // assert: full, hold, full for the move, off
+    EXPECT_EQ((std::vector<uint16_t>{1000, 250, 1000, 0}), pwm.duties);
+    EXPECT_EQ(AccelStepperMotor::CoilPower::OFF, motor->getCoilPower());
+}
+
+TEST_F(AccelStepperMotorPowerTest, UnusableConfig_IsIgnored)
+{
+    // arrange: neither an enable pin nor a PWM output
+    motor = std::make_unique<AccelStepperMotor>(mockStepperController, 200 * 16, mockHomingStrategy, loggerMock);
+    EXPECT_CALL(loggerMock, log_error(_)).Times(2);
+
+    // act
+    motor->setPowerConfig(config(AccelStepperMotor::IdlePower::DISABLED));
+    motor->setPowerConfig(config(AccelStepperMotor::IdlePower::REDUCED));
+    homeNow();
+    virtualClock().advanceMillis(IDLE_TIMEOUT_MS);
+    motor->update();
+
+    // assert
+    EXPECT_FALSE(motor->isPowerDownPending());
+    EXPECT_EQ(AccelStepperMotor::CoilPower::ON, motor->getCoilPower());
+}
+
+class AccelStepperMotorPollingTest : public AccelStepperMotorPowerTest
+{
+};
+
+TEST_F(AccelStepperMotorPollingTest, Moving_SkipsTheControllerUntilTheNextStepIsDue)
+{
+    // arrange: a move whose next step is 500 us away
+    homeNow();
+    EXPECT_CALL(mockStepperController, distanceToGo()).WillRepeatedly(Return(100));
+    ASSERT_TRUE(motor->moveToStep(100));
+    EXPECT_CALL(mockStepperController, run()).WillOnce(Return(true));
+    EXPECT_CALL(mockStepperController, nextStepDueMicros()).WillOnce(Return(micros() + 500));
+    motor->update();
+    ::testing::Mock::VerifyAndClearExpectations(&mockStepperController);
+
+    // act & assert: no controller call before the step is due
+    EXPECT_CALL(mockStepperController, run()).Times(0);
+    EXPECT_CALL(mockStepperController, distanceToGo()).Times(0);
+    for (int loop = 0; loop < 499; loop++)
+    {
+        virtualClock().advanceMicros(1);
+        EXPECT_FALSE(motor->isUpdateDue());
+        motor->update();
+    }
+    ::testing::Mock::VerifyAndClearExpectations(&mockStepperController);
+
+    EXPECT_CALL(mockStepperController, distanceToGo()).WillRepeatedly(Return(99));
+    EXPECT_CALL(mockStepperController, run()).WillOnce(Return(true));
+    EXPECT_CALL(mockStepperController, nextStepDueMicros()).WillOnce(Return(micros() + 500));
+    virtualClock().advanceMicros(1);
+    EXPECT_TRUE(motor->isUpdateDue());
+    motor->update();
+    EXPECT_FALSE(motor->isUpdateDue());
+
+    // a new speed may bring the next step forward
+    motor->setSpeed(200.0);
+    EXPECT_TRUE(motor->isUpdateDue());
+}
+
+// records every motion event
+class RecordingMotionListener : public IMotionListener
+{
+public:
+    void onMotionEvent(IStepperMotor & /*motor*/, MotionEvent event) override { events.push_back(event); }
+
+    std::vector<MotionEvent> events;
+};
+
+class AccelStepperMotorEventTest : public AccelStepperMotorPowerTest
+{
+protected:
+    RecordingMotionListener listener;
+
+    void SetUp() override
+    {
+        AccelStepperMotorPowerTest::SetUp();
+        ASSERT_TRUE(motor->addMotionListener(listener));
+    }
+};
+
+TEST_F(AccelStepperMotorEventTest, Homing_ReportsTheSuccessOnce)
+{
+    // act
+    motor->home();
+    EXPECT_TRUE(listener.events.empty());
+    ON_CALL(mockHomingStrategy, updateHoming()).WillByDefault(Return(HomingResult::SUCCESS));
+    motor->update();
+    motor->update();
+
+    // assert
+    EXPECT_EQ(std::vector<MotionEvent>{MotionEvent::HOMING_SUCCEEDED}, listener.events);
+}
+
+TEST_F(AccelStepperMotorEventTest, Homing_InstantStrategy_ReportsFromHome)
+{
+    // arrange
+    ON_CALL(mockHomingStrategy, getHomingResult()).WillByDefault(Return(HomingResult::SUCCESS));
+
+    // act
+    ASSERT_TRUE(motor->home());
+
+    // assert
+    EXPECT_EQ(std::vector<MotionEvent>{MotionEvent::HOMING_SUCCEEDED}, listener.events);
+}
+
+TEST_F(AccelStepperMotorEventTest, Homing_RejectedOrFailed_ReportsTheFailureOnce)
+{
+    // a rejected homing
+    EXPECT_CALL(mockHomingStrategy, beginHoming()).WillOnce(Return(false)).WillOnce(Return(true));
+    ASSERT_FALSE(motor->home());
+    EXPECT_EQ(std::vector<MotionEvent>{MotionEvent::HOMING_FAILED}, listener.events);
+
+    // a homing that does not find home
+    listener.events.clear();
+    ASSERT_TRUE(motor->home());
+    EXPECT_CALL(mockHomingStrategy, updateHoming()).WillOnce(Return(HomingResult::FAILURE_TIMEOUT));
+    motor->update();
+    motor->update();
+    EXPECT_EQ(std::vector<MotionEvent>{MotionEvent::HOMING_FAILED}, listener.events);
+}
+
+TEST_F(AccelStepperMotorEventTest, Move_ReportsTheCompletionOnce)
+{
+    // arrange
+    homeNow();
+    listener.events.clear();
+    EXPECT_CALL(mockStepperController, distanceToGo())
+        .WillOnce(Return(1000))
+        .WillOnce(Return(500))
+        .WillRepeatedly(Return(0));
+    ASSERT_TRUE(motor->moveToStep(1000));
+
+    // act: one update on the way, the last one arrives
+    motor->update();
+    EXPECT_TRUE(listener.events.empty());
+    motor->update();
+    motor->update();
+
+    // assert
+    EXPECT_EQ(std::vector<MotionEvent>{MotionEvent::MOVE_COMPLETE}, listener.events);
+    EXPECT_FALSE(motor->isBusy());
+}
+
+TEST_F(AccelStepperMotorEventTest, ZeroDistanceMove_ReportsFromTheCommand)
+{
+    // arrange
+    homeNow();
+    listener.events.clear();
+
+    // act: the default distanceToGo is 0
+    ASSERT_TRUE(motor->moveToStep(0));
+
+    // assert
+    EXPECT_EQ(std::vector<MotionEvent>{MotionEvent::MOVE_COMPLETE}, listener.events);
+}
+
+TEST_F(AccelStepperMotorEventTest, MoveTakingOverTheVelocityRun_ReportsOnce)
+{
+    // arrange
+    homeNow();
+    listener.events.clear();
+    ASSERT_TRUE(motor->runAtVelocity(6.0));
+    EXPECT_CALL(mockStepperController, distanceToGo()).WillOnce(Return(1000)).WillRepeatedly(Return(0));
+    ASSERT_TRUE(motor->moveToStep(1000));
+    EXPECT_TRUE(listener.events.empty());
+
+    // act
+    motor->update();
+
+    // assert
+    EXPECT_EQ(std::vector<MotionEvent>{MotionEvent::MOVE_COMPLETE}, listener.events);
+}
+
+TEST_F(AccelStepperMotorEventTest, Listeners_HaveAFixedNumberOfSlots)
+{
+    // arrange: the fixture's listener takes the first slot, adding it again keeps one
+    std::vector<RecordingMotionListener> others(MotionListeners::CAPACITY);
+    ASSERT_TRUE(motor->addMotionListener(listener));
+    for (size_t i = 0; i + 1 < MotionListeners::CAPACITY; i++)
+    {
+        ASSERT_TRUE(motor->addMotionListener(others[i]));
+    }
+
+    // act & assert
+    EXPECT_FALSE(motor->addMotionListener(others.back()));
+    motor->removeMotionListener(listener);
+    EXPECT_TRUE(motor->addMotionListener(others.back()));
+
+    homeNow();
+    EXPECT_TRUE(listener.events.empty());
+    for (const RecordingMotionListener &other : others)
+    {
+        EXPECT_EQ(std::vector<MotionEvent>{MotionEvent::HOMING_SUCCEEDED}, other.events);
+    }
+}
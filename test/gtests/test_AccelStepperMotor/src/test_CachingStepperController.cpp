@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <Arduino.h>
+#include <memory>
+
+#include "StepperControllerMock.h"
+#include "LoggerMock.h"
+#include "stepper/accel/AccelStepperMotor.h"
+#include "stepper/accel/CachingStepperController.h"
+#include "stepper/homing/LimitSwitchHomingStrategy.h"
+#include "stepper/sim/RecordingStepperController.h"
+#include "stepper/sim/SimulatedLimitSwitch.h"
+#include "stepper/sim/SimulatedStepperController.h"
+
+using namespace stepper::accel;
+using ::testing::NiceMock;
+
+class CachingStepperControllerTest : public ::testing::Test
+{
+protected:
+    NiceMock<stepper::testing::MockStepperController> mockStepperController;
+    CachingStepperController cache{mockStepperController};
+};
+
+TEST_F(CachingStepperControllerTest, UnchangedProfile_IsPassedOnOnce)
+{
+    // arrange
+    EXPECT_CALL(mockStepperController, setMaxSpeed(800.0f)).Times(1);
+    EXPECT_CALL(mockStepperController, setAcceleration(3200.0f)).Times(1);
+
+    // act
+    for (int move = 0; move < 3; move++)
+    {
+        cache.setMaxSpeed(800.0f);
+        cache.setAcceleration(3200.0f);
+    }
+
+    // assert
+    EXPECT_EQ(2u, cache.getForwardedCount());
+    EXPECT_EQ(4u, cache.getSkippedCount());
+}
+
+TEST_F(CachingStepperControllerTest, ChangedProfile_IsPassedOn)
+{
+    // arrange
+    ::testing::InSequence sequence;
+    EXPECT_CALL(mockStepperController, setMaxSpeed(800.0f));
+    EXPECT_CALL(mockStepperController, setMaxSpeed(400.0f));
+    EXPECT_CALL(mockStepperController, setMaxSpeed(800.0f));
+
+    // act & assert
+    cache.setMaxSpeed(800.0f);
+    cache.setMaxSpeed(400.0f);
+    cache.setMaxSpeed(800.0f);
+    EXPECT_EQ(0u, cache.getSkippedCount());
+}
+
+TEST_F(CachingStepperControllerTest, Outputs_AreSwitchedOnlyOnAChange)
+{
+    // arrange
+    EXPECT_CALL(mockStepperController, enableOutputs()).Times(2);
+    EXPECT_CALL(mockStepperController, disableOutputs()).Times(2);
+
+    // act: a new polarity makes the state of the enable pin unknown
+    cache.enableOutputs();
+    cache.enableOutputs();
+    cache.disableOutputs();
+    cache.disableOutputs();
+    cache.setPinsInverted(false, false, true);
+    cache.disableOutputs();
+    cache.enableOutputs();
+
+    // assert
+    EXPECT_EQ(2u, cache.getSkippedCount());
+}
+
+TEST_F(CachingStepperControllerTest, Invalidate_PassesTheNextProfileOn)
+{
+    // arrange: e.g. the controller was configured behind the cache
+    EXPECT_CALL(mockStepperController, setMaxSpeed(800.0f)).Times(2);
+    cache.setMaxSpeed(800.0f);
+
+    // act
+    cache.invalidate();
+    cache.setMaxSpeed(800.0f);
+}
+
+TEST(CachingStepperControllerHomingTest, LimitSwitchHoming_KeepsItsProfileAndTheMotorsAfterwards)
+{
+    // arrange: the strategy and the motor share the cache, the recorder sees what passes it
+    virtualClock().reset();
+    NiceMock<soc::testing::LoggerMock> logger;
+    stepper::sim::SimulatedStepperController simulated(300);
+    stepper::sim::RecordingStepperController recorder(simulated);
+    CachingStepperController cache(recorder);
+    stepper::sim::SimulatedLimitSwitch limitSwitch(simulated, 0, -1);
+    limitSwitch.begin();
+    stepper::homing::LimitSwitchHomingStrategy homing(cache, limitSwitch, {400, 800, 3200, -1}, logger);
+    AccelStepperMotor motor(cache, 1600, homing, logger);
+    motor.setSpeed(180.0);        // 800 steps per second
+    motor.setAcceleration(720.0); // 3200 steps per second squared
+
+    // act: home, tick, home again and tick again
+    for (int round = 0; round < 2; round++)
+    {
+        ASSERT_TRUE(motor.home());
+        for (int loop = 0; loop < 200000 && motor.isBusy(); loop++)
+        {
+            motor.update();
+            virtualClock().advanceMicros(20);
+        }
+        ASSERT_FALSE(motor.needsHoming());
+        for (double degrees : {6.0, 12.0, 18.0})
+        {
+            ASSERT_TRUE(motor.moveToAbsolute(degrees));
+            for (int loop = 0; loop < 200000 && motor.isBusy(); loop++)
+            {
+                motor.update();
+                virtualClock().advanceMicros(20);
+            }
+        }
+    }
+
+    // assert: every homing moved with the homing profile, every tick with the motor's
+    const std::vector<stepper::sim::RecordingStepperController::MoveRecord> &moves = recorder.getMoves();
+    ASSERT_LE(8u, moves.size());
+    for (const stepper::sim::RecordingStepperController::MoveRecord &move : moves)
+    {
+        bool homingMove = move.targetPosition < move.startPosition;
+        EXPECT_FLOAT_EQ(homingMove ? 400.0f : 800.0f, move.maxSpeed) << "move to " << move.targetPosition;
+        EXPECT_FLOAT_EQ(homingMove ? 800.0f : 3200.0f, move.acceleration) << "move to " << move.targetPosition;
+    }
+    EXPECT_EQ(80, simulated.getCurrentPosition());
+    EXPECT_LT(0u, cache.getSkippedCount());
+    virtualClock().reset();
+}
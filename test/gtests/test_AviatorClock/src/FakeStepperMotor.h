@@ -0,0 +1,151 @@
+#pragma once
+
+#include <stepper/api/IStepperMotor.h>
+#include <stepper/api/MotionListeners.h>
+
+namespace aviator_clock
+{
+    namespace testing
+    {
+        /**
+         * @brief Motor that homes and moves in a fixed number of update() calls,
+         * reports it to its listeners and counts what the clock does with it.
+         */
+        class FakeStepperMotor : public IStepperMotor
+        {
+        public:
+            // ten steps per degree, so the test angles are exact
+            static const long STEPS_PER_REVOLUTION = 3600;
+
+            explicit FakeStepperMotor(int updatesPerMove = 3) : _updatesPerMove(updatesPerMove) {}
+
+            stepper::api::Status home() override
+            {
+                if (failHoming)
+                {
+                    _listeners.notify(*this, stepper::api::MotionEvent::HOMING_FAILED);
+                    return stepper::api::StepperError::HOMING_REJECTED;
+                }
+                _homed = false;
+                _remainingUpdates = _updatesPerMove;
+                return stepper::api::Status::ok();
+            }
+            bool isHomingFailed() const override
+            {
+                statusQueries++;
+                return failHoming;
+            }
+            bool isHoming() const override
+            {
+                statusQueries++;
+                return !_homed;
+            }
+            bool needsHoming() const override
+            {
+                statusQueries++;
+                return !_homed;
+            }
+
+            stepper::api::Status moveToAbsolute(double degreesAbsolute) override
+            {
+                moves++;
+                lastTargetDegrees = degreesAbsolute;
+                velocityDps = 0.0;
+                _remainingUpdates = _updatesPerMove;
+                _pendingPowerDownUpdates = 0;
+                return stepper::api::Status::ok();
+            }
+            stepper::api::Status moveToStep(long stepsAbsolute) override
+            {
+                lastTargetSteps = stepsAbsolute;
+                return moveToAbsolute(stepsAbsolute * 360.0 / STEPS_PER_REVOLUTION);
+            }
+            long getStepsPerRevolution() const override { return STEPS_PER_REVOLUTION; }
+            stepper::api::Status rotateRelative(double /*degreesRelative*/) override { return stepper::api::StepperError::BUSY; }
+            stepper::api::Status runAtVelocity(double degreesPerSecond) override
+            {
+                if (!_homed)
+                    return stepper::api::StepperError::NOT_HOMED;
+                if (busy() && velocityDps == 0.0)
+                    return stepper::api::StepperError::BUSY;
+                velocityDps = degreesPerSecond;
+                return stepper::api::Status::ok();
+            }
+            bool isRunningAtVelocity() const override { return velocityDps != 0.0; }
+            void setSpeed(double degreesPerSecond) override { speedDps = degreesPerSecond; }
+            void setAcceleration(double degreesPerSecondSquared) override { accelerationDps2 = degreesPerSecondSquared; }
+            stepper::api::Result<double> getCurrentPositionDegrees() const override { return lastTargetDegrees; }
+            stepper::api::StepperMotorState getState() const override
+            {
+                if (!_homed)
+                    return stepper::api::StepperMotorState::HOMING_IN_PROGRESS;
+                return busy() ? stepper::api::StepperMotorState::MOVING : stepper::api::StepperMotorState::IDLE;
+            }
+            void enable() override {}
+            void disable() override {}
+
+            void update() override
+            {
+                updates++;
+                if (_remainingUpdates > 0 && --_remainingUpdates == 0)
+                {
+                    bool homing = !_homed;
+                    _homed = true;
+                    _pendingPowerDownUpdates = _powerDownUpdates;
+                    _listeners.notify(*this, homing ? stepper::api::MotionEvent::HOMING_SUCCEEDED
+                                                    : stepper::api::MotionEvent::MOVE_COMPLETE);
+                }
+                else if (_pendingPowerDownUpdates > 0 && --_pendingPowerDownUpdates == 0)
+                {
+                    powerDowns++;
+                }
+            }
+            bool isBusy() const override
+            {
+                statusQueries++;
+                return busy();
+            }
+            void stop() override
+            {
+                bool wasBusy = busy();
+                _remainingUpdates = 0;
+                velocityDps = 0.0;
+                if (wasBusy)
+                {
+                    _listeners.notify(*this, stepper::api::MotionEvent::MOVE_COMPLETE);
+                }
+            }
+            bool isPowerDownPending() const override { return _pendingPowerDownUpdates > 0; }
+            bool isUpdateDue() const override { return stepDue || !busy(); }
+            bool addMotionListener(stepper::api::IMotionListener &listener) override { return _listeners.add(listener); }
+            void removeMotionListener(stepper::api::IMotionListener &listener) override { _listeners.remove(listener); }
+
+            /**
+             * @brief Powers down in the given number of update() calls after a move.
+             */
+            void powerDownAfter(int idleUpdates) { _powerDownUpdates = idleUpdates; }
+
+            int moves = 0;
+            int updates = 0;
+            int powerDowns = 0;
+            bool stepDue = true;     // false: a move waits for its next step
+            bool failHoming = false; // home() is rejected
+            mutable int statusQueries = 0; // isBusy(), needsHoming(), isHoming(), isHomingFailed()
+            double lastTargetDegrees = -1;
+            long lastTargetSteps = -1;
+            double speedDps = 0.0;
+            double accelerationDps2 = 0.0;
+            double velocityDps = 0.0; // the hand does not move in velocity mode, the test moves the time
+
+        private:
+            bool busy() const { return _remainingUpdates > 0 || velocityDps != 0.0; }
+
+            const int _updatesPerMove;
+            int _remainingUpdates = 0;
+            bool _homed = false;
+            int _powerDownUpdates = 0;
+            int _pendingPowerDownUpdates = 0;
+            stepper::api::MotionListeners _listeners;
+        };
+    }
+}
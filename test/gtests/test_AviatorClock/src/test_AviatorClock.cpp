@@ -0,0 +1,700 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <Preferences.h>
+#include <memory>
+#include <vector>
+
+#include "FakeStepperMotor.h"
+#include "LoggerMock.h"
+#include "aviator-clock/AviatorClock.h"
+#include "aviator-clock/TickProfileTuning.h"
+#include "soc/esp32/ESP32PreferencesStore.h"
+
+using namespace aviator_clock;
+using aviator_clock::testing::FakeStepperMotor;
+using ::testing::NiceMock;
+
+// time that only changes when the test says so, and counts how often it is read
+class FakeTime : public soc::api::ITime
+{
+public:
+    unsigned long now() override
+    {
+        reads++;
+        return ((time.hours * 60 + time.minutes) * 60 + time.seconds) * 1000;
+    }
+
+    bool asTimeComponents(TimeComponents &components) override
+    {
+        reads++;
+        components = time;
+        return true;
+    }
+
+    TimeComponents time{0, 0, 0, 0};
+    int reads = 0;
+};
+
+class AviatorClockTest : public ::testing::Test
+{
+protected:
+    static const unsigned long STAGGER_MS = 50;
+
+    NiceMock<soc::testing::LoggerMock> logger;
+    FakeTime timeProvider;
+    AviatorClock clock{timeProvider, logger, STAGGER_MS};
+    FakeStepperMotor *hourMotor = nullptr;
+    FakeStepperMotor *minuteMotor = nullptr;
+    FakeStepperMotor *secondMotor = nullptr;
+    unsigned long nowMs = 0;
+
+    FakeStepperMotor *addHand(ClockHand::HandType type)
+    {
+        auto motor = std::make_unique<FakeStepperMotor>();
+        FakeStepperMotor *view = motor.get();
+        clock.addHand(std::make_unique<ClockHand>(type, timeProvider, std::move(motor), logger, 360.0, 0.0, 100.0, 100.0));
+        return view;
+    }
+
+    void SetUp() override
+    {
+        hourMotor = addHand(ClockHand::HandType::HOUR);
+        minuteMotor = addHand(ClockHand::HandType::MINUTE);
+        secondMotor = addHand(ClockHand::HandType::SECOND);
+        timeProvider.time = {1, 59, 58, 0};
+        clock.setup();
+    }
+
+    void loop(int iterations = 1, unsigned long stepMs = 1)
+    {
+        for (int i = 0; i < iterations; i++)
+        {
+            clock.advanceState(nowMs);
+            clock.render();
+            nowMs += stepMs;
+        }
+    }
+
+    // lets every pending move run to its end
+    void settle()
+    {
+        loop(1, 10);
+        for (int i = 0; i < 1000 && !clock.isSettled(); i++)
+        {
+            loop(1, 10);
+        }
+        ASSERT_TRUE(clock.isSettled());
+    }
+};
+
+TEST_F(AviatorClockTest, OwnsAllHands)
+{
+    EXPECT_EQ(3u, clock.getHandCount());
+}
+
+TEST_F(AviatorClockTest, ReadsTheTimeOncePerLoop)
+{
+    loop(20);
+
+    EXPECT_EQ(20, timeProvider.reads);
+}
+
+TEST_F(AviatorClockTest, PositionsEveryHandAfterHoming)
+{
+    settle();
+
+    EXPECT_DOUBLE_EQ(1 * 30.0, hourMotor->lastTargetDegrees);
+    EXPECT_DOUBLE_EQ(59 * 6.0, minuteMotor->lastTargetDegrees);
+    EXPECT_DOUBLE_EQ(58 * 6.0, secondMotor->lastTargetDegrees);
+}
+
+TEST_F(AviatorClockTest, IsSetUpOnceEveryHandHomed)
+{
+    EXPECT_FALSE(clock.isSetUp());
+    EXPECT_STREQ("second hand", ClockHand(ClockHand::HandType::SECOND, timeProvider, nullptr, logger,
+                                          360.0, 0.0, 100.0, 100.0).getName());
+
+    settle();
+
+    EXPECT_TRUE(clock.isSetUp());
+}
+
+TEST_F(AviatorClockTest, IdleLoopsDoNotTouchTheHands)
+{
+    settle();
+    int updates = hourMotor->updates + minuteMotor->updates + secondMotor->updates;
+
+    loop(100);
+
+    EXPECT_EQ(updates, hourMotor->updates + minuteMotor->updates + secondMotor->updates);
+}
+
+TEST_F(AviatorClockTest, OnlyTheSecondHandMovesWithinAMinute)
+{
+    settle();
+
+    timeProvider.time = {1, 59, 59, 0};
+    settle();
+
+    EXPECT_EQ(2, secondMotor->moves);
+    EXPECT_EQ(1, minuteMotor->moves);
+    EXPECT_EQ(1, hourMotor->moves);
+}
+
+TEST_F(AviatorClockTest, StaggersTheMovesAtAnHourRollover)
+{
+    settle();
+    nowMs += 1000;
+
+    timeProvider.time = {2, 0, 0, 0};
+    loop(1);
+
+    // the second hand goes first, the others wait for their slot
+    EXPECT_EQ(2, secondMotor->moves);
+    EXPECT_EQ(1, minuteMotor->moves);
+    EXPECT_EQ(1, hourMotor->moves);
+
+    loop(STAGGER_MS - 1);
+    EXPECT_EQ(1, minuteMotor->moves);
+    loop(1);
+    EXPECT_EQ(2, minuteMotor->moves);
+    EXPECT_EQ(1, hourMotor->moves);
+
+    loop(STAGGER_MS);
+    EXPECT_EQ(2, hourMotor->moves);
+    EXPECT_DOUBLE_EQ(2 * 30.0, hourMotor->lastTargetDegrees);
+    EXPECT_DOUBLE_EQ(0.0, minuteMotor->lastTargetDegrees);
+    EXPECT_DOUBLE_EQ(0.0, secondMotor->lastTargetDegrees);
+}
+
+TEST_F(AviatorClockTest, StartsTheHandsOfATypeTogether)
+{
+    // arrange: a clock with two hands of every type
+    AviatorClock banked{timeProvider, logger, STAGGER_MS};
+    std::vector<FakeStepperMotor *> motors[3]; // by HandType
+    for (int i = 0; i < 2; i++)
+    {
+        for (ClockHand::HandType type : {ClockHand::HandType::HOUR, ClockHand::HandType::MINUTE, ClockHand::HandType::SECOND})
+        {
+            auto motor = std::make_unique<FakeStepperMotor>();
+            motors[static_cast<int>(type)].push_back(motor.get());
+            banked.addHand(std::make_unique<ClockHand>(type, timeProvider, std::move(motor), logger, 360.0, 0.0, 100.0, 100.0));
+        }
+    }
+    banked.setup();
+    for (int i = 0; i < 100 && !banked.isSettled(); i++)
+    {
+        banked.advanceState(nowMs);
+        nowMs += 10;
+    }
+    ASSERT_TRUE(banked.isSettled());
+    nowMs += 1000;
+
+    // act: an hour rollover, one slot for the seconds and one for the minutes
+    timeProvider.time = {2, 0, 0, 0};
+    for (unsigned long i = 0; i < 2 * STAGGER_MS; i++)
+    {
+        banked.advanceState(nowMs++);
+    }
+
+    // assert: the hour hands start in the third slot, together
+    std::vector<FakeStepperMotor *> &minuteMotors = motors[static_cast<int>(ClockHand::HandType::MINUTE)];
+    std::vector<FakeStepperMotor *> &hourMotors = motors[static_cast<int>(ClockHand::HandType::HOUR)];
+    EXPECT_EQ(2, minuteMotors[0]->moves);
+    EXPECT_EQ(2, minuteMotors[1]->moves);
+    EXPECT_EQ(1, hourMotors[0]->moves);
+    EXPECT_EQ(1, hourMotors[1]->moves);
+    banked.advanceState(nowMs);
+    EXPECT_EQ(2, hourMotors[0]->moves);
+    EXPECT_EQ(2, hourMotors[1]->moves);
+}
+
+TEST_F(AviatorClockTest, HandThatIsStillMovingCatchesUpAfterwards)
+{
+    settle();
+
+    // two seconds pass while the second hand moves
+    timeProvider.time = {1, 59, 59, 0};
+    loop(1);
+    timeProvider.time = {2, 0, 0, 0};
+    settle();
+
+    EXPECT_DOUBLE_EQ(0.0, secondMotor->lastTargetDegrees);
+    EXPECT_DOUBLE_EQ(0.0, minuteMotor->lastTargetDegrees);
+    EXPECT_DOUBLE_EQ(2 * 30.0, hourMotor->lastTargetDegrees);
+}
+
+TEST_F(AviatorClockTest, HandStaysActiveUntilItsMotorPoweredDown)
+{
+    secondMotor->powerDownAfter(20);
+    settle();
+    EXPECT_EQ(1, secondMotor->powerDowns);
+
+    // the tick takes three updates, the power down 20 more
+    timeProvider.time = {1, 59, 59, 0};
+    loop(4);
+    EXPECT_FALSE(secondMotor->isBusy());
+    EXPECT_FALSE(clock.isSettled());
+
+    loop(20);
+    EXPECT_EQ(2, secondMotor->powerDowns);
+    EXPECT_TRUE(clock.isSettled());
+}
+
+TEST_F(AviatorClockTest, HandThatWaitsToPowerDownTicksOnTime)
+{
+    secondMotor->powerDownAfter(100000);
+    loop(200);
+    ASSERT_FALSE(secondMotor->isBusy());
+    ASSERT_TRUE(secondMotor->isPowerDownPending());
+
+    timeProvider.time = {1, 59, 59, 0};
+    loop(1);
+
+    EXPECT_EQ(2, secondMotor->moves);
+    EXPECT_DOUBLE_EQ(59 * 6.0, secondMotor->lastTargetDegrees);
+    EXPECT_FALSE(secondMotor->isPowerDownPending());
+}
+
+TEST_F(AviatorClockTest, MovingHandSkipsTheMotorBetweenTwoSteps)
+{
+    settle();
+    nowMs += 1000;
+    timeProvider.time = {1, 59, 59, 0};
+    loop(1);
+    ASSERT_TRUE(secondMotor->isBusy());
+    int updates = secondMotor->updates;
+
+    // act
+    secondMotor->stepDue = false;
+    loop(50);
+
+    // assert: the hand stays active, the motor gets no update until its step is due
+    EXPECT_EQ(updates, secondMotor->updates);
+    EXPECT_FALSE(clock.isSettled());
+    secondMotor->stepDue = true;
+    settle();
+    EXPECT_DOUBLE_EQ(59 * 6.0, secondMotor->lastTargetDegrees);
+}
+
+TEST_F(AviatorClockTest, HandsLearnTheEndOfAMoveFromTheMotorEvents)
+{
+    // arrange
+    settle();
+    int queries = hourMotor->statusQueries + minuteMotor->statusQueries + secondMotor->statusQueries;
+
+    // act: a tick of all hands
+    nowMs += 1000;
+    timeProvider.time = {2, 0, 0, 0};
+    settle();
+
+    // assert: the hands moved without asking the motors whether they are done
+    EXPECT_DOUBLE_EQ(2 * 30.0, hourMotor->lastTargetDegrees);
+    EXPECT_DOUBLE_EQ(0.0, minuteMotor->lastTargetDegrees);
+    EXPECT_DOUBLE_EQ(0.0, secondMotor->lastTargetDegrees);
+    EXPECT_EQ(queries, hourMotor->statusQueries + minuteMotor->statusQueries + secondMotor->statusQueries);
+}
+
+TEST_F(AviatorClockTest, RejectedHomingIsReportedOnceAndStopsTheHand)
+{
+    // arrange
+    settle();
+    int moves = secondMotor->moves;
+    secondMotor->failHoming = true;
+    EXPECT_CALL(logger, log_error(::testing::_)).Times(::testing::AnyNumber());
+    EXPECT_CALL(logger, log_error(::testing::HasSubstr("Homing has failed"))).Times(1);
+
+    // act
+    clock.setup();
+    timeProvider.time = {1, 59, 59, 0};
+    loop(100);
+
+    // assert: the other hands go on
+    EXPECT_EQ(moves, secondMotor->moves);
+    EXPECT_DOUBLE_EQ(59 * 6.0, minuteMotor->lastTargetDegrees);
+}
+
+// a component a hand waits for, set up when the test says so
+class FakeDependency : public soc::api::ISocComponent
+{
+public:
+    void advanceState(unsigned long) override {}
+    void render() override {}
+    bool isSetUp() const override { return setUp; }
+
+    bool setUp = false;
+};
+
+TEST(AviatorClockDependencyTest, HandWaitsForItsDependency_TheOthersHomeMeanwhile)
+{
+    // arrange
+    NiceMock<soc::testing::LoggerMock> logger;
+    FakeTime timeProvider;
+    timeProvider.time = {1, 59, 58, 0};
+    AviatorClock clock{timeProvider, logger, 50};
+    FakeDependency tuning;
+    auto waitingMotor = std::make_unique<FakeStepperMotor>();
+    auto freeMotor = std::make_unique<FakeStepperMotor>();
+    FakeStepperMotor *waiting = waitingMotor.get();
+    FakeStepperMotor *free = freeMotor.get();
+    auto waitingHand = std::make_unique<ClockHand>(ClockHand::HandType::SECOND, timeProvider, std::move(waitingMotor),
+                                                   logger, 360.0, 0.0, 100.0, 100.0);
+    waitingHand->setDependency(&tuning);
+    clock.addHand(std::move(waitingHand));
+    clock.addHand(std::make_unique<ClockHand>(ClockHand::HandType::MINUTE, timeProvider, std::move(freeMotor),
+                                              logger, 360.0, 0.0, 100.0, 100.0));
+
+    // act
+    clock.setup();
+    for (unsigned long ms = 0; ms < 100; ms += 10)
+    {
+        clock.advanceState(ms);
+    }
+
+    // assert: the minute hand homed and shows the time, the second hand was not touched
+    EXPECT_FALSE(clock.isSetUp());
+    EXPECT_DOUBLE_EQ(59 * 6.0, free->lastTargetDegrees);
+    EXPECT_EQ(0, waiting->updates);
+    EXPECT_TRUE(waiting->isHoming()); // never homed
+
+    tuning.setUp = true;
+    for (unsigned long ms = 100; ms < 200; ms += 10)
+    {
+        clock.advanceState(ms);
+    }
+    EXPECT_TRUE(clock.isSetUp());
+    EXPECT_DOUBLE_EQ(58 * 6.0, waiting->lastTargetDegrees);
+}
+
+class TickProfileTuningTest : public ::testing::Test
+{
+protected:
+    // the switch of a hand that is never pressed
+    class OpenSwitch : public soc::api::IDigitalInput
+    {
+    public:
+        bool isActive() const override { return false; }
+        void begin() const override {}
+    };
+
+    NiceMock<soc::testing::LoggerMock> logger;
+    FakeTime timeProvider;
+    OpenSwitch limitSwitch;
+    soc::esp32::ESP32PreferencesStore store{"clock"};
+    FakeStepperMotor *motor = nullptr;
+    std::unique_ptr<ClockHand> hand;
+
+    void SetUp() override
+    {
+        fakeFlash().reset();
+        store.begin();
+        auto fake = std::make_unique<FakeStepperMotor>();
+        motor = fake.get();
+        hand = std::make_unique<ClockHand>(ClockHand::HandType::SECOND, timeProvider, std::move(fake), logger, 360.0, 0.0, 100.0, 100.0);
+    }
+
+    void TearDown() override
+    {
+        fakeFlash().reset();
+    }
+};
+
+TEST_F(TickProfileTuningTest, SavedProfile_IsGivenToTheHandAtOnce)
+{
+    // arrange
+    TickProfileTuner::SavedProfile saved = {TickProfileTuner::SAVED_PROFILE_VERSION, 1800.0f, 45000.0f};
+    ASSERT_TRUE(store.save("tick-second", &saved, sizeof(saved)));
+    TickProfileTuning tuning(*hand, *motor, limitSwitch, store, "tick-second", logger,
+                             TickProfileTuner::defaultConfig(), false);
+
+    // act
+    tuning.setup();
+    hand->setup();
+
+    // assert: the motor was left to the hand
+    EXPECT_TRUE(tuning.isSetUp());
+    EXPECT_FALSE(tuning.isTuned());
+    EXPECT_STREQ("tick-second", tuning.getName());
+    EXPECT_DOUBLE_EQ(1800.0, motor->speedDps);
+    EXPECT_DOUBLE_EQ(45000.0, motor->accelerationDps2);
+}
+
+TEST_F(TickProfileTuningTest, FailedTuning_KeepsTheProfileOfTheHand)
+{
+    // arrange: a saved profile does not count when retuning
+    TickProfileTuner::SavedProfile saved = {TickProfileTuner::SAVED_PROFILE_VERSION, 1800.0f, 45000.0f};
+    store.save("tick-second", &saved, sizeof(saved));
+    motor->failHoming = true;
+    EXPECT_CALL(logger, log_warn(::testing::_)).Times(::testing::AnyNumber());
+    EXPECT_CALL(logger, log_warn(::testing::HasSubstr("keeping the default"))).Times(1);
+    TickProfileTuning tuning(*hand, *motor, limitSwitch, store, "tick-second", logger,
+                             TickProfileTuner::defaultConfig(), true);
+
+    // act
+    tuning.setup();
+    motor->failHoming = false;
+    hand->setup();
+
+    // assert
+    EXPECT_TRUE(tuning.isSetUp());
+    EXPECT_FALSE(tuning.isTuned());
+    EXPECT_DOUBLE_EQ(100.0, motor->speedDps);
+}
+
+class ClockHandSweepTest : public ::testing::Test
+{
+protected:
+    NiceMock<soc::testing::LoggerMock> logger;
+    FakeTime timeProvider;
+    FakeStepperMotor *motor = nullptr;
+    std::unique_ptr<ClockHand> hand;
+
+    void SetUp() override
+    {
+        auto fake = std::make_unique<FakeStepperMotor>();
+        motor = fake.get();
+        hand = std::make_unique<ClockHand>(ClockHand::HandType::SECOND, timeProvider, std::move(fake), logger, 360.0, 0.0, 100.0, 100.0);
+        hand->setMotionMode(ClockHand::MotionMode::SWEEP);
+        timeProvider.time = {0, 0, 10, 500};
+        hand->setup();
+    }
+
+    void loop(int iterations = 1)
+    {
+        for (int i = 0; i < iterations; i++)
+        {
+            hand->advanceState(0);
+        }
+    }
+};
+
+TEST_F(ClockHandSweepTest, PositionsToTheFractionOfTheUnitAndSweepsAtTheNominalVelocity)
+{
+    loop(10);
+
+    EXPECT_EQ(1, motor->moves);
+    EXPECT_DOUBLE_EQ(10.5 * 6.0, motor->lastTargetDegrees);
+    EXPECT_DOUBLE_EQ(6.0, motor->velocityDps);
+}
+
+TEST_F(ClockHandSweepTest, CorrectsALagWithASmallVelocityAdjustment)
+{
+    loop(10);
+
+    // the hand lags a fifth of a second behind
+    timeProvider.time = {0, 0, 10, 700};
+    loop();
+
+    EXPECT_EQ(1, motor->moves);
+    EXPECT_GT(motor->velocityDps, 6.0);
+    EXPECT_LE(motor->velocityDps, 6.0 * 1.1);
+}
+
+TEST_F(ClockHandSweepTest, FliesBackAtTheEndOfTheDial)
+{
+    loop(10);
+
+    timeProvider.time = {0, 1, 0, 100};
+    loop();
+
+    EXPECT_EQ(2, motor->moves);
+    // the sweep target is truncated to fixed point, 1/256 step at ten steps per degree
+    EXPECT_NEAR(0.1 * 6.0, motor->lastTargetDegrees, 2.0 / 2560);
+}
+
+TEST_F(ClockHandSweepTest, FullMinuteWithItsFlybackIsNoCatchUp)
+{
+    loop(10);
+
+    for (int tenths = 106; tenths <= 605; tenths++)
+    {
+        timeProvider.time = {0, tenths / 600, (tenths / 10) % 60, tenths % 10 * 100};
+        loop(5);
+    }
+
+    // flew back to the start of the dial
+    EXPECT_LT(motor->lastTargetDegrees, 6.0);
+    EXPECT_EQ(0u, hand->getCatchUpCount());
+}
+
+TEST_F(ClockHandSweepTest, TimeJumpIsACatchUp)
+{
+    loop(10);
+
+    timeProvider.time = {0, 0, 40, 500};
+    loop(10);
+
+    EXPECT_EQ(1u, hand->getCatchUpCount());
+}
+
+TEST_F(ClockHandSweepTest, StaysActiveInAnAviatorClock)
+{
+    AviatorClock clock{timeProvider, logger, 50};
+    auto fake = std::make_unique<FakeStepperMotor>();
+    FakeStepperMotor *view = fake.get();
+    auto sweepingHand = std::make_unique<ClockHand>(ClockHand::HandType::SECOND, timeProvider, std::move(fake), logger, 360.0, 0.0, 100.0, 100.0);
+    sweepingHand->setMotionMode(ClockHand::MotionMode::SWEEP);
+    clock.addHand(std::move(sweepingHand));
+    clock.setup();
+
+    for (int i = 0; i < 20; i++)
+    {
+        clock.advanceState(i * 10);
+    }
+
+    EXPECT_FALSE(clock.isSettled());
+    EXPECT_TRUE(view->isRunningAtVelocity());
+    EXPECT_EQ(20, view->updates);
+}
+
+class ClockHandCatchUpTest : public ::testing::Test
+{
+protected:
+    NiceMock<soc::testing::LoggerMock> logger;
+    FakeTime timeProvider;
+    FakeStepperMotor *motor = nullptr;
+    std::unique_ptr<ClockHand> hand;
+    unsigned long nowMs = 0;
+
+    void SetUp() override
+    {
+        auto fake = std::make_unique<FakeStepperMotor>();
+        motor = fake.get();
+        hand = std::make_unique<ClockHand>(ClockHand::HandType::SECOND, timeProvider, std::move(fake), logger, 360.0, 0.0, 100.0, 100.0);
+        hand->setCatchUpProfile(1000.0, 5000.0, 2);
+        timeProvider.time = {0, 0, 10, 0};
+        hand->setup();
+        loop(10);
+    }
+
+    void loop(int iterations = 1)
+    {
+        for (int i = 0; i < iterations; i++)
+        {
+            hand->advanceState(nowMs);
+            nowMs += 10;
+        }
+    }
+};
+
+TEST_F(ClockHandCatchUpTest, BoundIsTheProfileAcrossTheWholeDial)
+{
+    // 360 degrees: 0.2 s ramping and 0.16 s at 1000 dps
+    EXPECT_EQ(560u, hand->getCatchUpBoundMs());
+}
+
+TEST_F(ClockHandCatchUpTest, NormalTicksAndTheRolloverAreNoCatchUp)
+{
+    for (int second = 11; second <= 60; second++)
+    {
+        timeProvider.time = {0, second / 60, second % 60, 0};
+        loop(10);
+    }
+
+    EXPECT_EQ(0.0, motor->lastTargetDegrees);
+    EXPECT_EQ(0u, hand->getCatchUpCount());
+    EXPECT_DOUBLE_EQ(100.0, motor->speedDps);
+}
+
+TEST_F(ClockHandCatchUpTest, JumpMovesStraightToTheTargetWithTheCatchUpProfile)
+{
+    int moves = motor->moves;
+
+    timeProvider.time = {0, 0, 40, 0};
+    loop();
+
+    EXPECT_EQ(moves + 1, motor->moves);
+    EXPECT_DOUBLE_EQ(40 * 6.0, motor->lastTargetDegrees);
+    EXPECT_DOUBLE_EQ(1000.0, motor->speedDps);
+    EXPECT_DOUBLE_EQ(5000.0, motor->accelerationDps2);
+}
+
+TEST_F(ClockHandCatchUpTest, ReturnsToTheTickProfileAndReportsTheDuration)
+{
+    timeProvider.time = {0, 0, 40, 0};
+    loop(10);
+
+    EXPECT_DOUBLE_EQ(100.0, motor->speedDps);
+    EXPECT_DOUBLE_EQ(100.0, motor->accelerationDps2);
+    EXPECT_EQ(1u, hand->getCatchUpCount());
+    // the fake motor needs three updates for a move
+    EXPECT_EQ(30u, hand->getLastCatchUpMs());
+    EXPECT_LE(hand->getMaxCatchUpMs(), hand->getCatchUpBoundMs());
+}
+
+TEST_F(ClockHandCatchUpTest, TimeSetBackIsACatchUp)
+{
+    timeProvider.time = {0, 0, 5, 0};
+    loop(10);
+
+    EXPECT_EQ(1u, hand->getCatchUpCount());
+    EXPECT_DOUBLE_EQ(5 * 6.0, motor->lastTargetDegrees);
+}
+
+TEST(ClockHandStepTableTest, TicksDifferByAtMostOneStep)
+{
+    NiceMock<soc::testing::LoggerMock> logger;
+    FakeTime timeProvider;
+    auto fake = std::make_unique<FakeStepperMotor>();
+    FakeStepperMotor *motor = fake.get();
+    // 359 degrees are 59.83 steps per second at 3600 steps per revolution
+    ClockHand hand(ClockHand::HandType::SECOND, timeProvider, std::move(fake), logger, 359.0, 0.0, 100.0, 100.0);
+    hand.setup();
+
+    long previous = 0;
+    for (int second = 0; second < 60; second++)
+    {
+        timeProvider.time = {0, 0, second, 0};
+        for (int i = 0; i < 10; i++)
+        {
+            hand.advanceState(0);
+        }
+        ASSERT_EQ(lround(second * 3590.0 / 60.0), motor->lastTargetSteps);
+        if (second > 0)
+        {
+            long spacing = motor->lastTargetSteps - previous;
+            EXPECT_TRUE(spacing == 59 || spacing == 60) << "second " << second << " spacing " << spacing;
+        }
+        previous = motor->lastTargetSteps;
+    }
+}
+
+TEST(ClockHandDialMappingTest, TicksFollowTheCalibratedDial)
+{
+    NiceMock<soc::testing::LoggerMock> logger;
+    FakeTime timeProvider;
+    auto fake = std::make_unique<FakeStepperMotor>();
+    FakeStepperMotor *motor = fake.get();
+    ClockHand hand(ClockHand::HandType::SECOND, timeProvider, std::move(fake), logger, 330.0, 0.0, 100.0, 100.0);
+    DialMapping compressed(60, {{0.0, 0.0}, {30.0, 240.0}, {60.0, 300.0}});
+    hand.setDialMapping(compressed);
+    hand.setup();
+
+    timeProvider.time = {0, 0, 45, 0};
+    for (int i = 0; i < 10; i++)
+    {
+        hand.advanceState(0);
+    }
+
+    EXPECT_EQ(lround(compressed.degreesAt(45.0) * 10.0), motor->lastTargetSteps);
+}
+
+TEST(ClockHandDialMappingTest, InvalidMappingKeepsTheLinearDial)
+{
+    NiceMock<soc::testing::LoggerMock> logger;
+    FakeTime timeProvider;
+    auto fake = std::make_unique<FakeStepperMotor>();
+    FakeStepperMotor *motor = fake.get();
+    ClockHand hand(ClockHand::HandType::SECOND, timeProvider, std::move(fake), logger, 330.0, 0.0, 100.0, 100.0);
+    EXPECT_CALL(logger, log_error(::testing::_)).Times(1);
+    hand.setDialMapping(DialMapping(12, {{0.0, 0.0}, {12.0, 300.0}}));
+    hand.setup();
+
+    timeProvider.time = {0, 0, 45, 0};
+    for (int i = 0; i < 10; i++)
+    {
+        hand.advanceState(0);
+    }
+
+    EXPECT_EQ(45 * 55, motor->lastTargetSteps);
+}
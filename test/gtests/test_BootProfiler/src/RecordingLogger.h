@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdarg>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <soc/api/ILogger.h>
+
+namespace soc
+{
+    namespace testing
+    {
+        /**
+         * @brief Keeps every formatted line with its level prefix, e.g. "INFO: ...".
+         */
+        class RecordingLogger : public soc::api::ILogger
+        {
+        public:
+            std::vector<std::string> lines;
+
+            void trace(const char *format, ...) override
+            {
+                va_list args;
+                va_start(args, format);
+                record("TRACE", format, args);
+                va_end(args);
+            }
+
+            void debug(const char *format, ...) override
+            {
+                va_list args;
+                va_start(args, format);
+                record("DEBUG", format, args);
+                va_end(args);
+            }
+
+            void info(const char *format, ...) override
+            {
+                va_list args;
+                va_start(args, format);
+                record("INFO", format, args);
+                va_end(args);
+            }
+
+            void warn(const char *format, ...) override
+            {
+                va_list args;
+                va_start(args, format);
+                record("WARN", format, args);
+                va_end(args);
+            }
+
+            void error(const char *format, ...) override
+            {
+                va_list args;
+                va_start(args, format);
+                record("ERROR", format, args);
+                va_end(args);
+            }
+
+        private:
+            void record(const char *level, const char *format, va_list args)
+            {
+                char buffer[256];
+                vsnprintf(buffer, sizeof(buffer), format, args);
+                lines.push_back(std::string(level) + ": " + buffer);
+            }
+        };
+    }
+}
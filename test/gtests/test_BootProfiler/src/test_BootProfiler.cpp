@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+#include <Arduino.h>
+#include <string>
+
+#include "RecordingLogger.h"
+#include "soc/trace/BootProfiler.h"
+
+using soc::trace::BootProfiler;
+
+class BootProfilerTest : public ::testing::Test
+{
+protected:
+    soc::testing::RecordingLogger logger;
+
+    void SetUp() override
+    {
+        virtualClock().reset();
+        // setup() starts some time after reset
+        virtualClock().advanceMicros(300000);
+    }
+
+    void TearDown() override
+    {
+        virtualClock().reset();
+    }
+
+    bool logged(const std::string &text) const
+    {
+        for (const std::string &line : logger.lines)
+        {
+            if (line.find(text) != std::string::npos)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+TEST_F(BootProfilerTest, SequentialPhases_NothingConcurrent)
+{
+    // arrange
+    BootProfiler profiler;
+
+    // act
+    int loggerPhase = profiler.begin("logger");
+    virtualClock().advanceMicros(1500);
+    profiler.end(loggerPhase);
+    int rtc = profiler.begin("rtc");
+    virtualClock().advanceMicros(2500);
+    profiler.end(rtc);
+
+    // assert
+    ASSERT_EQ(2u, profiler.getPhaseCount());
+    EXPECT_STREQ("rtc", profiler.getPhase(1).name);
+    EXPECT_EQ(301500UL, profiler.getPhase(1).startMicros);
+    EXPECT_EQ(304000UL, profiler.getPhase(1).endMicros);
+    EXPECT_EQ(4000UL, profiler.getTotalMicros());
+    EXPECT_EQ(4000UL, profiler.getCoveredMicros());
+}
+
+TEST_F(BootProfilerTest, OverlappingPhases_AreConcurrent)
+{
+    // arrange: the second hand homes for 3 s, the minute hand for 2 s, the time syncs meanwhile
+    BootProfiler profiler;
+
+    // act
+    int second = profiler.begin("second hand");
+    virtualClock().advanceMillis(100);
+    int minute = profiler.begin("minute hand");
+    int time = profiler.begin("time");
+    virtualClock().advanceMillis(5);
+    profiler.end(time);
+    virtualClock().advanceMillis(1995);
+    profiler.end(minute);
+    virtualClock().advanceMillis(900);
+    profiler.end(second);
+
+    // assert
+    EXPECT_EQ(3000000UL + 2000000UL + 5000UL, profiler.getTotalMicros());
+    EXPECT_EQ(3000000UL, profiler.getCoveredMicros());
+}
+
+TEST_F(BootProfilerTest, Gap_IsNotCovered)
+{
+    // arrange
+    BootProfiler profiler;
+
+    // act
+    int first = profiler.begin("first");
+    virtualClock().advanceMillis(10);
+    profiler.end(first);
+    virtualClock().advanceMillis(50);
+    int second = profiler.begin("second");
+    virtualClock().advanceMillis(20);
+    profiler.end(second);
+
+    // assert
+    EXPECT_EQ(30000UL, profiler.getCoveredMicros());
+}
+
+TEST_F(BootProfilerTest, Scope_EndsWithItsBlock)
+{
+    // arrange
+    BootProfiler profiler;
+
+    // act
+    {
+        BootProfiler::Scope phase(&profiler, "nvs");
+        virtualClock().advanceMicros(700);
+    }
+    {
+        BootProfiler::Scope nothing(nullptr, "ignored");
+    }
+
+    // assert
+    ASSERT_EQ(1u, profiler.getPhaseCount());
+    EXPECT_TRUE(profiler.getPhase(0).ended);
+    EXPECT_EQ(700UL, profiler.getTotalMicros());
+}
+
+TEST_F(BootProfilerTest, End_IgnoresInvalidAndEndedPhases)
+{
+    // arrange
+    BootProfiler profiler;
+    int phase = profiler.begin("motors");
+    virtualClock().advanceMicros(100);
+    profiler.end(phase);
+
+    // act
+    virtualClock().advanceMicros(100);
+    profiler.end(phase);
+    profiler.end(BootProfiler::NO_PHASE);
+    profiler.end(7);
+
+    // assert
+    EXPECT_EQ(100UL, profiler.getTotalMicros());
+}
+
+TEST_F(BootProfilerTest, Full_DropsTheFurtherPhases)
+{
+    // arrange
+    BootProfiler profiler;
+    for (size_t i = 0; i < BootProfiler::MAX_PHASES; i++)
+    {
+        profiler.end(profiler.begin("phase"));
+    }
+
+    // act
+    int dropped = profiler.begin("too many");
+    profiler.end(dropped);
+
+    // assert
+    EXPECT_EQ(BootProfiler::NO_PHASE, dropped);
+    EXPECT_EQ(BootProfiler::MAX_PHASES, profiler.getPhaseCount());
+    EXPECT_EQ(1u, profiler.getDroppedCount());
+}
+
+TEST_F(BootProfilerTest, Report_ListsThePhasesAndTheTotals)
+{
+    // arrange
+    BootProfiler profiler;
+    int clock = profiler.begin("AviatorClock");
+    int rtc = profiler.begin("rtc time");
+    virtualClock().advanceMicros(2500);
+    profiler.end(rtc);
+    virtualClock().advanceMillis(1000);
+    profiler.end(clock);
+    profiler.begin("still homing");
+
+    // act
+    profiler.report(logger);
+
+    // assert
+    ASSERT_EQ(5u, logger.lines.size());
+    EXPECT_EQ("INFO: Boot:      300.0       1002.5  AviatorClock", logger.lines[1]);
+    EXPECT_EQ("INFO: Boot:      300.0          2.5  rtc time", logger.lines[2]);
+    EXPECT_TRUE(logged("running  still homing"));
+    EXPECT_EQ("INFO: Boot: 3 phases, 1005.0 ms in total, 1002.5 ms covered, 2.5 ms concurrent.", logger.lines[4]);
+    EXPECT_FALSE(logged("WARN"));
+}
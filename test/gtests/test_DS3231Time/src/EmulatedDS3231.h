@@ -0,0 +1,122 @@
+#pragma once
+
+#include <Arduino.h>
+#include <cstdint>
+#include <soc/api/II2cBus.h>
+
+namespace soc
+{
+    namespace rtc
+    {
+        namespace testing
+        {
+            /**
+             * @brief A DS3231 on an I2C bus of its own, running on the virtual clock with
+             * a drift of its own. Counts every transfer on the bus.
+             */
+            class EmulatedDS3231 : public soc::api::II2cBus
+            {
+            public:
+                static const uint8_t ADDRESS = 0x68;
+
+                explicit EmulatedDS3231(uint64_t epochSeconds, double driftPpm = 0.0)
+                    : _driftPpm(driftPpm)
+                {
+                    setTime(epochSeconds * 1000ULL);
+                }
+
+                void begin() override {}
+
+                bool transfer(uint8_t address,
+                              const uint8_t *writeData, size_t writeLength,
+                              uint8_t *readData, size_t readLength) override
+                {
+                    transfers++;
+                    if (!present || address != ADDRESS)
+                    {
+                        return false;
+                    }
+                    if (writeLength > 0)
+                    {
+                        _pointer = writeData[0];
+                    }
+                    uint8_t registers[0x13] = {0};
+                    fillRegisters(registers);
+                    for (size_t i = 0; i < readLength; i++)
+                    {
+                        readData[i] = registers[_pointer];
+                        _pointer = (_pointer + 1) % sizeof(registers);
+                    }
+                    return true;
+                }
+
+                /**
+                 * @brief Sets the RTC, from now on it counts from epochMillis.
+                 */
+                void setTime(uint64_t epochMillis)
+                {
+                    _baseMillis = epochMillis;
+                    _baseMicros = virtualClock().nowMicros();
+                }
+
+                uint64_t nowMillis() const
+                {
+                    double elapsedMicros = static_cast<double>(virtualClock().nowMicros() - _baseMicros);
+                    return _baseMillis + static_cast<uint64_t>(elapsedMicros * (1.0 + _driftPpm / 1e6) / 1000.0);
+                }
+
+                bool present = true;      // false: no acknowledge
+                bool twelveHours = false; // the hours register in 12 hour mode
+                uint8_t status = 0x00;    // 0x80: the oscillator stopped
+                unsigned long transfers = 0;
+
+            private:
+                const double _driftPpm;
+                uint64_t _baseMillis = 0;
+                uint64_t _baseMicros = 0;
+                uint8_t _pointer = 0;
+
+                static uint8_t toBcd(unsigned value)
+                {
+                    return static_cast<uint8_t>(((value / 10) << 4) | (value % 10));
+                }
+
+                void fillRegisters(uint8_t *registers) const
+                {
+                    uint64_t seconds = nowMillis() / 1000ULL;
+                    unsigned secondOfDay = static_cast<unsigned>(seconds % 86400);
+                    long days = static_cast<long>(seconds / 86400);
+
+                    // the date of a day since 1970, see daysFromCivil() of DS3231Time
+                    days += 719468;
+                    long era = days / 146097;
+                    unsigned dayOfEra = static_cast<unsigned>(days - era * 146097);
+                    unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+                    unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+                    unsigned monthIndex = (5 * dayOfYear + 2) / 153;
+                    unsigned day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+                    unsigned month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+                    long year = static_cast<long>(yearOfEra) + era * 400 + (month <= 2);
+
+                    unsigned hours = secondOfDay / 3600;
+                    registers[0x00] = toBcd(secondOfDay % 60);
+                    registers[0x01] = toBcd(secondOfDay / 60 % 60);
+                    if (twelveHours)
+                    {
+                        unsigned hours12 = hours % 12 == 0 ? 12 : hours % 12;
+                        registers[0x02] = 0x40 | (hours >= 12 ? 0x20 : 0x00) | toBcd(hours12);
+                    }
+                    else
+                    {
+                        registers[0x02] = toBcd(hours);
+                    }
+                    registers[0x03] = static_cast<uint8_t>((days + 3) % 7 + 1); // day of the week, not used
+                    registers[0x04] = toBcd(day);
+                    registers[0x05] = toBcd(month) | (year >= 2100 ? 0x80 : 0x00);
+                    registers[0x06] = toBcd(static_cast<unsigned>(year % 100));
+                    registers[0x0F] = status;
+                }
+            };
+        }
+    }
+}
@@ -0,0 +1,331 @@
+#include <gtest/gtest.h>
+#include <Arduino.h>
+
+#include "EmulatedDS3231.h"
+#include "soc/rtc/DS3231Time.h"
+#include "soc/rtc/DriftCompensatedTime.h"
+#include "soc/rtc/RtcSync.h"
+#include "soc/esp32/ESP32Logger.h"
+#include "soc/esp32/ESP32MillisTime.h"
+#include "soc/esp32/ESP32PreferencesStore.h"
+
+using soc::rtc::DS3231Rtc;
+using soc::rtc::DS3231Time;
+using soc::rtc::testing::EmulatedDS3231;
+
+// 2026-10-19 13:45:30 UTC
+static const uint64_t BOOT_EPOCH_SECONDS = 1792417530ULL;
+
+class DS3231TimeTest : public ::testing::Test
+{
+protected:
+    static const unsigned long HOUR_MS = 3600000UL;
+
+    soc::esp32::ESP32Logger logger{soc::api::ILogger::ERROR_LEVEL};
+    soc::esp32::ESP32MillisTime uptime;
+
+    void SetUp() override
+    {
+        virtualClock().reset();
+        // the RTC is read some time after power up
+        virtualClock().advanceMillis(1234);
+    }
+
+    void TearDown() override
+    {
+        virtualClock().reset();
+    }
+
+    static soc::api::ITime::TimeComponents componentsOf(DS3231Time &time)
+    {
+        soc::api::ITime::TimeComponents components;
+        time.asTimeComponents(components);
+        return components;
+    }
+
+    // the shown time minus the time of the RTC
+    static int64_t errorMs(DS3231Time &time, const EmulatedDS3231 &rtc)
+    {
+        return static_cast<int64_t>(time.nowMillis()) - static_cast<int64_t>(rtc.nowMillis());
+    }
+};
+
+TEST_F(DS3231TimeTest, Begin_ShowsTheTimeOfTheRtc)
+{
+    // arrange
+    EmulatedDS3231 rtc(BOOT_EPOCH_SECONDS);
+    DS3231Rtc registers(rtc);
+    DS3231Time time(registers, uptime, logger);
+
+    // act
+    ASSERT_TRUE(time.begin());
+    virtualClock().advanceMillis(2000);
+
+    // assert: the middle of the second the RTC showed
+    soc::api::ITime::TimeComponents components = componentsOf(time);
+    EXPECT_EQ(13u, components.hours);
+    EXPECT_EQ(45, components.minutes);
+    EXPECT_EQ(32, components.seconds);
+    EXPECT_EQ(500, components.milliseconds);
+    EXPECT_EQ(BOOT_EPOCH_SECONDS * 1000 + 2500, time.nowMillis());
+    EXPECT_TRUE(time.isSynced());
+}
+
+TEST_F(DS3231TimeTest, LoopPath_DoesNotTouchTheBus)
+{
+    // arrange
+    EmulatedDS3231 rtc(BOOT_EPOCH_SECONDS);
+    DS3231Rtc registers(rtc);
+    DS3231Time time(registers, uptime, logger);
+    time.begin();
+    unsigned long bootTransfers = rtc.transfers;
+
+    // act: a loop every millisecond, across two resync intervals
+    soc::api::ITime::TimeComponents components;
+    for (unsigned long ms = 1; ms <= 2 * HOUR_MS + 1000; ms++)
+    {
+        virtualClock().advanceMillis(1);
+        time.asTimeComponents(components);
+        time.now();
+    }
+
+    // assert: the queries only extrapolate, the resync is overdue
+    EXPECT_EQ(bootTransfers, rtc.transfers);
+    EXPECT_EQ(1u, time.getResyncCount());
+    EXPECT_EQ(15u, components.hours);
+    EXPECT_EQ(45, components.minutes);
+
+    // the loop component reads the time registers once
+    soc::rtc::RtcSync sync(time);
+    sync.advanceState(millis());
+    sync.render();
+    sync.advanceState(millis());
+    time.asTimeComponents(components);
+    EXPECT_EQ(bootTransfers + 1, rtc.transfers);
+    EXPECT_EQ(2u, time.getResyncCount());
+    EXPECT_STREQ("rtc sync", sync.getName());
+}
+
+TEST_F(DS3231TimeTest, Sync_Degraded_PostponesTheResync)
+{
+    // arrange
+    EmulatedDS3231 rtc(BOOT_EPOCH_SECONDS);
+    DS3231Rtc registers(rtc);
+    DS3231Time time(registers, uptime, logger);
+    time.begin();
+    soc::rtc::RtcSync sync(time);
+    virtualClock().advanceMillis(HOUR_MS);
+
+    // act
+    sync.setDegraded(true);
+    sync.advanceState(millis());
+    unsigned long whileDegraded = time.getResyncCount();
+    sync.setDegraded(false);
+    sync.advanceState(millis());
+
+    // assert
+    EXPECT_FALSE(sync.isCritical());
+    EXPECT_EQ(1u, whileDegraded);
+    EXPECT_EQ(2u, time.getResyncCount());
+}
+
+TEST_F(DS3231TimeTest, LoopPath_OverTheDriftCompensation_DoesNotTouchTheBusOrTheFlash)
+{
+    // arrange: the composition of the firmware, both read the same RTC
+    fakeFlash().reset();
+    soc::esp32::ESP32PreferencesStore store("clock");
+    store.begin();
+    EmulatedDS3231 rtc(BOOT_EPOCH_SECONDS);
+    DS3231Rtc registers(rtc);
+    soc::rtc::DriftCompensatedTime::Config drift = soc::rtc::DriftCompensatedTime::defaultConfig();
+    drift.sampleIntervalMs = HOUR_MS / 4;
+    soc::rtc::DriftCompensatedTime compensatedUptime(uptime, registers, store, logger, drift);
+    compensatedUptime.begin();
+    DS3231Time time(registers, compensatedUptime, logger);
+    time.begin();
+    unsigned long bootTransfers = rtc.transfers;
+    unsigned long bootWrites = fakeFlash().writes;
+
+    // act: a loop every millisecond past the resync and three samples that are due
+    soc::api::ITime::TimeComponents components;
+    for (unsigned long ms = 1; ms <= HOUR_MS + 1000; ms++)
+    {
+        virtualClock().advanceMillis(1);
+        time.asTimeComponents(components);
+        time.now();
+    }
+
+    // assert
+    EXPECT_EQ(bootTransfers, rtc.transfers);
+    EXPECT_EQ(bootWrites, fakeFlash().writes);
+    EXPECT_EQ(1u, compensatedUptime.getSampleCount());
+
+    // the sample and the resync are left to the loop components
+    EXPECT_TRUE(compensatedUptime.update());
+    EXPECT_TRUE(time.update());
+    EXPECT_EQ(bootTransfers + 2, rtc.transfers);
+    fakeFlash().reset();
+}
+
+TEST_F(DS3231TimeTest, Resync_WithinTheSecondOfTheRtc_KeepsTheTime)
+{
+    // arrange
+    EmulatedDS3231 rtc(BOOT_EPOCH_SECONDS, 20.0);
+    DS3231Rtc registers(rtc);
+    DS3231Time time(registers, uptime, logger);
+    time.begin();
+
+    // act: 72 ms of drift in an hour
+    virtualClock().advanceMillis(HOUR_MS);
+    EXPECT_TRUE(time.update());
+    uint64_t shown = time.nowMillis();
+
+    // assert
+    EXPECT_EQ(BOOT_EPOCH_SECONDS * 1000 + 500 + HOUR_MS, shown);
+    EXPECT_EQ(0, time.getPendingCorrectionMs());
+    EXPECT_EQ(2u, time.getResyncCount());
+}
+
+TEST_F(DS3231TimeTest, Resync_SlewsASmallDisagreement)
+{
+    // arrange
+    DS3231Time::Config config = DS3231Time::defaultConfig();
+    EmulatedDS3231 rtc(BOOT_EPOCH_SECONDS);
+    DS3231Rtc registers(rtc);
+    DS3231Time time(registers, uptime, logger, config);
+    time.begin();
+    virtualClock().advanceMillis(HOUR_MS - 1);
+    rtc.setTime(rtc.nowMillis() + 1700);
+
+    // act
+    uint64_t previous = time.nowMillis();
+    virtualClock().advanceMillis(1);
+    EXPECT_TRUE(time.update());
+    uint64_t afterResync = time.nowMillis();
+
+    // assert: no jump, the seconds are 1 % longer until the RTC is reached
+    EXPECT_EQ(previous + 1, afterResync);
+    int64_t pending = time.getPendingCorrectionMs();
+    EXPECT_GE(pending, 1000);
+    EXPECT_LE(pending, 2000);
+    for (int step = 0; step < 30000; step++)
+    {
+        virtualClock().advanceMillis(10);
+        time.update();
+        uint64_t shown = time.nowMillis();
+        ASSERT_GE(shown, previous);
+        ASSERT_LE(shown - previous, 10u + 10u * config.slewPpm / 1000000u + 1u);
+        previous = shown;
+    }
+    EXPECT_EQ(0, time.getPendingCorrectionMs());
+    EXPECT_LT(errorMs(time, rtc), 1000);
+    EXPECT_GT(errorMs(time, rtc), -1000);
+}
+
+TEST_F(DS3231TimeTest, Resync_SetsALargeDisagreementAtOnce)
+{
+    // arrange: the RTC is set an hour ahead
+    EmulatedDS3231 rtc(BOOT_EPOCH_SECONDS);
+    DS3231Rtc registers(rtc);
+    DS3231Time time(registers, uptime, logger);
+    time.begin();
+    virtualClock().advanceMillis(HOUR_MS - 1);
+    rtc.setTime(rtc.nowMillis() + HOUR_MS);
+
+    // act
+    virtualClock().advanceMillis(1);
+    time.update();
+
+    // assert
+    EXPECT_EQ(15u, componentsOf(time).hours);
+    EXPECT_EQ(0, time.getPendingCorrectionMs());
+    EXPECT_LT(errorMs(time, rtc), 1000);
+    EXPECT_GT(errorMs(time, rtc), -1000);
+}
+
+TEST_F(DS3231TimeTest, Drift_StaysWithinASecondOfTheRtc)
+{
+    // arrange: the crystal of the ESP32 and the RTC part by 50 ppm
+    EmulatedDS3231 rtc(BOOT_EPOCH_SECONDS, -50.0);
+    DS3231Rtc registers(rtc);
+    DS3231Time time(registers, uptime, logger);
+    time.begin();
+
+    // act: two days, sampled every second
+    int64_t maxError = 0;
+    for (unsigned long second = 0; second < 2 * 86400UL; second++)
+    {
+        virtualClock().advanceMillis(1000);
+        time.update();
+        int64_t error = errorMs(time, rtc);
+        maxError = error > maxError ? error : (-error > maxError ? -error : maxError);
+    }
+
+    // assert: 180 ms of drift per hour on top of the second of the RTC
+    EXPECT_LT(maxError, 1000 + 180 + 1);
+    EXPECT_EQ(49u, time.getResyncCount());
+}
+
+TEST_F(DS3231TimeTest, MissingRtc_CountsFromMidnight_AndSyncsWhenItAnswers)
+{
+    // arrange
+    EmulatedDS3231 rtc(BOOT_EPOCH_SECONDS);
+    rtc.present = false;
+    DS3231Rtc registers(rtc);
+    DS3231Time time(registers, uptime, logger);
+
+    // act
+    EXPECT_FALSE(time.begin());
+    virtualClock().advanceMillis(60000);
+
+    // assert: the uptime
+    soc::api::ITime::TimeComponents components = componentsOf(time);
+    EXPECT_EQ(0u, components.hours);
+    EXPECT_EQ(1, components.minutes);
+    EXPECT_EQ(1, components.seconds);
+    EXPECT_FALSE(time.isSynced());
+    EXPECT_EQ(1u, time.getFailedReadCount());
+
+    // the next resync finds the RTC
+    rtc.present = true;
+    virtualClock().advanceMillis(HOUR_MS);
+    EXPECT_TRUE(time.update());
+    EXPECT_EQ(14u, componentsOf(time).hours);
+    EXPECT_TRUE(time.isSynced());
+}
+
+TEST_F(DS3231TimeTest, StoppedOscillator_IsNotTrusted)
+{
+    // arrange
+    EmulatedDS3231 rtc(BOOT_EPOCH_SECONDS);
+    rtc.status = 0x80;
+    DS3231Rtc registers(rtc);
+    DS3231Time time(registers, uptime, logger);
+
+    // act & assert
+    EXPECT_FALSE(time.begin());
+    EXPECT_EQ(0u, componentsOf(time).hours);
+    EXPECT_EQ(1u, rtc.transfers); // only the status
+}
+
+TEST_F(DS3231TimeTest, Registers_TwelveHourModeAndCentury)
+{
+    // arrange: 2099-12-31 23:59:59 in 12 hour mode, the century flips during the resync interval
+    EmulatedDS3231 rtc(4102444799ULL);
+    rtc.twelveHours = true;
+    DS3231Time::Config config = DS3231Time::defaultConfig();
+    config.resyncIntervalMs = 1000;
+    DS3231Rtc registers(rtc);
+    DS3231Time time(registers, uptime, logger, config);
+
+    // act & assert
+    ASSERT_TRUE(time.begin());
+    EXPECT_EQ(4102444799500ULL, time.nowMillis());
+    EXPECT_EQ(23u, componentsOf(time).hours);
+
+    virtualClock().advanceMillis(1000);
+    time.update();
+    EXPECT_EQ(4102444800500ULL, time.nowMillis());
+    EXPECT_EQ(0u, componentsOf(time).hours);
+    EXPECT_EQ(0, time.getPendingCorrectionMs());
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <cmath>
+
+#include "aviator-clock/DialMapping.h"
+
+using aviator_clock::DialMapping;
+
+// an aviator gauge: wide scale in the middle, compressed towards the stop
+static const std::vector<DialMapping::CalibrationPoint> GAUGE_POINTS = {
+    {0.0, 0.0},
+    {10.0, 40.0},
+    {40.0, 250.0},
+    {50.0, 295.0},
+    {55.0, 310.0},
+    {60.0, 318.0}};
+
+static uint32_t unitFixed(double unit)
+{
+    return static_cast<uint32_t>(unit * DialMapping::UNIT_ONE);
+}
+
+TEST(DialMappingTest, Linear_MatchesTheRoundedExactPositions)
+{
+    DialMapping mapping = DialMapping::linear(60, 0.0, 330.0);
+    mapping.bake(1600);
+
+    ASSERT_TRUE(mapping.isValid());
+    for (int unit = 0; unit <= 60; unit++)
+    {
+        EXPECT_EQ(lround(unit * 5.5 * 1600 / 360.0), mapping.stepsForUnit(unit)) << "unit " << unit;
+    }
+}
+
+TEST(DialMappingTest, Spline_PassesThroughTheCalibrationPoints)
+{
+    DialMapping mapping(60, GAUGE_POINTS);
+    mapping.bake(3600);
+
+    ASSERT_TRUE(mapping.isValid());
+    for (const DialMapping::CalibrationPoint &point : GAUGE_POINTS)
+    {
+        EXPECT_NEAR(point.degrees, mapping.degreesAt(point.unit), 1e-9);
+        EXPECT_EQ(lround(point.degrees * 10.0), mapping.stepsForUnit(static_cast<int>(point.unit)));
+    }
+}
+
+TEST(DialMappingTest, Spline_IsMonotoneAndDoesNotOvershoot)
+{
+    DialMapping mapping(60, GAUGE_POINTS);
+
+    double previous = mapping.degreesAt(0.0);
+    size_t segment = 0;
+    for (double unit = 0.01; unit <= 60.0; unit += 0.01)
+    {
+        while (unit > GAUGE_POINTS[segment + 1].unit)
+        {
+            segment++;
+        }
+        double degrees = mapping.degreesAt(unit);
+        EXPECT_GE(degrees, previous - 1e-9) << "unit " << unit;
+        EXPECT_GE(degrees, GAUGE_POINTS[segment].degrees - 1e-9) << "unit " << unit;
+        EXPECT_LE(degrees, GAUGE_POINTS[segment + 1].degrees + 1e-9) << "unit " << unit;
+        previous = degrees;
+    }
+}
+
+TEST(DialMappingTest, Spline_StaysFlatBetweenEqualPoints)
+{
+    DialMapping mapping(60, {{0.0, 0.0}, {10.0, 60.0}, {20.0, 60.0}, {60.0, 300.0}});
+
+    EXPECT_DOUBLE_EQ(60.0, mapping.degreesAt(12.5));
+    EXPECT_DOUBLE_EQ(60.0, mapping.degreesAt(17.5));
+}
+
+TEST(DialMappingTest, FractionalUnit_InterpolatesTheTable)
+{
+    DialMapping mapping = DialMapping::linear(60, 0.0, 360.0);
+    mapping.bake(3600);
+
+    // 10.5 units are 63 degrees, 630 steps
+    EXPECT_EQ(630 * DialMapping::SUB_STEPS, mapping.subStepsAt(unitFixed(10.5)));
+    EXPECT_EQ(60 * DialMapping::SUB_STEPS, mapping.subStepsPerUnitAt(unitFixed(10.5)));
+}
+
+TEST(DialMappingTest, FractionalUnit_FollowsTheSpline)
+{
+    DialMapping mapping(60, GAUGE_POINTS);
+    mapping.bake(3600);
+
+    for (double unit = 0.0; unit < 60.0; unit += 0.37)
+    {
+        double expected = mapping.degreesAt(unit) * 10.0 * DialMapping::SUB_STEPS;
+        // the table has four samples per unit, a chord of the spline is close enough
+        EXPECT_NEAR(expected, mapping.subStepsAt(unitFixed(unit)), 0.05 * 10.0 * DialMapping::SUB_STEPS) << "unit " << unit;
+    }
+}
+
+TEST(DialMappingTest, EndOfTheDial_IsClamped)
+{
+    DialMapping mapping(60, GAUGE_POINTS);
+    mapping.bake(3600);
+
+    EXPECT_EQ(3180 * DialMapping::SUB_STEPS, mapping.subStepsAt(unitFixed(60.0)));
+    EXPECT_EQ(3180, mapping.stepsForUnit(61));
+}
+
+TEST(DialMappingTest, InvalidPoints_AreRejected)
+{
+    EXPECT_FALSE(DialMapping(60, {{1.0, 0.0}, {60.0, 300.0}}).isValid());
+    EXPECT_FALSE(DialMapping(60, {{0.0, 0.0}, {50.0, 300.0}}).isValid());
+    EXPECT_FALSE(DialMapping(60, {{0.0, 0.0}, {30.0, 200.0}, {60.0, 150.0}}).isValid());
+    EXPECT_FALSE(DialMapping(60, {{0.0, 0.0}, {30.0, 100.0}, {30.0, 150.0}, {60.0, 300.0}}).isValid());
+    EXPECT_FALSE(DialMapping(60, {{0.0, 0.0}}).isValid());
+
+    DialMapping invalid(12, {{0.0, 0.0}});
+    invalid.bake(1600);
+    EXPECT_FALSE(invalid.isBaked());
+    EXPECT_EQ(0, invalid.stepsForUnit(6));
+}
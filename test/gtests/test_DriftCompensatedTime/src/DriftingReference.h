@@ -0,0 +1,68 @@
+#pragma once
+
+#include <Arduino.h>
+#include <cmath>
+#include <cstdint>
+#include <soc/api/IReferenceClock.h>
+
+namespace soc
+{
+    namespace rtc
+    {
+        namespace testing
+        {
+            /**
+             * @brief Stand-in for an RTC or a time server: runs on the virtual clock, which is
+             * the crystal of the SoC, with a drift of its own and reads in whole resolutions
+             * like an RTC reads in whole seconds.
+             */
+            class DriftingReference : public soc::api::IReferenceClock
+            {
+            public:
+                DriftingReference(uint64_t epochMillis, double driftPpm, unsigned long resolutionMs = 1000)
+                    : _driftPpm(driftPpm), _resolutionMs(resolutionMs)
+                {
+                    setTime(epochMillis);
+                }
+
+                bool readMillis(uint64_t &epochMillis) override
+                {
+                    reads++;
+                    if (!present)
+                    {
+                        return false;
+                    }
+                    epochMillis = nowMillis() / _resolutionMs * _resolutionMs + _resolutionMs / 2;
+                    return true;
+                }
+
+                unsigned long getResolutionMs() const override
+                {
+                    return _resolutionMs;
+                }
+
+                void setTime(uint64_t epochMillis)
+                {
+                    _baseMillis = epochMillis;
+                    _baseMicros = virtualClock().nowMicros();
+                }
+
+                // the true time of the reference
+                uint64_t nowMillis() const
+                {
+                    double elapsedMicros = static_cast<double>(virtualClock().nowMicros() - _baseMicros);
+                    return _baseMillis + static_cast<uint64_t>(std::floor(elapsedMicros * (1.0 + _driftPpm / 1e6) / 1000.0));
+                }
+
+                bool present = true;
+                unsigned long reads = 0;
+
+            private:
+                const double _driftPpm;
+                const unsigned long _resolutionMs;
+                uint64_t _baseMillis = 0;
+                uint64_t _baseMicros = 0;
+            };
+        }
+    }
+}
@@ -0,0 +1,335 @@
+#include <gtest/gtest.h>
+#include <Arduino.h>
+#include <Preferences.h>
+
+#include "DriftingReference.h"
+#include "soc/rtc/DriftCompensatedTime.h"
+#include "soc/rtc/DriftSampler.h"
+#include "soc/esp32/ESP32Logger.h"
+#include "soc/esp32/ESP32MillisTime.h"
+#include "soc/esp32/ESP32PreferencesStore.h"
+
+using soc::rtc::DriftCompensatedTime;
+using soc::rtc::testing::DriftingReference;
+
+// 2026-10-19 13:45:30.250 UTC
+static const uint64_t REFERENCE_EPOCH_MILLIS = 1792417530250ULL;
+
+class DriftCompensatedTimeTest : public ::testing::Test
+{
+protected:
+    static const unsigned long HOUR_MS = 3600000UL;
+    static const unsigned long DAY_MS = 24 * HOUR_MS;
+
+    soc::esp32::ESP32Logger logger{soc::api::ILogger::ERROR_LEVEL};
+    soc::esp32::ESP32MillisTime uptime;
+    soc::esp32::ESP32PreferencesStore store{"clock"};
+
+    void SetUp() override
+    {
+        virtualClock().reset();
+        fakeFlash().reset();
+        store.begin();
+    }
+
+    void TearDown() override
+    {
+        virtualClock().reset();
+        fakeFlash().reset();
+    }
+
+    // runs the loop every second, like a ticking second hand asks for the time
+    static void runFor(DriftCompensatedTime &time, unsigned long durationMs)
+    {
+        for (unsigned long elapsed = 0; elapsed < durationMs; elapsed += 1000)
+        {
+            virtualClock().advanceMillis(1000);
+            time.update();
+            time.now();
+        }
+    }
+
+    static double ppm(int64_t ppmQ16)
+    {
+        return static_cast<double>(ppmQ16) / DriftCompensatedTime::ONE_PPM;
+    }
+};
+
+TEST_F(DriftCompensatedTimeTest, Uncalibrated_FollowsTheUptime)
+{
+    // arrange
+    DriftingReference reference(REFERENCE_EPOCH_MILLIS, 30.0);
+    DriftCompensatedTime time(uptime, reference, store, logger);
+
+    // act
+    EXPECT_FALSE(time.begin());
+    virtualClock().advanceMillis(HOUR_MS + 1234);
+    time.update();
+
+    // assert
+    EXPECT_EQ(HOUR_MS + 1234, time.now());
+    soc::api::ITime::TimeComponents components;
+    time.asTimeComponents(components);
+    EXPECT_EQ(1u, components.hours);
+    EXPECT_EQ(1, components.seconds);
+    EXPECT_EQ(234, components.milliseconds);
+    EXPECT_EQ(DriftCompensatedTime::NOT_CALIBRATED, time.getUncertaintyPpmQ16());
+    EXPECT_EQ(2u, time.getSampleCount());
+}
+
+TEST_F(DriftCompensatedTimeTest, Learn_TheRateOfTheReference)
+{
+    // arrange: the crystal is 30 ppm slow
+    DriftingReference reference(REFERENCE_EPOCH_MILLIS, 30.0);
+    DriftCompensatedTime time(uptime, reference, store, logger);
+    time.begin();
+
+    // act: a day is not enough with a reference of one second
+    runFor(time, DAY_MS);
+    EXPECT_EQ(0, time.getCorrectionPpmQ16());
+    runFor(time, 2 * DAY_MS);
+
+    // assert
+    double uncertainty = ppm(time.getUncertaintyPpmQ16());
+    EXPECT_LE(uncertainty, 1000.0 * 1e6 / (3.0 * DAY_MS) + 0.01);
+    EXPECT_NEAR(30.0, ppm(time.getCorrectionPpmQ16()), uncertainty);
+    EXPECT_EQ(reference.reads, time.getSampleCount());
+    EXPECT_EQ(73u, time.getSampleCount());
+}
+
+TEST_F(DriftCompensatedTimeTest, Correction_KeepsStepWithTheReference)
+{
+    // arrange: learned a week ago
+    DriftingReference reference(REFERENCE_EPOCH_MILLIS, -42.0);
+    DriftCompensatedTime time(uptime, reference, store, logger);
+    time.begin();
+    runFor(time, 7 * DAY_MS);
+    int64_t start = static_cast<int64_t>(reference.nowMillis()) - static_cast<int64_t>(time.now());
+
+    // act: another week
+    runFor(time, 7 * DAY_MS);
+
+    // assert: 25 s a week without the correction, less than the resolution of the reference with it
+    int64_t drift = static_cast<int64_t>(reference.nowMillis()) - static_cast<int64_t>(time.now()) - start;
+    EXPECT_LT(drift < 0 ? -drift : drift, 1000);
+    EXPECT_NEAR(-42.0, ppm(time.getCorrectionPpmQ16()), 0.5);
+}
+
+TEST_F(DriftCompensatedTimeTest, Correction_IsContinuousAndMonotonic)
+{
+    // arrange
+    DriftingReference reference(REFERENCE_EPOCH_MILLIS, 150.0);
+    DriftCompensatedTime time(uptime, reference, store, logger);
+    time.begin();
+
+    // act & assert: the correction changes hourly, the time never jumps
+    unsigned long previous = time.now();
+    for (unsigned long ms = 0; ms < 3 * DAY_MS; ms += 100)
+    {
+        virtualClock().advanceMillis(100);
+        time.update();
+        unsigned long shown = time.now();
+        ASSERT_GE(shown - previous, 100u);
+        ASSERT_LE(shown - previous, 101u);
+        previous = shown;
+    }
+    EXPECT_NEAR(150.0, ppm(time.getCorrectionPpmQ16()), ppm(time.getUncertaintyPpmQ16()));
+}
+
+TEST_F(DriftCompensatedTimeTest, Reboot_AppliesTheSavedCorrection)
+{
+    // arrange: learned before the reboot
+    {
+        DriftingReference reference(REFERENCE_EPOCH_MILLIS, 23.5);
+        DriftCompensatedTime time(uptime, reference, store, logger);
+        time.begin();
+        runFor(time, 4 * DAY_MS);
+        ASSERT_GT(time.getSaveCount(), 0u);
+    }
+    virtualClock().reset();
+    DriftingReference reference(REFERENCE_EPOCH_MILLIS, 23.5);
+    soc::esp32::ESP32PreferencesStore rebootedStore("clock");
+    rebootedStore.begin();
+    DriftCompensatedTime time(uptime, reference, rebootedStore, logger);
+
+    // act
+    ASSERT_TRUE(time.begin());
+    runFor(time, DAY_MS);
+
+    // assert: the crystal loses 2 s a day, corrected from the first hour on
+    EXPECT_NEAR(23.5, ppm(time.getCorrectionPpmQ16()), ppm(time.getUncertaintyPpmQ16()));
+    int64_t error = static_cast<int64_t>(reference.nowMillis() - REFERENCE_EPOCH_MILLIS) - static_cast<int64_t>(time.now());
+    EXPECT_LT(error < 0 ? -error : error, 300);
+}
+
+TEST_F(DriftCompensatedTimeTest, Correction_InFixedPoint)
+{
+    // arrange: 12.5 ppm saved
+    DriftCompensatedTime::Calibration calibration = {DriftCompensatedTime::CALIBRATION_VERSION,
+                                                     25 * DriftCompensatedTime::ONE_PPM / 2,
+                                                     DriftCompensatedTime::ONE_PPM};
+    ASSERT_TRUE(store.save(DriftCompensatedTime::CALIBRATION_KEY, &calibration, sizeof(calibration)));
+    DriftingReference reference(REFERENCE_EPOCH_MILLIS, 12.5);
+    reference.present = false;
+    DriftCompensatedTime time(uptime, reference, store, logger);
+    time.begin();
+
+    // act & assert: 1.25 ms per 100 s, not rounded per sample
+    virtualClock().advanceMillis(100000);
+    EXPECT_EQ(100001u, time.now());
+    virtualClock().advanceMillis(100000000 - 100000);
+    time.update();
+    EXPECT_EQ(100001250u, time.now());
+    EXPECT_EQ(2u, time.getFailedSampleCount()); // at begin() and when due
+}
+
+TEST_F(DriftCompensatedTimeTest, Saves_AtMostOnceADay)
+{
+    // arrange
+    DriftingReference reference(REFERENCE_EPOCH_MILLIS, -8.0);
+    DriftCompensatedTime time(uptime, reference, store, logger);
+    time.begin();
+
+    // act: the rate gets more certain every hour
+    runFor(time, 10 * DAY_MS);
+
+    // assert
+    EXPECT_LE(time.getSaveCount(), 9u);
+    EXPECT_EQ(time.getSaveCount(), fakeFlash().writes);
+    DriftCompensatedTime::Calibration saved;
+    ASSERT_TRUE(store.load(DriftCompensatedTime::CALIBRATION_KEY, &saved, sizeof(saved)));
+    EXPECT_NEAR(-8.0, ppm(saved.correctionPpmQ16), ppm(saved.uncertaintyPpmQ16));
+}
+
+TEST_F(DriftCompensatedTimeTest, ReferenceSet_IsNotTakenForDrift)
+{
+    // arrange
+    DriftingReference reference(REFERENCE_EPOCH_MILLIS, 5.0);
+    DriftCompensatedTime time(uptime, reference, store, logger);
+    time.begin();
+    runFor(time, DAY_MS);
+
+    // act: somebody sets the reference an hour ahead
+    reference.setTime(reference.nowMillis() + HOUR_MS);
+    runFor(time, 3 * DAY_MS);
+
+    // assert: learned from the time after the jump
+    EXPECT_NEAR(5.0, ppm(time.getCorrectionPpmQ16()), ppm(time.getUncertaintyPpmQ16()));
+    EXPECT_LT(ppm(time.getUncertaintyPpmQ16()), 10.0);
+}
+
+TEST_F(DriftCompensatedTimeTest, TemperatureChange_ReplacesAMoreCertainCorrection)
+{
+    // arrange: a week at 10 ppm saved
+    DriftCompensatedTime::Calibration calibration = {DriftCompensatedTime::CALIBRATION_VERSION,
+                                                     10 * DriftCompensatedTime::ONE_PPM,
+                                                     DriftCompensatedTime::ONE_PPM * 2 / 3};
+    store.save(DriftCompensatedTime::CALIBRATION_KEY, &calibration, sizeof(calibration));
+    DriftingReference reference(REFERENCE_EPOCH_MILLIS, 35.0);
+    DriftCompensatedTime time(uptime, reference, store, logger);
+    ASSERT_TRUE(time.begin());
+
+    // act
+    runFor(time, 2 * DAY_MS);
+
+    // assert
+    EXPECT_NEAR(35.0, ppm(time.getCorrectionPpmQ16()), ppm(time.getUncertaintyPpmQ16()));
+}
+
+TEST_F(DriftCompensatedTimeTest, OtherFirmware_IgnoresTheRecord)
+{
+    // arrange
+    uint32_t old = 42;
+    store.save(DriftCompensatedTime::CALIBRATION_KEY, &old, sizeof(old));
+    DriftingReference reference(REFERENCE_EPOCH_MILLIS, 0.0);
+    DriftCompensatedTime time(uptime, reference, store, logger);
+
+    // act & assert
+    EXPECT_FALSE(time.begin());
+    EXPECT_EQ(0, time.getCorrectionPpmQ16());
+}
+
+TEST_F(DriftCompensatedTimeTest, Now_TouchesNeitherTheReferenceNorTheStore)
+{
+    // arrange
+    DriftingReference reference(REFERENCE_EPOCH_MILLIS, 30.0);
+    DriftCompensatedTime time(uptime, reference, store, logger);
+    time.begin();
+    unsigned long writes = fakeFlash().writes;
+
+    // act: the loop of a ticking clock for two days, without update()
+    soc::api::ITime::TimeComponents components;
+    for (unsigned long ms = 0; ms < 2 * DAY_MS; ms += 1000)
+    {
+        virtualClock().advanceMillis(1000);
+        time.now();
+        time.asTimeComponents(components);
+    }
+
+    // assert
+    EXPECT_EQ(1u, reference.reads);
+    EXPECT_EQ(writes, fakeFlash().writes);
+    EXPECT_EQ(48u, components.hours);
+}
+
+TEST_F(DriftCompensatedTimeTest, Update_ReadsAndSavesInSeparateCalls)
+{
+    // arrange: a rate is accepted after 28 hours
+    DriftingReference reference(REFERENCE_EPOCH_MILLIS, 30.0);
+    DriftCompensatedTime time(uptime, reference, store, logger);
+    time.begin();
+    for (unsigned long hours = 0; time.getUncertaintyPpmQ16() == DriftCompensatedTime::NOT_CALIBRATED; hours++)
+    {
+        ASSERT_LT(hours, 48u);
+        virtualClock().advanceMillis(HOUR_MS);
+        EXPECT_TRUE(time.update());
+    }
+    unsigned long reads = reference.reads;
+
+    // act & assert: the save follows in the next call, then there is nothing to do
+    EXPECT_EQ(0u, time.getSaveCount());
+    EXPECT_TRUE(time.update());
+    EXPECT_EQ(1u, time.getSaveCount());
+    EXPECT_EQ(reads, reference.reads);
+    EXPECT_FALSE(time.update());
+}
+
+TEST_F(DriftCompensatedTimeTest, Sampler_UpdatesFromTheLoop)
+{
+    // arrange
+    DriftingReference reference(REFERENCE_EPOCH_MILLIS, 30.0);
+    DriftCompensatedTime time(uptime, reference, store, logger);
+    time.begin();
+    soc::rtc::DriftSampler sampler(time);
+
+    // act
+    virtualClock().advanceMillis(HOUR_MS);
+    sampler.advanceState(millis());
+    sampler.render();
+
+    // assert
+    EXPECT_EQ(2u, time.getSampleCount());
+    EXPECT_STREQ("drift compensation", sampler.getName());
+}
+
+TEST_F(DriftCompensatedTimeTest, Sampler_Degraded_PostponesTheUpdate)
+{
+    // arrange
+    DriftingReference reference(REFERENCE_EPOCH_MILLIS, 30.0);
+    DriftCompensatedTime time(uptime, reference, store, logger);
+    time.begin();
+    soc::rtc::DriftSampler sampler(time);
+    virtualClock().advanceMillis(HOUR_MS);
+
+    // act
+    sampler.setDegraded(true);
+    sampler.advanceState(millis());
+    unsigned long whileDegraded = time.getSampleCount();
+    sampler.setDegraded(false);
+    sampler.advanceState(millis());
+
+    // assert
+    EXPECT_FALSE(sampler.isCritical());
+    EXPECT_EQ(1u, whileDegraded);
+    EXPECT_EQ(2u, time.getSampleCount());
+}
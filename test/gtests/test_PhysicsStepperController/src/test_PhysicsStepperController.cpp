@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include <Arduino.h>
+
+#include "stepper/sim/SimulatedStepperController.h"
+#include "stepper/sim/PhysicsStepperController.h"
+
+using stepper::sim::PhysicsStepperController;
+using stepper::sim::SimulatedStepperController;
+
+class PhysicsStepperControllerTest : public ::testing::Test
+{
+protected:
+    static const unsigned long LOOP_MICROS = 20;
+
+    std::unique_ptr<SimulatedStepperController> stepGenerator;
+    std::unique_ptr<PhysicsStepperController> motor;
+
+    void SetUp() override
+    {
+        virtualClock().reset();
+        stepGenerator = std::make_unique<SimulatedStepperController>();
+        motor = std::make_unique<PhysicsStepperController>(*stepGenerator, PhysicsStepperController::defaultConfig());
+    }
+
+    void TearDown() override
+    {
+        virtualClock().reset();
+    }
+
+    // runs the move like the main loop does and lets the rotor settle afterwards
+    void runMove(float speed, float acceleration, long targetSteps)
+    {
+        motor->setMaxSpeed(speed);
+        motor->setAcceleration(acceleration);
+        motor->moveTo(targetSteps);
+        while (motor->run())
+        {
+            virtualClock().advanceMicros(LOOP_MICROS);
+        }
+        virtualClock().advanceMillis(500);
+        motor->settle();
+    }
+};
+
+TEST_F(PhysicsStepperControllerTest, GentleMove_FollowsWithoutLosingSteps)
+{
+    // act
+    runMove(1600, 8000, 1600);
+
+    // assert
+    EXPECT_EQ(motor->getCommandedRotorPosition(), 1600);
+    EXPECT_NEAR(motor->getExactRotorPosition(), 1600.0, 1.0);
+    EXPECT_EQ(motor->getLostSteps(), 0);
+    EXPECT_EQ(motor->getSlipEvents(), 0u);
+    EXPECT_EQ(motor->getUnfollowableSteps(), 0u);
+    EXPECT_TRUE(motor->isAtRest());
+}
+
+TEST_F(PhysicsStepperControllerTest, ClockTickProfile_LosesNoSteps)
+{
+    // 2400 deg/s and 60000 deg/s^2 at 1600 steps per revolution, one second tick
+    for (int tick = 1; tick <= 10; tick++)
+    {
+        runMove(10666, 266666, tick * 24);
+    }
+
+    EXPECT_EQ(motor->getLostSteps(), 0);
+    EXPECT_NEAR(motor->getExactRotorPosition(), 240.0, 1.0);
+}
+
+TEST_F(PhysicsStepperControllerTest, AccelerationBeyondTorque_IsDetectedAsLostSteps)
+{
+    // act: the rotor cannot accelerate the load this fast
+    runMove(40000, 20000000, 3200);
+
+    // assert
+    EXPECT_GT(motor->getUnfollowableSteps(), 0u);
+    EXPECT_GT(motor->getSlipEvents(), 0u);
+    EXPECT_NE(motor->getLostSteps(), 0);
+    EXPECT_EQ(motor->getLostSteps() % 32, 0); // whole electrical periods (4 full steps * 8 microsteps)
+    EXPECT_NEAR(motor->getExactRotorPosition(), 3200.0 - motor->getLostSteps(), 1.0);
+}
+
+TEST_F(PhysicsStepperControllerTest, DisabledOutputs_RotorDoesNotFollow)
+{
+    // arrange
+    motor->disableOutputs();
+
+    // act
+    runMove(1600, 8000, 400);
+
+    // assert
+    EXPECT_EQ(motor->getCommandedRotorPosition(), 400);
+    EXPECT_NEAR(motor->getExactRotorPosition(), 0.0, 1.0);
+}
+
+TEST_F(PhysicsStepperControllerTest, AverageCurrent_FollowsTheEnabledTime)
+{
+    // arrange
+    motor->resetStatistics();
+
+    // act: enabled for one second, disabled for three
+    virtualClock().advanceMillis(1000);
+    motor->disableOutputs();
+    virtualClock().advanceMillis(3000);
+
+    // assert: two phases at the rated current for a quarter of the time
+    EXPECT_EQ(motor->getEnabledMicros(), 1000000UL);
+    EXPECT_NEAR(motor->getAverageCurrentA(), 2.0 * PhysicsStepperController::defaultConfig().ratedCurrentA / 4.0, 1e-9);
+}
+
+TEST_F(PhysicsStepperControllerTest, SetCurrentPosition_DoesNotMoveTheRotor)
+{
+    // arrange
+    runMove(1600, 8000, 800);
+
+    // act
+    motor->setCurrentPosition(0);
+
+    // assert
+    EXPECT_EQ(motor->getCurrentPosition(), 0);
+    EXPECT_EQ(motor->getRotorPosition(), 800);
+}
+
+TEST_F(PhysicsStepperControllerTest, CoilEnergy_ScalesWithTheSquareOfTheDuty)
+{
+    // arrange
+    PhysicsStepperController::Config config = PhysicsStepperController::defaultConfig();
+    double ratedPowerW = 2.0 * config.ratedCurrentA * config.ratedCurrentA * config.phaseResistanceOhm;
+    motor->resetStatistics();
+
+    // act: one second at the rated current, one at a 30 % hold current
+    virtualClock().advanceMillis(1000);
+    motor->setDuty(300);
+    virtualClock().advanceMillis(1000);
+
+    // assert: the current decays with the coil time constant
+    double decayJ = ratedPowerW * (config.currentRiseMicros * 1e-6);
+    EXPECT_NEAR(motor->getCurrentFraction(), 0.3, 1e-9);
+    EXPECT_NEAR(motor->getEnergyJ(), ratedPowerW * (1.0 + 0.09), decayJ);
+    EXPECT_NEAR(motor->getAverageCurrentA(), 2.0 * config.ratedCurrentA * 1.3 / 2.0, 0.001);
+    EXPECT_EQ(motor->getEnabledMicros(), 2000000UL);
+    EXPECT_NEAR(motor->getAveragePowerFraction(), (1.0 + 0.09) / 2.0, decayJ / ratedPowerW / 2.0);
+}
+
+TEST_F(PhysicsStepperControllerTest, SlowCurrentRise_StepsNeedAWakeLeadAfterEnabling)
+{
+    // a coil that needs 3 ms to build up the current
+    PhysicsStepperController::Config config = PhysicsStepperController::defaultConfig();
+    config.currentRiseMicros = 3000;
+    for (unsigned long wakeLeadMicros : {0UL, 5 * config.currentRiseMicros})
+    {
+        virtualClock().reset();
+        stepGenerator = std::make_unique<SimulatedStepperController>();
+        motor = std::make_unique<PhysicsStepperController>(*stepGenerator, config);
+        motor->disableOutputs();
+        virtualClock().advanceMillis(100);
+
+        // act: an aggressive tick right after enabling, or after the lead
+        motor->enableOutputs();
+        virtualClock().advanceMicros(wakeLeadMicros);
+        runMove(10666, 3000000, 24);
+
+        // assert
+        if (wakeLeadMicros == 0)
+        {
+            EXPECT_GT(motor->getUnfollowableSteps(), 0u);
+        }
+        else
+        {
+            EXPECT_EQ(motor->getUnfollowableSteps(), 0u);
+            EXPECT_EQ(motor->getLostSteps(), 0);
+            EXPECT_NEAR(motor->getExactRotorPosition(), 24.0, 1.0);
+        }
+    }
+}
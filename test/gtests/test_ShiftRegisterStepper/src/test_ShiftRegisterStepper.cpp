@@ -0,0 +1,305 @@
+#include <gtest/gtest.h>
+#include <Arduino.h>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include "stepper/shift/ShiftRegisterStepperBank.h"
+#include "stepper/sim/SimulatedShiftRegisterChain.h"
+#include "stepper/sim/SimulatedStepperController.h"
+#include "stepper/sim/RecordingStepperController.h"
+#include "stepper/accel/AccelStepperMotor.h"
+#include "stepper/homing/NoHomingStrategy.h"
+#include "soc/esp32/ESP32Logger.h"
+
+using stepper::shift::ShiftRegisterStepperBank;
+using stepper::shift::ShiftRegisterStepperController;
+using stepper::sim::RecordingStepperController;
+using stepper::sim::SimulatedShiftRegisterChain;
+using stepper::sim::SimulatedStepperController;
+
+class ShiftRegisterStepperTest : public ::testing::Test
+{
+protected:
+    static const unsigned long LOOP_MICROS = 20;
+    static const size_t MOTORS = 40;
+
+    std::unique_ptr<SimulatedShiftRegisterChain> chain;
+    std::unique_ptr<ShiftRegisterStepperBank> bank;
+
+    void SetUp() override
+    {
+        virtualClock().reset();
+        createBank(MOTORS);
+    }
+
+    void TearDown() override
+    {
+        virtualClock().reset();
+    }
+
+    void createBank(size_t motors, bool enableActiveLow = false)
+    {
+        chain = std::make_unique<SimulatedShiftRegisterChain>(motors, enableActiveLow);
+        bank = std::make_unique<ShiftRegisterStepperBank>(*chain, motors);
+        bank->begin();
+    }
+
+    // one main loop: the bank steps, then every motor polls its controller
+    bool loopOnce()
+    {
+        bank->run();
+        bool running = false;
+        for (size_t motor = 0; motor < bank->getMotorCount(); motor++)
+        {
+            running |= bank->controller(motor).run();
+        }
+        virtualClock().advanceMicros(LOOP_MICROS);
+        return running;
+    }
+
+    void runUntilIdle()
+    {
+        while (loopOnce())
+        {
+        }
+        // the last burst
+        loopOnce();
+    }
+
+    void expectCleanPulses(size_t motor)
+    {
+        const SimulatedShiftRegisterChain::MotorRecord &record = chain->getMotor(motor);
+        EXPECT_EQ(0u, record.dirSetupViolations) << "motor " << motor;
+        EXPECT_EQ(0u, record.openPulses) << "motor " << motor;
+        EXPECT_EQ(0u, record.stepsWhileDisabled) << "motor " << motor;
+    }
+};
+
+TEST_F(ShiftRegisterStepperTest, FortyMotors_ReachTheirTargetsWithCleanPulses)
+{
+    // arrange: every motor with its own profile and direction
+    std::vector<long> targets;
+    for (size_t motor = 0; motor < MOTORS; motor++)
+    {
+        long distance = 100 + 10 * static_cast<long>(motor);
+        targets.push_back(motor % 2 ? distance : -distance);
+        ShiftRegisterStepperController &controller = bank->controller(motor);
+        controller.setMaxSpeed(400.0f + 50.0f * motor);
+        controller.setAcceleration(2000.0f + 500.0f * motor);
+        controller.moveTo(targets.back());
+    }
+
+    // act
+    runUntilIdle();
+
+    // assert
+    unsigned long totalSteps = 0;
+    for (size_t motor = 0; motor < MOTORS; motor++)
+    {
+        EXPECT_EQ(targets[motor], bank->controller(motor).getCurrentPosition()) << "motor " << motor;
+        EXPECT_EQ(targets[motor], chain->getMotor(motor).position) << "motor " << motor;
+        EXPECT_EQ(static_cast<unsigned long>(labs(targets[motor])), chain->getMotor(motor).steps) << "motor " << motor;
+        expectCleanPulses(motor);
+        totalSteps += chain->getMotor(motor).steps;
+    }
+    EXPECT_EQ(totalSteps, bank->getStepCount());
+    EXPECT_EQ(chain->getBurstCount(), bank->getBurstCount());
+    EXPECT_EQ(0u, chain->getMalformedBursts());
+}
+
+TEST_F(ShiftRegisterStepperTest, StepTiming_MatchesTheSimulatedController)
+{
+    // arrange: the same moves on a controller that steps on its own
+    const size_t motors = 32;
+    createBank(motors);
+    std::vector<std::unique_ptr<SimulatedStepperController>> references;
+    std::vector<std::unique_ptr<RecordingStepperController>> recorders;
+    for (size_t motor = 0; motor < motors; motor++)
+    {
+        references.push_back(std::make_unique<SimulatedStepperController>());
+        recorders.push_back(std::make_unique<RecordingStepperController>(*references.back()));
+
+        float speed = 800.0f + 100.0f * motor;
+        float acceleration = 4000.0f + 1000.0f * motor;
+        long target = motor % 3 == 0 ? -300 : 300;
+        for (stepper::api::IStepperController *controller :
+             {static_cast<stepper::api::IStepperController *>(&bank->controller(motor)),
+              static_cast<stepper::api::IStepperController *>(recorders.back().get())})
+        {
+            controller->setMaxSpeed(speed);
+            controller->setAcceleration(acceleration);
+            controller->moveTo(target);
+        }
+    }
+
+    // act
+    bool running = true;
+    while (running)
+    {
+        running = false;
+        bank->run();
+        for (size_t motor = 0; motor < motors; motor++)
+        {
+            running |= bank->controller(motor).run();
+            running |= recorders[motor]->run();
+        }
+        virtualClock().advanceMicros(LOOP_MICROS);
+    }
+    bank->run();
+
+    // assert: the same steps at the same intervals. A move away from the initial
+    // direction starts one loop later, the bank latches the direction first.
+    for (size_t motor = 0; motor < motors; motor++)
+    {
+        const std::vector<unsigned long> &stepTimes = chain->getMotor(motor).stepTimes;
+        const std::vector<RecordingStepperController::StepRecord> &reference = recorders[motor]->getSteps();
+        ASSERT_EQ(reference.size(), stepTimes.size()) << "motor " << motor;
+        for (size_t i = 1; i < stepTimes.size(); i++)
+        {
+            EXPECT_EQ(reference[i].timeMicros - reference[0].timeMicros, stepTimes[i] - stepTimes[0])
+                << "motor " << motor << " step " << i;
+        }
+        EXPECT_EQ(reference.back().position, chain->getMotor(motor).position);
+        expectCleanPulses(motor);
+    }
+}
+
+TEST_F(ShiftRegisterStepperTest, Reversal_LatchesTheDirectionBeforeTheStep)
+{
+    // arrange
+    for (size_t motor = 0; motor < MOTORS; motor++)
+    {
+        ShiftRegisterStepperController &controller = bank->controller(motor);
+        controller.setMaxSpeed(2000);
+        controller.setAcceleration(20000);
+        controller.moveTo(200);
+    }
+    for (int loop = 0; loop < 2000; loop++)
+    {
+        loopOnce();
+    }
+
+    // act: turn around at full speed
+    for (size_t motor = 0; motor < MOTORS; motor++)
+    {
+        bank->controller(motor).moveTo(-200);
+    }
+    runUntilIdle();
+
+    // assert
+    for (size_t motor = 0; motor < MOTORS; motor++)
+    {
+        EXPECT_EQ(-200, chain->getMotor(motor).position) << "motor " << motor;
+        expectCleanPulses(motor);
+    }
+}
+
+TEST_F(ShiftRegisterStepperTest, ConstantSpeed_StepsAllMotorsInOneBurstPerTick)
+{
+    // arrange
+    for (size_t motor = 0; motor < MOTORS; motor++)
+    {
+        ShiftRegisterStepperController &controller = bank->controller(motor);
+        controller.setMaxSpeed(1000);
+        controller.setSpeed(1000);
+    }
+    unsigned long burstsBefore = chain->getBurstCount();
+
+    // act: one second at 1000 steps per second
+    for (unsigned long elapsed = 0; elapsed < 1000000UL; elapsed += LOOP_MICROS)
+    {
+        bank->run();
+        for (size_t motor = 0; motor < MOTORS; motor++)
+        {
+            bank->controller(motor).runSpeed();
+        }
+        virtualClock().advanceMicros(LOOP_MICROS);
+    }
+
+    // assert: all motors share every burst, plus the one latching the direction
+    for (size_t motor = 0; motor < MOTORS; motor++)
+    {
+        EXPECT_NEAR(1000.0, chain->getMotor(motor).steps, 1.0) << "motor " << motor;
+        expectCleanPulses(motor);
+    }
+    EXPECT_LE(chain->getBurstCount() - burstsBefore, 1002u);
+    EXPECT_EQ(2 * (chain->getBurstCount() - burstsBefore) - 1, chain->getLatchCount() - 1);
+}
+
+TEST_F(ShiftRegisterStepperTest, IdleLoops_DoNotTouchTheBus)
+{
+    // act
+    for (int loop = 0; loop < 1000; loop++)
+    {
+        loopOnce();
+    }
+
+    // assert: only the initial state from begin()
+    EXPECT_EQ(1u, chain->getBurstCount());
+}
+
+TEST_F(ShiftRegisterStepperTest, Wiring_MotorNibblesFollowTheChainOrder)
+{
+    // arrange: an odd motor count leaves the upper nibble of the last register unused
+    createBank(5);
+
+    // act
+    bank->controller(1).setPinsInverted(true, false, false);
+    bank->controller(4).disableOutputs();
+    bank->run();
+
+    // assert
+    ASSERT_EQ(3u, chain->getRegisterCount());
+    EXPECT_EQ(0x64, chain->getRegisterOutputs(0)); // motor 1 with inverted dir, motor 0
+    EXPECT_EQ(0x44, chain->getRegisterOutputs(1));
+    EXPECT_EQ(0x00, chain->getRegisterOutputs(2)); // motor 4 disabled
+    EXPECT_FALSE(chain->isEnabled(4));
+    EXPECT_TRUE(chain->getDirection(1));
+}
+
+TEST_F(ShiftRegisterStepperTest, AccelStepperMotors_DriveTheBankLikeDirectPins)
+{
+    // arrange: 32 motors with active low enable pins on the chain
+    const size_t motors = 32;
+    createBank(motors, true);
+    soc::esp32::ESP32Logger logger(soc::api::ILogger::ERROR_LEVEL);
+    stepper::homing::NoHomingStrategy homing;
+    std::vector<std::unique_ptr<stepper::accel::AccelStepperMotor>> steppers;
+    for (size_t motor = 0; motor < motors; motor++)
+    {
+        steppers.push_back(std::make_unique<stepper::accel::AccelStepperMotor>(
+            bank->controller(motor), 1600, homing, logger, 0, true));
+        steppers.back()->home();
+    }
+    for (auto &stepper : steppers)
+    {
+        stepper->update();
+        stepper->setSpeed(360.0);
+        stepper->setAcceleration(3600.0);
+        stepper->moveToAbsolute(90.0);
+    }
+
+    // act
+    bool busy = true;
+    while (busy)
+    {
+        busy = false;
+        bank->run();
+        for (auto &stepper : steppers)
+        {
+            stepper->update();
+            busy |= stepper->isBusy();
+        }
+        virtualClock().advanceMicros(LOOP_MICROS);
+    }
+    bank->run();
+
+    // assert: 90 degrees are 400 microsteps
+    for (size_t motor = 0; motor < motors; motor++)
+    {
+        EXPECT_EQ(400, chain->getMotor(motor).position) << "motor " << motor;
+        EXPECT_TRUE(chain->isEnabled(motor));
+        expectCleanPulses(motor);
+    }
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <Arduino.h>
+
+#include "stepper/sim/LoopLatencyModel.h"
+#include "stepper/sim/RecordingStepperController.h"
+#include "stepper/sim/SimulatedStepperController.h"
+#include "stepper/sim/StepJitterAnalyzer.h"
+
+using namespace stepper::sim;
+
+class StepJitterAnalyzerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        virtualClock().reset();
+    }
+
+    void TearDown() override
+    {
+        virtualClock().reset();
+    }
+
+    // drives ten clock ticks through the recorder with the given loop latency
+    StepJitterAnalyzer::Report analyzeTicks(LoopLatencyModel latency)
+    {
+        SimulatedStepperController stepGenerator;
+        RecordingStepperController recorder(stepGenerator);
+        StepJitterAnalyzer analyzer;
+
+        recorder.setMaxSpeed(10666);
+        recorder.setAcceleration(266666);
+        for (int tick = 1; tick <= 10; tick++)
+        {
+            recorder.moveTo(tick * 240);
+            while (recorder.run())
+            {
+                virtualClock().advanceMicros(latency.next());
+            }
+            analyzer.addMoves(recorder);
+            recorder.clear();
+        }
+        return analyzer.getReport();
+    }
+};
+
+TEST_F(StepJitterAnalyzerTest, IdealTime_TriangularProfile_IsSymmetric)
+{
+    double total = StepJitterAnalyzer::idealTime(100, 100, 1e9, 1000);
+
+    EXPECT_NEAR(StepJitterAnalyzer::idealTime(50, 100, 1e9, 1000), total / 2.0, 1e-9);
+    EXPECT_NEAR(total, 2.0 * sqrt(100.0 / 1000.0), 1e-9);
+}
+
+TEST_F(StepJitterAnalyzerTest, IdealTime_TrapezoidalProfile_CruisesAtMaxSpeed)
+{
+    // 100 steps/s reached after 1 s and 50 steps, cruise 100 steps, decelerate 50 steps
+    EXPECT_NEAR(StepJitterAnalyzer::idealTime(50, 200, 100, 100), 1.0, 1e-9);
+    EXPECT_NEAR(StepJitterAnalyzer::idealTime(150, 200, 100, 100), 2.0, 1e-9);
+    EXPECT_NEAR(StepJitterAnalyzer::idealTime(200, 200, 100, 100), 3.0, 1e-9);
+}
+
+TEST_F(StepJitterAnalyzerTest, RecordsEveryStepOfAMove)
+{
+    SimulatedStepperController stepGenerator;
+    RecordingStepperController recorder(stepGenerator);
+    recorder.setMaxSpeed(1000);
+    recorder.setAcceleration(5000);
+
+    recorder.moveTo(100);
+    while (recorder.run())
+    {
+        virtualClock().advanceMicros(10);
+    }
+
+    ASSERT_EQ(recorder.getMoves().size(), 1u);
+    EXPECT_EQ(recorder.getMoves()[0].stepCount, 100u);
+    EXPECT_TRUE(recorder.getMoves()[0].fromStandstill);
+    EXPECT_FALSE(recorder.getMoves()[0].interrupted);
+    EXPECT_EQ(recorder.getSteps().back().position, 100);
+}
+
+TEST_F(StepJitterAnalyzerTest, StoppedMove_IsSkipped)
+{
+    SimulatedStepperController stepGenerator;
+    RecordingStepperController recorder(stepGenerator);
+    StepJitterAnalyzer analyzer;
+    recorder.setMaxSpeed(1000);
+    recorder.setAcceleration(5000);
+
+    recorder.moveTo(1000);
+    for (int i = 0; i < 1000; i++)
+    {
+        recorder.run();
+        virtualClock().advanceMicros(10);
+    }
+    recorder.stop();
+    while (recorder.run())
+    {
+        virtualClock().advanceMicros(10);
+    }
+    analyzer.addMoves(recorder);
+
+    EXPECT_EQ(analyzer.getReport().moves, 0u);
+    EXPECT_GE(analyzer.getReport().skippedMoves, 1u);
+}
+
+TEST_F(StepJitterAnalyzerTest, SpikyLoopLatency_ShowsUpAsJitterAndGaps)
+{
+    // act
+    StepJitterAnalyzer::Report smooth = analyzeTicks(LoopLatencyModel::constant(2));
+    StepJitterAnalyzer::Report spiky = analyzeTicks(LoopLatencyModel::spiky(2, 0.01, 3000, 7));
+
+    // assert
+    EXPECT_EQ(smooth.moves, 10u);
+    EXPECT_EQ(spiky.moves, 10u);
+    EXPECT_GT(spiky.p99IntervalErrorMicros, smooth.p99IntervalErrorMicros);
+    EXPECT_GT(spiky.maxGapMicros, 3000u);
+    EXPECT_LT(smooth.maxGapMicros, 2000u); // the first interval of a ramp is the longest
+    EXPECT_GT(spiky.meanVelocityErrorPercent, smooth.meanVelocityErrorPercent);
+}
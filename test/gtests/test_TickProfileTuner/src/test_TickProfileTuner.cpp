@@ -0,0 +1,295 @@
+#include <gtest/gtest.h>
+#include <Arduino.h>
+#include <Preferences.h>
+#include <memory>
+
+#include "aviator-clock/AviatorClock.h"
+#include "aviator-clock/TickProfileTuner.h"
+#include "aviator-clock/TickProfileTuning.h"
+#include "soc/esp32/ESP32Logger.h"
+#include "soc/esp32/ESP32PreferencesStore.h"
+#include "soc/esp32/ESP32Soc.h"
+#include "stepper/accel/AccelStepperMotor.h"
+#include "stepper/homing/LimitSwitchHomingStrategy.h"
+#include "stepper/sim/PhysicsStepperController.h"
+#include "stepper/sim/SimulatedLimitSwitch.h"
+#include "stepper/sim/SimulatedStepperController.h"
+#include "stepper/sim/StepLossStepperController.h"
+
+using aviator_clock::TickProfileTuner;
+using stepper::sim::StepLossStepperController;
+
+class TickProfileTunerTest : public ::testing::Test
+{
+protected:
+    static const long STEPS_PER_REVOLUTION = 1600;
+    static const unsigned long LOOP_MICROS = 20;
+    static constexpr const char *KEY = "tick-second";
+
+    soc::esp32::ESP32Logger logger{soc::api::ILogger::ERROR_LEVEL};
+    soc::esp32::ESP32PreferencesStore store{"clock"};
+    stepper::homing::LimitSwitchHomingStrategy::Config homingConfig = {400, 800, 2 * STEPS_PER_REVOLUTION, -1};
+
+    std::unique_ptr<stepper::sim::SimulatedStepperController> stepGenerator;
+    std::unique_ptr<StepLossStepperController> stepLossModel;
+    std::unique_ptr<stepper::sim::PhysicsStepperController> physicsModel;
+    std::unique_ptr<stepper::sim::SimulatedLimitSwitch> limitSwitch;
+    std::unique_ptr<stepper::homing::LimitSwitchHomingStrategy> homing;
+    std::unique_ptr<stepper::accel::AccelStepperMotor> motor;
+
+    void SetUp() override
+    {
+        virtualClock().reset();
+        fakeFlash().reset();
+        store.begin();
+        stepGenerator = std::make_unique<stepper::sim::SimulatedStepperController>();
+    }
+
+    void TearDown() override
+    {
+        virtualClock().reset();
+        fakeFlash().reset();
+    }
+
+    static double toStepsPerSec(double degreesPerSec)
+    {
+        return degreesPerSec * STEPS_PER_REVOLUTION / 360.0;
+    }
+
+    // a motor that follows up to the given profile, the rotor starts away from the switch
+    void buildStepLossMotor(double maxSpeedDps, double maxAccelerationDps2, long switchPosition = 0)
+    {
+        stepLossModel = std::make_unique<StepLossStepperController>(
+            *stepGenerator,
+            StepLossStepperController::Config{toStepsPerSec(maxSpeedDps), toStepsPerSec(maxAccelerationDps2)},
+            300);
+        buildMotor(*stepLossModel, *stepLossModel, switchPosition);
+    }
+
+    void buildPhysicsMotor()
+    {
+        physicsModel = std::make_unique<stepper::sim::PhysicsStepperController>(
+            *stepGenerator, stepper::sim::PhysicsStepperController::defaultConfig(), 300);
+        buildMotor(*physicsModel, *physicsModel, 0);
+    }
+
+    void buildMotor(stepper::api::IStepperController &controller, stepper::sim::IRotorPositionSource &rotor,
+                    long switchPosition)
+    {
+        limitSwitch = std::make_unique<stepper::sim::SimulatedLimitSwitch>(rotor, switchPosition, -1);
+        homing = std::make_unique<stepper::homing::LimitSwitchHomingStrategy>(controller, *limitSwitch, homingConfig, logger);
+        motor = std::make_unique<stepper::accel::AccelStepperMotor>(controller, STEPS_PER_REVOLUTION, *homing, logger);
+    }
+
+    static void runTuner(TickProfileTuner &tuner)
+    {
+        for (unsigned long loops = 0; tuner.update(); loops++)
+        {
+            ASSERT_LT(loops, 10000000UL) << "the tuner does not end";
+            virtualClock().advanceMicros(LOOP_MICROS);
+        }
+    }
+
+    // a minute of a second hand and its fly back, like the clock does
+    void tickAMinute(const TickProfileTuner::Profile &profile)
+    {
+        motor->setSpeed(profile.speedDps);
+        motor->setAcceleration(profile.accelerationDps2);
+        for (int tick = 0; tick <= 60; tick++)
+        {
+            long target = tick < 60 ? 200 + tick * 24 : 200;
+            ASSERT_TRUE(motor->moveToStep(target));
+            while (motor->isBusy())
+            {
+                motor->update();
+                virtualClock().advanceMicros(LOOP_MICROS);
+            }
+            virtualClock().advanceMillis(100);
+        }
+    }
+};
+
+TEST_F(TickProfileTunerTest, AccelerationLimit_SettlesBelowItWithMargin)
+{
+    // arrange: the hand loses steps above 50000 deg/s^2
+    buildStepLossMotor(100000.0, 50000.0);
+    TickProfileTuner tuner(*motor, *limitSwitch, store, KEY, logger);
+
+    // act
+    ASSERT_TRUE(tuner.begin());
+    runTuner(tuner);
+
+    // assert
+    ASSERT_EQ(TickProfileTuner::State::SUCCEEDED, tuner.getState());
+    TickProfileTuner::Profile profile = tuner.getProfile();
+    EXPECT_LT(profile.accelerationDps2, 50000.0 * 0.8);
+    EXPECT_GT(profile.accelerationDps2, 50000.0 * 0.8 / 1.25 / 1.25);
+    EXPECT_GT(stepLossModel->getLostSteps(), 0u); // found the limit
+
+    unsigned long lostWhileTuning = stepLossModel->getLostSteps();
+    ASSERT_TRUE(motor->home());
+    while (motor->isHoming())
+    {
+        motor->update();
+        virtualClock().advanceMicros(LOOP_MICROS);
+    }
+    tickAMinute(profile);
+    EXPECT_EQ(lostWhileTuning, stepLossModel->getLostSteps());
+}
+
+TEST_F(TickProfileTunerTest, SpeedLimit_SettlesBelowItWithMargin)
+{
+    // arrange: the hand loses steps above 500 deg/s
+    buildStepLossMotor(500.0, 1e9);
+    TickProfileTuner::Config config = TickProfileTuner::defaultConfig();
+    config.start = {300.0, 15000.0};
+    TickProfileTuner tuner(*motor, *limitSwitch, store, KEY, logger, config);
+
+    // act
+    ASSERT_TRUE(tuner.begin());
+    runTuner(tuner);
+
+    // assert: 300, 375 and 469 deg/s follow, 586 does not
+    ASSERT_EQ(TickProfileTuner::State::SUCCEEDED, tuner.getState());
+    EXPECT_EQ(3, tuner.getSafeLevelCount());
+    EXPECT_NEAR(468.75 * 0.8, tuner.getProfile().speedDps, 0.01);
+    EXPECT_GT(tuner.getLastProbeErrorSteps(), config.toleranceSteps);
+}
+
+TEST_F(TickProfileTunerTest, Limit_IsTheFastestProfileTried)
+{
+    // arrange: a hand that follows everything
+    buildStepLossMotor(1e9, 1e9);
+    TickProfileTuner::Config config = TickProfileTuner::defaultConfig();
+    TickProfileTuner tuner(*motor, *limitSwitch, store, KEY, logger, config);
+
+    // act
+    tuner.begin();
+    runTuner(tuner);
+
+    // assert
+    ASSERT_EQ(TickProfileTuner::State::SUCCEEDED, tuner.getState());
+    EXPECT_DOUBLE_EQ(config.limit.speedDps * 0.8, tuner.getProfile().speedDps);
+    EXPECT_DOUBLE_EQ(config.limit.accelerationDps2 * 0.8, tuner.getProfile().accelerationDps2);
+    EXPECT_EQ(0, tuner.getLastProbeErrorSteps());
+    EXPECT_EQ(0u, stepLossModel->getLostSteps());
+}
+
+TEST_F(TickProfileTunerTest, Result_IsSavedForTheNextBoot)
+{
+    // arrange
+    TickProfileTuner::Profile loaded = {1.0, 2.0};
+    EXPECT_FALSE(TickProfileTuner::loadProfile(store, KEY, loaded));
+    buildStepLossMotor(100000.0, 50000.0);
+    TickProfileTuner tuner(*motor, *limitSwitch, store, KEY, logger);
+
+    // act
+    tuner.begin();
+    runTuner(tuner);
+
+    // assert
+    soc::esp32::ESP32PreferencesStore rebootedStore("clock");
+    rebootedStore.begin();
+    ASSERT_TRUE(TickProfileTuner::loadProfile(rebootedStore, KEY, loaded));
+    EXPECT_NEAR(tuner.getProfile().speedDps, loaded.speedDps, 0.01);
+    EXPECT_NEAR(tuner.getProfile().accelerationDps2, loaded.accelerationDps2, 0.01);
+    EXPECT_EQ(1u, fakeFlash().writes);
+}
+
+TEST_F(TickProfileTunerTest, FirstLevelLosesSteps_FailsAndSavesNothing)
+{
+    // arrange
+    buildStepLossMotor(100000.0, 5000.0);
+    TickProfileTuner tuner(*motor, *limitSwitch, store, KEY, logger);
+
+    // act
+    tuner.begin();
+    runTuner(tuner);
+
+    // assert
+    EXPECT_EQ(TickProfileTuner::State::FAILED, tuner.getState());
+    EXPECT_EQ(0u, fakeFlash().writes);
+}
+
+TEST_F(TickProfileTunerTest, NoSwitch_FailsWithTheHoming)
+{
+    // arrange: the switch is out of the homing travel
+    buildStepLossMotor(100000.0, 50000.0, -100000);
+    TickProfileTuner tuner(*motor, *limitSwitch, store, KEY, logger);
+
+    // act
+    tuner.begin();
+    runTuner(tuner);
+
+    // assert
+    EXPECT_EQ(TickProfileTuner::State::FAILED, tuner.getState());
+    EXPECT_EQ(0u, fakeFlash().writes);
+}
+
+TEST_F(TickProfileTunerTest, PhysicsModel_TunedProfileLosesNoSteps)
+{
+    // arrange
+    buildPhysicsMotor();
+    TickProfileTuner tuner(*motor, *limitSwitch, store, KEY, logger);
+
+    // act
+    tuner.begin();
+    runTuner(tuner);
+    ASSERT_EQ(TickProfileTuner::State::SUCCEEDED, tuner.getState());
+    physicsModel->resetStatistics();
+
+    // assert: a minute of ticks and the fly back at the tuned profile do not slip
+    ASSERT_TRUE(motor->home());
+    while (motor->isHoming())
+    {
+        motor->update();
+        virtualClock().advanceMicros(LOOP_MICROS);
+    }
+    tickAMinute(tuner.getProfile());
+    EXPECT_EQ(0u, physicsModel->getSlipEvents());
+    EXPECT_GT(tuner.getSafeLevelCount(), 0);
+}
+
+TEST_F(TickProfileTunerTest, InTheSoc_TheHandHomesOnceTuned)
+{
+    // arrange
+    class NoonTime : public soc::api::ITime
+    {
+    public:
+        unsigned long now() override { return 12 * 3600000UL; }
+        bool asTimeComponents(TimeComponents &components) override
+        {
+            components = {12, 0, 0, 0};
+            return true;
+        }
+    } time;
+    buildStepLossMotor(100000.0, 50000.0);
+    stepper::accel::AccelStepperMotor *handMotor = motor.get();
+    auto hand = std::make_unique<aviator_clock::ClockHand>(aviator_clock::ClockHand::HandType::SECOND, time,
+                                                           std::move(motor), logger, 330.0, 0.0, 600.0, 15000.0);
+    auto tuning = std::make_shared<aviator_clock::TickProfileTuning>(
+        *hand, *handMotor, *limitSwitch, store, KEY, logger, TickProfileTuner::defaultConfig(), false);
+    hand->setDependency(tuning.get());
+    auto clock = std::make_shared<aviator_clock::AviatorClock>(time, logger, 50);
+    clock->addHand(std::move(hand));
+    soc::esp32::ESP32Soc soc;
+
+    // act
+    soc.addComponent(tuning);
+    soc.addComponent(clock);
+    bool clockWaitedForTheTuning = !clock->isSetUp();
+    for (unsigned long loops = 0; !soc.isBooted(); loops++)
+    {
+        ASSERT_LT(loops, 10000000UL) << "the soc does not boot";
+        soc.advanceState(millis());
+        soc.render();
+        virtualClock().advanceMicros(LOOP_MICROS);
+    }
+
+    // assert
+    EXPECT_TRUE(clockWaitedForTheTuning);
+    EXPECT_TRUE(tuning->isTuned());
+    EXPECT_FALSE(handMotor->isHoming());
+    TickProfileTuner::Profile loaded = {0.0, 0.0};
+    EXPECT_TRUE(TickProfileTuner::loadProfile(store, KEY, loaded));
+}
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <Arduino.h>
+#include <sstream>
+#include <string>
+
+#include "soc/trace/ChromeTraceConverter.h"
+#include "soc/trace/TraceRecorder.h"
+
+using namespace soc::trace;
+
+class TraceRecorderTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        virtualClock().reset();
+    }
+
+    void TearDown() override
+    {
+        virtualClock().reset();
+    }
+
+    static std::string toJson(const TraceRecorder &recorder)
+    {
+        std::stringstream binary;
+        StreamTraceSink sink(binary);
+        recorder.serialize(sink);
+
+        std::stringstream json;
+        std::string error;
+        EXPECT_TRUE(ChromeTraceConverter::convert(binary, json, &error)) << error;
+        return json.str();
+    }
+
+    static size_t count(const std::string &text, const std::string &pattern)
+    {
+        size_t found = 0;
+        for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1))
+        {
+            found++;
+        }
+        return found;
+    }
+
+    TraceRecorder recorder;
+    int motor = 0;
+};
+
+TEST_F(TraceRecorderTest, RecordsEventsWithTimestamp)
+{
+    virtualClock().advanceMicros(100);
+    recorder.record(TraceEventType::BEGIN, &motor, "run", 0);
+    virtualClock().advanceMicros(25);
+    recorder.record(TraceEventType::END, &motor, "run", 0);
+
+    ASSERT_EQ(2u, recorder.size());
+    EXPECT_EQ(TraceEventType::BEGIN, recorder.at(0).type);
+    EXPECT_EQ(100u, recorder.at(0).timeMicros);
+    EXPECT_EQ(125u, recorder.at(1).timeMicros);
+    EXPECT_EQ(&motor, recorder.at(1).track);
+}
+
+TEST_F(TraceRecorderTest, RingOverwritesOldestEvents)
+{
+    for (int i = 0; i < SOC_TRACE_CAPACITY + 10; i++)
+    {
+        recorder.record(TraceEventType::COUNTER, &motor, "position", i);
+    }
+
+    EXPECT_EQ(static_cast<size_t>(SOC_TRACE_CAPACITY), recorder.size());
+    EXPECT_EQ(10u, recorder.dropped());
+    EXPECT_EQ(10, recorder.at(0).value);
+    EXPECT_EQ(SOC_TRACE_CAPACITY + 9, recorder.at(SOC_TRACE_CAPACITY - 1).value);
+
+    recorder.clear();
+    EXPECT_EQ(0u, recorder.size());
+    EXPECT_EQ(0u, recorder.dropped());
+}
+
+TEST_F(TraceRecorderTest, DisabledRecorderRecordsNothing)
+{
+    recorder.setEnabled(false);
+    recorder.record(TraceEventType::INSTANT, &motor, "tick", 1);
+
+    EXPECT_EQ(0u, recorder.size());
+}
+
+TEST_F(TraceRecorderTest, ConvertsStatesToConsecutiveSlices)
+{
+    ASSERT_TRUE(recorder.nameTrack(&motor, "SecondHand"));
+    recorder.record(TraceEventType::STATE, &motor, "HOMING", 0);
+    virtualClock().advanceMicros(500);
+    recorder.record(TraceEventType::STATE, &motor, "MOVING", 0);
+    virtualClock().advanceMicros(200);
+    recorder.record(TraceEventType::INSTANT, &motor, "moveToUnit", 42);
+
+    std::string json = toJson(recorder);
+
+    EXPECT_NE(std::string::npos, json.find("\"args\":{\"name\":\"SecondHand\"}"));
+    // HOMING closed by MOVING, MOVING closed at the end of the trace
+    EXPECT_EQ(2u, count(json, "\"ph\":\"B\""));
+    EXPECT_EQ(2u, count(json, "\"ph\":\"E\""));
+    EXPECT_NE(std::string::npos, json.find("{\"name\":\"HOMING\",\"ph\":\"E\",\"ts\":500,"));
+    EXPECT_NE(std::string::npos, json.find("{\"name\":\"MOVING\",\"ph\":\"E\",\"ts\":700,"));
+    EXPECT_NE(std::string::npos, json.find("\"ph\":\"i\",\"ts\":700,\"pid\":1,\"tid\":1,\"s\":\"t\",\"args\":{\"value\":42}"));
+}
+
+TEST_F(TraceRecorderTest, UnwrapsMicrosOverflow)
+{
+    virtualClock().advanceMicros(0xFFFFFF00ULL);
+    recorder.record(TraceEventType::COUNTER, &motor, "position", 1);
+    virtualClock().advanceMicros(0x200);
+    recorder.record(TraceEventType::COUNTER, &motor, "position", 2);
+
+    std::string json = toJson(recorder);
+
+    EXPECT_NE(std::string::npos, json.find("\"ts\":4294967040,"));
+    EXPECT_NE(std::string::npos, json.find("\"ts\":4294967552,"));
+}
+
+TEST_F(TraceRecorderTest, RejectsInvalidInput)
+{
+    std::stringstream binary("not a trace at all");
+    std::stringstream json;
+    std::string error;
+
+    EXPECT_FALSE(ChromeTraceConverter::convert(binary, json, &error));
+    EXPECT_FALSE(error.empty());
+}
+
+TEST_F(TraceRecorderTest, ExtractsLastDumpFromSerialLog)
+{
+    recorder.record(TraceEventType::INSTANT, nullptr, "boot", 0);
+    std::stringstream binary;
+    StreamTraceSink sink(binary);
+    recorder.serialize(sink);
+
+    std::stringstream log;
+    log << "[INFO] booting\n--- soc-trace begin ---\n00\n--- soc-trace end ---\n";
+    log << "--- soc-trace begin ---\r\n";
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    std::string bytes = binary.str();
+    for (size_t i = 0; i < bytes.size(); i++)
+    {
+        uint8_t byte = static_cast<uint8_t>(bytes[i]);
+        log << HEX_DIGITS[byte >> 4] << HEX_DIGITS[byte & 0x0F];
+        if (i % 32 == 31)
+        {
+            log << "\r\n";
+        }
+    }
+    log << "\r\n[INFO] ClockHand: interleaved log line\r\n--- soc-trace end ---\r\n";
+
+    std::string extracted;
+    ASSERT_TRUE(ChromeTraceConverter::extractFromLog(log, extracted));
+    EXPECT_EQ(bytes, extracted);
+}
+
+TEST_F(TraceRecorderTest, DropsEndWhoseBeginWasOverwritten)
+{
+    for (int i = 0; i < SOC_TRACE_CAPACITY + 1; i++)
+    {
+        recorder.record(i % 2 == 0 ? TraceEventType::BEGIN : TraceEventType::END, &motor, "loop", 0);
+    }
+
+    std::string json = toJson(recorder);
+
+    // the oldest event left is an END, its BEGIN is gone
+    EXPECT_EQ(SOC_TRACE_CAPACITY / 2u, count(json, "\"ph\":\"B\""));
+    EXPECT_EQ(SOC_TRACE_CAPACITY / 2u - 1, count(json, "\"ph\":\"E\""));
+}
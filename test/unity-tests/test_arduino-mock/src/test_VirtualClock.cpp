@@ -0,0 +1,108 @@
+#include <unity.h>
+#include <Arduino.h>
+
+#include <soc/api/ITime.h>
+#include <soc/esp32/ESP32MillisTime.h>
+#include <soc/esp32/ESP32DigitalInput.h>
+
+using soc::esp32::ESP32DigitalInput;
+using soc::esp32::ESP32MillisTime;
+
+// every test starts at virtual time zero without pending events
+void setUp(void) {
+    virtualClock().reset();
+    fakePinValues().clear();
+}
+
+void tearDown(void) {
+    virtualClock().reset();
+    fakePinValues().clear();
+}
+
+void test_time_does_not_move_by_itself() {
+    TEST_ASSERT_EQUAL_UINT32(0, millis());
+    TEST_ASSERT_EQUAL_UINT32(0, micros());
+    TEST_ASSERT_EQUAL_UINT32(0, millis());
+}
+
+void test_delay_advances_time() {
+    delay(1500);
+    TEST_ASSERT_EQUAL_UINT32(1500, millis());
+    delayMicroseconds(250);
+    TEST_ASSERT_EQUAL_UINT32(1500250, micros());
+}
+
+void test_auto_advance_on_every_read() {
+    virtualClock().setAutoAdvanceMicros(10);
+    TEST_ASSERT_EQUAL_UINT32(10, micros());
+    TEST_ASSERT_EQUAL_UINT32(20, micros());
+    TEST_ASSERT_EQUAL_UINT64(20, virtualClock().nowMicros());
+}
+
+void test_scheduled_pin_changes_are_applied_in_order() {
+    const int PIN = 26;
+    virtualClock().schedulePinChange(2000, PIN, LOW);
+    virtualClock().schedulePinChange(1000, PIN, HIGH);
+
+    virtualClock().advanceMicros(999);
+    TEST_ASSERT_EQUAL_INT(LOW, digitalRead(PIN));
+
+    virtualClock().advanceMicros(1);
+    TEST_ASSERT_EQUAL_INT(HIGH, digitalRead(PIN));
+
+    delay(5);
+    TEST_ASSERT_EQUAL_INT(LOW, digitalRead(PIN));
+    TEST_ASSERT_EQUAL_UINT32(0, virtualClock().pendingEvents());
+}
+
+void test_advance_to_next_event_skips_idle_time() {
+    const int PIN = 3;
+    virtualClock().schedulePinChangeIn(3600000000ULL, PIN, HIGH);
+
+    TEST_ASSERT_TRUE(virtualClock().advanceToNextEvent());
+    TEST_ASSERT_EQUAL_UINT32(3600000UL, millis());
+    TEST_ASSERT_EQUAL_INT(HIGH, digitalRead(PIN));
+    TEST_ASSERT_FALSE(virtualClock().advanceToNextEvent());
+}
+
+void test_limit_switch_bounce_is_seen_by_digital_input() {
+    const int PIN = 26;
+    ESP32DigitalInput limitSwitch(PIN, true);
+    fakePinValues()[PIN] = HIGH; // open, pulled up
+
+    virtualClock().schedulePinChangeIn(100, PIN, LOW);
+    virtualClock().schedulePinChangeIn(150, PIN, HIGH);
+    virtualClock().schedulePinChangeIn(300, PIN, LOW);
+
+    delayMicroseconds(120);
+    TEST_ASSERT_TRUE(limitSwitch.isActive());
+    delayMicroseconds(100);
+    TEST_ASSERT_FALSE(limitSwitch.isActive());
+    delayMicroseconds(100);
+    TEST_ASSERT_TRUE(limitSwitch.isActive());
+}
+
+void test_millis_time_runs_through_hours_of_simulated_time() {
+    ESP32MillisTime timeProvider;
+    soc::api::ITime::TimeComponents time;
+
+    // 26 hours, 3 minutes and 7 seconds
+    virtualClock().advanceMillis(((26UL * 60 + 3) * 60 + 7) * 1000);
+
+    TEST_ASSERT_TRUE(timeProvider.asTimeComponents(time));
+    TEST_ASSERT_EQUAL_UINT32(26, time.hours);
+    TEST_ASSERT_EQUAL_INT(3, time.minutes);
+    TEST_ASSERT_EQUAL_INT(7, time.seconds);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_time_does_not_move_by_itself);
+    RUN_TEST(test_delay_advances_time);
+    RUN_TEST(test_auto_advance_on_every_read);
+    RUN_TEST(test_scheduled_pin_changes_are_applied_in_order);
+    RUN_TEST(test_advance_to_next_event_skips_idle_time);
+    RUN_TEST(test_limit_switch_bounce_is_seen_by_digital_input);
+    RUN_TEST(test_millis_time_runs_through_hours_of_simulated_time);
+    return UNITY_END();
+}
@@ -0,0 +1,129 @@
+#include <unity.h>
+#include <Arduino.h>
+
+#include <soc/esp32/FastGpio.h>
+#include <soc/esp32/ESP32PulseBatch.h>
+#include <soc/esp32/ESP32DigitalOutput.h>
+#include <soc/esp32/ESP32DigitalInput.h>
+
+using soc::esp32::ESP32DigitalInput;
+using soc::esp32::ESP32DigitalOutput;
+using soc::esp32::ESP32PulseBatch;
+using soc::esp32::FastGpio;
+
+void setUp(void) {
+    virtualClock().reset();
+    fakePinValues().clear();
+    fakeGpioRegisters().reset();
+}
+
+void tearDown(void) {
+    virtualClock().reset();
+    fakePinValues().clear();
+    fakeGpioRegisters().reset();
+}
+
+void test_set_writes_several_pins_at_once() {
+    FastGpio::set(FastGpio::mask(14) | FastGpio::mask(18) | FastGpio::mask(33));
+
+    TEST_ASSERT_EQUAL_UINT32(1, fakeGpioRegisters().writes.size());
+    TEST_ASSERT_TRUE(fakeGpioRegisters().writes[0].set);
+    TEST_ASSERT_EQUAL_INT(HIGH, digitalRead(14));
+    TEST_ASSERT_EQUAL_INT(HIGH, digitalRead(18));
+    TEST_ASSERT_EQUAL_INT(HIGH, digitalRead(33));
+    TEST_ASSERT_EQUAL_INT(LOW, digitalRead(19));
+}
+
+void test_clear_leaves_other_pins_alone() {
+    FastGpio::set(FastGpio::mask(14) | FastGpio::mask(18));
+    FastGpio::clear(FastGpio::mask(14));
+
+    TEST_ASSERT_EQUAL_INT(LOW, digitalRead(14));
+    TEST_ASSERT_EQUAL_INT(HIGH, digitalRead(18));
+    TEST_ASSERT_EQUAL_UINT32(1, fakeGpioRegisters().clearWrites);
+}
+
+void test_read_sees_digitalWrite_and_the_high_bank() {
+    digitalWrite(5, HIGH);
+    digitalWrite(39, HIGH);
+
+    uint64_t levels = FastGpio::read();
+
+    TEST_ASSERT_TRUE(levels & FastGpio::mask(5));
+    TEST_ASSERT_TRUE(levels & FastGpio::mask(39));
+    TEST_ASSERT_FALSE(levels & FastGpio::mask(6));
+}
+
+void test_digital_output_uses_one_register_write() {
+    ESP32DigitalOutput out(27);
+
+    out.on();
+    out.off();
+
+    TEST_ASSERT_EQUAL_UINT32(1, fakeGpioRegisters().setWrites);
+    TEST_ASSERT_EQUAL_UINT32(1, fakeGpioRegisters().clearWrites);
+    TEST_ASSERT_EQUAL_INT(LOW, fakePinValues()[27]);
+}
+
+void test_digital_input_reads_the_input_register() {
+    ESP32DigitalInput activeLow(26, true);
+    ESP32DigitalInput activeHigh(13, false);
+    fakePinValues()[26] = LOW;
+    fakePinValues()[13] = HIGH;
+
+    TEST_ASSERT_TRUE(activeLow.isActive());
+    TEST_ASSERT_TRUE(activeHigh.isActive());
+    TEST_ASSERT_EQUAL_UINT32(2, fakeGpioRegisters().inputReads);
+}
+
+void test_pulse_batch_steps_all_pins_together() {
+    ESP32PulseBatch batch(2);
+    batch.add(FastGpio::mask(14));
+    batch.add(FastGpio::mask(33));
+    batch.add(FastGpio::mask(18));
+
+    batch.flush();
+
+    // one rising and one falling write for all three step pins, the pulse width apart
+    const uint64_t steps = FastGpio::mask(14) | FastGpio::mask(18) | FastGpio::mask(33);
+    TEST_ASSERT_EQUAL_UINT32(2, fakeGpioRegisters().writes.size());
+    TEST_ASSERT_TRUE(fakeGpioRegisters().writes[0].set);
+    TEST_ASSERT_TRUE(fakeGpioRegisters().writes[0].mask == steps);
+    TEST_ASSERT_FALSE(fakeGpioRegisters().writes[1].set);
+    TEST_ASSERT_TRUE(fakeGpioRegisters().writes[1].mask == steps);
+    TEST_ASSERT_EQUAL_UINT32(2, fakeGpioRegisters().writes[1].timeMicros - fakeGpioRegisters().writes[0].timeMicros);
+    TEST_ASSERT_EQUAL_INT(LOW, digitalRead(33));
+    TEST_ASSERT_EQUAL_UINT32(1, batch.getPulseCount());
+}
+
+void test_pulse_batch_without_pins_does_not_touch_the_registers() {
+    ESP32PulseBatch batch;
+
+    batch.flush();
+
+    TEST_ASSERT_EQUAL_UINT32(0, fakeGpioRegisters().writes.size());
+    TEST_ASSERT_EQUAL_UINT32(0, batch.getPulseCount());
+}
+
+void test_pulse_batch_reports_pending_pins() {
+    ESP32PulseBatch batch;
+    batch.add(FastGpio::mask(14));
+
+    TEST_ASSERT_TRUE(batch.isPending(FastGpio::mask(14)));
+    TEST_ASSERT_FALSE(batch.isPending(FastGpio::mask(18)));
+    batch.flush();
+    TEST_ASSERT_FALSE(batch.isPending(FastGpio::mask(14)));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_set_writes_several_pins_at_once);
+    RUN_TEST(test_clear_leaves_other_pins_alone);
+    RUN_TEST(test_read_sees_digitalWrite_and_the_high_bank);
+    RUN_TEST(test_digital_output_uses_one_register_write);
+    RUN_TEST(test_digital_input_reads_the_input_register);
+    RUN_TEST(test_pulse_batch_steps_all_pins_together);
+    RUN_TEST(test_pulse_batch_without_pins_does_not_touch_the_registers);
+    RUN_TEST(test_pulse_batch_reports_pending_pins);
+    return UNITY_END();
+}
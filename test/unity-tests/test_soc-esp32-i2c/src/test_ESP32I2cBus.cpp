@@ -0,0 +1,80 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <Wire.h>
+
+#include <soc/esp32/ESP32I2cBus.h>
+
+using soc::esp32::ESP32I2cBus;
+
+static TwoWire wire;
+
+void setUp(void) {
+    wire = TwoWire();
+}
+
+void tearDown(void) {
+}
+
+void test_begin_configures_pins_and_clock() {
+    ESP32I2cBus bus(16, 17, 400000, wire);
+    bus.begin();
+    TEST_ASSERT_TRUE(wire.begun);
+    TEST_ASSERT_EQUAL_INT(16, wire.sdaPin);
+    TEST_ASSERT_EQUAL_INT(17, wire.sclPin);
+    TEST_ASSERT_EQUAL_UINT32(400000, wire.frequency);
+}
+
+void test_register_read_uses_a_repeated_start() {
+    ESP32I2cBus bus(16, 17, 100000, wire);
+    wire.readData = {0x30, 0x45, 0x13};
+    const uint8_t reg = 0x00;
+    uint8_t data[3] = {0};
+
+    TEST_ASSERT_TRUE(bus.transfer(0x68, &reg, 1, data, 3));
+
+    TEST_ASSERT_EQUAL_UINT32(1, wire.transmissions.size());
+    TEST_ASSERT_EQUAL_UINT16(0x68, wire.transmissions[0].address);
+    TEST_ASSERT_EQUAL_UINT32(1, wire.transmissions[0].data.size());
+    TEST_ASSERT_FALSE(wire.transmissions[0].sendStop);
+    TEST_ASSERT_EQUAL_UINT32(1, wire.requests);
+    TEST_ASSERT_EQUAL_UINT8(0x30, data[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x13, data[2]);
+}
+
+void test_write_only_ends_with_a_stop() {
+    ESP32I2cBus bus(16, 17, 100000, wire);
+    const uint8_t data[] = {0x0E, 0x1C};
+
+    TEST_ASSERT_TRUE(bus.transfer(0x68, data, 2, nullptr, 0));
+
+    TEST_ASSERT_TRUE(wire.transmissions[0].sendStop);
+    TEST_ASSERT_EQUAL_UINT32(0, wire.requests);
+}
+
+void test_missing_device_fails() {
+    ESP32I2cBus bus(16, 17, 100000, wire);
+    wire.acknowledge = false;
+    const uint8_t reg = 0x00;
+    uint8_t data[7];
+
+    TEST_ASSERT_FALSE(bus.transfer(0x68, &reg, 1, data, 7));
+    TEST_ASSERT_EQUAL_UINT32(0, wire.requests);
+}
+
+void test_short_read_fails() {
+    ESP32I2cBus bus(16, 17, 100000, wire);
+    wire.readData = {0x01, 0x02};
+    uint8_t data[7];
+
+    TEST_ASSERT_FALSE(bus.transfer(0x68, nullptr, 0, data, 7));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_begin_configures_pins_and_clock);
+    RUN_TEST(test_register_read_uses_a_repeated_start);
+    RUN_TEST(test_write_only_ends_with_a_stop);
+    RUN_TEST(test_missing_device_fails);
+    RUN_TEST(test_short_read_fails);
+    return UNITY_END();
+}
@@ -0,0 +1,258 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <vector>
+
+#include <soc/esp32/DebounceFilter.h>
+#include <soc/esp32/ESP32InputSampler.h>
+#include <soc/esp32/ESP32DebouncedInput.h>
+
+using soc::esp32::DebounceFilter;
+using soc::esp32::ESP32DebouncedInput;
+using soc::esp32::ESP32InputSampler;
+
+static const uint8_t THRESHOLD = 4;
+static const DebounceFilter::Config INTEGRATOR = {DebounceFilter::Mode::INTEGRATOR, THRESHOLD};
+static const DebounceFilter::Config CONSECUTIVE = {DebounceFilter::Mode::CONSECUTIVE, THRESHOLD};
+
+// deterministic pseudo random numbers, the same patterns on every run
+static uint32_t randomState = 1;
+static uint32_t nextRandom() {
+    randomState = randomState * 1664525u + 1013904223u;
+    return randomState >> 8;
+}
+
+// one pin, filtered the obvious way
+struct ReferenceFilter {
+    DebounceFilter::Mode mode;
+    int count = 0;
+    bool state = false;
+    bool primed = false;
+
+    bool sample(bool level) {
+        if (!primed) {
+            primed = true;
+            count = (mode == DebounceFilter::Mode::INTEGRATOR && level) ? THRESHOLD : 0;
+            state = level;
+            return state;
+        }
+        if (mode == DebounceFilter::Mode::INTEGRATOR) {
+            if (level && count < THRESHOLD) count++;
+            if (!level && count > 0) count--;
+            if (count == THRESHOLD) state = true;
+            if (count == 0) state = false;
+        } else {
+            count = (level == state) ? 0 : count + 1;
+            if (count == THRESHOLD) {
+                state = level;
+                count = 0;
+            }
+        }
+        return state;
+    }
+};
+
+// contact bounce of a closing switch: one sample open, then closed for longer and longer
+static std::vector<bool> pressWithBounce(size_t stableSamples) {
+    std::vector<bool> levels;
+    int closed = 1;
+    while (closed < THRESHOLD) {
+        for (int i = 0; i < closed; i++) levels.push_back(true);
+        levels.push_back(false);
+        closed += 1 + nextRandom() % 2;
+    }
+    for (size_t i = 0; i < stableSamples; i++) levels.push_back(true);
+    return levels;
+}
+
+void setUp(void) {
+    randomState = 1;
+    virtualClock().reset();
+    fakePinValues().clear();
+    fakeGpioRegisters().reset();
+}
+
+void tearDown(void) {
+    virtualClock().reset();
+    fakePinValues().clear();
+    fakeGpioRegisters().reset();
+}
+
+static void expectReferenceOnAllPins(DebounceFilter::Config config) {
+    DebounceFilter filter(~0ULL, config);
+    std::vector<ReferenceFilter> references(64, ReferenceFilter{config.mode});
+
+    for (int n = 0; n < 20000; n++) {
+        // every pin with its own noise density, from quiet to very noisy
+        uint64_t levels = 0;
+        for (int pin = 0; pin < 64; pin++) {
+            bool flip = nextRandom() % 64 < static_cast<uint32_t>(pin);
+            bool level = (n / 50) % 2 ? !flip : flip;
+            levels |= static_cast<uint64_t>(level) << pin;
+        }
+        filter.sample(levels);
+        for (int pin = 0; pin < 64; pin++) {
+            bool expected = references[pin].sample((levels >> pin) & 1);
+            if (expected != static_cast<bool>((filter.getStates() >> pin) & 1)) {
+                printf("  pin %d sample %d\n", pin, n);
+                TEST_FAIL_MESSAGE("bit-sliced filter differs from the reference");
+            }
+        }
+    }
+}
+
+void test_integrator_matches_the_reference_on_64_pins() {
+    expectReferenceOnAllPins(INTEGRATOR);
+}
+
+void test_consecutive_matches_the_reference_on_64_pins() {
+    expectReferenceOnAllPins(CONSECUTIVE);
+}
+
+void test_clean_edge_switches_after_threshold_samples() {
+    for (DebounceFilter::Config config : {INTEGRATOR, CONSECUTIVE}) {
+        DebounceFilter filter(1ULL << 26, config);
+        filter.sample(1ULL << 26);
+        TEST_ASSERT_TRUE(filter.getStates() & (1ULL << 26));
+
+        for (int n = 1; n < THRESHOLD; n++) {
+            filter.sample(0);
+            TEST_ASSERT_TRUE(filter.getStates() & (1ULL << 26));
+        }
+        filter.sample(0);
+        TEST_ASSERT_FALSE(filter.getStates() & (1ULL << 26));
+    }
+}
+
+void test_pins_outside_the_mask_stay_low() {
+    DebounceFilter filter(1ULL << 5, INTEGRATOR);
+    for (int n = 0; n < 10; n++) {
+        filter.sample(~0ULL);
+    }
+    TEST_ASSERT_TRUE(filter.getStates() == (1ULL << 5));
+}
+
+void test_history_is_bit_packed_per_pin() {
+    DebounceFilter filter(1ULL << 7, INTEGRATOR);
+    filter.sample(0);
+    filter.sample(1ULL << 7);
+    filter.sample(0);
+    filter.sample(1ULL << 7);
+    filter.sample(1ULL << 7);
+
+    TEST_ASSERT_EQUAL_UINT32(0x0B, filter.getHistory(7) & 0x1F);
+}
+
+void test_bouncing_presses_switch_once_within_the_latency() {
+    for (DebounceFilter::Config config : {INTEGRATOR, CONSECUTIVE}) {
+        DebounceFilter filter(1ULL, config);
+        filter.sample(0);
+        int transitions = 0;
+        bool state = false;
+        for (int press = 0; press < 200; press++) {
+            std::vector<bool> levels = pressWithBounce(20);
+            size_t bounceEnd = levels.size() - 20;
+            for (size_t i = 0; i < levels.size(); i++) {
+                filter.sample(levels[i] ? 1ULL : 0ULL);
+                bool now = filter.getStates() & 1ULL;
+                if (now != state) {
+                    transitions++;
+                    state = now;
+                    TEST_ASSERT_LESS_OR_EQUAL(bounceEnd + THRESHOLD, i + 1);
+                }
+            }
+            TEST_ASSERT_TRUE(state);
+
+            // a clean release
+            for (int i = 0; i < 20; i++) {
+                filter.sample(0);
+            }
+            state = filter.getStates() & 1ULL;
+            TEST_ASSERT_FALSE(state);
+            transitions++;
+        }
+        TEST_ASSERT_EQUAL_INT(400, transitions);
+    }
+}
+
+void test_short_spikes_never_trigger() {
+    for (DebounceFilter::Config config : {INTEGRATOR, CONSECUTIVE}) {
+        DebounceFilter filter(1ULL, config);
+        filter.sample(0);
+        for (int spike = 0; spike < 1000; spike++) {
+            // up to threshold - 1 samples of EMI, then quiet for twice the threshold
+            int length = 1 + nextRandom() % (THRESHOLD - 1);
+            for (int i = 0; i < length; i++) {
+                filter.sample(1ULL);
+                TEST_ASSERT_FALSE(filter.getStates() & 1ULL);
+            }
+            for (int i = 0; i < 2 * THRESHOLD; i++) {
+                filter.sample(0);
+            }
+        }
+    }
+}
+
+void test_debounced_input_follows_a_bouncing_limit_switch() {
+    const uint8_t PIN = 26;
+    const uint32_t PERIOD = 500;
+    ESP32InputSampler sampler(1ULL << PIN, PERIOD, INTEGRATOR);
+    ESP32DebouncedInput limitSwitch(sampler, PIN, true);
+    limitSwitch.begin();
+    fakePinValues()[PIN] = HIGH; // the pull-up
+    sampler.begin();
+
+    // the lever closes at 10 ms and bounces for 1.8 ms
+    const uint64_t PRESS = 10000;
+    const uint64_t SETTLED = PRESS + 1800;
+    int level = LOW;
+    for (uint64_t t = PRESS; t < SETTLED; t += 150 + nextRandom() % 300) {
+        virtualClock().schedulePinChange(t, PIN, level);
+        level = level == LOW ? HIGH : LOW;
+    }
+    virtualClock().schedulePinChange(SETTLED, PIN, LOW);
+
+    int transitions = 0;
+    bool active = false;
+    uint64_t activeAt = 0;
+    for (uint64_t t = PERIOD; t <= 30000; t += PERIOD) {
+        virtualClock().advanceTo(t);
+        sampler.sampleNow();
+        if (limitSwitch.isActive() != active) {
+            active = !active;
+            transitions++;
+            activeAt = t;
+        }
+    }
+
+    TEST_ASSERT_TRUE(active);
+    TEST_ASSERT_EQUAL_INT(1, transitions);
+    TEST_ASSERT_GREATER_OR_EQUAL(PRESS, activeAt);
+    TEST_ASSERT_LESS_OR_EQUAL(SETTLED + THRESHOLD * PERIOD, activeAt);
+    // every sample is one register read for all pins
+    TEST_ASSERT_EQUAL_UINT32(sampler.getFilter().getSampleCount(), fakeGpioRegisters().inputReads);
+}
+
+void test_switch_pressed_at_boot_reads_active_right_away() {
+    const uint8_t PIN = 13;
+    ESP32InputSampler sampler(1ULL << PIN, 500, INTEGRATOR);
+    ESP32DebouncedInput limitSwitch(sampler, PIN, true);
+    fakePinValues()[PIN] = LOW;
+
+    sampler.begin();
+
+    TEST_ASSERT_TRUE(limitSwitch.isActive());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_integrator_matches_the_reference_on_64_pins);
+    RUN_TEST(test_consecutive_matches_the_reference_on_64_pins);
+    RUN_TEST(test_clean_edge_switches_after_threshold_samples);
+    RUN_TEST(test_pins_outside_the_mask_stay_low);
+    RUN_TEST(test_history_is_bit_packed_per_pin);
+    RUN_TEST(test_bouncing_presses_switch_once_within_the_latency);
+    RUN_TEST(test_short_spikes_never_trigger);
+    RUN_TEST(test_debounced_input_follows_a_bouncing_limit_switch);
+    RUN_TEST(test_switch_pressed_at_boot_reads_active_right_away);
+    return UNITY_END();
+}
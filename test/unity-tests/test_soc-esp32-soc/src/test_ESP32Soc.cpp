@@ -0,0 +1,417 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <cstdarg>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <soc/api/ISocComponent.h>
+#include <soc/esp32/ESP32Soc.h>
+#include <soc/esp32/ThrottledLogger.h>
+#include <soc/trace/BootProfiler.h>
+
+using soc::esp32::ESP32Soc;
+using soc::esp32::ThrottledLogger;
+using soc::trace::BootProfiler;
+
+// a component whose setup takes setupLoops loops, like a motor that homes
+class SlowSetupComponent : public soc::api::ISocComponent
+{
+public:
+    SlowSetupComponent(const char *name, int setupLoops, std::vector<std::string> &calls)
+        : _name(name), _setupLoops(setupLoops), _calls(calls) {}
+
+    void setup() override { _calls.push_back(_name + ".setup"); }
+    void advanceState(unsigned long) override
+    {
+        advanced++;
+        virtualClock().advanceMillis(1);
+    }
+    void render() override { rendered++; }
+    void teardown() override { _calls.push_back(_name + ".teardown"); }
+
+    bool isSetUp() const override { return advanced >= _setupLoops; }
+    const char *getName() const override { return _name.c_str(); }
+    const ISocComponent *getDependency(size_t index) const override
+    {
+        return index < dependencies.size() ? dependencies[index] : nullptr;
+    }
+
+    std::vector<const ISocComponent *> dependencies;
+    int advanced = 0;
+    int rendered = 0;
+
+private:
+    const std::string _name;
+    const int _setupLoops;
+    std::vector<std::string> &_calls;
+};
+
+// a component that takes as long as injected, in advanceState() and in render()
+class SlowLoopComponent : public soc::api::ISocComponent
+{
+public:
+    SlowLoopComponent(const char *name, bool critical) : _name(name), _critical(critical) {}
+
+    void setup() override {}
+    void advanceState(unsigned long) override { virtualClock().advanceMicros(advanceMicros); }
+    void render() override
+    {
+        rendered++;
+        virtualClock().advanceMicros(renderMicros);
+    }
+    void teardown() override {}
+
+    const char *getName() const override { return _name; }
+    bool isCritical() const override { return _critical; }
+    void setDegraded(bool degraded) override { degradations.push_back(degraded); }
+
+    unsigned long advanceMicros = 0;
+    unsigned long renderMicros = 0;
+    int rendered = 0;
+    std::vector<bool> degradations;
+
+private:
+    const char *_name;
+    const bool _critical;
+};
+
+#define CAPTURE(level)                 \
+    va_list args;                      \
+    va_start(args, format);            \
+    capture(level, format, args);      \
+    va_end(args)
+
+class CapturingLogger : public soc::api::ILogger
+{
+public:
+    void trace(const char *format, ...) override { CAPTURE("TRACE"); }
+    void debug(const char *format, ...) override { CAPTURE("DEBUG"); }
+    void info(const char *format, ...) override { CAPTURE("INFO"); }
+    void warn(const char *format, ...) override { CAPTURE("WARN"); }
+    void error(const char *format, ...) override { CAPTURE("ERROR"); }
+
+    std::vector<std::string> lines;
+
+private:
+    void capture(const char *level, const char *format, va_list args)
+    {
+        char message[256];
+        vsnprintf(message, sizeof(message), format, args);
+        lines.push_back(std::string(level) + ": " + message);
+    }
+};
+
+static const ESP32Soc::WatchdogConfig WATCHDOG = {1000, 400, 3};
+
+static std::vector<std::string> calls;
+
+void setUp(void) {
+    calls.clear();
+    virtualClock().reset();
+}
+
+void tearDown(void) {
+    virtualClock().reset();
+}
+
+static void runLoops(ESP32Soc &soc, int loops) {
+    for (int i = 0; i < loops; i++)
+    {
+        soc.advanceState(millis());
+        soc.render();
+    }
+}
+
+void test_independent_components_set_up_side_by_side() {
+    ESP32Soc soc;
+    auto homing = std::make_shared<SlowSetupComponent>("homing", 3, calls);
+    auto time = std::make_shared<SlowSetupComponent>("time", 2, calls);
+    soc.addComponent(homing);
+    soc.addComponent(time);
+
+    TEST_ASSERT_EQUAL_UINT32(2, calls.size());
+    TEST_ASSERT_FALSE(soc.isBooted());
+    runLoops(soc, 2);
+    TEST_ASSERT_TRUE(time->isSetUp());
+    TEST_ASSERT_FALSE(soc.isBooted());
+    runLoops(soc, 1);
+    TEST_ASSERT_TRUE(soc.isBooted());
+}
+
+void test_dependent_component_waits_for_its_dependency() {
+    ESP32Soc soc;
+    auto time = std::make_shared<SlowSetupComponent>("time", 2, calls);
+    auto clock = std::make_shared<SlowSetupComponent>("clock", 0, calls);
+    clock->dependencies.push_back(time.get());
+    soc.addComponent(clock);
+    soc.addComponent(time);
+
+    // the clock is not set up, advanced or rendered before the time
+    TEST_ASSERT_EQUAL_UINT32(1, calls.size());
+    TEST_ASSERT_EQUAL_STRING("time.setup", calls[0].c_str());
+    runLoops(soc, 1);
+    TEST_ASSERT_EQUAL_INT(0, clock->advanced);
+    TEST_ASSERT_EQUAL_INT(0, clock->rendered);
+
+    runLoops(soc, 1);
+    TEST_ASSERT_EQUAL_UINT32(2, calls.size());
+    TEST_ASSERT_EQUAL_STRING("clock.setup", calls[1].c_str());
+    TEST_ASSERT_TRUE(soc.isBooted());
+    // set up at the end of advanceState(), rendered in the same loop
+    TEST_ASSERT_EQUAL_INT(0, clock->advanced);
+    TEST_ASSERT_EQUAL_INT(1, clock->rendered);
+    runLoops(soc, 1);
+    TEST_ASSERT_EQUAL_INT(1, clock->advanced);
+}
+
+void test_ready_dependency_releases_at_once() {
+    ESP32Soc soc;
+    auto logger = std::make_shared<SlowSetupComponent>("logger", 0, calls);
+    auto clock = std::make_shared<SlowSetupComponent>("clock", 0, calls);
+    clock->dependencies.push_back(logger.get());
+    soc.addComponent(logger);
+    soc.addComponent(clock);
+
+    TEST_ASSERT_EQUAL_UINT32(2, calls.size());
+    TEST_ASSERT_TRUE(soc.isBooted());
+}
+
+void test_dependency_outside_of_the_soc_only_has_to_be_set_up() {
+    ESP32Soc soc;
+    std::vector<std::string> otherCalls;
+    SlowSetupComponent external("external", 1, otherCalls);
+    auto clock = std::make_shared<SlowSetupComponent>("clock", 0, calls);
+    clock->dependencies.push_back(&external);
+    soc.addComponent(clock);
+
+    runLoops(soc, 1);
+    TEST_ASSERT_EQUAL_UINT32(0, calls.size());
+    external.advanceState(0);
+    runLoops(soc, 1);
+    TEST_ASSERT_EQUAL_UINT32(1, calls.size());
+}
+
+void test_teardown_skips_components_never_set_up() {
+    {
+        ESP32Soc soc;
+        auto first = std::make_shared<SlowSetupComponent>("first", 0, calls);
+        auto second = std::make_shared<SlowSetupComponent>("second", 0, calls);
+        auto blocked = std::make_shared<SlowSetupComponent>("blocked", 0, calls);
+        SlowSetupComponent never("never", 1, calls);
+        blocked->dependencies.push_back(&never);
+        soc.addComponent(first);
+        soc.addComponent(blocked);
+        soc.addComponent(second);
+        TEST_ASSERT_FALSE(soc.isBooted());
+    }
+
+    const char *expected[] = {"first.setup", "second.setup", "second.teardown", "first.teardown"};
+    TEST_ASSERT_EQUAL_UINT32(4, calls.size());
+    for (size_t i = 0; i < calls.size(); i++)
+    {
+        TEST_ASSERT_EQUAL_STRING(expected[i], calls[i].c_str());
+    }
+}
+
+void test_boot_profiler_records_every_setup() {
+    BootProfiler profiler;
+    ESP32Soc soc(&profiler);
+    auto homing = std::make_shared<SlowSetupComponent>("homing", 10, calls);
+    auto time = std::make_shared<SlowSetupComponent>("time", 4, calls);
+    soc.addComponent(homing);
+    soc.addComponent(time);
+    runLoops(soc, 10);
+
+    TEST_ASSERT_TRUE(soc.isBooted());
+    TEST_ASSERT_EQUAL_UINT32(2, profiler.getPhaseCount());
+    TEST_ASSERT_EQUAL_STRING("homing", profiler.getPhase(0).name);
+    // every loop of the fakes takes 2 ms, both advance
+    TEST_ASSERT_EQUAL_UINT32(20000, profiler.getPhase(0).endMicros - profiler.getPhase(0).startMicros);
+    TEST_ASSERT_EQUAL_UINT32(8000, profiler.getPhase(1).endMicros - profiler.getPhase(1).startMicros);
+    TEST_ASSERT_EQUAL_UINT32(20000, profiler.getCoveredMicros());
+}
+
+void test_watchdog_loop_within_budget() {
+    ESP32Soc soc;
+    soc.setWatchdog(WATCHDOG);
+    auto motor = std::make_shared<SlowLoopComponent>("motor", true);
+    motor->advanceMicros = 300;
+    motor->renderMicros = 100;
+    soc.addComponent(motor);
+
+    runLoops(soc, 5);
+
+    const ESP32Soc::WatchdogStats &stats = soc.getWatchdogStats();
+    TEST_ASSERT_EQUAL_UINT32(5, stats.iterations);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.overruns);
+    TEST_ASSERT_EQUAL_UINT32(400, stats.maxIterationMicros);
+    ESP32Soc::ComponentOverruns overruns;
+    TEST_ASSERT_TRUE(soc.getOverruns(*motor, overruns));
+    TEST_ASSERT_EQUAL_UINT32(0, overruns.count);
+    TEST_ASSERT_EQUAL_UINT32(400, overruns.maxMicros);
+}
+
+void test_watchdog_blames_the_component_beyond_its_slice() {
+    ESP32Soc soc;
+    soc.setWatchdog(WATCHDOG);
+    auto motor = std::make_shared<SlowLoopComponent>("motor", true);
+    auto display = std::make_shared<SlowLoopComponent>("display", true);
+    motor->advanceMicros = 300;
+    display->renderMicros = 900;
+    soc.addComponent(motor);
+    soc.addComponent(display);
+
+    runLoops(soc, 1);
+    display->renderMicros = 1500;
+    runLoops(soc, 1);
+    display->renderMicros = 100;
+    runLoops(soc, 1);
+
+    const ESP32Soc::WatchdogStats &stats = soc.getWatchdogStats();
+    TEST_ASSERT_EQUAL_UINT32(3, stats.iterations);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.overruns);
+    TEST_ASSERT_EQUAL_UINT32(1800, stats.maxIterationMicros);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.unattributedOverruns);
+    TEST_ASSERT_TRUE(stats.lastBlamed == display.get());
+    TEST_ASSERT_EQUAL_UINT32(800, stats.lastExcessMicros);
+    ESP32Soc::ComponentOverruns overruns;
+    TEST_ASSERT_TRUE(soc.getOverruns(*display, overruns));
+    TEST_ASSERT_EQUAL_UINT32(2, overruns.count);
+    TEST_ASSERT_EQUAL_UINT32(1100, overruns.lastExcessMicros);
+    TEST_ASSERT_EQUAL_UINT32(1100, overruns.maxExcessMicros);
+    TEST_ASSERT_EQUAL_UINT32(1500, overruns.maxMicros);
+    TEST_ASSERT_TRUE(soc.getOverruns(*motor, overruns));
+    TEST_ASSERT_EQUAL_UINT32(0, overruns.count);
+}
+
+void test_watchdog_overrun_outside_of_the_components() {
+    ESP32Soc soc;
+    soc.setWatchdog(WATCHDOG);
+    auto motor = std::make_shared<SlowLoopComponent>("motor", true);
+    motor->advanceMicros = 300;
+    soc.addComponent(motor);
+
+    // e.g. a blocking Serial between advanceState() and render()
+    soc.advanceState(millis());
+    virtualClock().advanceMicros(2000);
+    soc.render();
+
+    const ESP32Soc::WatchdogStats &stats = soc.getWatchdogStats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.overruns);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.unattributedOverruns);
+    TEST_ASSERT_TRUE(stats.lastBlamed == nullptr);
+    TEST_ASSERT_EQUAL_UINT32(1300, stats.lastExcessMicros);
+}
+
+void test_watchdog_degrades_a_non_critical_component() {
+    ESP32Soc soc;
+    soc.setWatchdog(WATCHDOG);
+    auto display = std::make_shared<SlowLoopComponent>("display", false);
+    display->renderMicros = 2000;
+    soc.addComponent(display);
+
+    runLoops(soc, 1);
+    TEST_ASSERT_TRUE(soc.isDegraded(*display));
+    TEST_ASSERT_EQUAL_UINT32(1, display->degradations.size());
+    TEST_ASSERT_TRUE(display->degradations[0]);
+
+    // its render is skipped for three loops, then it is back
+    runLoops(soc, 2);
+    TEST_ASSERT_EQUAL_INT(1, display->rendered);
+    TEST_ASSERT_TRUE(soc.isDegraded(*display));
+    runLoops(soc, 1);
+    TEST_ASSERT_FALSE(soc.isDegraded(*display));
+    TEST_ASSERT_EQUAL_UINT32(2, display->degradations.size());
+    TEST_ASSERT_FALSE(display->degradations[1]);
+    display->renderMicros = 100;
+    runLoops(soc, 1);
+    TEST_ASSERT_EQUAL_INT(2, display->rendered);
+    TEST_ASSERT_EQUAL_UINT32(1, soc.getWatchdogStats().overruns);
+}
+
+void test_watchdog_never_degrades_a_critical_component() {
+    ESP32Soc soc;
+    soc.setWatchdog(WATCHDOG);
+    auto motor = std::make_shared<SlowLoopComponent>("motor", true);
+    motor->renderMicros = 2000;
+    soc.addComponent(motor);
+
+    runLoops(soc, 3);
+
+    TEST_ASSERT_FALSE(soc.isDegraded(*motor));
+    TEST_ASSERT_EQUAL_INT(3, motor->rendered);
+    TEST_ASSERT_EQUAL_UINT32(0, motor->degradations.size());
+    TEST_ASSERT_EQUAL_UINT32(3, soc.getWatchdogStats().overruns);
+}
+
+void test_watchdog_off_by_default() {
+    ESP32Soc soc;
+    auto display = std::make_shared<SlowLoopComponent>("display", false);
+    display->renderMicros = 5000;
+    soc.addComponent(display);
+
+    runLoops(soc, 3);
+
+    TEST_ASSERT_EQUAL_UINT32(0, soc.getWatchdogStats().iterations);
+    TEST_ASSERT_EQUAL_INT(3, display->rendered);
+    SlowLoopComponent stranger("stranger", false);
+    ESP32Soc::ComponentOverruns overruns;
+    TEST_ASSERT_FALSE(soc.getOverruns(stranger, overruns));
+}
+
+void test_watchdog_report_names_the_culprit() {
+    ESP32Soc soc;
+    soc.setWatchdog(WATCHDOG);
+    auto display = std::make_shared<SlowLoopComponent>("display", true);
+    display->renderMicros = 1500;
+    soc.addComponent(display);
+    runLoops(soc, 2);
+    CapturingLogger logger;
+
+    soc.reportWatchdog(logger);
+
+    TEST_ASSERT_EQUAL_UINT32(2, logger.lines.size());
+    TEST_ASSERT_EQUAL_STRING("INFO: Watchdog: 2 overruns in 2 loops, the longest took 1500 us of 1000 us.",
+                             logger.lines[0].c_str());
+    TEST_ASSERT_EQUAL_STRING("INFO: Watchdog: display overran 2 times, up to 1100 us beyond its slice, the longest took 1500 us.",
+                             logger.lines[1].c_str());
+}
+
+void test_throttled_logger_drops_chatter_but_not_errors() {
+    CapturingLogger target;
+    ThrottledLogger logger(target);
+
+    logger.info("homed after %d steps", 42);
+    logger.setThrottled(true);
+    logger.debug("step %d", 1);
+    logger.info("step %d", 2);
+    logger.error("stalled at %d", 3);
+    TEST_ASSERT_EQUAL_UINT32(2, logger.getDroppedCount());
+    logger.setThrottled(false);
+
+    TEST_ASSERT_EQUAL_UINT32(3, target.lines.size());
+    TEST_ASSERT_EQUAL_STRING("INFO: homed after 42 steps", target.lines[0].c_str());
+    TEST_ASSERT_EQUAL_STRING("ERROR: stalled at 3", target.lines[1].c_str());
+    TEST_ASSERT_EQUAL_STRING("INFO: 2 messages dropped while throttled.", target.lines[2].c_str());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_independent_components_set_up_side_by_side);
+    RUN_TEST(test_dependent_component_waits_for_its_dependency);
+    RUN_TEST(test_ready_dependency_releases_at_once);
+    RUN_TEST(test_dependency_outside_of_the_soc_only_has_to_be_set_up);
+    RUN_TEST(test_teardown_skips_components_never_set_up);
+    RUN_TEST(test_boot_profiler_records_every_setup);
+    RUN_TEST(test_watchdog_loop_within_budget);
+    RUN_TEST(test_watchdog_blames_the_component_beyond_its_slice);
+    RUN_TEST(test_watchdog_overrun_outside_of_the_components);
+    RUN_TEST(test_watchdog_degrades_a_non_critical_component);
+    RUN_TEST(test_watchdog_never_degrades_a_critical_component);
+    RUN_TEST(test_watchdog_off_by_default);
+    RUN_TEST(test_watchdog_report_names_the_culprit);
+    RUN_TEST(test_throttled_logger_drops_chatter_but_not_errors);
+    return UNITY_END();
+}
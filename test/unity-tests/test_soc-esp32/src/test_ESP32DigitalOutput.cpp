@@ -5,17 +5,21 @@
 // pull in your implementation and API
 #include <soc/api/IDigitalOutput.h>
 #include <soc/esp32/ESP32DigitalOutput.h>
+#include <soc/esp32/ESP32LedcPwmOutput.h>
 
 using soc::api::IDigitalOutput;
 using soc::esp32::ESP32DigitalOutput;
+using soc::esp32::ESP32LedcPwmOutput;
 
 // helper to clear state before each test
 void setUp(void) {
     fakePinValues().clear();
+    fakeLedcChannels().clear();
 }
 
 void tearDown(void) {
     fakePinValues().clear();
+    fakeLedcChannels().clear();
 }
 
 void test_on() {
@@ -32,10 +36,40 @@ void test_off() {
     TEST_ASSERT_EQUAL_INT(LOW, fakePinValues()[PIN]);
 }
 
+void test_pwm_begin_attaches_the_pin_inactive() {
+    ESP32LedcPwmOutput pwm(27, 2, 25000);
+    pwm.begin();
+    TEST_ASSERT_EQUAL_INT(27, fakeLedcChannels()[2].pin);
+    TEST_ASSERT_EQUAL_INT(10, fakeLedcChannels()[2].resolutionBits);
+    TEST_ASSERT_EQUAL_UINT32(0, fakeLedcChannels()[2].duty);
+}
+
+void test_pwm_duty_is_scaled_to_the_resolution() {
+    ESP32LedcPwmOutput pwm(27, 0);
+    pwm.begin();
+    pwm.setDuty(250);
+    TEST_ASSERT_EQUAL_UINT32(256, fakeLedcChannels()[0].duty);
+    pwm.setDuty(ESP32LedcPwmOutput::DUTY_FULL);
+    TEST_ASSERT_EQUAL_UINT32(1023, fakeLedcChannels()[0].duty);
+    pwm.setDuty(5000);
+    TEST_ASSERT_EQUAL_UINT16(ESP32LedcPwmOutput::DUTY_FULL, pwm.getDuty());
+}
+
+void test_pwm_active_low_inverts_the_duty() {
+    ESP32LedcPwmOutput pwm(21, 1, 25000, true);
+    pwm.begin();
+    TEST_ASSERT_EQUAL_UINT32(1023, fakeLedcChannels()[1].duty);
+    pwm.setDuty(300);
+    TEST_ASSERT_EQUAL_UINT32(1023 - 307, fakeLedcChannels()[1].duty);
+}
+
 int main() {
     UNITY_BEGIN();
     RUN_TEST(test_on);
     RUN_TEST(test_off);
+    RUN_TEST(test_pwm_begin_attaches_the_pin_inactive);
+    RUN_TEST(test_pwm_duty_is_scaled_to_the_resolution);
+    RUN_TEST(test_pwm_active_low_inverts_the_duty);
     // …
     return UNITY_END();
 }
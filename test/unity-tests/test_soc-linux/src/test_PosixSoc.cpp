@@ -0,0 +1,283 @@
+#include <unity.h>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include <soc/api/ISocComponent.h>
+#include <soc/posix/PosixDigitalInput.h>
+#include <soc/posix/PosixDigitalOutput.h>
+#include <soc/posix/PosixLogger.h>
+#include <soc/posix/PosixSleeper.h>
+#include <soc/posix/PosixSoc.h>
+#include <soc/posix/PosixSteadyTime.h>
+
+using soc::posix::PosixDigitalInput;
+using soc::posix::PosixDigitalOutput;
+using soc::posix::PosixLogger;
+using soc::posix::PosixSleeper;
+using soc::posix::PosixSoc;
+using soc::posix::PosixSteadyTime;
+
+static std::string tempPath(const char *name)
+{
+    return std::string("/tmp/test_soc-linux-") + std::to_string(getpid()) + "-" + name;
+}
+
+static std::string readFile(const std::string &path)
+{
+    std::string content;
+    FILE *file = fopen(path.c_str(), "r");
+    if (file)
+    {
+        char buffer[256];
+        size_t count;
+        while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        {
+            content.append(buffer, count);
+        }
+        fclose(file);
+    }
+    return content;
+}
+
+static double elapsedMillis(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_time_follows_the_steady_clock() {
+    PosixSteadyTime time;
+    unsigned long start = time.now();
+    PosixSleeper().sleep(20);
+    unsigned long elapsed = time.now() - start;
+    TEST_ASSERT_TRUE(elapsed >= 20);
+    TEST_ASSERT_TRUE(elapsed < 1000);
+}
+
+void test_time_scale_speeds_the_time_up() {
+    PosixSteadyTime time(1000.0);
+    PosixSleeper().sleep(5);
+    // 5 ms of wall clock are at least 5 s
+    soc::api::ITime::TimeComponents components;
+    TEST_ASSERT_TRUE(time.asTimeComponents(components));
+    TEST_ASSERT_TRUE(components.seconds >= 5 || components.minutes > 0);
+    TEST_ASSERT_TRUE(time.nowMicros() >= 5000000ULL);
+}
+
+void test_sleeper_sleeps_scaled_time() {
+    auto start = std::chrono::steady_clock::now();
+    PosixSleeper(100.0).sleep(1000);
+    double wall = elapsedMillis(start);
+    TEST_ASSERT_TRUE(wall >= 10.0);
+    TEST_ASSERT_TRUE(wall < 500.0);
+}
+
+void test_logger_buffers_until_flushed() {
+    std::string path = tempPath("log");
+    unlink(path.c_str());
+    {
+        PosixLogger logger(path.c_str(), soc::api::ILogger::INFO_LEVEL);
+        TEST_ASSERT_TRUE(logger.isLoggingToFile());
+        logger.debug("filtered %d", 1);
+        logger.info("tick %d of %s", 42, "second");
+        TEST_ASSERT_EQUAL_STRING("", readFile(path).c_str());
+
+        logger.flush();
+        TEST_ASSERT_EQUAL_STRING("INFO: tick 42 of second\n", readFile(path).c_str());
+    }
+    unlink(path.c_str());
+}
+
+void test_logger_writes_warnings_at_once() {
+    std::string path = tempPath("warn");
+    unlink(path.c_str());
+    {
+        PosixLogger logger(path.c_str(), soc::api::ILogger::INFO_LEVEL);
+        logger.info("before");
+        logger.warn("homing took %lu ms", 1234UL);
+        TEST_ASSERT_EQUAL_STRING("INFO: before\nWARN: homing took 1234 ms\n", readFile(path).c_str());
+        logger.info("after");
+    }
+    // the destructor flushes
+    TEST_ASSERT_EQUAL_STRING("INFO: before\nWARN: homing took 1234 ms\nINFO: after\n", readFile(path).c_str());
+    unlink(path.c_str());
+}
+
+void test_logger_keeps_lines_whole_when_the_buffer_is_full() {
+    std::string path = tempPath("full");
+    unlink(path.c_str());
+    std::string message(1000, 'x');
+    size_t lines = 2 * PosixLogger::BUFFER_SIZE / 1000;
+    {
+        PosixLogger logger(path.c_str(), soc::api::ILogger::INFO_LEVEL);
+        for (size_t i = 0; i < lines; i++)
+        {
+            logger.info("%s", message.c_str());
+        }
+    }
+    std::string content = readFile(path);
+    std::string line = "INFO: " + message + "\n";
+    TEST_ASSERT_EQUAL_UINT32(lines * line.size(), content.size());
+    TEST_ASSERT_TRUE(content.find(line + line) == 0);
+    TEST_ASSERT_TRUE(content.find("xI") == std::string::npos);
+    unlink(path.c_str());
+}
+
+void test_input_in_memory() {
+    PosixDigitalInput input;
+    input.begin();
+    TEST_ASSERT_FALSE(input.isPipeOpen());
+    TEST_ASSERT_FALSE(input.isActive());
+    input.setActive(true);
+    TEST_ASSERT_TRUE(input.isActive());
+}
+
+void test_input_follows_its_pipe() {
+    std::string path = tempPath("switch");
+    unlink(path.c_str());
+    PosixDigitalInput input(path.c_str());
+    input.begin();
+    TEST_ASSERT_TRUE(input.isPipeOpen());
+    TEST_ASSERT_FALSE(input.isActive());
+
+    int writer = open(path.c_str(), O_WRONLY | O_NONBLOCK);
+    TEST_ASSERT_TRUE(writer >= 0);
+    TEST_ASSERT_EQUAL_INT(2, write(writer, "1\n", 2));
+    TEST_ASSERT_TRUE(input.isActive());
+    TEST_ASSERT_TRUE(input.isActive()); // stays active without new input
+
+    // the last state written wins
+    TEST_ASSERT_EQUAL_INT(4, write(writer, "0\n1\n", 4));
+    close(writer);
+    TEST_ASSERT_TRUE(input.isActive());
+
+    // a new writer after the first one closed
+    writer = open(path.c_str(), O_WRONLY | O_NONBLOCK);
+    TEST_ASSERT_EQUAL_INT(1, write(writer, "0", 1));
+    close(writer);
+    TEST_ASSERT_FALSE(input.isActive());
+    unlink(path.c_str());
+}
+
+void test_output_reports_changes_through_its_pipe() {
+    std::string path = tempPath("led");
+    unlink(path.c_str());
+    PosixDigitalOutput output(path.c_str());
+    output.begin();
+    output.on(); // nobody reads yet, dropped
+
+    int reader = open(path.c_str(), O_RDONLY | O_NONBLOCK);
+    TEST_ASSERT_TRUE(reader >= 0);
+    output.off();
+    output.off();
+    output.on();
+
+    char buffer[16] = {0};
+    TEST_ASSERT_EQUAL_INT(4, read(reader, buffer, sizeof(buffer) - 1));
+    TEST_ASSERT_EQUAL_STRING("0\n1\n", buffer);
+    TEST_ASSERT_TRUE(output.isOn());
+    TEST_ASSERT_EQUAL_UINT32(3, output.getChangeCount());
+
+    // the reader going away does not stop the output
+    close(reader);
+    output.off();
+    TEST_ASSERT_FALSE(output.isOn());
+    unlink(path.c_str());
+}
+
+class RecordingComponent : public soc::api::ISocComponent
+{
+public:
+    RecordingComponent(const char *name, std::vector<std::string> &calls) : _name(name), _calls(calls) {}
+
+    void setup() override { _calls.push_back(_name + ".setup"); }
+    void advanceState(unsigned long currentTimeMs) override { _calls.push_back(_name + ".advance " + std::to_string(currentTimeMs)); }
+    void render() override { _calls.push_back(_name + ".render"); }
+    void teardown() override { _calls.push_back(_name + ".teardown"); }
+    bool isSetUp() const override { return setUp; }
+    const ISocComponent *getDependency(size_t index) const override { return index == 0 ? dependency : nullptr; }
+
+    bool setUp = true;
+    const ISocComponent *dependency = nullptr;
+
+private:
+    const std::string _name;
+    std::vector<std::string> &_calls;
+};
+
+void test_soc_runs_its_components_in_order() {
+    std::vector<std::string> calls;
+    {
+        PosixSoc soc;
+        soc.addComponent(std::make_shared<RecordingComponent>("a", calls));
+        soc.addComponent(nullptr);
+        soc.addComponent(std::make_shared<RecordingComponent>("b", calls));
+        soc.processInput();
+        soc.advanceState(7);
+        soc.render();
+    }
+
+    const char *expected[] = {"a.setup", "b.setup", "a.advance 7", "b.advance 7", "a.render", "b.render",
+                              "b.teardown", "a.teardown"};
+    TEST_ASSERT_EQUAL_UINT32(8, calls.size());
+    for (size_t i = 0; i < calls.size(); i++)
+    {
+        TEST_ASSERT_EQUAL_STRING(expected[i], calls[i].c_str());
+    }
+}
+
+void test_soc_sets_up_a_component_after_its_dependency() {
+    std::vector<std::string> calls;
+    {
+        PosixSoc soc;
+        auto tuning = std::make_shared<RecordingComponent>("tuning", calls);
+        tuning->setUp = false;
+        auto hand = std::make_shared<RecordingComponent>("hand", calls);
+        hand->dependency = tuning.get();
+        soc.addComponent(hand); // waits, even though it is added first
+        soc.addComponent(tuning);
+        soc.advanceState(1);
+        TEST_ASSERT_FALSE(soc.isBooted());
+
+        tuning->setUp = true;
+        soc.advanceState(2); // the hand is set up at the end of the loop
+        soc.advanceState(3);
+        TEST_ASSERT_TRUE(soc.isBooted());
+    }
+
+    const char *expected[] = {"tuning.setup", "tuning.advance 1", "tuning.advance 2", "hand.setup",
+                              "hand.advance 3", "tuning.advance 3", "tuning.teardown", "hand.teardown"};
+    TEST_ASSERT_EQUAL_UINT32(8, calls.size());
+    for (size_t i = 0; i < calls.size(); i++)
+    {
+        TEST_ASSERT_EQUAL_STRING(expected[i], calls[i].c_str());
+    }
+}
+
+int main() {
+    // see PosixDigitalOutput
+    signal(SIGPIPE, SIG_IGN);
+    UNITY_BEGIN();
+    RUN_TEST(test_time_follows_the_steady_clock);
+    RUN_TEST(test_time_scale_speeds_the_time_up);
+    RUN_TEST(test_sleeper_sleeps_scaled_time);
+    RUN_TEST(test_logger_buffers_until_flushed);
+    RUN_TEST(test_logger_writes_warnings_at_once);
+    RUN_TEST(test_logger_keeps_lines_whole_when_the_buffer_is_full);
+    RUN_TEST(test_input_in_memory);
+    RUN_TEST(test_input_follows_its_pipe);
+    RUN_TEST(test_output_reports_changes_through_its_pipe);
+    RUN_TEST(test_soc_runs_its_components_in_order);
+    RUN_TEST(test_soc_sets_up_a_component_after_its_dependency);
+    return UNITY_END();
+}